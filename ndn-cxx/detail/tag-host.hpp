@@ -25,11 +25,42 @@
 #include "ndn-cxx/detail/common.hpp"
 #include "ndn-cxx/tag.hpp"
 
-#include <map>
+#include <boost/container/small_vector.hpp>
+#include <cstring>
 
 namespace ndn {
 
+namespace detail {
+
+/** \brief determines whether the value of tag type T can be stored inline in a TagHost
+ *
+ *  This is true for a SimpleTag whose value is trivially copyable and fits in 8 octets.
+ */
+template<typename T, typename = void>
+struct IsInlineTag : std::false_type
+{
+};
+
+template<typename T>
+struct IsInlineTag<T, decltype(void(std::declval<typename T::ValueType>()))>
+  : std::integral_constant<bool,
+      std::is_same<T, SimpleTag<typename T::ValueType, T::getTypeId()>>::value &&
+      std::is_trivially_copyable<typename T::ValueType>::value &&
+      sizeof(typename T::ValueType) <= sizeof(uint64_t)>
+{
+};
+
+} // namespace detail
+
 /** \brief Base class to store tag information (e.g., inside Interest and Data packets)
+ *
+ *  Tags are kept in a small flat array searched by type identifier. A packet usually carries
+ *  no more than a few tags, which are stored without allocating. The value of a SimpleTag
+ *  assigned with setTagValue() is stored inline if it is trivially copyable and fits in 8 octets,
+ *  so that no Tag object is allocated unless getTag() is called.
+ *
+ *  The const accessors getTag() and getTagValue() never modify the tag host, so they may be
+ *  called concurrently on a shared packet as long as no tag is set or removed at the same time.
  */
 class TagHost
 {
@@ -37,6 +68,8 @@ public:
   /** \brief get a tag item
    *  \tparam T type of the tag, which must be a subclass of ndn::Tag
    *  \retval nullptr if no Tag of type T is stored
+   *  \note If the value was stored inline by setTagValue(), each call returns a new Tag object
+   *        holding a copy of the value.
    */
   template<typename T>
   shared_ptr<T>
@@ -57,8 +90,111 @@ public:
   void
   removeTag() const;
 
+  /** \brief get the value of a SimpleTag without copying the Tag object
+   *  \tparam T a SimpleTag type
+   *  \retval nullopt if no Tag of type T is stored
+   */
+  template<typename T>
+  optional<typename T::ValueType>
+  getTagValue() const;
+
+  /** \brief set a SimpleTag by value
+   *  \tparam T a SimpleTag type
+   *  \note Tag can be set even on a const tag host instance
+   */
+  template<typename T>
+  void
+  setTagValue(const typename T::ValueType& value) const;
+
+private:
+  struct Entry
+  {
+    int type;
+    shared_ptr<Tag> tag; ///< nullptr if the value is stored inline
+    uint64_t inlineValue;
+  };
+
+  Entry*
+  findEntry(int type) const noexcept
+  {
+    for (auto& entry : m_tags) {
+      if (entry.type == type) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  Entry&
+  findOrInsertEntry(int type) const
+  {
+    Entry* entry = findEntry(type);
+    if (entry == nullptr) {
+      m_tags.push_back({type, nullptr, 0});
+      entry = &m_tags.back();
+    }
+    return *entry;
+  }
+
+  void
+  eraseEntry(int type) const noexcept
+  {
+    Entry* entry = findEntry(type);
+    if (entry != nullptr) {
+      m_tags.erase(m_tags.begin() + (entry - m_tags.data()));
+    }
+  }
+
+  template<typename T>
+  static typename T::ValueType
+  loadInline(const Entry& entry, std::true_type) noexcept
+  {
+    typename T::ValueType value;
+    std::memcpy(&value, &entry.inlineValue, sizeof(value));
+    return value;
+  }
+
+  template<typename T>
+  static optional<typename T::ValueType>
+  loadInline(const Entry&, std::false_type) noexcept
+  {
+    BOOST_ASSERT_MSG(false, "only an inline tag type can have an inline value");
+    return nullopt;
+  }
+
+  template<typename T>
+  static shared_ptr<T>
+  makeTagFromInline(const Entry& entry, std::true_type)
+  {
+    return make_shared<T>(loadInline<T>(entry, std::true_type{}));
+  }
+
+  template<typename T>
+  static shared_ptr<T>
+  makeTagFromInline(const Entry&, std::false_type)
+  {
+    BOOST_ASSERT_MSG(false, "only an inline tag type can have an inline value");
+    return nullptr;
+  }
+
+  template<typename T>
+  void
+  setTagValueImpl(const typename T::ValueType& value, std::true_type) const
+  {
+    Entry& entry = findOrInsertEntry(T::getTypeId());
+    entry.tag = nullptr;
+    std::memcpy(&entry.inlineValue, &value, sizeof(value));
+  }
+
+  template<typename T>
+  void
+  setTagValueImpl(const typename T::ValueType& value, std::false_type) const
+  {
+    setTag(make_shared<T>(value));
+  }
+
 private:
-  mutable std::map<int, shared_ptr<Tag>> m_tags;
+  mutable boost::container::small_vector<Entry, 3> m_tags;
 };
 
 template<typename T>
@@ -67,11 +203,15 @@ TagHost::getTag() const
 {
   static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
 
-  auto it = m_tags.find(T::getTypeId());
-  if (it == m_tags.end()) {
+  const Entry* entry = findEntry(T::getTypeId());
+  if (entry == nullptr) {
     return nullptr;
   }
-  return static_pointer_cast<T>(it->second);
+  if (entry->tag == nullptr) {
+    // the value was stored inline; wrap a copy without caching it, so that this stays read-only
+    return makeTagFromInline<T>(*entry, detail::IsInlineTag<T>{});
+  }
+  return static_pointer_cast<T>(entry->tag);
 }
 
 template<typename T>
@@ -81,10 +221,10 @@ TagHost::setTag(shared_ptr<T> tag) const
   static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
 
   if (tag == nullptr) {
-    m_tags.erase(T::getTypeId());
+    eraseEntry(T::getTypeId());
   }
   else {
-    m_tags[T::getTypeId()] = std::move(tag);
+    findOrInsertEntry(T::getTypeId()).tag = std::move(tag);
   }
 }
 
@@ -95,6 +235,33 @@ TagHost::removeTag() const
   setTag<T>(nullptr);
 }
 
+template<typename T>
+optional<typename T::ValueType>
+TagHost::getTagValue() const
+{
+  static_assert(std::is_base_of<SimpleTag<typename T::ValueType, T::getTypeId()>, T>::value,
+                "T must be a SimpleTag");
+
+  const Entry* entry = findEntry(T::getTypeId());
+  if (entry == nullptr) {
+    return nullopt;
+  }
+  if (entry->tag == nullptr) {
+    return loadInline<T>(*entry, detail::IsInlineTag<T>{});
+  }
+  return static_cast<const T&>(*entry->tag).get();
+}
+
+template<typename T>
+void
+TagHost::setTagValue(const typename T::ValueType& value) const
+{
+  static_assert(std::is_base_of<SimpleTag<typename T::ValueType, T::getTypeId()>, T>::value,
+                "T must be a SimpleTag");
+
+  setTagValueImpl<T>(value, detail::IsInlineTag<T>{});
+}
+
 } // namespace ndn
 
 #endif // NDN_DETAIL_TAG_HOST_HPP
@@ -460,6 +460,13 @@ Block::push_back(const Block& element)
   m_elements.push_back(element);
 }
 
+void
+Block::push_back(Block&& element)
+{
+  resetWire();
+  m_elements.push_back(std::move(element));
+}
+
 Block::element_iterator
 Block::insert(Block::element_const_iterator pos, const Block& element)
 {
@@ -467,6 +474,13 @@ Block::insert(Block::element_const_iterator pos, const Block& element)
   return m_elements.insert(pos, element);
 }
 
+Block::element_iterator
+Block::insert(Block::element_const_iterator pos, Block&& element)
+{
+  resetWire();
+  return m_elements.insert(pos, std::move(element));
+}
+
 // ---- misc ----
 
 Block::operator boost::asio::const_buffer() const
@@ -376,6 +376,13 @@ public: // sub-elements
   void
   push_back(const Block& element);
 
+  /** @brief Append a sub-element
+   *  @note This overload takes over the underlying buffer of @p element without touching
+   *        its reference count.
+   */
+  void
+  push_back(Block&& element);
+
   /** @brief Insert a sub-element
    *  @param pos position of the new sub-element
    *  @param element new sub-element to insert
@@ -384,6 +391,14 @@ public: // sub-elements
   element_iterator
   insert(element_const_iterator pos, const Block& element);
 
+  /** @brief Insert a sub-element
+   *  @param pos position of the new sub-element
+   *  @param element new sub-element to insert
+   *  @return iterator in elements() to the new sub-element
+   */
+  element_iterator
+  insert(element_const_iterator pos, Block&& element);
+
   /** @brief Get container of sub-elements
    *  @pre parse() has been executed
    */
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/encoding/buffer-pool.hpp"
+
+namespace ndn {
+namespace encoding {
+
+constexpr std::array<size_t, 3> BufferPool::SIZE_CLASSES;
+constexpr size_t BufferPool::DEFAULT_CAPACITY;
+
+// Set while the pool of the current thread is alive, so that buffers released during or after
+// thread-local destruction are freed instead of being returned to a destroyed pool.
+static thread_local bool t_isPoolAlive = false;
+
+class BufferPool::Deleter
+{
+public:
+  void
+  operator()(Buffer* buffer) const noexcept
+  {
+    if (t_isPoolAlive) {
+      BufferPool::getThreadLocal().release(buffer);
+    }
+    else {
+      delete buffer;
+    }
+  }
+};
+
+BufferPool&
+BufferPool::getThreadLocal()
+{
+  thread_local BufferPool pool;
+  return pool;
+}
+
+BufferPool::BufferPool()
+{
+  setCapacity(DEFAULT_CAPACITY);
+  t_isPoolAlive = true;
+}
+
+BufferPool::~BufferPool()
+{
+  t_isPoolAlive = false;
+}
+
+shared_ptr<Buffer>
+BufferPool::allocate(size_t size)
+{
+  auto sizeClass = std::lower_bound(SIZE_CLASSES.begin(), SIZE_CLASSES.end(), size);
+  if (sizeClass == SIZE_CLASSES.end() || m_capacity == 0) {
+    return make_shared<Buffer>(size);
+  }
+
+  auto& idle = m_idle[sizeClass - SIZE_CLASSES.begin()];
+  unique_ptr<Buffer> buffer;
+  if (idle.empty()) {
+    buffer = make_unique<Buffer>();
+    buffer->reserve(*sizeClass);
+  }
+  else {
+    buffer = std::move(idle.back());
+    idle.pop_back();
+  }
+  buffer->resize(size);
+  return shared_ptr<Buffer>(buffer.release(), Deleter());
+}
+
+void
+BufferPool::release(Buffer* buffer) noexcept
+{
+  unique_ptr<Buffer> owned(buffer);
+
+  // a buffer is filed under the largest size class that fits into its capacity, so that
+  // allocate() never needs to grow a reused buffer
+  auto sizeClass = std::upper_bound(SIZE_CLASSES.begin(), SIZE_CLASSES.end(), buffer->capacity());
+  if (sizeClass == SIZE_CLASSES.begin() || buffer->capacity() > SIZE_CLASSES.back()) {
+    return;
+  }
+
+  auto& idle = m_idle[sizeClass - SIZE_CLASSES.begin() - 1];
+  if (idle.size() < m_capacity) {
+    // cannot throw, storage for m_capacity entries has been reserved in setCapacity()
+    idle.push_back(std::move(owned));
+  }
+}
+
+void
+BufferPool::setCapacity(size_t capacity)
+{
+  for (auto& idle : m_idle) {
+    if (idle.size() > capacity) {
+      idle.resize(capacity);
+    }
+    idle.reserve(capacity);
+  }
+  m_capacity = capacity;
+}
+
+size_t
+BufferPool::size() const noexcept
+{
+  size_t n = 0;
+  for (const auto& idle : m_idle) {
+    n += idle.size();
+  }
+  return n;
+}
+
+void
+BufferPool::clear() noexcept
+{
+  for (auto& idle : m_idle) {
+    idle.clear();
+  }
+}
+
+} // namespace encoding
+} // namespace ndn
@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_BUFFER_POOL_HPP
+#define NDN_ENCODING_BUFFER_POOL_HPP
+
+#include "ndn-cxx/encoding/buffer.hpp"
+#include "ndn-cxx/encoding/tlv.hpp"
+
+#include <array>
+
+namespace ndn {
+namespace encoding {
+
+/**
+ * @brief Per-thread pool of wire buffers used by Encoder
+ *
+ * Buffers are grouped into size classes that follow typical packet sizes.  A buffer obtained
+ * from allocate() goes back to the pool of the thread that releases the last reference to it,
+ * usually when the last Block sharing the wire encoding is destroyed, and is handed out again
+ * by a subsequent allocate() of the same size class.  Requests larger than the largest size
+ * class are served by regular heap allocations and are never pooled.
+ *
+ * No locking is involved: every thread owns an independent pool.
+ */
+class BufferPool : noncopyable
+{
+public:
+  /**
+   * @brief Size classes of pooled buffers, in ascending order
+   */
+  static constexpr std::array<size_t, 3> SIZE_CLASSES{{512, 2048, MAX_NDN_PACKET_SIZE}};
+
+  /**
+   * @brief Default maximum number of idle buffers kept in each size class
+   */
+  static constexpr size_t DEFAULT_CAPACITY = 64;
+
+  /**
+   * @brief Get the pool of the calling thread
+   */
+  static BufferPool&
+  getThreadLocal();
+
+  ~BufferPool();
+
+  /**
+   * @brief Obtain a buffer of exactly @p size octets
+   * @note Unlike `Buffer(size)`, octets of the returned buffer are not zero-initialized
+   *       when the buffer is reused.
+   */
+  shared_ptr<Buffer>
+  allocate(size_t size);
+
+  /**
+   * @brief Get the maximum number of idle buffers kept in each size class
+   */
+  size_t
+  getCapacity() const noexcept
+  {
+    return m_capacity;
+  }
+
+  /**
+   * @brief Set the maximum number of idle buffers kept in each size class
+   *
+   * Zero disables pooling on the calling thread.  Idle buffers exceeding the new capacity
+   * are freed immediately.
+   */
+  void
+  setCapacity(size_t capacity);
+
+  /**
+   * @brief Get the number of idle buffers in the pool
+   */
+  size_t
+  size() const noexcept;
+
+  /**
+   * @brief Free all idle buffers
+   */
+  void
+  clear() noexcept;
+
+private:
+  BufferPool();
+
+  void
+  release(Buffer* buffer) noexcept;
+
+  class Deleter;
+
+private:
+  std::array<std::vector<unique_ptr<Buffer>>, SIZE_CLASSES.size()> m_idle;
+  size_t m_capacity = 0;
+};
+
+} // namespace encoding
+} // namespace ndn
+
+#endif // NDN_ENCODING_BUFFER_POOL_HPP
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2018 Regents of the University of California.
+ * Copyright (c) 2013-2019 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -20,6 +20,7 @@
  */
 
 #include "ndn-cxx/encoding/encoder.hpp"
+#include "ndn-cxx/encoding/buffer-pool.hpp"
 
 #include <boost/endian/conversion.hpp>
 
@@ -29,7 +30,7 @@ namespace encoding {
 namespace endian = boost::endian;
 
 Encoder::Encoder(size_t totalReserve, size_t reserveFromBack)
-  : m_buffer(make_shared<Buffer>(totalReserve))
+  : m_buffer(BufferPool::getThreadLocal().allocate(totalReserve))
 {
   m_begin = m_end = m_buffer->end() - (reserveFromBack < totalReserve ? reserveFromBack : 0);
 }
@@ -72,10 +73,10 @@ Encoder::reserve(size_t size, bool addInFront)
     size_t diffEnd = m_buffer->end() - m_end;
     size_t diffBegin = m_buffer->end() - m_begin;
 
-    Buffer* buf = new Buffer(size);
+    auto buf = BufferPool::getThreadLocal().allocate(size);
     std::copy_backward(m_buffer->begin(), m_buffer->end(), buf->end());
 
-    m_buffer.reset(buf);
+    m_buffer = std::move(buf);
 
     m_end = m_buffer->end() - diffEnd;
     m_begin = m_buffer->end() - diffBegin;
@@ -84,10 +85,10 @@ Encoder::reserve(size_t size, bool addInFront)
     size_t diffEnd = m_end - m_buffer->begin();
     size_t diffBegin = m_begin - m_buffer->begin();
 
-    Buffer* buf = new Buffer(size);
+    auto buf = BufferPool::getThreadLocal().allocate(size);
     std::copy(m_buffer->begin(), m_buffer->end(), buf->begin());
 
-    m_buffer.reset(buf);
+    m_buffer = std::move(buf);
 
     m_end = m_buffer->begin() + diffEnd;
     m_begin = m_buffer->begin() + diffBegin;
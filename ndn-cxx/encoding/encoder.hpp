@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2018 Regents of the University of California.
+ * Copyright (c) 2013-2019 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -134,6 +134,10 @@ public: // unique interface to the Encoder
    * @brief Create instance of the encoder with the specified reserved sizes
    * @param totalReserve    initial buffer size to reserve
    * @param reserveFromBack number of bytes to reserve for append* operations
+   *
+   * The underlying buffer is obtained from the BufferPool of the calling thread.  For large
+   * packets, pass the exact size computed by an EncodingEstimator as @p totalReserve to avoid
+   * reallocations while prepending.
    */
   explicit
   Encoder(size_t totalReserve = MAX_NDN_PACKET_SIZE, size_t reserveFromBack = 400);
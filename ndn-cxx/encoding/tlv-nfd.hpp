@@ -49,6 +49,10 @@ enum {
   StatusCode      = 102,
   StatusText      = 103,
 
+  // batched ControlCommand
+  ControlParametersBatch = 116,
+  ControlResponseBatch   = 117,
+
   // ForwarderStatus
   NfdVersion           = 128,
   StartTimestamp       = 129,
@@ -0,0 +1,494 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_TLV_SCHEMA_HPP
+#define NDN_ENCODING_TLV_SCHEMA_HPP
+
+#include "ndn-cxx/encoding/block-helpers.hpp"
+#include "ndn-cxx/encoding/encoding-buffer.hpp"
+#include "ndn-cxx/util/time.hpp"
+
+#include <boost/range/adaptor/reversed.hpp>
+
+#include <vector>
+
+namespace ndn {
+namespace encoding {
+
+/** @brief Declarative description of fixed-layout TLV elements.
+ *
+ *  A schema lists the sub-elements of a TLV element in wire order.  Each field binds a TLV-TYPE
+ *  to a data member, a codec that converts between TLV-VALUE and the member, and a presence rule.
+ *  From the field list, Schema generates the prepend-style encoder (usable with both
+ *  EncodingBuffer and EncodingEstimator) and a single-pass decoder that walks TLV-VALUE directly,
+ *  without calling Block::parse() on the outer element.
+ *
+ *  Example:
+ *  @code
+ *  struct NextHopRecord::Schema : schema::Schema<tlv::nfd::NextHopRecord,
+ *    NDN_CXX_TLV_SCHEMA_FIELD(tlv::nfd::FaceId, NonNegativeIntegerCodec, Required,
+ *                             &NextHopRecord::m_faceId),
+ *    NDN_CXX_TLV_SCHEMA_FIELD(tlv::nfd::Cost, NonNegativeIntegerCodec, Required,
+ *                             &NextHopRecord::m_cost)>
+ *  {
+ *  };
+ *  @endcode
+ */
+namespace schema {
+
+/** @brief A sub-element found while decoding TLV-VALUE
+ */
+class Element
+{
+public:
+  /** @brief Create a Block that shares the wire buffer of the enclosing element
+   */
+  Block
+  block() const
+  {
+    return Block(buffer, type, begin, end, valueBegin, end);
+  }
+
+  size_t
+  value_size() const
+  {
+    return static_cast<size_t>(end - valueBegin);
+  }
+
+public:
+  ConstBufferPtr buffer;
+  uint32_t type;
+  Buffer::const_iterator begin;
+  Buffer::const_iterator valueBegin;
+  Buffer::const_iterator end;
+};
+
+/** @brief Codec for a TLV-VALUE that is a NonNegativeInteger
+ *
+ *  The member can be an unsigned integral type, an enumeration type, or a `time::duration`
+ *  (encoded as its count).
+ */
+struct NonNegativeIntegerCodec
+{
+  template<Tag TAG, typename T>
+  static size_t
+  encode(EncodingImpl<TAG>& encoder, uint32_t type, const T& value)
+  {
+    return prependNonNegativeIntegerBlock(encoder, type, toInteger(value));
+  }
+
+  template<typename T>
+  static void
+  decode(const Element& element, T& value)
+  {
+    auto begin = element.valueBegin;
+    fromInteger(tlv::readNonNegativeInteger(element.value_size(), begin, element.end), value);
+  }
+
+private:
+  template<typename T>
+  static std::enable_if_t<std::is_integral<T>::value, uint64_t>
+  toInteger(T value)
+  {
+    return static_cast<uint64_t>(value);
+  }
+
+  template<typename T>
+  static std::enable_if_t<std::is_enum<T>::value, uint64_t>
+  toInteger(T value)
+  {
+    return static_cast<uint64_t>(value);
+  }
+
+  template<typename Rep, typename Period>
+  static uint64_t
+  toInteger(time::duration<Rep, Period> value)
+  {
+    return static_cast<uint64_t>(value.count());
+  }
+
+  template<typename T>
+  static std::enable_if_t<std::is_integral<T>::value>
+  fromInteger(uint64_t n, T& value)
+  {
+    if (n > static_cast<uint64_t>(std::numeric_limits<T>::max())) {
+      NDN_THROW(tlv::Error("Value " + to_string(n) + " is too large"));
+    }
+    value = static_cast<T>(n);
+  }
+
+  template<typename T>
+  static std::enable_if_t<std::is_enum<T>::value>
+  fromInteger(uint64_t n, T& value)
+  {
+    std::underlying_type_t<T> underlying;
+    fromInteger(n, underlying);
+    value = static_cast<T>(underlying);
+  }
+
+  template<typename Rep, typename Period>
+  static void
+  fromInteger(uint64_t n, time::duration<Rep, Period>& value)
+  {
+    Rep count;
+    fromInteger(n, count);
+    value = time::duration<Rep, Period>(count);
+  }
+};
+
+/** @brief Codec for a nested TLV element
+ *
+ *  The member type must provide `wireEncode(EncodingImpl<TAG>&)` that encodes the complete
+ *  element including its TLV-TYPE, and `wireDecode(const Block&)`.
+ */
+struct NestedCodec
+{
+  template<Tag TAG, typename T>
+  static size_t
+  encode(EncodingImpl<TAG>& encoder, uint32_t type, const T& value)
+  {
+    return value.wireEncode(encoder);
+  }
+
+  template<typename T>
+  static void
+  decode(const Element& element, T& value)
+  {
+    value.wireDecode(element.block());
+  }
+};
+
+/** @brief Presence rule of a field that must appear exactly once
+ */
+struct Required
+{
+  static constexpr bool isRepeated = false;
+
+  template<typename Codec, uint32_t TYPE, Tag TAG, typename T>
+  static size_t
+  encode(EncodingImpl<TAG>& encoder, const T& value)
+  {
+    return Codec::encode(encoder, TYPE, value);
+  }
+
+  template<typename Codec, typename T>
+  static void
+  decode(const Element& element, T& value)
+  {
+    Codec::decode(element, value);
+  }
+
+  template<typename T>
+  static void
+  reset(T&)
+  {
+  }
+};
+
+/** @brief Presence rule of a field that may appear at most once; the member is `optional<T>`
+ */
+struct Optional
+{
+  static constexpr bool isRepeated = false;
+
+  template<typename Codec, uint32_t TYPE, Tag TAG, typename T>
+  static size_t
+  encode(EncodingImpl<TAG>& encoder, const optional<T>& value)
+  {
+    return value ? Codec::encode(encoder, TYPE, *value) : 0;
+  }
+
+  template<typename Codec, typename T>
+  static void
+  decode(const Element& element, optional<T>& value)
+  {
+    value.emplace();
+    Codec::decode(element, *value);
+  }
+
+  template<typename T>
+  static void
+  reset(optional<T>& value)
+  {
+    value = nullopt;
+  }
+};
+
+/** @brief Presence rule of a field that may appear any number of times consecutively;
+ *         the member is `std::vector<T>`
+ */
+struct Repeated
+{
+  static constexpr bool isRepeated = true;
+
+  template<typename Codec, uint32_t TYPE, Tag TAG, typename T>
+  static size_t
+  encode(EncodingImpl<TAG>& encoder, const std::vector<T>& values)
+  {
+    size_t totalLength = 0;
+    for (const auto& value : values | boost::adaptors::reversed) {
+      totalLength += Codec::encode(encoder, TYPE, value);
+    }
+    return totalLength;
+  }
+
+  template<typename Codec, typename T>
+  static void
+  decode(const Element& element, std::vector<T>& values)
+  {
+    values.emplace_back();
+    Codec::decode(element, values.back());
+  }
+
+  template<typename T>
+  static void
+  reset(std::vector<T>& values)
+  {
+    values.clear();
+  }
+};
+
+/** @brief Declare a field of a Schema
+ *  @tparam TYPE TLV-TYPE of the sub-element
+ *  @tparam CODEC NonNegativeIntegerCodec, NestedCodec, or a compatible codec
+ *  @tparam PRESENCE Required, Optional, or Repeated
+ *  @tparam MemberPtr pointer-to-data-member type
+ *  @tparam MEMBER the data member
+ *  @sa NDN_CXX_TLV_SCHEMA_FIELD
+ */
+template<uint32_t TYPE, typename CODEC, typename PRESENCE, typename MemberPtr, MemberPtr MEMBER>
+struct Field
+{
+  static constexpr uint32_t type = TYPE;
+  static constexpr bool isRequired = std::is_same<PRESENCE, Required>::value;
+  static constexpr bool isRepeated = PRESENCE::isRepeated;
+
+  template<Tag TAG, typename Class>
+  static size_t
+  encode(EncodingImpl<TAG>& encoder, const Class& obj)
+  {
+    return PRESENCE::template encode<CODEC, TYPE>(encoder, obj.*MEMBER);
+  }
+
+  template<typename Class>
+  static void
+  decode(const Element& element, Class& obj)
+  {
+    PRESENCE::template decode<CODEC>(element, obj.*MEMBER);
+  }
+
+  template<typename Class>
+  static void
+  reset(Class& obj)
+  {
+    PRESENCE::reset(obj.*MEMBER);
+  }
+};
+
+/** @cond implementation detail */
+namespace detail {
+
+struct DecodeState
+{
+  size_t next = 0; ///< index of the first field that may match the next sub-element
+  uint64_t seen = 0; ///< bitmap of fields that have been decoded
+};
+
+template<size_t I, typename... FIELDS>
+struct FieldList
+{
+  template<Tag TAG, typename Class>
+  static size_t
+  encode(EncodingImpl<TAG>&, const Class&)
+  {
+    return 0;
+  }
+
+  template<typename Class>
+  static void
+  reset(Class&)
+  {
+  }
+
+  template<typename Class>
+  static bool
+  decode(const Element&, Class&, DecodeState&)
+  {
+    return false;
+  }
+
+  template<typename Error>
+  static void
+  checkRequired(const DecodeState&)
+  {
+  }
+};
+
+template<size_t I, typename F, typename... REST>
+struct FieldList<I, F, REST...>
+{
+  using Next = FieldList<I + 1, REST...>;
+
+  template<Tag TAG, typename Class>
+  static size_t
+  encode(EncodingImpl<TAG>& encoder, const Class& obj)
+  {
+    // fields are prepended, so the last field is encoded first
+    size_t totalLength = Next::encode(encoder, obj);
+    totalLength += F::encode(encoder, obj);
+    return totalLength;
+  }
+
+  template<typename Class>
+  static void
+  reset(Class& obj)
+  {
+    F::reset(obj);
+    Next::reset(obj);
+  }
+
+  template<typename Class>
+  static bool
+  decode(const Element& element, Class& obj, DecodeState& state)
+  {
+    if (I >= state.next && element.type == F::type) {
+      F::decode(element, obj);
+      state.seen |= uint64_t(1) << I;
+      state.next = F::isRepeated ? I : I + 1;
+      return true;
+    }
+    return Next::decode(element, obj, state);
+  }
+
+  template<typename Error>
+  static void
+  checkRequired(const DecodeState& state)
+  {
+    if (F::isRequired && (state.seen & (uint64_t(1) << I)) == 0) {
+      NDN_THROW(Error("Missing required element of type " + to_string(F::type)));
+    }
+    Next::template checkRequired<Error>(state);
+  }
+};
+
+} // namespace detail
+/** @endcond */
+
+/** @brief A TLV element of type @p TYPE whose sub-elements are described by @p FIELDS
+ */
+template<uint32_t TYPE, typename... FIELDS>
+class Schema
+{
+  static_assert(sizeof...(FIELDS) <= 64, "Schema supports at most 64 fields");
+
+  using Fields = detail::FieldList<0, FIELDS...>;
+
+public:
+  /** @brief Prepend the TLV element representing @p obj to @p encoder
+   */
+  template<Tag TAG, typename Class>
+  static size_t
+  encode(EncodingImpl<TAG>& encoder, const Class& obj)
+  {
+    size_t totalLength = Fields::encode(encoder, obj);
+    totalLength += encoder.prependVarNumber(totalLength);
+    totalLength += encoder.prependVarNumber(TYPE);
+    return totalLength;
+  }
+
+  /** @brief Encode @p obj into a new Block, using an estimation pass to size the buffer
+   */
+  template<typename Class>
+  static Block
+  encode(const Class& obj)
+  {
+    EncodingEstimator estimator;
+    size_t estimatedSize = encode(estimator, obj);
+
+    EncodingBuffer buffer(estimatedSize, 0);
+    encode(buffer, obj);
+    return buffer.block();
+  }
+
+  /** @brief Decode @p wire into the members of @p obj in a single pass over TLV-VALUE
+   *  @throw Class::Error @p wire has an unexpected TLV-TYPE, a required field is missing,
+   *                      or an unrecognized sub-element of critical TLV-TYPE is present
+   *
+   *  Sub-elements must appear in the order in which fields are declared.  A sub-element that
+   *  does not match the next expected field is ignored if its TLV-TYPE is non-critical.
+   */
+  template<typename Class>
+  static void
+  decode(const Block& wire, Class& obj)
+  {
+    using Error = typename Class::Error;
+
+    if (wire.type() != TYPE) {
+      NDN_THROW(Error("Expecting TLV-TYPE " + to_string(TYPE) + ", but got " +
+                      to_string(wire.type())));
+    }
+
+    if (!wire.hasValue() && wire.elements_size() > 0) {
+      // sub-elements have been modified but not yet encoded
+      Block encoded(wire);
+      encoded.encode();
+      return decode(encoded, obj);
+    }
+
+    Fields::reset(obj);
+    detail::DecodeState state;
+
+    Element element;
+    element.buffer = wire.getBuffer();
+    auto pos = wire.value_begin();
+    const auto end = wire.value_end();
+    while (pos != end) {
+      element.begin = pos;
+      element.type = tlv::readType(pos, end);
+      uint64_t length = tlv::readVarNumber(pos, end);
+      if (length > static_cast<uint64_t>(end - pos)) {
+        NDN_THROW(Error("TLV-LENGTH of sub-element of type " + to_string(element.type) +
+                        " exceeds TLV-VALUE boundary of parent block"));
+      }
+      element.valueBegin = pos;
+      element.end = pos = pos + length;
+
+      if (!Fields::decode(element, obj, state) && tlv::isCriticalType(element.type)) {
+        NDN_THROW(Error("Unrecognized or out-of-order element of critical type " +
+                        to_string(element.type)));
+      }
+    }
+
+    Fields::template checkRequired<Error>(state);
+  }
+};
+
+} // namespace schema
+} // namespace encoding
+} // namespace ndn
+
+/** @brief Declare a schema::Field bound to data member @p MEMBER
+ */
+#define NDN_CXX_TLV_SCHEMA_FIELD(TYPE, CODEC, PRESENCE, MEMBER) \
+  ::ndn::encoding::schema::Field<TYPE, ::ndn::encoding::schema::CODEC, \
+                                 ::ndn::encoding::schema::PRESENCE, decltype(MEMBER), MEMBER>
+
+#endif // NDN_ENCODING_TLV_SCHEMA_HPP
@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/face-counters.hpp"
+#include "ndn-cxx/encoding/block-helpers.hpp"
+#include "ndn-cxx/encoding/encoding-buffer.hpp"
+#include "ndn-cxx/encoding/tlv-nfd.hpp"
+
+namespace ndn {
+
+FaceCounters::FaceCounters(const Block& wire)
+{
+  this->wireDecode(wire);
+}
+
+template<encoding::Tag TAG>
+size_t
+FaceCounters::wireEncode(EncodingImpl<TAG>& encoder) const
+{
+  size_t totalLength = 0;
+
+  size_t histogramLength = 0;
+  for (size_t i = util::LatencyHistogram::N_BUCKETS; i-- > 0;) {
+    uint64_t count = rtt.getBucketCount(i);
+    if (count == 0) {
+      continue;
+    }
+    size_t bucketLength = 0;
+    bucketLength += prependNonNegativeIntegerBlock(encoder, tlv::facecounters::RttBucketCount, count);
+    bucketLength += prependNonNegativeIntegerBlock(encoder, tlv::facecounters::RttBucketLowerBound,
+                                                   util::LatencyHistogram::getBucketLowerBound(i).count());
+    bucketLength += encoder.prependVarNumber(bucketLength);
+    bucketLength += encoder.prependVarNumber(tlv::facecounters::RttBucket);
+    histogramLength += bucketLength;
+  }
+  histogramLength += encoder.prependVarNumber(histogramLength);
+  histogramLength += encoder.prependVarNumber(tlv::facecounters::RttHistogram);
+  totalLength += histogramLength;
+
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::facecounters::NPendingInterests, nPendingInterests);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::facecounters::NTimedOutInterests, nTimedOutInterests);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::facecounters::NNackedInterests, nNackedInterests);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NSatisfiedInterests, nSatisfiedInterests);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutBytes, nOutBytes);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NInBytes, nInBytes);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutNacks, nOutNacks);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutData, nOutData);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutInterests, nOutInterests);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NInNacks, nInNacks);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NInData, nInData);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NInInterests, nInInterests);
+
+  totalLength += encoder.prependVarNumber(totalLength);
+  totalLength += encoder.prependVarNumber(tlv::facecounters::FaceCounters);
+  return totalLength;
+}
+
+template size_t
+FaceCounters::wireEncode<encoding::EncoderTag>(EncodingBuffer&) const;
+
+template size_t
+FaceCounters::wireEncode<encoding::EstimatorTag>(EncodingEstimator&) const;
+
+Block
+FaceCounters::wireEncode() const
+{
+  EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+  return buffer.block();
+}
+
+void
+FaceCounters::wireDecode(const Block& wire)
+{
+  if (wire.type() != tlv::facecounters::FaceCounters) {
+    NDN_THROW(Error("FaceCounters", wire.type()));
+  }
+
+  wire.parse();
+  auto val = wire.elements_begin();
+
+  auto decodeCounter = [&] (uint32_t type, const char* fieldName, util::Counter& counter) {
+    if (val == wire.elements_end() || val->type() != type) {
+      NDN_THROW(Error("missing required "s + fieldName + " field"));
+    }
+    counter.set(readNonNegativeInteger(*val));
+    ++val;
+  };
+
+  decodeCounter(tlv::nfd::NInInterests, "NInInterests", nInInterests);
+  decodeCounter(tlv::nfd::NInData, "NInData", nInData);
+  decodeCounter(tlv::nfd::NInNacks, "NInNacks", nInNacks);
+  decodeCounter(tlv::nfd::NOutInterests, "NOutInterests", nOutInterests);
+  decodeCounter(tlv::nfd::NOutData, "NOutData", nOutData);
+  decodeCounter(tlv::nfd::NOutNacks, "NOutNacks", nOutNacks);
+  decodeCounter(tlv::nfd::NInBytes, "NInBytes", nInBytes);
+  decodeCounter(tlv::nfd::NOutBytes, "NOutBytes", nOutBytes);
+  decodeCounter(tlv::nfd::NSatisfiedInterests, "NSatisfiedInterests", nSatisfiedInterests);
+  decodeCounter(tlv::facecounters::NNackedInterests, "NNackedInterests", nNackedInterests);
+  decodeCounter(tlv::facecounters::NTimedOutInterests, "NTimedOutInterests", nTimedOutInterests);
+  decodeCounter(tlv::facecounters::NPendingInterests, "NPendingInterests", nPendingInterests);
+
+  if (val == wire.elements_end() || val->type() != tlv::facecounters::RttHistogram) {
+    NDN_THROW(Error("missing required RttHistogram field"));
+  }
+  rtt.reset();
+  val->parse();
+  for (const auto& bucket : val->elements()) {
+    if (bucket.type() != tlv::facecounters::RttBucket) {
+      NDN_THROW(Error("RttBucket", bucket.type()));
+    }
+    bucket.parse();
+    if (bucket.elements_size() != 2 ||
+        bucket.elements()[0].type() != tlv::facecounters::RttBucketLowerBound ||
+        bucket.elements()[1].type() != tlv::facecounters::RttBucketCount) {
+      NDN_THROW(Error("malformed RttBucket"));
+    }
+    rtt.add(time::microseconds(readNonNegativeInteger(bucket.elements()[0])),
+            readNonNegativeInteger(bucket.elements()[1]));
+  }
+}
+
+std::ostream&
+operator<<(std::ostream& os, const FaceCounters& counters)
+{
+  return os << "Interests: {in: " << counters.nInInterests
+            << ", out: " << counters.nOutInterests << "}, "
+            << "Data: {in: " << counters.nInData
+            << ", out: " << counters.nOutData << "}, "
+            << "Nacks: {in: " << counters.nInNacks
+            << ", out: " << counters.nOutNacks << "}, "
+            << "Bytes: {in: " << counters.nInBytes
+            << ", out: " << counters.nOutBytes << "}, "
+            << "ExpressedInterests: {satisfied: " << counters.nSatisfiedInterests
+            << ", nacked: " << counters.nNackedInterests
+            << ", timed-out: " << counters.nTimedOutInterests
+            << ", pending: " << counters.nPendingInterests << "}, "
+            << "RTT: {" << counters.rtt << "}";
+}
+
+} // namespace ndn
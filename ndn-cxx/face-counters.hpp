@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_FACE_COUNTERS_HPP
+#define NDN_FACE_COUNTERS_HPP
+
+#include "ndn-cxx/encoding/block.hpp"
+#include "ndn-cxx/util/counter.hpp"
+#include "ndn-cxx/util/latency-histogram.hpp"
+
+namespace ndn {
+
+namespace tlv {
+namespace facecounters {
+
+/** @brief TLV-TYPE numbers of the FaceCounters encoding
+ *
+ *  Packet counters reuse the TLV-TYPE numbers of the NFD face dataset.
+ */
+enum {
+  FaceCounters        = 128,
+  NNackedInterests    = 160,
+  NTimedOutInterests  = 161,
+  NPendingInterests   = 162,
+  RttHistogram        = 163,
+  RttBucket           = 164,
+  RttBucketLowerBound = 165,
+  RttBucketCount      = 166,
+};
+
+} // namespace facecounters
+} // namespace tlv
+
+/**
+ * @brief Packet counters and round-trip time histogram of a Face
+ *
+ * The counters are updated by the thread that processes events of the Face, and may be read
+ * from any thread while the Face exists. Each update is a relaxed atomic store, so that counting
+ * does not slow down packet processing.
+ *
+ * An application can publish the counters as a status dataset, for example:
+ * @code
+ * dispatcher.addStatusDataset("face-counters", security::makeAcceptAllAuthorization(),
+ *   [&face] (const Name&, const Interest&, mgmt::StatusDatasetContext& context) {
+ *     context.append(face.getCounters().wireEncode());
+ *     context.end();
+ *   });
+ * @endcode
+ * A monitoring tool can decode each dataset item by constructing a FaceCounters from it.
+ */
+class FaceCounters : noncopyable
+{
+public:
+  class Error : public tlv::Error
+  {
+  public:
+    using tlv::Error::Error;
+  };
+
+  FaceCounters() = default;
+
+  explicit
+  FaceCounters(const Block& wire);
+
+  template<encoding::Tag TAG>
+  size_t
+  wireEncode(EncodingImpl<TAG>& encoder) const;
+
+  /**
+   * @brief Encode a snapshot of the counters
+   */
+  Block
+  wireEncode() const;
+
+  /**
+   * @brief Replace the counters with values decoded from @p wire
+   *
+   * The decoded round-trip time histogram places each value at the lower bound of its bucket.
+   */
+  void
+  wireDecode(const Block& wire);
+
+public:
+  util::Counter nInInterests;  ///< Interests received from the forwarder
+  util::Counter nInData;       ///< Data received from the forwarder
+  util::Counter nInNacks;      ///< Nacks received from the forwarder
+  util::Counter nOutInterests; ///< Interests sent to the forwarder
+  util::Counter nOutData;      ///< Data sent to the forwarder
+  util::Counter nOutNacks;     ///< Nacks sent to the forwarder
+  util::Counter nInBytes;      ///< octets of TLV elements received from the transport
+  util::Counter nOutBytes;     ///< octets of TLV elements sent to the transport
+
+  util::Counter nSatisfiedInterests; ///< expressed Interests satisfied by Data
+  util::Counter nNackedInterests;    ///< expressed Interests that received a Nack
+  util::Counter nTimedOutInterests;  ///< expressed Interests that timed out
+  util::Counter nPendingInterests;   ///< current number of pending Interest records
+
+  /** @brief Round-trip time of expressed Interests satisfied by Data
+   *
+   *  Measured from the call of Face::expressInterest until the Data is received.
+   */
+  util::LatencyHistogram rtt;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const FaceCounters& counters);
+
+} // namespace ndn
+
+#endif // NDN_FACE_COUNTERS_HPP
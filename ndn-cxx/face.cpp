@@ -55,6 +55,8 @@ Face::OversizedPacketError::OversizedPacketError(char pktType, const Name& name,
 {
 }
 
+constexpr size_t Face::MAX_FRAGMENTED_PACKET_SIZE;
+
 Face::Face(shared_ptr<Transport> transport)
   : m_internalIoService(make_unique<boost::asio::io_service>())
   , m_ioService(*m_internalIoService)
@@ -109,6 +111,8 @@ Face::makeDefaultTransport()
 {
   // transport=unix:///var/run/nfd.sock
   // transport=tcp://localhost:6363
+  // transport=udp://localhost:6363
+  // transport=unix+seqpacket:///var/run/nfd.seqpacket
 
   std::string transportUri;
 
@@ -137,6 +141,12 @@ Face::makeDefaultTransport()
     else if (protocol == "tcp" || protocol == "tcp4" || protocol == "tcp6") {
       return TcpTransport::create(transportUri);
     }
+    else if (protocol == "udp" || protocol == "udp4" || protocol == "udp6") {
+      return UdpTransport::create(transportUri);
+    }
+    else if (protocol == "unix+seqpacket") {
+      return UnixSeqpacketTransport::create(transportUri);
+    }
     else {
       NDN_THROW(ConfigFile::Error("Unsupported transport protocol \"" + protocol + "\""));
     }
@@ -229,6 +239,53 @@ Face::put(lp::Nack nack)
   } IO_CAPTURE_WEAK_IMPL_END
 }
 
+constexpr size_t Face::SUBMISSION_QUEUE_CAPACITY;
+
+optional<PendingInterestHandle>
+Face::trySubmit(const Interest& interest,
+                const DataCallback& afterSatisfied,
+                const NackCallback& afterNacked,
+                const TimeoutCallback& afterTimeout)
+{
+  auto id = m_impl->m_pendingInterestTable.allocateId();
+
+  Impl::InterestSubmission submission{id, interest, afterSatisfied, afterNacked, afterTimeout};
+  submission.interest.getNonce();
+  if (!submit(std::move(submission))) {
+    return nullopt;
+  }
+  return PendingInterestHandle(*this, reinterpret_cast<const PendingInterestId*>(id));
+}
+
+bool
+Face::trySubmit(Data data)
+{
+  return submit(std::move(data));
+}
+
+bool
+Face::trySubmit(lp::Nack nack)
+{
+  return submit(std::move(nack));
+}
+
+template<typename Packet>
+bool
+Face::submit(Packet&& packet)
+{
+  if (!m_impl->submit(std::forward<Packet>(packet))) {
+    return false;
+  }
+
+  // one event drains every packet submitted before it runs
+  if (!m_impl->m_isDrainScheduled.exchange(true)) {
+    IO_CAPTURE_WEAK_IMPL(post) {
+      impl->drainSubmissions();
+    } IO_CAPTURE_WEAK_IMPL_END
+  }
+  return true;
+}
+
 RegisteredPrefixHandle
 Face::setInterestFilter(const InterestFilter& filter, const InterestCallback& onInterest,
                         const RegisterPrefixFailureCallback& onFailure,
@@ -285,6 +342,12 @@ Face::registerPrefix(const Name& prefix,
   return RegisteredPrefixHandle(*this, reinterpret_cast<const RegisteredPrefixId*>(id));
 }
 
+void
+Face::setPrefixRegistrationBatching(bool enable)
+{
+  m_impl->m_isPrefixRegistrationBatched = enable;
+}
+
 void
 Face::unregisterPrefixImpl(const RegisteredPrefixId* registeredPrefixId,
                            const UnregisterPrefixSuccessCallback& onSuccess,
@@ -296,6 +359,18 @@ Face::unregisterPrefixImpl(const RegisteredPrefixId* registeredPrefixId,
   } IO_CAPTURE_WEAK_IMPL_END
 }
 
+void
+Face::setPacketTrace(shared_ptr<util::PacketTraceWriter> trace)
+{
+  m_impl->m_packetTrace = std::move(trace);
+}
+
+const FaceCounters&
+Face::getCounters() const
+{
+  return m_impl->m_counters;
+}
+
 void
 Face::doProcessEvents(time::milliseconds timeout, bool keepThread)
 {
@@ -361,12 +436,40 @@ extractLpLocalFields(NetPkt& netPacket, const lp::Packet& lpPacket)
 void
 Face::onReceiveElement(const Block& blockFromDaemon)
 {
+  if (m_impl->m_packetTrace != nullptr) {
+    m_impl->m_packetTrace->write(util::PacketDirection::INCOMING, blockFromDaemon);
+  }
+  m_impl->m_counters.nInBytes += blockFromDaemon.size();
+
   lp::Packet lpPacket(blockFromDaemon); // bare Interest/Data is a valid lp::Packet,
                                         // no need to distinguish
 
-  Buffer::const_iterator begin, end;
-  std::tie(begin, end) = lpPacket.get<lp::FragmentField>();
-  Block netPacket(&*begin, std::distance(begin, end));
+  Block netPacket;
+  if (lpPacket.has<lp::FragCountField>()) {
+    optional<std::pair<Block, lp::Packet>> reassembled;
+    try {
+      reassembled = m_impl->m_reassembler.receiveFragment(lpPacket);
+    }
+    catch (const lp::Reassembler::Error& e) {
+      NDN_LOG_DEBUG("dropping malformed fragment: " << e.what());
+      return;
+    }
+    if (!reassembled) {
+      return;
+    }
+    std::tie(netPacket, lpPacket) = std::move(*reassembled);
+  }
+  else if (blockFromDaemon.type() != lp::tlv::LpPacket) {
+    // bare Interest/Data: lpPacket wraps a copy, so use the received element directly
+    netPacket = blockFromDaemon;
+  }
+  else {
+    Buffer::const_iterator begin, end;
+    std::tie(begin, end) = lpPacket.get<lp::FragmentField>();
+    // the network packet shares the wire buffer of the received element instead of copying it
+    netPacket = Block(blockFromDaemon, begin, end);
+  }
+
   switch (netPacket.type()) {
     case tlv::Interest: {
       auto interest = make_shared<Interest>(netPacket);
@@ -375,11 +478,13 @@ Face::onReceiveElement(const Block& blockFromDaemon)
         nack->setHeader(lpPacket.get<lp::NackField>());
         extractLpLocalFields(*nack, lpPacket);
         NDN_LOG_DEBUG(">N " << nack->getInterest() << '~' << nack->getHeader().getReason());
+        ++m_impl->m_counters.nInNacks;
         m_impl->nackPendingInterests(*nack);
       }
       else {
         extractLpLocalFields(*interest, lpPacket);
         NDN_LOG_DEBUG(">I " << *interest);
+        ++m_impl->m_counters.nInInterests;
         m_impl->processIncomingInterest(std::move(interest));
       }
       break;
@@ -388,6 +493,7 @@ Face::onReceiveElement(const Block& blockFromDaemon)
       auto data = make_shared<Data>(netPacket);
       extractLpLocalFields(*data, lpPacket);
       NDN_LOG_DEBUG(">D " << data->getName());
+      ++m_impl->m_counters.nInData;
       m_impl->satisfyPendingInterests(*data);
       break;
     }
@@ -36,6 +36,7 @@ namespace ndn {
 
 class Transport;
 
+class FaceCounters;
 class PendingInterestId;
 class PendingInterestHandle;
 class RegisteredPrefixId;
@@ -47,6 +48,10 @@ namespace nfd {
 class Controller;
 } // namespace nfd
 
+namespace util {
+class PacketTraceWriter;
+} // namespace util
+
 /**
  * @brief Callback invoked when expressed Interest gets satisfied with a Data packet
  */
@@ -119,6 +124,14 @@ public:
     const size_t wireSize;
   };
 
+  /**
+   * @brief Maximum size of a network layer packet sent over a DatagramTransport
+   *
+   * Over a DatagramTransport, a packet larger than MAX_NDN_PACKET_SIZE is sent as NDNLPv2
+   * fragments, and fragmented packets received from the forwarder are reassembled.
+   */
+  static constexpr size_t MAX_FRAGMENTED_PACKET_SIZE = 65536;
+
 public: // constructors
   /**
    * @brief Create Face using given transport (or default transport if omitted)
@@ -231,7 +244,8 @@ public: // consumer
    * @param afterNacked function to be invoked if Network NACK is returned
    * @param afterTimeout function to be invoked if neither Data nor Network NACK
    *                     is returned within InterestLifetime
-   * @throw OversizedPacketError encoded Interest size exceeds MAX_NDN_PACKET_SIZE
+   * @throw OversizedPacketError encoded Interest size exceeds MAX_NDN_PACKET_SIZE, or
+   *        MAX_FRAGMENTED_PACKET_SIZE over a DatagramTransport
    * @return A handle for canceling the pending Interest.
    */
   PendingInterestHandle
@@ -354,6 +368,19 @@ public: // producer
                  const security::SigningInfo& signingInfo = security::SigningInfo(),
                  uint64_t flags = nfd::ROUTE_FLAG_CHILD_INHERIT);
 
+  /**
+   * @brief Send prefix registrations in batched commands
+   *
+   * When enabled, the prefix registrations requested by registerPrefix and setInterestFilter
+   * before the face processes its next event are sent in batched rib/register commands,
+   * so that many prefixes are registered with a few signed Interests and round trips.
+   * The connected forwarder must support batched control commands. Disabled by default.
+   * While enabled, a registration whose command cannot be issued (e.g., because signing
+   * fails) is reported through its failure callback instead of an exception.
+   */
+  void
+  setPrefixRegistrationBatching(bool enable);
+
   /**
    * @deprecated use RegisteredPrefixHandle::unregister()
    */
@@ -394,7 +421,8 @@ public: // producer
    * This method can be called to satisfy incoming Interests, or to add Data packet into the cache
    * of the local NDN forwarder if forwarder is configured to accept unsolicited Data.
    *
-   * @throw OversizedPacketError encoded Data size exceeds MAX_NDN_PACKET_SIZE
+   * @throw OversizedPacketError encoded Data size exceeds MAX_NDN_PACKET_SIZE, or
+   *        MAX_FRAGMENTED_PACKET_SIZE over a DatagramTransport
    */
   void
   put(Data data);
@@ -403,11 +431,69 @@ public: // producer
    * @brief Send a network NACK
    * @param nack the Nack; a copy will be made, so that the caller is not required to
    *             maintain the argument unchanged
-   * @throw OversizedPacketError encoded Nack size exceeds MAX_NDN_PACKET_SIZE
+   * @throw OversizedPacketError encoded Nack size exceeds MAX_NDN_PACKET_SIZE, or
+   *        MAX_FRAGMENTED_PACKET_SIZE over a DatagramTransport
    */
   void
   put(lp::Nack nack);
 
+public: // submission from other threads
+  /**
+   * @brief Maximum number of packets waiting in the submission queue.
+   */
+  static constexpr size_t SUBMISSION_QUEUE_CAPACITY = 1024;
+
+  /**
+   * @brief Express Interest from any thread
+   *
+   * Unlike expressInterest(), which posts one event per Interest, this method appends the Interest
+   * to a bounded lock-free queue, which is drained in batches on the thread that processes events
+   * of this Face. The callbacks are invoked on that thread.
+   *
+   * @return A handle for canceling the pending Interest, or nullopt if the submission queue is full
+   */
+  optional<PendingInterestHandle>
+  trySubmit(const Interest& interest,
+            const DataCallback& afterSatisfied,
+            const NackCallback& afterNacked,
+            const TimeoutCallback& afterTimeout);
+
+  /**
+   * @brief Publish data packet from any thread
+   * @retval false the submission queue is full, the Data has not been published
+   * @sa put(Data)
+   */
+  bool
+  trySubmit(Data data);
+
+  /**
+   * @brief Send a network NACK from any thread
+   * @retval false the submission queue is full, the Nack has not been sent
+   * @sa put(lp::Nack)
+   */
+  bool
+  trySubmit(lp::Nack nack);
+
+public: // tracing
+  /**
+   * @brief Record every packet sent to or received from the forwarder
+   * @param trace the trace file, or nullptr to stop tracing
+   *
+   * Packets are recorded as they appear on the transport, including NDNLPv2 headers and
+   * fragmentation. This method must be called from the thread that processes events.
+   */
+  void
+  setPacketTrace(shared_ptr<util::PacketTraceWriter> trace);
+
+  /**
+   * @brief Get packet counters and round-trip time histogram of this face
+   *
+   * The returned counters may be read from any thread while this face exists.
+   * Counters of the underlying connection are available via getTransport()->getCounters().
+   */
+  const FaceCounters&
+  getCounters() const;
+
 public: // IO routine
   /**
    * @brief Process any data to receive or call timeout callbacks.
@@ -436,7 +522,8 @@ public: // IO routine
    * the data.  If you call this from an main event loop, you may want to catch and
    * log/disregard all exceptions.
    *
-   * @throw OversizedPacketError encoded packet size exceeds MAX_NDN_PACKET_SIZE
+   * @throw OversizedPacketError encoded packet size exceeds MAX_NDN_PACKET_SIZE, or
+   *        MAX_FRAGMENTED_PACKET_SIZE over a DatagramTransport
    */
   void
   processEvents(time::milliseconds timeout = time::milliseconds::zero(),
@@ -500,6 +587,13 @@ private:
   void
   cancelPendingInterest(const PendingInterestId* pendingInterestId);
 
+  /**
+   * @brief Appends @p packet to the submission queue and schedules draining it if necessary.
+   */
+  template<typename Packet>
+  bool
+  submit(Packet&& packet);
+
   void
   clearInterestFilter(const InterestFilterId* interestFilterId);
 
@@ -24,19 +24,28 @@
 
 #include "ndn-cxx/face.hpp"
 #include "ndn-cxx/impl/lp-field-tag.hpp"
+#include "ndn-cxx/impl/mpsc-queue.hpp"
 #include "ndn-cxx/impl/pending-interest.hpp"
 #include "ndn-cxx/impl/registered-prefix.hpp"
+#include "ndn-cxx/lp/fragmenter.hpp"
 #include "ndn-cxx/lp/packet.hpp"
+#include "ndn-cxx/lp/reassembler.hpp"
 #include "ndn-cxx/lp/tags.hpp"
 #include "ndn-cxx/mgmt/nfd/command-options.hpp"
 #include "ndn-cxx/mgmt/nfd/controller.hpp"
+#include "ndn-cxx/transport/datagram-transport.hpp"
 #include "ndn-cxx/transport/tcp-transport.hpp"
+#include "ndn-cxx/transport/udp-transport.hpp"
+#include "ndn-cxx/transport/unix-seqpacket-transport.hpp"
 #include "ndn-cxx/transport/unix-transport.hpp"
 #include "ndn-cxx/util/config-file.hpp"
 #include "ndn-cxx/util/logger.hpp"
+#include "ndn-cxx/util/packet-trace.hpp"
 #include "ndn-cxx/util/scheduler.hpp"
 #include "ndn-cxx/util/signal.hpp"
 
+#include <mutex>
+
 NDN_LOG_INIT(ndn.Face);
 // INFO level: prefix registration, etc.
 //
@@ -91,15 +100,14 @@ public: // consumer
 
     const Interest& interest2 = *interest;
     auto& entry = m_pendingInterestTable.put(id, std::move(interest), afterSatisfied, afterNacked,
-                                             afterTimeout, ref(m_scheduler));
+                                             afterTimeout, ref(m_scheduler), ref(m_counters));
 
     lp::Packet lpPacket;
     addFieldFromTag<lp::NextHopFaceIdField, lp::NextHopFaceIdTag>(lpPacket, interest2);
     addFieldFromTag<lp::CongestionMarkField, lp::CongestionMarkTag>(lpPacket, interest2);
 
     entry.recordForwarding();
-    m_face.m_transport->send(finishEncoding(std::move(lpPacket), interest2.wireEncode(),
-                                            'I', interest2.getName()));
+    sendPacket(std::move(lpPacket), interest2.wireEncode(), 'I', interest2.getName());
     dispatchInterest(entry, interest2);
   }
 
@@ -195,7 +203,8 @@ public: // producer
   processIncomingInterest(shared_ptr<const Interest> interest)
   {
     const Interest& interest2 = *interest;
-    auto& entry = m_pendingInterestTable.insert(std::move(interest), ref(m_scheduler));
+    auto& entry = m_pendingInterestTable.insert(std::move(interest), ref(m_scheduler),
+                                                ref(m_counters));
     dispatchInterest(entry, interest2);
   }
 
@@ -227,8 +236,7 @@ public: // producer
     addFieldFromTag<lp::CachePolicyField, lp::CachePolicyTag>(lpPacket, data);
     addFieldFromTag<lp::CongestionMarkField, lp::CongestionMarkTag>(lpPacket, data);
 
-    m_face.m_transport->send(finishEncoding(std::move(lpPacket), data.wireEncode(),
-                                            'D', data.getName()));
+    sendPacket(std::move(lpPacket), data.wireEncode(), 'D', data.getName());
   }
 
   void
@@ -247,8 +255,7 @@ public: // producer
     addFieldFromTag<lp::CongestionMarkField, lp::CongestionMarkTag>(lpPacket, *outNack);
 
     const Interest& interest = outNack->getInterest();
-    m_face.m_transport->send(finishEncoding(std::move(lpPacket), interest.wireEncode(),
-                                            'N', interest.getName()));
+    sendPacket(std::move(lpPacket), interest.wireEncode(), 'N', interest.getName());
   }
 
 public: // prefix registration
@@ -261,34 +268,75 @@ public: // prefix registration
   {
     NDN_LOG_INFO("registering prefix: " << prefix);
     auto id = m_registeredPrefixTable.allocateId();
+    PendingRegistration registration{id, prefix, onSuccess, onFailure, flags, options,
+                                     filter, onInterest};
+
+    if (m_isPrefixRegistrationBatched) {
+      m_pendingRegistrations.push_back(std::move(registration));
+      if (m_pendingRegistrations.size() == 1) {
+        m_sendRegistrationsEvent = m_scheduler.schedule(0_ns, [this] {
+          this->sendPendingRegistrations();
+        });
+      }
+      return id;
+    }
 
     m_face.m_nfdController->start<nfd::RibRegisterCommand>(
       nfd::ControlParameters().setName(prefix).setFlags(flags),
-      [=] (const nfd::ControlParameters&) {
-        NDN_LOG_INFO("registered prefix: " << prefix);
-
-        RecordId filterId = 0;
-        if (filter) {
-          NDN_LOG_INFO("setting InterestFilter: " << *filter);
-          InterestFilterRecord& filterRecord = m_interestFilterTable.insert(*filter, onInterest);
-          filterId = filterRecord.getId();
-        }
-
-        m_registeredPrefixTable.put(id, prefix, options, filterId);
-
-        if (onSuccess != nullptr) {
-          onSuccess(prefix);
-        }
-      },
-      [=] (const nfd::ControlResponse& resp) {
-        NDN_LOG_INFO("register prefix failed: " << prefix);
-        onFailure(prefix, resp.getText());
-      },
+      [=] (const nfd::ControlParameters&) { afterPrefixRegistered(registration); },
+      [=] (const nfd::ControlResponse& resp) { afterPrefixRegisterFailed(registration, resp); },
       options);
 
     return id;
   }
 
+  /** @brief send pending registrations in batched commands, one per CommandOptions
+   */
+  void
+  sendPendingRegistrations()
+  {
+    auto registrations = std::make_shared<std::vector<PendingRegistration>>();
+    registrations->swap(m_pendingRegistrations);
+
+    auto begin = registrations->begin();
+    while (begin != registrations->end()) {
+      auto end = std::find_if(begin, registrations->end(), [&] (const PendingRegistration& r) {
+        return r.options.getSigningInfo() != begin->options.getSigningInfo() ||
+               r.options.getPrefix() != begin->options.getPrefix() ||
+               r.options.getTimeout() != begin->options.getTimeout();
+      });
+
+      std::vector<nfd::ControlParameters> parameters;
+      for (auto it = begin; it != end; ++it) {
+        parameters.push_back(nfd::ControlParameters().setName(it->prefix).setFlags(it->flags));
+      }
+      size_t offset = std::distance(registrations->begin(), begin);
+      try {
+        m_face.m_nfdController->startBatch<nfd::RibRegisterCommand>(parameters,
+          [=] (const std::vector<nfd::ControlResponse>& responses) {
+            for (size_t i = 0; i < responses.size(); ++i) {
+              const auto& registration = (*registrations)[offset + i];
+              if (responses[i].getCode() < nfd::Controller::ERROR_LBOUND) {
+                afterPrefixRegistered(registration);
+              }
+              else {
+                afterPrefixRegisterFailed(registration, responses[i]);
+              }
+            }
+          },
+          begin->options);
+      }
+      catch (const std::exception& e) {
+        // the command cannot be issued (e.g., invalid parameters or signing failure); this runs
+        // in a scheduler event, so report it to each registration instead of throwing
+        for (auto it = begin; it != end; ++it) {
+          afterPrefixRegisterFailed(*it, nfd::ControlResponse(400, e.what()));
+        }
+      }
+      begin = end;
+    }
+  }
+
   void
   asyncUnregisterPrefix(RecordId id,
                         const UnregisterPrefixSuccessCallback& onSuccess,
@@ -324,6 +372,57 @@ public: // prefix registration
       record->getCommandOptions());
   }
 
+public: // submission from other threads
+  struct InterestSubmission
+  {
+    RecordId id;
+    Interest interest;
+    DataCallback afterSatisfied;
+    NackCallback afterNacked;
+    TimeoutCallback afterTimeout;
+  };
+
+  using Submission = variant<monostate, InterestSubmission, Data, lp::Nack>;
+
+  /** @brief Appends a packet to the submission queue; may be called from any thread.
+   *  @retval true the packet has been queued, and the caller must schedule drainSubmissions()
+   *               if m_isDrainScheduled was false
+   */
+  bool
+  submit(Submission&& submission)
+  {
+    std::call_once(m_submissionQueueCreated, [this] {
+      m_submissionQueue = make_unique<MpscQueue<Submission>>(Face::SUBMISSION_QUEUE_CAPACITY);
+    });
+    return m_submissionQueue->tryPush(std::move(submission));
+  }
+
+  /** @brief Processes the packets in the submission queue.
+   */
+  void
+  drainSubmissions()
+  {
+    // a packet submitted from now on schedules another drain, if this one does not pick it up
+    m_isDrainScheduled = false;
+
+    Submission submission;
+    size_t nDrained = 0;
+    while (nDrained < m_submissionQueue->capacity() && m_submissionQueue->tryPop(submission)) {
+      ++nDrained;
+      if (auto interest = get_if<InterestSubmission>(&submission)) {
+        asyncExpressInterest(interest->id, make_shared<Interest>(std::move(interest->interest)),
+                             interest->afterSatisfied, interest->afterNacked, interest->afterTimeout);
+      }
+      else if (auto data = get_if<Data>(&submission)) {
+        asyncPutData(*data);
+      }
+      else if (auto nack = get_if<lp::Nack>(&submission)) {
+        asyncPutNack(*nack);
+      }
+    }
+    NDN_LOG_TRACE("drained " << nDrained << " submitted packets");
+  }
+
 public: // IO routine
   void
   ensureConnected(bool wantResume)
@@ -349,40 +448,147 @@ public: // IO routine
   }
 
 private:
-  /** @brief Finish packet encoding
+  /** @brief Finish packet encoding and send the packet
+   *
+   *  Over a DatagramTransport, a packet that does not fit in one datagram is sent as NDNLPv2
+   *  fragments of at most MAX_NDN_PACKET_SIZE octets each.
+   *
    *  @param lpPacket NDNLP packet without FragmentField
    *  @param wire wire encoding of Interest or Data
    *  @param pktType packet type, 'I' for Interest, 'D' for Data, 'N' for Nack
    *  @param name packet name
-   *  @return wire encoding of either NDNLP or bare network packet
    *  @throw Face::OversizedPacketError wire encoding exceeds limit
    */
-  Block
-  finishEncoding(lp::Packet&& lpPacket, Block wire, char pktType, const Name& name)
+  void
+  sendPacket(lp::Packet&& lpPacket, Block wire, char pktType, const Name& name)
   {
-    if (!lpPacket.empty()) {
+    size_t netPacketSize = wire.size();
+    if (!lpPacket.empty() || netPacketSize > MAX_NDN_PACKET_SIZE) {
       lpPacket.add<lp::FragmentField>(std::make_pair(wire.begin(), wire.end()));
       wire = lpPacket.wireEncode();
     }
 
-    if (wire.size() > MAX_NDN_PACKET_SIZE) {
+    if (wire.size() <= MAX_NDN_PACKET_SIZE) {
+      countOutgoing(pktType);
+      sendWire(wire);
+      return;
+    }
+
+    if (netPacketSize > Face::MAX_FRAGMENTED_PACKET_SIZE ||
+        dynamic_cast<DatagramTransport*>(m_face.m_transport.get()) == nullptr) {
       NDN_THROW(Face::OversizedPacketError(pktType, name, wire.size()));
     }
 
-    return wire;
+    auto fragments = m_fragmenter.fragment(lpPacket, MAX_NDN_PACKET_SIZE);
+    NDN_LOG_TRACE("sending " << pktType << ' ' << name << " in " << fragments.size() << " fragments");
+    countOutgoing(pktType);
+    for (const auto& fragment : fragments) {
+      sendWire(fragment);
+    }
+  }
+
+  void
+  countOutgoing(char pktType)
+  {
+    switch (pktType) {
+      case 'I':
+        ++m_counters.nOutInterests;
+        break;
+      case 'D':
+        ++m_counters.nOutData;
+        break;
+      case 'N':
+        ++m_counters.nOutNacks;
+        break;
+    }
+  }
+
+  void
+  sendWire(const Block& wire)
+  {
+    if (m_packetTrace != nullptr) {
+      m_packetTrace->write(util::PacketDirection::OUTGOING, wire);
+    }
+    m_counters.nOutBytes += wire.size();
+    m_face.m_transport->send(wire);
+  }
+
+private:
+  struct PendingRegistration
+  {
+    RecordId id;
+    Name prefix;
+    RegisterPrefixSuccessCallback onSuccess;
+    RegisterPrefixFailureCallback onFailure;
+    uint64_t flags;
+    nfd::CommandOptions options;
+    optional<InterestFilter> filter;
+    InterestCallback onInterest;
+  };
+
+  void
+  afterPrefixRegistered(const PendingRegistration& registration)
+  {
+    NDN_LOG_INFO("registered prefix: " << registration.prefix);
+
+    RecordId filterId = 0;
+    if (registration.filter) {
+      NDN_LOG_INFO("setting InterestFilter: " << *registration.filter);
+      InterestFilterRecord& filterRecord = m_interestFilterTable.insert(*registration.filter,
+                                                                        registration.onInterest);
+      filterId = filterRecord.getId();
+    }
+
+    m_registeredPrefixTable.put(registration.id, registration.prefix, registration.options,
+                                filterId);
+
+    if (registration.onSuccess != nullptr) {
+      registration.onSuccess(registration.prefix);
+    }
+  }
+
+  void
+  afterPrefixRegisterFailed(const PendingRegistration& registration,
+                            const nfd::ControlResponse& resp)
+  {
+    NDN_LOG_INFO("register prefix failed: " << registration.prefix);
+    registration.onFailure(registration.prefix, resp.getText());
+  }
+
+  static lp::Reassembler::Options
+  makeReassemblerOptions()
+  {
+    // accept the largest packet that Face itself would fragment, and nothing larger
+    lp::Reassembler::Options options;
+    options.maxPacketSize = Face::MAX_FRAGMENTED_PACKET_SIZE;
+    return options;
   }
 
 private:
   Face& m_face;
+  FaceCounters m_counters; // declared before tables, because PendingInterest records refer to it
   Scheduler m_scheduler;
   scheduler::ScopedEventId m_processEventsTimeoutEvent;
 
+  lp::Fragmenter m_fragmenter;
+  lp::Reassembler m_reassembler{m_scheduler, makeReassemblerOptions()};
+
   PendingInterestTable m_pendingInterestTable;
   InterestFilterTable m_interestFilterTable;
   RegisteredPrefixTable m_registeredPrefixTable;
 
   unique_ptr<boost::asio::io_service::work> m_ioServiceWork; // if thread needs to be preserved
 
+  std::once_flag m_submissionQueueCreated;
+  unique_ptr<MpscQueue<Submission>> m_submissionQueue;
+  std::atomic<bool> m_isDrainScheduled{false};
+
+  shared_ptr<util::PacketTraceWriter> m_packetTrace;
+
+  bool m_isPrefixRegistrationBatched = false;
+  std::vector<PendingRegistration> m_pendingRegistrations;
+  scheduler::ScopedEventId m_sendRegistrationsEvent;
+
   friend class Face;
 };
 
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_IMPL_MPSC_QUEUE_HPP
+#define NDN_IMPL_MPSC_QUEUE_HPP
+
+#include "ndn-cxx/detail/common.hpp"
+
+#include <atomic>
+
+namespace ndn {
+
+/** \brief Bounded lock-free queue with multiple producers and a single consumer.
+ *
+ *  Each slot carries a sequence number that tells producers whether it is free and the consumer
+ *  whether it has been filled, so that neither side takes a lock or allocates memory.
+ *  \tparam T element type, must be default-constructible and move-assignable
+ */
+template<typename T>
+class MpscQueue : noncopyable
+{
+public:
+  /** \brief Constructor.
+   *  \param capacity maximum number of elements, rounded up to a power of two
+   */
+  explicit
+  MpscQueue(size_t capacity)
+  {
+    size_t size = 2;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    m_slots = make_unique<Slot[]>(size);
+    m_mask = size - 1;
+    for (size_t i = 0; i < size; ++i) {
+      m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  size_t
+  capacity() const
+  {
+    return m_mask + 1;
+  }
+
+  /** \brief Appends an element; may be called from any thread.
+   *  \retval false the queue is full; \p value is left unchanged
+   */
+  bool
+  tryPush(T&& value)
+  {
+    size_t pos = m_pushPos.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    while (true) {
+      slot = &m_slots[pos & m_mask];
+      size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        // the slot is free: try to claim it
+        if (m_pushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      }
+      else if (diff < 0) {
+        // the slot still holds an element from the previous round
+        return false;
+      }
+      else {
+        // another producer claimed the slot
+        pos = m_pushPos.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->value = std::move(value);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** \brief Removes the oldest element; must be called from the consumer thread only.
+   *  \retval false the queue is empty
+   */
+  bool
+  tryPop(T& value)
+  {
+    Slot& slot = m_slots[m_popPos & m_mask];
+    size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != m_popPos + 1) {
+      // empty, or the producer that claimed the slot has not finished writing
+      return false;
+    }
+
+    value = std::move(slot.value);
+    slot.value = T(); // release resources held by the element
+    slot.sequence.store(m_popPos + m_mask + 1, std::memory_order_release);
+    ++m_popPos;
+    return true;
+  }
+
+private:
+  struct Slot
+  {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  unique_ptr<Slot[]> m_slots;
+  size_t m_mask;
+  std::atomic<size_t> m_pushPos{0};
+  // keep the consumer position away from the cache line written by producers
+  char m_padding[64];
+  size_t m_popPos = 0;
+};
+
+} // namespace ndn
+
+#endif // NDN_IMPL_MPSC_QUEUE_HPP
@@ -24,6 +24,7 @@
 
 #include "ndn-cxx/data.hpp"
 #include "ndn-cxx/face.hpp"
+#include "ndn-cxx/face-counters.hpp"
 #include "ndn-cxx/interest.hpp"
 #include "ndn-cxx/impl/record-container.hpp"
 #include "ndn-cxx/lp/nack.hpp"
@@ -70,29 +71,40 @@ public:
    *
    * The timeout is set based on the current time and InterestLifetime.
    * This class will invoke the timeout callback unless the record is deleted before timeout.
+   * The outcome and round-trip time of the Interest are recorded in @p counters.
    */
   PendingInterest(shared_ptr<const Interest> interest, const DataCallback& dataCallback,
                   const NackCallback& nackCallback, const TimeoutCallback& timeoutCallback,
-                  Scheduler& scheduler)
+                  Scheduler& scheduler, FaceCounters& counters)
     : m_interest(std::move(interest))
     , m_origin(PendingInterestOrigin::APP)
     , m_dataCallback(dataCallback)
     , m_nackCallback(nackCallback)
     , m_timeoutCallback(timeoutCallback)
     , m_nNotNacked(0)
+    , m_counters(counters)
+    , m_sendTime(time::steady_clock::now())
   {
     scheduleTimeoutEvent(scheduler);
+    ++m_counters.nPendingInterests;
   }
 
   /**
    * @brief Construct a pending Interest record for an Interest from NFD
    */
-  PendingInterest(shared_ptr<const Interest> interest, Scheduler& scheduler)
+  PendingInterest(shared_ptr<const Interest> interest, Scheduler& scheduler, FaceCounters& counters)
     : m_interest(std::move(interest))
     , m_origin(PendingInterestOrigin::FORWARDER)
     , m_nNotNacked(0)
+    , m_counters(counters)
   {
     scheduleTimeoutEvent(scheduler);
+    ++m_counters.nPendingInterests;
+  }
+
+  ~PendingInterest()
+  {
+    --m_counters.nPendingInterests;
   }
 
   shared_ptr<const Interest>
@@ -143,6 +155,9 @@ public:
   void
   invokeDataCallback(const Data& data)
   {
+    ++m_counters.nSatisfiedInterests;
+    m_counters.rtt.record(time::steady_clock::now() - m_sendTime);
+
     if (m_dataCallback != nullptr) {
       m_dataCallback(*m_interest, data);
     }
@@ -155,6 +170,8 @@ public:
   void
   invokeNackCallback(const lp::Nack& nack)
   {
+    ++m_counters.nNackedInterests;
+
     if (m_nackCallback != nullptr) {
       m_nackCallback(*m_interest, nack);
     }
@@ -174,6 +191,10 @@ private:
   void
   invokeTimeoutCallback()
   {
+    if (m_origin == PendingInterestOrigin::APP) {
+      ++m_counters.nTimedOutInterests;
+    }
+
     if (m_timeoutCallback) {
       m_timeoutCallback(*m_interest);
     }
@@ -190,6 +211,8 @@ private:
   scheduler::ScopedEventId m_timeoutEvent;
   int m_nNotNacked; ///< number of Interest destinations that have not Nacked
   optional<lp::Nack> m_leastSevereNack;
+  FaceCounters& m_counters;
+  time::steady_clock::TimePoint m_sendTime; ///< when an Interest from the app was sent
   std::function<void()> m_deleter;
 };
 
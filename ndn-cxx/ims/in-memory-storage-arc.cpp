@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/ims/in-memory-storage-arc.hpp"
+
+namespace ndn {
+
+InMemoryStorageArc::InMemoryStorageArc(size_t limit)
+  : InMemoryStorage(limit)
+  , m_recencyTarget(0)
+{
+}
+
+InMemoryStorageArc::InMemoryStorageArc(boost::asio::io_service& ioService,
+                                       size_t limit)
+  : InMemoryStorage(ioService, limit)
+  , m_recencyTarget(0)
+{
+}
+
+void
+InMemoryStorageArc::afterInsert(InMemoryStorageEntry* entry)
+{
+  BOOST_ASSERT(m_positions.size() <= size());
+  const Name& name = entry->getName();
+
+  // a hit in a ghost list shows that the corresponding resident list deserved more room
+  size_t b1Size = m_b1.size();
+  size_t b2Size = m_b2.size();
+  if (m_b1.erase(name)) {
+    size_t delta = std::max<size_t>(b2Size / b1Size, 1);
+    m_recencyTarget = std::min(m_recencyTarget + delta, getLimit());
+    pushResident(m_t2, entry);
+  }
+  else if (m_b2.erase(name)) {
+    size_t delta = std::max<size_t>(b1Size / b2Size, 1);
+    m_recencyTarget -= std::min(m_recencyTarget, delta);
+    pushResident(m_t2, entry);
+  }
+  else {
+    pushResident(m_t1, entry);
+  }
+
+  trimGhosts();
+}
+
+bool
+InMemoryStorageArc::evictItem()
+{
+  EntryList* list = nullptr;
+  GhostList* ghosts = nullptr;
+  if (!m_t1.empty() && (m_t1.size() > m_recencyTarget || m_t2.empty())) {
+    list = &m_t1;
+    ghosts = &m_b1;
+  }
+  else if (!m_t2.empty()) {
+    list = &m_t2;
+    ghosts = &m_b2;
+  }
+  else {
+    return false;
+  }
+
+  InMemoryStorageEntry* victim = list->front();
+  Name name = victim->getName();
+  Name fullName = victim->getFullName();
+  list->pop_front();
+  m_positions.erase(victim);
+
+  eraseImpl(fullName);
+  ghosts->push(name);
+  trimGhosts();
+  return true;
+}
+
+void
+InMemoryStorageArc::beforeErase(InMemoryStorageEntry* entry)
+{
+  auto it = m_positions.find(entry);
+  if (it != m_positions.end()) {
+    it->second.list->erase(it->second.it);
+    m_positions.erase(it);
+  }
+}
+
+void
+InMemoryStorageArc::afterAccess(InMemoryStorageEntry* entry)
+{
+  beforeErase(entry);
+  pushResident(m_t2, entry);
+}
+
+void
+InMemoryStorageArc::pushResident(EntryList& list, InMemoryStorageEntry* entry)
+{
+  m_positions[entry] = {&list, list.insert(list.end(), entry)};
+}
+
+void
+InMemoryStorageArc::trimGhosts()
+{
+  // resident entries never exceed the limit, so bounding the ghosts by the limit keeps
+  // the total directory size within twice the limit
+  while (m_b1.size() > 0 && m_t1.size() + m_b1.size() > getLimit()) {
+    m_b1.pop();
+  }
+  while (m_b1.size() + m_b2.size() > getLimit()) {
+    if (m_b2.size() > 0) {
+      m_b2.pop();
+    }
+    else {
+      m_b1.pop();
+    }
+  }
+}
+
+bool
+InMemoryStorageArc::GhostList::erase(const Name& name)
+{
+  auto it = m_index.find(name);
+  if (it == m_index.end()) {
+    return false;
+  }
+  m_names.erase(it->second);
+  m_index.erase(it);
+  return true;
+}
+
+void
+InMemoryStorageArc::GhostList::push(const Name& name)
+{
+  erase(name);
+  m_index[name] = m_names.insert(m_names.end(), name);
+}
+
+void
+InMemoryStorageArc::GhostList::pop()
+{
+  BOOST_ASSERT(!m_names.empty());
+  m_index.erase(m_names.front());
+  m_names.pop_front();
+}
+
+} // namespace ndn
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_IMS_IN_MEMORY_STORAGE_ARC_HPP
+#define NDN_IMS_IN_MEMORY_STORAGE_ARC_HPP
+
+#include "ndn-cxx/ims/in-memory-storage.hpp"
+
+#include <list>
+#include <unordered_map>
+
+namespace ndn {
+
+/** @brief Provides in-memory storage employing Adaptive Replacement Cache (ARC) policy.
+ *
+ *  Resident entries are kept in two LRU lists: T1 holds entries seen once since they were
+ *  inserted, T2 holds entries that have been accessed again. Names of recently evicted entries
+ *  are remembered in the ghost lists B1 and B2. A later insertion of a name found in a ghost
+ *  list adapts the target size of T1, shifting capacity between recency and frequency.
+ *
+ *  @sa N. Megiddo and D. S. Modha, "ARC: A Self-Tuning, Low Overhead Replacement Cache",
+ *      USENIX FAST 2003
+ */
+class InMemoryStorageArc : public InMemoryStorage
+{
+public:
+  explicit
+  InMemoryStorageArc(size_t limit = 16);
+
+  explicit
+  InMemoryStorageArc(boost::asio::io_service& ioService, size_t limit = 16);
+
+  /** @brief Returns the current target size of the recency list T1.
+   */
+  size_t
+  getRecencyTarget() const
+  {
+    return m_recencyTarget;
+  }
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PROTECTED:
+  /** @brief Removes one Data packet from in-memory storage based on ARC, i.e. evict the least
+   *  recently used entry of T1 if T1 exceeds its target size, otherwise of T2
+   *  @return{ whether the Data was removed }
+   */
+  bool
+  evictItem() override;
+
+  /** @brief Update the entry when the entry is returned by the find() function,
+   *  move it to the most recently used end of T2
+   */
+  void
+  afterAccess(InMemoryStorageEntry* entry) override;
+
+  /** @brief Update the entry after a entry is successfully inserted, add it to T1, or to T2
+   *  if its name is found in a ghost list
+   */
+  void
+  afterInsert(InMemoryStorageEntry* entry) override;
+
+  /** @brief Update the entry or other data structures before a entry is successfully erased,
+   *  remove it from T1 or T2
+   */
+  void
+  beforeErase(InMemoryStorageEntry* entry) override;
+
+private:
+  using EntryList = std::list<InMemoryStorageEntry*>;
+
+  struct EntryPosition
+  {
+    EntryList* list;
+    EntryList::iterator it;
+  };
+
+  class GhostList
+  {
+  public:
+    size_t
+    size() const
+    {
+      return m_names.size();
+    }
+
+    bool
+    erase(const Name& name);
+
+    void
+    push(const Name& name);
+
+    void
+    pop();
+
+  private:
+    std::list<Name> m_names;
+    std::unordered_map<Name, std::list<Name>::iterator> m_index;
+  };
+
+  void
+  pushResident(EntryList& list, InMemoryStorageEntry* entry);
+
+  void
+  trimGhosts();
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  EntryList m_t1;
+  EntryList m_t2;
+  GhostList m_b1;
+  GhostList m_b2;
+
+private:
+  std::unordered_map<InMemoryStorageEntry*, EntryPosition> m_positions;
+  size_t m_recencyTarget;
+};
+
+} // namespace ndn
+
+#endif // NDN_IMS_IN_MEMORY_STORAGE_ARC_HPP
@@ -0,0 +1,227 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/ims/in-memory-storage-tinylfu.hpp"
+
+namespace ndn {
+
+// the sketch keeps this many counters per row for each entry of the storage
+const size_t SKETCH_COUNTERS_PER_ENTRY = 4;
+const size_t MAX_SKETCH_WIDTH = 1 << 20;
+
+constexpr size_t InMemoryStorageTinyLfu::FrequencySketch::N_ROWS;
+constexpr uint8_t InMemoryStorageTinyLfu::FrequencySketch::MAX_COUNT;
+
+InMemoryStorageTinyLfu::InMemoryStorageTinyLfu(size_t limit)
+  : InMemoryStorage(limit)
+  , m_sketch(limit)
+{
+}
+
+InMemoryStorageTinyLfu::InMemoryStorageTinyLfu(boost::asio::io_service& ioService,
+                                               size_t limit)
+  : InMemoryStorage(ioService, limit)
+  , m_sketch(limit)
+{
+}
+
+size_t
+InMemoryStorageTinyLfu::getWindowCapacity() const
+{
+  return std::max<size_t>(getLimit() / 100, 1);
+}
+
+size_t
+InMemoryStorageTinyLfu::getMainCapacity() const
+{
+  return getLimit() - std::min(getLimit(), getWindowCapacity());
+}
+
+size_t
+InMemoryStorageTinyLfu::getProtectedCapacity() const
+{
+  return getMainCapacity() - getMainCapacity() / 5;
+}
+
+void
+InMemoryStorageTinyLfu::afterInsert(InMemoryStorageEntry* entry)
+{
+  BOOST_ASSERT(m_positions.size() <= size());
+  m_sketch.increment(entry->getName());
+  pushEntry(m_window, entry);
+
+  // while the storage is filling up, the window spills over into the main segments
+  while (m_window.size() > getWindowCapacity() &&
+         m_probation.size() + m_protected.size() < getMainCapacity()) {
+    moveEntry(m_probation, m_window.front());
+  }
+}
+
+bool
+InMemoryStorageTinyLfu::evictItem()
+{
+  bool isMainEmpty = m_probation.empty() && m_protected.empty();
+  EntryList& mainVictims = m_probation.empty() ? m_protected : m_probation;
+
+  // an insertion is about to overflow the window: its candidate competes for admission
+  if (!m_window.empty() && (m_window.size() >= getWindowCapacity() || isMainEmpty)) {
+    InMemoryStorageEntry* candidate = m_window.front();
+    if (isMainEmpty || m_sketch.estimate(candidate->getName()) <=
+                       m_sketch.estimate(mainVictims.front()->getName())) {
+      evictFront(m_window);
+    }
+    else {
+      evictFront(mainVictims);
+      moveEntry(m_probation, candidate);
+    }
+    return true;
+  }
+
+  if (!isMainEmpty) {
+    evictFront(mainVictims);
+    return true;
+  }
+
+  return false;
+}
+
+void
+InMemoryStorageTinyLfu::beforeErase(InMemoryStorageEntry* entry)
+{
+  auto it = m_positions.find(entry);
+  if (it != m_positions.end()) {
+    it->second.list->erase(it->second.it);
+    m_positions.erase(it);
+  }
+}
+
+void
+InMemoryStorageTinyLfu::afterAccess(InMemoryStorageEntry* entry)
+{
+  m_sketch.increment(entry->getName());
+
+  auto it = m_positions.find(entry);
+  if (it == m_positions.end()) {
+    return;
+  }
+
+  if (it->second.list == &m_window) {
+    moveEntry(m_window, entry);
+    return;
+  }
+
+  moveEntry(m_protected, entry);
+  while (m_protected.size() > getProtectedCapacity()) {
+    moveEntry(m_probation, m_protected.front());
+  }
+}
+
+void
+InMemoryStorageTinyLfu::pushEntry(EntryList& list, InMemoryStorageEntry* entry)
+{
+  m_positions[entry] = {&list, list.insert(list.end(), entry)};
+}
+
+void
+InMemoryStorageTinyLfu::moveEntry(EntryList& list, InMemoryStorageEntry* entry)
+{
+  EntryPosition& pos = m_positions.at(entry);
+  list.splice(list.end(), *pos.list, pos.it);
+  pos.list = &list;
+}
+
+void
+InMemoryStorageTinyLfu::evictFront(EntryList& list)
+{
+  BOOST_ASSERT(!list.empty());
+  InMemoryStorageEntry* victim = list.front();
+  Name fullName = victim->getFullName();
+  list.pop_front();
+  m_positions.erase(victim);
+  eraseImpl(fullName);
+}
+
+InMemoryStorageTinyLfu::FrequencySketch::FrequencySketch(size_t nCounters)
+  : m_nAdditions(0)
+{
+  size_t width = 1;
+  while (width < MAX_SKETCH_WIDTH && width < nCounters * SKETCH_COUNTERS_PER_ENTRY) {
+    width <<= 1;
+  }
+  for (auto& row : m_counters) {
+    row.resize(width);
+  }
+  m_mask = width - 1;
+  m_sampleSize = 10 * width;
+}
+
+void
+InMemoryStorageTinyLfu::FrequencySketch::increment(const Name& name)
+{
+  uint64_t hash = std::hash<Name>()(name);
+  bool isAdded = false;
+  for (size_t row = 0; row < N_ROWS; ++row) {
+    uint8_t& counter = m_counters[row][getIndex(hash, row)];
+    if (counter < MAX_COUNT) {
+      ++counter;
+      isAdded = true;
+    }
+  }
+
+  if (isAdded && ++m_nAdditions >= m_sampleSize) {
+    age();
+  }
+}
+
+uint8_t
+InMemoryStorageTinyLfu::FrequencySketch::estimate(const Name& name) const
+{
+  uint64_t hash = std::hash<Name>()(name);
+  uint8_t count = MAX_COUNT;
+  for (size_t row = 0; row < N_ROWS; ++row) {
+    count = std::min(count, m_counters[row][getIndex(hash, row)]);
+  }
+  return count;
+}
+
+size_t
+InMemoryStorageTinyLfu::FrequencySketch::getIndex(uint64_t hash, size_t row) const
+{
+  static const uint64_t SEEDS[N_ROWS] = {
+    0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL,
+  };
+
+  uint64_t h = (hash + row) * SEEDS[row];
+  return static_cast<size_t>(h ^ (h >> 32)) & m_mask;
+}
+
+void
+InMemoryStorageTinyLfu::FrequencySketch::age()
+{
+  for (auto& row : m_counters) {
+    for (auto& counter : row) {
+      counter >>= 1;
+    }
+  }
+  m_nAdditions /= 2;
+}
+
+} // namespace ndn
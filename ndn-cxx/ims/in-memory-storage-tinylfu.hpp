@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_IMS_IN_MEMORY_STORAGE_TINYLFU_HPP
+#define NDN_IMS_IN_MEMORY_STORAGE_TINYLFU_HPP
+
+#include "ndn-cxx/ims/in-memory-storage.hpp"
+
+#include <list>
+#include <unordered_map>
+
+namespace ndn {
+
+/** @brief Provides in-memory storage employing Window TinyLFU (W-TinyLFU) replacement policy.
+ *
+ *  New entries enter a small LRU admission window holding about 1% of the limit. The rest of
+ *  the storage is a segmented LRU made of a probation and a protected segment; entries are
+ *  promoted to the protected segment when accessed while on probation. When the window
+ *  overflows, its least recently used entry competes with the probation victim, and the one
+ *  with the lower estimated access frequency is evicted. Frequencies are estimated by a
+ *  count-min sketch with 4-bit counters that are halved periodically, so that the history
+ *  gradually ages out.
+ *
+ *  @sa G. Einziger, R. Friedman, and B. Manes, "TinyLFU: A Highly Efficient Cache Admission
+ *      Policy", ACM Transactions on Storage, 2017
+ */
+class InMemoryStorageTinyLfu : public InMemoryStorage
+{
+public:
+  explicit
+  InMemoryStorageTinyLfu(size_t limit = 16);
+
+  explicit
+  InMemoryStorageTinyLfu(boost::asio::io_service& ioService, size_t limit = 16);
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PROTECTED:
+  /** @brief Removes one Data packet from in-memory storage based on W-TinyLFU, i.e. evict
+   *  either the window candidate or the probation victim, whichever is less frequently used
+   *  @return{ whether the Data was removed }
+   */
+  bool
+  evictItem() override;
+
+  /** @brief Update the entry when the entry is returned by the find() function,
+   *  record the access in the frequency sketch and promote the entry
+   */
+  void
+  afterAccess(InMemoryStorageEntry* entry) override;
+
+  /** @brief Update the entry after a entry is successfully inserted, record it in the
+   *  frequency sketch and add it to the admission window
+   */
+  void
+  afterInsert(InMemoryStorageEntry* entry) override;
+
+  /** @brief Update the entry or other data structures before a entry is successfully erased,
+   *  remove it from its segment
+   */
+  void
+  beforeErase(InMemoryStorageEntry* entry) override;
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** @brief Count-min sketch estimating how often a name has been seen recently.
+   */
+  class FrequencySketch
+  {
+  public:
+    explicit
+    FrequencySketch(size_t nCounters);
+
+    void
+    increment(const Name& name);
+
+    uint8_t
+    estimate(const Name& name) const;
+
+  private:
+    size_t
+    getIndex(uint64_t hash, size_t row) const;
+
+    void
+    age();
+
+  public:
+    static constexpr size_t N_ROWS = 4;
+    static constexpr uint8_t MAX_COUNT = 15;
+
+  private:
+    std::vector<uint8_t> m_counters[N_ROWS];
+    size_t m_mask;
+    size_t m_nAdditions;
+    size_t m_sampleSize;
+  };
+
+  size_t
+  getWindowCapacity() const;
+
+  size_t
+  getMainCapacity() const;
+
+  size_t
+  getProtectedCapacity() const;
+
+private:
+  using EntryList = std::list<InMemoryStorageEntry*>;
+
+  struct EntryPosition
+  {
+    EntryList* list;
+    EntryList::iterator it;
+  };
+
+  void
+  pushEntry(EntryList& list, InMemoryStorageEntry* entry);
+
+  void
+  moveEntry(EntryList& list, InMemoryStorageEntry* entry);
+
+  void
+  evictFront(EntryList& list);
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  FrequencySketch m_sketch;
+  EntryList m_window;
+  EntryList m_probation;
+  EntryList m_protected;
+
+private:
+  std::unordered_map<InMemoryStorageEntry*, EntryPosition> m_positions;
+};
+
+} // namespace ndn
+
+#endif // NDN_IMS_IN_MEMORY_STORAGE_TINYLFU_HPP
@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/lp/fragmenter.hpp"
+#include "ndn-cxx/lp/fields.hpp"
+#include "ndn-cxx/util/random.hpp"
+
+namespace ndn {
+namespace lp {
+
+/** \brief upper bound of the size of a TLV type and length, for types below 253
+ */
+const size_t MAX_TL_SIZE = 1 + 9;
+
+/** \brief upper bound of the size of Sequence, FragIndex, and FragCount fields
+ */
+const size_t FRAG_FIELDS_SIZE = 3 * (1 + 1 + 8);
+
+Fragmenter::Fragmenter()
+  : Fragmenter(random::generateWord64())
+{
+}
+
+Fragmenter::Fragmenter(Sequence initialSequence)
+  : m_nextSequence(initialSequence)
+{
+}
+
+std::vector<Block>
+Fragmenter::fragment(const Packet& packet, size_t mtu)
+{
+  if (!packet.has<FragmentField>()) {
+    NDN_THROW(Error("LpPacket has no fragment"));
+  }
+
+  Block wire = packet.wireEncode();
+  if (wire.size() <= mtu) {
+    return {wire};
+  }
+
+  Buffer::const_iterator begin, end;
+  std::tie(begin, end) = packet.get<FragmentField>();
+  size_t payloadSize = static_cast<size_t>(std::distance(begin, end));
+
+  // size of the header fields copied to the first fragment
+  size_t headerSize = wire.value_size() - payloadSize;
+
+  size_t overhead = MAX_TL_SIZE + FRAG_FIELDS_SIZE + MAX_TL_SIZE;
+  if (mtu <= overhead + headerSize) {
+    NDN_THROW(Error("MTU " + to_string(mtu) + " is too small to fragment this LpPacket"));
+  }
+  size_t firstPayloadSize = std::min(payloadSize, mtu - overhead - headerSize);
+  size_t otherPayloadSize = mtu - overhead;
+  size_t fragCount = 1 + (payloadSize - firstPayloadSize + otherPayloadSize - 1) / otherPayloadSize;
+
+  std::vector<Block> fragments;
+  fragments.reserve(fragCount);
+  auto fragBegin = begin;
+  for (size_t fragIndex = 0; fragIndex < fragCount; ++fragIndex) {
+    size_t size = std::min(fragIndex == 0 ? firstPayloadSize : otherPayloadSize,
+                           static_cast<size_t>(std::distance(fragBegin, end)));
+    auto fragEnd = fragBegin + size;
+
+    Packet frag;
+    if (fragIndex == 0) {
+      frag = packet;
+      frag.clear<FragmentField>();
+    }
+    frag.add<SequenceField>(m_nextSequence++);
+    frag.add<FragIndexField>(fragIndex);
+    frag.add<FragCountField>(fragCount);
+    frag.add<FragmentField>(std::make_pair(fragBegin, fragEnd));
+    fragments.push_back(frag.wireEncode());
+    BOOST_ASSERT(fragments.back().size() <= mtu);
+
+    fragBegin = fragEnd;
+  }
+  BOOST_ASSERT(fragBegin == end);
+
+  return fragments;
+}
+
+} // namespace lp
+} // namespace ndn
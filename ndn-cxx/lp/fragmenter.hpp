@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_CXX_LP_FRAGMENTER_HPP
+#define NDN_CXX_LP_FRAGMENTER_HPP
+
+#include "ndn-cxx/lp/packet.hpp"
+#include "ndn-cxx/lp/sequence.hpp"
+
+#include <vector>
+
+namespace ndn {
+namespace lp {
+
+/** \brief splits an LpPacket into NDNLPv2 fragments
+ *
+ *  Each fragment carries a consecutive Sequence number, its FragIndex, and the FragCount.
+ *  The first fragment also carries every other header field of the original packet.
+ *
+ *  \sa Reassembler
+ */
+class Fragmenter
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /** \brief Construct a fragmenter whose first Sequence number is random
+   */
+  Fragmenter();
+
+  explicit
+  Fragmenter(Sequence initialSequence);
+
+  /** \brief Split \p packet into fragments no larger than \p mtu
+   *  \param packet an LpPacket with a FragmentField and without fragmentation fields
+   *  \param mtu maximum size of the wire encoding of each fragment
+   *  \return wire encodings of the fragments; the encoding of \p packet itself if it fits in \p mtu
+   *  \throw Error \p packet has no FragmentField, or \p mtu is too small for the header fields
+   */
+  std::vector<Block>
+  fragment(const Packet& packet, size_t mtu);
+
+private:
+  Sequence m_nextSequence;
+};
+
+} // namespace lp
+} // namespace ndn
+
+#endif // NDN_CXX_LP_FRAGMENTER_HPP
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/lp/reassembler.hpp"
+#include "ndn-cxx/lp/fields.hpp"
+#include "ndn-cxx/util/logger.hpp"
+
+NDN_LOG_INIT(ndn.lp.Reassembler);
+
+namespace ndn {
+namespace lp {
+
+Reassembler::Reassembler(Scheduler& scheduler, const Options& options)
+  : m_scheduler(scheduler)
+  , m_options(options)
+{
+}
+
+optional<std::pair<Block, Packet>>
+Reassembler::receiveFragment(const Packet& packet)
+{
+  if (!packet.has<FragmentField>()) {
+    NDN_THROW(Error("LpPacket has no fragment"));
+  }
+
+  size_t fragCount = packet.has<FragCountField>() ? packet.get<FragCountField>() : 1;
+  size_t fragIndex = packet.has<FragIndexField>() ? packet.get<FragIndexField>() : 0;
+  if (fragIndex >= fragCount) {
+    NDN_THROW(Error("FragIndex " + to_string(fragIndex) + " is not less than FragCount " +
+                    to_string(fragCount)));
+  }
+
+  if (fragCount == 1) {
+    return std::make_pair(assemble({packet}), packet);
+  }
+
+  if (fragCount > m_options.maxFragCount) {
+    NDN_THROW(Error("FragCount " + to_string(fragCount) + " exceeds the limit"));
+  }
+  if (!packet.has<SequenceField>()) {
+    NDN_THROW(Error("Fragment has no Sequence"));
+  }
+  Sequence key = packet.get<SequenceField>() - fragIndex;
+
+  auto it = m_partialPackets.find(key);
+  if (it == m_partialPackets.end()) {
+    if (m_partialPackets.size() >= m_options.maxPartialPackets) {
+      NDN_LOG_DEBUG("dropped fragment seq=" << key << '+' << fragIndex << ": too many partial packets");
+      return nullopt;
+    }
+
+    it = m_partialPackets.emplace(key, PartialPacket()).first;
+    it->second.fragments.resize(fragCount);
+    it->second.nRemaining = fragCount;
+    it->second.dropTimer = m_scheduler.schedule(m_options.reassemblyTimeout, [this, key] {
+      NDN_LOG_DEBUG("dropped partial packet seq=" << key << ": reassembly timeout");
+      m_partialPackets.erase(key);
+    });
+  }
+
+  PartialPacket& partial = it->second;
+  if (partial.fragments.size() != fragCount) {
+    NDN_LOG_DEBUG("dropped fragment seq=" << key << '+' << fragIndex << ": FragCount mismatch");
+    return nullopt;
+  }
+  if (!partial.fragments[fragIndex].empty()) {
+    NDN_LOG_TRACE("dropped duplicate fragment seq=" << key << '+' << fragIndex);
+    return nullopt;
+  }
+
+  auto range = packet.get<FragmentField>();
+  partial.size += static_cast<size_t>(std::distance(range.first, range.second));
+  if (partial.size > m_options.maxPacketSize) {
+    NDN_LOG_DEBUG("dropped partial packet seq=" << key << ": exceeds maximum packet size");
+    m_partialPackets.erase(it);
+    return nullopt;
+  }
+
+  partial.fragments[fragIndex] = packet;
+  if (--partial.nRemaining > 0) {
+    return nullopt;
+  }
+
+  std::vector<Packet> fragments = std::move(partial.fragments);
+  m_partialPackets.erase(it);
+  return std::make_pair(assemble(fragments), std::move(fragments.front()));
+}
+
+Block
+Reassembler::assemble(const std::vector<Packet>& fragments)
+{
+  size_t size = 0;
+  for (const auto& fragment : fragments) {
+    auto range = fragment.get<FragmentField>();
+    size += static_cast<size_t>(std::distance(range.first, range.second));
+  }
+
+  auto buffer = make_shared<Buffer>();
+  buffer->reserve(size);
+  for (const auto& fragment : fragments) {
+    auto range = fragment.get<FragmentField>();
+    buffer->insert(buffer->end(), range.first, range.second);
+  }
+
+  bool isOk = false;
+  Block netPacket;
+  std::tie(isOk, netPacket) = Block::fromBuffer(buffer, 0);
+  if (!isOk || netPacket.size() != buffer->size()) {
+    NDN_THROW(Error("Reassembled packet is not a TLV element"));
+  }
+  return netPacket;
+}
+
+} // namespace lp
+} // namespace ndn
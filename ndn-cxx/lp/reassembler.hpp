@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_CXX_LP_REASSEMBLER_HPP
+#define NDN_CXX_LP_REASSEMBLER_HPP
+
+#include "ndn-cxx/lp/packet.hpp"
+#include "ndn-cxx/lp/sequence.hpp"
+#include "ndn-cxx/util/scheduler.hpp"
+
+#include <map>
+#include <vector>
+
+namespace ndn {
+namespace lp {
+
+/** \brief reassembles NDNLPv2 fragments into network layer packets
+ *
+ *  Fragments of the same packet are identified by their Sequence minus their FragIndex.
+ *  A partially received packet is dropped if it is not completed within the reassembly timeout,
+ *  or once its received fragments add up to more than the maximum packet size.
+ *
+ *  \sa Fragmenter
+ */
+class Reassembler : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  class Options
+  {
+  public:
+    Options()
+    {
+    }
+
+  public:
+    /** \brief maximum number of partially received packets
+     *
+     *  Fragments that would start another partial packet are dropped.
+     */
+    size_t maxPartialPackets = 100;
+
+    /** \brief maximum FragCount
+     */
+    size_t maxFragCount = 400;
+
+    /** \brief maximum total size of the fragments of a packet, in octets
+     */
+    size_t maxPacketSize = 8 * MAX_NDN_PACKET_SIZE;
+
+    /** \brief how long a partially received packet is kept
+     */
+    time::nanoseconds reassemblyTimeout = 500_ms;
+  };
+
+  explicit
+  Reassembler(Scheduler& scheduler, const Options& options = Options());
+
+  /** \brief Process a received LpPacket
+   *  \param packet an LpPacket with a FragmentField; it need not be fragmented
+   *  \return the network layer packet and the LpPacket of its first fragment, once all fragments
+   *          have been received; nullopt if more fragments are needed or the fragment was dropped
+   *  \throw Error the fragmentation fields are invalid, or the reassembled packet is not a TLV element
+   */
+  optional<std::pair<Block, Packet>>
+  receiveFragment(const Packet& packet);
+
+  /** \return number of partially received packets
+   */
+  size_t
+  size() const
+  {
+    return m_partialPackets.size();
+  }
+
+private:
+  struct PartialPacket
+  {
+    std::vector<Packet> fragments; ///< indexed by FragIndex, empty Packet if not yet received
+    size_t nRemaining;
+    size_t size = 0; ///< total size of the received fragments
+    scheduler::ScopedEventId dropTimer;
+  };
+
+  Block
+  assemble(const std::vector<Packet>& fragments);
+
+private:
+  Scheduler& m_scheduler;
+  Options m_options;
+  std::map<Sequence, PartialPacket> m_partialPackets; ///< key is the Sequence of the first fragment
+};
+
+} // namespace lp
+} // namespace ndn
+
+#endif // NDN_CXX_LP_REASSEMBLER_HPP
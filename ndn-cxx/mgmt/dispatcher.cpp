@@ -20,9 +20,12 @@
  */
 
 #include "ndn-cxx/mgmt/dispatcher.hpp"
+#include "ndn-cxx/encoding/tlv-nfd.hpp"
 #include "ndn-cxx/lp/tags.hpp"
 #include "ndn-cxx/util/logger.hpp"
 
+#include <boost/asio/io_service.hpp>
+
 NDN_LOG_INIT(ndn.mgmt.Dispatcher);
 
 namespace ndn {
@@ -30,6 +33,19 @@ namespace mgmt {
 
 const time::milliseconds DEFAULT_FRESHNESS_PERIOD = 1_s;
 
+// number of status dataset segments signed in one event
+const size_t SIGNING_BATCH_SIZE = 8;
+
+// maximum number of request Names whose dataset snapshot is kept
+const size_t MAX_DATASET_SNAPSHOTS = 64;
+
+const name::Component&
+getStatusDatasetDeltaKeyword()
+{
+  static const name::Component keyword = name::Component::fromEscapedString("32=delta");
+  return keyword;
+}
+
 Authorization
 makeAcceptAllAuthorization()
 {
@@ -120,7 +136,16 @@ Dispatcher::queryStorage(const Name& prefix, const Interest& interest,
                          const InterestHandler& missContinuation)
 {
   auto data = m_storage.find(interest);
+  // a StatusDataset delta is only returned when explicitly requested
+  if (data != nullptr && data->getName().size() > interest.getName().size() &&
+      std::find(data->getName().begin() + interest.getName().size(), data->getName().end(),
+                getStatusDatasetDeltaKeyword()) != data->getName().end()) {
+    data = nullptr;
+  }
   if (data == nullptr) {
+    if (awaitDatasetSegment(interest)) {
+      return;
+    }
     // invoke missContinuation to process this Interest if the query fails.
     if (missContinuation)
       missContinuation(prefix, interest);
@@ -134,21 +159,32 @@ Dispatcher::queryStorage(const Name& prefix, const Interest& interest,
 void
 Dispatcher::sendData(const Name& dataName, const Block& content, const MetaInfo& metaInfo,
                      SendDestination option, time::milliseconds imsFresh)
+{
+  auto data = makeData(dataName, content, metaInfo);
+  m_keyChain.sign(*data, m_signingInfo);
+  deliverData(*data, option, imsFresh);
+}
+
+shared_ptr<Data>
+Dispatcher::makeData(const Name& dataName, const Block& content, const MetaInfo& metaInfo)
 {
   auto data = make_shared<Data>(dataName);
   data->setContent(content).setMetaInfo(metaInfo).setFreshnessPeriod(DEFAULT_FRESHNESS_PERIOD);
+  return data;
+}
 
-  m_keyChain.sign(*data, m_signingInfo);
-
+void
+Dispatcher::deliverData(Data& data, SendDestination option, time::milliseconds imsFresh)
+{
   if (option == SendDestination::IMS || option == SendDestination::FACE_AND_IMS) {
     lp::CachePolicy policy;
     policy.setPolicy(lp::CachePolicyType::NO_CACHE);
-    data->setTag(make_shared<lp::CachePolicyTag>(policy));
-    m_storage.insert(*data, imsFresh);
+    data.setTag(make_shared<lp::CachePolicyTag>(policy));
+    m_storage.insert(data, imsFresh);
   }
 
   if (option == SendDestination::FACE || option == SendDestination::FACE_AND_IMS) {
-    sendOnFace(*data);
+    sendOnFace(data);
   }
 }
 
@@ -170,6 +206,7 @@ Dispatcher::processControlCommandInterest(const Name& prefix,
                                           const ControlParametersParser& parser,
                                           const Authorization& authorization,
                                           const AuthorizationAcceptedCallback& accepted,
+                                          const BatchAcceptedCallback& batchAccepted,
                                           const AuthorizationRejectedCallback& rejected)
 {
   // /<prefix>/<relPrefix>/<parameters>
@@ -177,15 +214,72 @@ Dispatcher::processControlCommandInterest(const Name& prefix,
   const name::Component& pc = interest.getName().get(parametersLoc);
 
   shared_ptr<ControlParameters> parameters;
+  std::vector<shared_ptr<ControlParameters>> batch;
   try {
-    parameters = parser(pc);
+    Block block = pc.blockFromValue();
+    if (block.type() == tlv::nfd::ControlParametersBatch) {
+      block.parse();
+      for (const auto& element : block.elements()) {
+        batch.push_back(parser(element));
+      }
+      if (batch.empty()) {
+        return;
+      }
+    }
+    else {
+      parameters = parser(block);
+    }
   }
   catch (const tlv::Error&) {
     return;
   }
 
-  AcceptContinuation accept = [=] (const auto& req) { accepted(req, prefix, interest, parameters); };
+  if (!batch.empty()) {
+    // authorization may depend on the parameters, so every command is authorized separately
+    struct BatchAuthorization
+    {
+      std::vector<bool> isAuthorized;
+      std::vector<RejectReply> replies;
+      std::string requester;
+      size_t nPending;
+    };
+    auto state = make_shared<BatchAuthorization>();
+    state->isAuthorized.resize(batch.size());
+    state->replies.resize(batch.size(), RejectReply::SILENT);
+    state->nPending = batch.size();
+
+    auto decide = [=] {
+      if (--state->nPending > 0) {
+        return;
+      }
+      if (std::find(state->isAuthorized.begin(), state->isAuthorized.end(), true) ==
+          state->isAuthorized.end()) {
+        rejected(state->replies.front(), interest);
+      }
+      else {
+        batchAccepted(state->requester, prefix, interest, batch, state->isAuthorized);
+      }
+    };
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+      AcceptContinuation accept = [=] (const auto& req) {
+        if (state->requester.empty()) {
+          state->requester = req;
+        }
+        state->isAuthorized[i] = true;
+        decide();
+      };
+      RejectContinuation reject = [=] (RejectReply reply) {
+        state->replies[i] = reply;
+        decide();
+      };
+      authorization(prefix, interest, batch[i].get(), accept, reject);
+    }
+    return;
+  }
+
   RejectContinuation reject = [=] (RejectReply reply) { rejected(reply, interest); };
+  AcceptContinuation accept = [=] (const auto& req) { accepted(req, prefix, interest, parameters); };
   authorization(prefix, interest, parameters.get(), accept, reject);
 }
 
@@ -206,6 +300,52 @@ Dispatcher::processAuthorizedControlCommandInterest(const std::string& requester
   }
 }
 
+void
+Dispatcher::processAuthorizedControlCommandBatch(
+  const std::string& requester, const Name& prefix, const Interest& interest,
+  const std::vector<shared_ptr<ControlParameters>>& batch, const std::vector<bool>& isAuthorized,
+  const ValidateParameters& validateParams, const ControlCommandHandler& handler)
+{
+  struct BatchState
+  {
+    std::vector<ControlResponse> responses;
+    size_t nPending;
+  };
+  auto state = make_shared<BatchState>();
+  state->responses.resize(batch.size());
+  state->nPending = batch.size();
+
+  weak_ptr<bool> isAlive = m_isAlive;
+  auto done = [this, isAlive, state, interest] (size_t i, const ControlResponse& resp) {
+    if (isAlive.expired()) {
+      return;
+    }
+    state->responses[i] = resp;
+    if (--state->nPending > 0) {
+      return;
+    }
+
+    Block body(tlv::nfd::ControlResponseBatch);
+    for (const auto& response : state->responses) {
+      body.push_back(response.wireEncode());
+    }
+    body.encode();
+    sendControlResponse(ControlResponse(200, "OK").setBody(body), interest);
+  };
+
+  for (size_t i = 0; i < batch.size(); ++i) {
+    if (!isAuthorized[i]) {
+      done(i, ControlResponse(403, "authorization rejected"));
+    }
+    else if (validateParams(*batch[i])) {
+      handler(prefix, interest, *batch[i], [=] (const auto& resp) { done(i, resp); });
+    }
+    else {
+      done(i, ControlResponse(400, "failed in validating parameters"));
+    }
+  }
+}
+
 void
 Dispatcher::sendControlResponse(const ControlResponse& resp, const Interest& interest, bool isNack)
 {
@@ -223,6 +363,16 @@ void
 Dispatcher::addStatusDataset(const PartialName& relPrefix,
                              Authorization authorize,
                              StatusDatasetHandler handle)
+{
+  addStatusDataset(relPrefix, std::move(authorize), std::move(handle), nullptr);
+}
+
+void
+Dispatcher::addStatusDataset(const PartialName& relPrefix,
+                             Authorization authorize,
+                             StatusDatasetHandler handle,
+                             StatusDatasetGeneration getGeneration,
+                             bool wantDelta)
 {
   if (!m_topLevelPrefixes.empty()) {
     NDN_THROW(std::domain_error("one or more top-level prefix has been added"));
@@ -233,7 +383,8 @@ Dispatcher::addStatusDataset(const PartialName& relPrefix,
   }
 
   AuthorizationAcceptedCallback accepted =
-    bind(&Dispatcher::processAuthorizedStatusDatasetInterest, this, _1, _2, _3, std::move(handle));
+    bind(&Dispatcher::processAuthorizedStatusDatasetInterest, this, _1, _2, _3,
+         std::move(handle), std::move(getGeneration), wantDelta);
   AuthorizationRejectedCallback rejected =
     bind(&Dispatcher::afterAuthorizationRejected, this, _1, _2);
 
@@ -269,31 +420,279 @@ void
 Dispatcher::processAuthorizedStatusDatasetInterest(const std::string& requester,
                                                    const Name& prefix,
                                                    const Interest& interest,
-                                                   const StatusDatasetHandler& handler)
+                                                   const StatusDatasetHandler& handler,
+                                                   const StatusDatasetGeneration& getGeneration,
+                                                   bool wantDelta)
 {
+  shared_ptr<DatasetSnapshot> snapshot;
+  if (getGeneration) {
+    uint64_t generation = getGeneration();
+    auto it = m_datasetSnapshots.find(interest.getName());
+    if (it != m_datasetSnapshots.end()) {
+      DatasetSnapshotEntry& entry = it->second;
+      m_datasetSnapshotLru.splice(m_datasetSnapshotLru.end(), m_datasetSnapshotLru, entry.lruIt);
+      if (entry.snapshot->generation == generation && isDatasetSnapshotReady(*entry.snapshot)) {
+        resendDatasetSnapshot(*entry.snapshot);
+        return;
+      }
+    }
+
+    snapshot = make_shared<DatasetSnapshot>();
+    snapshot->generation = generation;
+    if (it != m_datasetSnapshots.end()) {
+      DatasetSnapshotEntry& entry = it->second;
+      if (wantDelta && isDatasetSnapshotReady(*entry.snapshot)) {
+        snapshot->previous = std::move(entry.snapshot);
+      }
+      entry.snapshot = snapshot;
+    }
+    else {
+      if (m_datasetSnapshots.size() >= MAX_DATASET_SNAPSHOTS) {
+        // evict the least recently used snapshot
+        m_datasetSnapshots.erase(m_datasetSnapshotLru.front());
+        m_datasetSnapshotLru.pop_front();
+      }
+      auto lruIt = m_datasetSnapshotLru.insert(m_datasetSnapshotLru.end(), interest.getName());
+      m_datasetSnapshots.emplace(interest.getName(), DatasetSnapshotEntry{snapshot, lruIt});
+    }
+  }
+
   StatusDatasetContext context(interest,
-                               bind(&Dispatcher::sendStatusDatasetSegment, this, _1, _2, _3, _4),
+                               bind(&Dispatcher::sendStatusDatasetSegment, this,
+                                    _1, _2, _3, _4, snapshot),
                                bind(&Dispatcher::sendControlResponse, this, _1, interest, true));
+  if (snapshot != nullptr && wantDelta) {
+    context.m_appendedBlocks = &snapshot->elements;
+  }
   handler(prefix, interest, context);
 }
 
 void
 Dispatcher::sendStatusDatasetSegment(const Name& dataName, const Block& content,
-                                     time::milliseconds imsFresh, bool isFinalBlock)
+                                     time::milliseconds imsFresh, bool isFinalBlock,
+                                     const shared_ptr<DatasetSnapshot>& snapshot)
 {
+  MetaInfo metaInfo;
+  if (isFinalBlock) {
+    metaInfo.setFinalBlock(dataName[-1]);
+  }
+  auto data = makeData(dataName, content, metaInfo);
+
   // the first segment will be sent to both places (the face and the in-memory storage)
-  // other segments will be inserted to the in-memory storage only
-  auto destination = SendDestination::IMS;
+  // right away, so that the requester can start fetching other segments
   if (dataName[-1].toSegment() == 0) {
-    destination = SendDestination::FACE_AND_IMS;
+    m_keyChain.sign(*data, m_signingInfo);
+    deliverData(*data, SendDestination::FACE_AND_IMS, imsFresh);
+  }
+  else {
+    // other segments will be inserted to the in-memory storage only, after they are signed
+    queueDatasetSegment(data, imsFresh);
+  }
+
+  if (snapshot == nullptr) {
+    return;
+  }
+  snapshot->segments.push_back(std::move(data));
+  snapshot->imsFresh = imsFresh;
+  if (isFinalBlock) {
+    snapshot->isFinalized = true;
+    if (snapshot->previous != nullptr) {
+      publishDatasetDelta(snapshot);
+    }
+  }
+}
+
+void
+Dispatcher::publishDatasetDelta(const shared_ptr<DatasetSnapshot>& snapshot)
+{
+  auto lessWire = [] (const Block& a, const Block& b) {
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+  };
+  std::vector<Block> oldElements = snapshot->previous->elements;
+  std::vector<Block> newElements = snapshot->elements;
+  std::sort(oldElements.begin(), oldElements.end(), lessWire);
+  std::sort(newElements.begin(), newElements.end(), lessWire);
+
+  std::vector<Block> removed;
+  std::set_difference(oldElements.begin(), oldElements.end(),
+                      newElements.begin(), newElements.end(),
+                      std::back_inserter(removed), lessWire);
+  std::vector<Block> added;
+  std::set_difference(newElements.begin(), newElements.end(),
+                      oldElements.begin(), oldElements.end(),
+                      std::back_inserter(added), lessWire);
+
+  // /<dataset>/32=delta/<previous version>/<version>
+  Name versionedName = snapshot->segments.front()->getName().getPrefix(-1);
+  Name deltaName = versionedName.getPrefix(-1);
+  deltaName.append(getStatusDatasetDeltaKeyword())
+           .append(snapshot->previous->segments.front()->getName().at(-2));
+  snapshot->previous.reset();
+
+  Interest deltaInterest(deltaName);
+  StatusDatasetContext context(deltaInterest,
+                               bind(&Dispatcher::sendDatasetDeltaSegment, this,
+                                    _1, _2, _3, _4, snapshot),
+                               nullptr);
+  context.setPrefix(Name(deltaName).append(versionedName[-1]));
+  context.setExpiry(snapshot->imsFresh);
+
+  auto appendWrapped = [&context] (uint32_t type, const Block& element) {
+    Block wrapped(type);
+    wrapped.push_back(element);
+    wrapped.encode();
+    context.append(wrapped);
+  };
+  for (const auto& element : removed) {
+    appendWrapped(tlv::dataset::DatasetDeltaRemoved, element);
+  }
+  for (const auto& element : added) {
+    appendWrapped(tlv::dataset::DatasetDeltaAdded, element);
   }
+  context.end();
+}
 
+void
+Dispatcher::sendDatasetDeltaSegment(const Name& dataName, const Block& content,
+                                    time::milliseconds imsFresh, bool isFinalBlock,
+                                    const shared_ptr<DatasetSnapshot>& snapshot)
+{
   MetaInfo metaInfo;
   if (isFinalBlock) {
     metaInfo.setFinalBlock(dataName[-1]);
   }
+  auto data = makeData(dataName, content, metaInfo);
+  snapshot->deltaSegments.push_back(data);
+  queueDatasetSegment(std::move(data), imsFresh);
+}
+
+bool
+Dispatcher::isDatasetSnapshotReady(const DatasetSnapshot& snapshot) const
+{
+  // segments are signed in the order they are queued, and delta segments are queued last
+  if (!snapshot.isFinalized) {
+    return false;
+  }
+  const auto& last = snapshot.deltaSegments.empty() ? snapshot.segments.back() :
+                                                      snapshot.deltaSegments.back();
+  return m_signingSegmentNames.count(last->getName()) == 0;
+}
+
+void
+Dispatcher::resendDatasetSnapshot(DatasetSnapshot& snapshot)
+{
+  // the first segments are made fresh again in the storage, other segments are re-inserted
+  // in case they have been evicted
+  auto reinsert = [this, &snapshot] (const std::vector<shared_ptr<Data>>& segments,
+                                     SendDestination firstDestination) {
+    for (size_t i = 0; i < segments.size(); ++i) {
+      if (i == 0) {
+        m_storage.erase(segments[i]->getName(), false);
+      }
+      deliverData(*segments[i], i == 0 ? firstDestination : SendDestination::IMS,
+                  snapshot.imsFresh);
+    }
+  };
+  reinsert(snapshot.segments, SendDestination::FACE_AND_IMS);
+  reinsert(snapshot.deltaSegments, SendDestination::IMS);
+}
+
+void
+Dispatcher::setDatasetSigningIo(boost::asio::io_service* io, KeyChain* keyChain)
+{
+  if (io != nullptr) {
+    if (keyChain == nullptr || keyChain == &m_keyChain) {
+      NDN_THROW(std::invalid_argument("Signing on worker threads requires a separate KeyChain"));
+    }
+    if (m_signingInfo.getPibIdentity() || m_signingInfo.getPibKey()) {
+      NDN_THROW(std::invalid_argument("SigningInfo must not refer to a PIB entry of the "
+                                      "Dispatcher's KeyChain"));
+    }
+  }
+
+  m_datasetSigningIo = io;
+  m_datasetSigningKeyChain = io == nullptr ? nullptr : keyChain;
+}
+
+void
+Dispatcher::queueDatasetSegment(shared_ptr<Data> data, time::milliseconds imsFresh)
+{
+  m_signingSegmentNames.insert(data->getName());
+  m_unsignedSegments.emplace_back(std::move(data), imsFresh);
+  signDatasetSegments();
+}
+
+void
+Dispatcher::signDatasetSegments()
+{
+  if (m_isSigningSegments || m_unsignedSegments.empty()) {
+    return;
+  }
+
+  size_t batchSize = std::min(m_unsignedSegments.size(), SIGNING_BATCH_SIZE);
+  std::vector<std::pair<shared_ptr<Data>, time::milliseconds>> batch(
+    std::make_move_iterator(m_unsignedSegments.begin()),
+    std::make_move_iterator(m_unsignedSegments.begin() + batchSize));
+  m_unsignedSegments.erase(m_unsignedSegments.begin(), m_unsignedSegments.begin() + batchSize);
+
+  // sign in a separate event, so that other Interests are processed between batches
+  m_isSigningSegments = true;
+  weak_ptr<bool> isAlive = m_isAlive;
+  auto afterSigned = [this, isAlive, batch] {
+    if (!isAlive.expired()) {
+      afterDatasetSegmentsSigned(batch);
+    }
+  };
+
+  if (m_datasetSigningIo == nullptr) {
+    m_face.getIoService().post([this, isAlive, batch, afterSigned] {
+      if (isAlive.expired()) {
+        return;
+      }
+      for (const auto& segment : batch) {
+        m_keyChain.sign(*segment.first, m_signingInfo);
+      }
+      afterSigned();
+    });
+    return;
+  }
+
+  // the worker only touches the batch and its own KeyChain; the result is handed back to the
+  // Face's thread, where the Dispatcher's liveness is checked
+  m_datasetSigningIo->post([batch, afterSigned,
+                            &keyChain = *m_datasetSigningKeyChain, signingInfo = m_signingInfo,
+                            &faceIo = m_face.getIoService()] () mutable {
+    for (const auto& segment : batch) {
+      keyChain.sign(*segment.first, signingInfo);
+    }
+    faceIo.post(std::move(afterSigned));
+  });
+}
 
-  sendData(dataName, content, metaInfo, destination, imsFresh);
+void
+Dispatcher::afterDatasetSegmentsSigned(const std::vector<std::pair<shared_ptr<Data>,
+                                                                   time::milliseconds>>& batch)
+{
+  m_isSigningSegments = false;
+  for (const auto& segment : batch) {
+    const Data& data = *segment.first;
+    m_signingSegmentNames.erase(data.getName());
+    bool isAwaited = m_awaitedSegmentNames.erase(data.getName()) > 0;
+    deliverData(*segment.first, isAwaited ? SendDestination::FACE_AND_IMS : SendDestination::IMS,
+                segment.second);
+  }
+
+  signDatasetSegments();
+}
+
+bool
+Dispatcher::awaitDatasetSegment(const Interest& interest)
+{
+  if (m_signingSegmentNames.count(interest.getName()) == 0) {
+    return false;
+  }
+  m_awaitedSegmentNames.insert(interest.getName());
+  return true;
 }
 
 PostNotification
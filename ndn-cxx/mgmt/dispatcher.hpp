@@ -24,15 +24,20 @@
 
 #include "ndn-cxx/face.hpp"
 #include "ndn-cxx/encoding/block.hpp"
+#include "ndn-cxx/encoding/tlv-dataset.hpp"
 #include "ndn-cxx/ims/in-memory-storage-fifo.hpp"
 #include "ndn-cxx/mgmt/control-response.hpp"
 #include "ndn-cxx/mgmt/control-parameters.hpp"
 #include "ndn-cxx/mgmt/status-dataset-context.hpp"
 #include "ndn-cxx/security/key-chain.hpp"
 
+#include <deque>
+#include <list>
+#include <set>
 #include <unordered_map>
 
 namespace ndn {
+
 namespace mgmt {
 
 // ---- AUTHORIZATION ----
@@ -117,6 +122,21 @@ typedef std::function<void(const Name& prefix, const Interest& interest,
 typedef std::function<void(const Name& prefix, const Interest& interest,
                            StatusDatasetContext& context)> StatusDatasetHandler;
 
+/** \brief a function that returns the current generation of a StatusDataset
+ *
+ *  The generation must change whenever the content of the dataset changes, e.g., a counter
+ *  that is incremented on every modification of the underlying table.
+ */
+typedef std::function<uint64_t()> StatusDatasetGeneration;
+
+/** \return the keyword component that introduces a StatusDataset delta, i.e., "32=delta"
+ *
+ *  The delta from version V of a dataset named /P is requested as /P/32=delta/V,
+ *  and published as /P/32=delta/V/<new version>/<segment>.
+ */
+const name::Component&
+getStatusDatasetDeltaKeyword();
+
 //---- NOTIFICATION STREAM ----
 
 /** \brief a function to post a notification
@@ -203,6 +223,15 @@ public: // ControlCommand
    *  6. sign the Data packet
    *  7. if the Data packet is too large, abort these steps and log an error
    *  8. send the signed Data packet
+   *
+   *  The NameComponent may instead contain a ControlParametersBatch element with one or more
+   *  ControlParameters. Authorization is then performed for each ControlParameters, and the
+   *  RejectReply action of the first one is performed if every ControlParameters is rejected.
+   *  Otherwise, a rejected ControlParameters gets a ControlResponse with StatusCode 403, while
+   *  each authorized ControlParameters is validated and handled separately. A single
+   *  ControlResponse with StatusCode 200 is sent after every handler completes. Its body is a
+   *  ControlResponseBatch element that contains the ControlResponse of each ControlParameters,
+   *  in the same order.
    */
   template<typename CP>
   void
@@ -241,12 +270,61 @@ public: // StatusDataset
    *
    *  As an optimization, a Data packet may be sent as soon as enough octets have been collected
    *  through StatusDatasetAppend calls.
+   *
+   *  The first segment is signed and sent right away. Other segments are signed in batches in
+   *  later events, or on the threads of setDatasetSigningIo, so that a large dataset does not
+   *  delay other Interests; each segment is inserted into the in-memory storage once signed.
+   *  An Interest for a segment that is still being signed is answered when it is signed.
    */
   void
   addStatusDataset(const PartialName& relPrefix,
                    Authorization authorize,
                    StatusDatasetHandler handle);
 
+  /** \brief register a StatusDataset whose snapshots are cached by generation
+   *  \param relPrefix a prefix for this dataset, e.g., "faces/list"
+   *  \param authorize should set identity to Name() if the dataset is public
+   *  \param handle Callback to process the incoming dataset requests
+   *  \param getGeneration Callback that returns the current generation of the dataset
+   *  \param wantDelta whether to publish the delta from the previous snapshot
+   *  \pre no top-level prefix has been added
+   *  \throw std::out_of_range \p relPrefix overlaps with an existing relPrefix
+   *  \throw std::domain_error one or more top-level prefix has been added
+   *
+   *  The signed segments of the last response to each request name are kept, together with the
+   *  generation at the time of that response. An authorized request that misses the in-memory
+   *  storage while the generation is unchanged is answered with the kept segments, without
+   *  invoking \p handle or signing again.
+   *
+   *  If \p wantDelta is true, when a new snapshot replaces a complete one, the blocks that were
+   *  removed and added are published under the delta name of the previous version (see
+   *  getStatusDatasetDeltaKeyword), each wrapped in a DatasetDeltaRemoved or DatasetDeltaAdded
+   *  element. Blocks are compared by their wire encoding. Delta segments are only inserted into
+   *  the in-memory storage.
+   */
+  void
+  addStatusDataset(const PartialName& relPrefix,
+                   Authorization authorize,
+                   StatusDatasetHandler handle,
+                   StatusDatasetGeneration getGeneration,
+                   bool wantDelta = false);
+
+  /** \brief sign status dataset segments on threads running \p io
+   *  \param io an io_service run by worker threads, or nullptr to sign on the Face's thread
+   *  \param keyChain the KeyChain used on the worker threads; it must be a separate instance
+   *                  from the Dispatcher's KeyChain, able to sign with the signing info given
+   *                  to the Dispatcher, and must not be used by anything else while set
+   *  \throw std::invalid_argument \p io is given without a separate \p keyChain, or the
+   *                               signing info refers to a key of the Dispatcher's KeyChain
+   *
+   *  KeyChain is not thread-safe, while the Dispatcher keeps signing control responses,
+   *  notifications, and the first segment of each dataset with its own KeyChain on the Face's
+   *  thread. At most one batch of segments is being signed on the worker threads at a time.
+   *  Both \p io and \p keyChain, as well as the Face's io_service, must outlive the signing.
+   */
+  void
+  setDatasetSigningIo(boost::asio::io_service* io, KeyChain* keyChain = nullptr);
+
 public: // NotificationStream
   /** \brief register a NotificationStream
    *  \param relPrefix a prefix for this notification stream, e.g., "faces/events";
@@ -279,16 +357,22 @@ private:
                              const Interest& interest,
                              const shared_ptr<ControlParameters>&)> AuthorizationAcceptedCallback;
 
+  typedef std::function<void(const std::string& requester,
+                             const Name& prefix,
+                             const Interest& interest,
+                             const std::vector<shared_ptr<ControlParameters>>&,
+                             const std::vector<bool>& isAuthorized)> BatchAcceptedCallback;
+
   typedef std::function<void(RejectReply act,
                              const Interest& interest)> AuthorizationRejectedCallback;
 
   /**
-   * @brief the parser of extracting control parameters from name component.
-   * @param comp name component that may encode control parameters.
+   * @brief the parser of extracting control parameters from a block.
+   * @param block the block that may encode control parameters.
    * @return a shared pointer to the extracted control parameters.
-   * @throw tlv::Error if the NameComponent cannot be parsed as ControlParameters
+   * @throw tlv::Error if the block cannot be parsed as ControlParameters
    */
-  typedef std::function<shared_ptr<ControlParameters>(const name::Component& comp)> ControlParametersParser;
+  typedef std::function<shared_ptr<ControlParameters>(const Block& block)> ControlParametersParser;
 
   bool
   isOverlappedWithOthers(const PartialName& relPrefix) const;
@@ -340,6 +424,18 @@ private:
   sendData(const Name& dataName, const Block& content, const MetaInfo& metaInfo,
            SendDestination destination, time::milliseconds imsFresh);
 
+  /**
+   * @brief create an unsigned Data packet with FreshnessPeriod set to DEFAULT_FRESHNESS_PERIOD
+   */
+  static shared_ptr<Data>
+  makeData(const Name& dataName, const Block& content, const MetaInfo& metaInfo);
+
+  /**
+   * @brief send a signed Data packet to the face and/or in-memory storage
+   */
+  void
+  deliverData(Data& data, SendDestination destination, time::milliseconds imsFresh);
+
   /**
    * @brief send out a data packt through the face
    *
@@ -357,6 +453,7 @@ private:
    * @param parser to extract control parameters from the \p interest
    * @param authorization to process validation on this command
    * @param accepted the callback for successful authorization
+   * @param batchAccepted the callback for a batch in which at least one command is authorized
    * @param rejected the callback for failed authorization
    */
   void
@@ -366,6 +463,7 @@ private:
                                 const ControlParametersParser& parser,
                                 const Authorization& authorization,
                                 const AuthorizationAcceptedCallback& accepted,
+                                const BatchAcceptedCallback& batchAccepted,
                                 const AuthorizationRejectedCallback& rejected);
 
   /**
@@ -386,6 +484,26 @@ private:
                                           const ValidateParameters& validate,
                                           const ControlCommandHandler& handler);
 
+  /**
+   * @brief process an authorized batch of control-commands.
+   *
+   * @param requester the requester
+   * @param prefix the top-level prefix
+   * @param interest the incoming Interest
+   * @param batch control parameters of each command in the batch
+   * @param isAuthorized whether each command in the batch passed authorization
+   * @param validate to validate control parameters
+   * @param handler to process each command
+   */
+  void
+  processAuthorizedControlCommandBatch(const std::string& requester,
+                                       const Name& prefix,
+                                       const Interest& interest,
+                                       const std::vector<shared_ptr<ControlParameters>>& batch,
+                                       const std::vector<bool>& isAuthorized,
+                                       const ValidateParameters& validate,
+                                       const ControlCommandHandler& handler);
+
   void
   sendControlResponse(const ControlResponse& resp, const Interest& interest, bool isNack = false);
 
@@ -417,7 +535,11 @@ private:
   processAuthorizedStatusDatasetInterest(const std::string& requester,
                                          const Name& prefix,
                                          const Interest& interest,
-                                         const StatusDatasetHandler& handler);
+                                         const StatusDatasetHandler& handler,
+                                         const StatusDatasetGeneration& getGeneration,
+                                         bool wantDelta);
+
+  struct DatasetSnapshot;
 
   /**
    * @brief send a segment of StatusDataset
@@ -426,10 +548,58 @@ private:
    * @param content the content of this piece of data
    * @param imsFresh the freshness period of this piece of data in the in-memory storage
    * @param isFinalBlock indicates whether this piece of data is the final block
+   * @param snapshot the snapshot that keeps this segment, or nullptr
    */
   void
   sendStatusDatasetSegment(const Name& dataName, const Block& content,
-                           time::milliseconds imsFresh, bool isFinalBlock);
+                           time::milliseconds imsFresh, bool isFinalBlock,
+                           const shared_ptr<DatasetSnapshot>& snapshot);
+
+  /**
+   * @brief publish the delta between @p snapshot and its previous snapshot
+   */
+  void
+  publishDatasetDelta(const shared_ptr<DatasetSnapshot>& snapshot);
+
+  void
+  sendDatasetDeltaSegment(const Name& dataName, const Block& content,
+                          time::milliseconds imsFresh, bool isFinalBlock,
+                          const shared_ptr<DatasetSnapshot>& snapshot);
+
+  /**
+   * @return whether every segment of @p snapshot has been generated and signed
+   */
+  bool
+  isDatasetSnapshotReady(const DatasetSnapshot& snapshot) const;
+
+  /**
+   * @brief answer a dataset request with the kept segments of @p snapshot
+   */
+  void
+  resendDatasetSnapshot(DatasetSnapshot& snapshot);
+
+  /**
+   * @brief queue a status dataset segment for signing and insertion into the in-memory storage
+   */
+  void
+  queueDatasetSegment(shared_ptr<Data> data, time::milliseconds imsFresh);
+
+  /**
+   * @brief start signing the next batch of status dataset segments, if none is being signed
+   */
+  void
+  signDatasetSegments();
+
+  void
+  afterDatasetSegmentsSigned(const std::vector<std::pair<shared_ptr<Data>, time::milliseconds>>& batch);
+
+  /**
+   * @brief remember an Interest for a status dataset segment that is being signed
+   * @retval true the Interest will be answered once the segment is signed
+   * @retval false no such segment is being signed
+   */
+  bool
+  awaitDatasetSegment(const Interest& interest);
 
   void
   postNotification(const Block& notification, const PartialName& relPrefix);
@@ -451,6 +621,39 @@ private:
   // NotificationStream name => next sequence number
   std::unordered_map<Name, uint64_t> m_streams;
 
+  // unsigned status dataset segments, with their freshness period in the in-memory storage
+  std::deque<std::pair<shared_ptr<Data>, time::milliseconds>> m_unsignedSegments;
+  // names of segments in m_unsignedSegments or being signed
+  std::set<Name> m_signingSegmentNames;
+  // segments requested while being signed
+  std::set<Name> m_awaitedSegmentNames;
+  bool m_isSigningSegments = false;
+  boost::asio::io_service* m_datasetSigningIo = nullptr;
+  KeyChain* m_datasetSigningKeyChain = nullptr;
+
+  struct DatasetSnapshot
+  {
+    uint64_t generation = 0;
+    std::vector<shared_ptr<Data>> segments;
+    std::vector<shared_ptr<Data>> deltaSegments;
+    // appended blocks, collected only if delta is wanted
+    std::vector<Block> elements;
+    // the replaced snapshot, kept until the delta against it is published
+    shared_ptr<DatasetSnapshot> previous;
+    time::milliseconds imsFresh = time::milliseconds::zero();
+    bool isFinalized = false;
+  };
+  struct DatasetSnapshotEntry
+  {
+    shared_ptr<DatasetSnapshot> snapshot;
+    std::list<Name>::iterator lruIt;
+  };
+  // request Name => last snapshot
+  std::unordered_map<Name, DatasetSnapshotEntry> m_datasetSnapshots;
+  // request Names in m_datasetSnapshots, least recently used first
+  std::list<Name> m_datasetSnapshotLru;
+  shared_ptr<bool> m_isAlive = make_shared<bool>();
+
 NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   InMemoryStorageFifo m_storage;
 };
@@ -470,20 +673,24 @@ Dispatcher::addControlCommand(const PartialName& relPrefix,
     NDN_THROW(std::out_of_range("relPrefix overlaps with another relPrefix"));
   }
 
-  auto parser = [] (const name::Component& comp) -> shared_ptr<ControlParameters> {
-    return make_shared<CP>(comp.blockFromValue());
+  auto parser = [] (const Block& block) -> shared_ptr<ControlParameters> {
+    return make_shared<CP>(block);
   };
 
   AuthorizationAcceptedCallback accepted =
     bind(&Dispatcher::processAuthorizedControlCommandInterest, this,
-         _1, _2, _3, _4, std::move(validate), std::move(handle));
+         _1, _2, _3, _4, validate, handle);
+
+  BatchAcceptedCallback batchAccepted =
+    bind(&Dispatcher::processAuthorizedControlCommandBatch, this,
+         _1, _2, _3, _4, _5, std::move(validate), std::move(handle));
 
   AuthorizationRejectedCallback rejected =
     bind(&Dispatcher::afterAuthorizationRejected, this, _1, _2);
 
   m_handlers[relPrefix] = bind(&Dispatcher::processControlCommandInterest, this,
                                _1, relPrefix, _2, std::move(parser), std::move(authorize),
-                               std::move(accepted), std::move(rejected));
+                               std::move(accepted), std::move(batchAccepted), std::move(rejected));
 }
 
 } // namespace mgmt
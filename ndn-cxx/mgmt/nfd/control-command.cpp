@@ -20,6 +20,7 @@
  */
 
 #include "ndn-cxx/mgmt/nfd/control-command.hpp"
+#include "ndn-cxx/encoding/tlv-nfd.hpp"
 
 namespace ndn {
 namespace nfd {
@@ -66,6 +67,27 @@ ControlCommand::getRequestName(const Name& commandPrefix,
   return name;
 }
 
+Name
+ControlCommand::getBatchRequestName(const Name& commandPrefix,
+                                    const std::vector<ControlParameters>& parameters) const
+{
+  if (parameters.empty()) {
+    NDN_THROW(ArgumentError("batch is empty"));
+  }
+
+  Block batch(tlv::nfd::ControlParametersBatch);
+  for (const auto& p : parameters) {
+    this->validateRequest(p);
+    batch.push_back(p.wireEncode());
+  }
+  batch.encode();
+
+  Name name = commandPrefix;
+  name.append(m_module).append(m_verb);
+  name.append(batch);
+  return name;
+}
+
 ControlCommand::FieldValidator::FieldValidator()
   : m_required(CONTROL_PARAMETER_UBOUND)
   , m_optional(CONTROL_PARAMETER_UBOUND)
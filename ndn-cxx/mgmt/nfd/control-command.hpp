@@ -78,6 +78,17 @@ public:
   Name
   getRequestName(const Name& commandPrefix, const ControlParameters& parameters) const;
 
+  /** \brief construct the Name for a batched request Interest
+   *
+   *  The parameters component contains a ControlParametersBatch element that holds
+   *  each of \p parameters in order.
+   *
+   *  \throw ArgumentError if \p parameters is empty, or any of \p parameters is invalid
+   */
+  Name
+  getBatchRequestName(const Name& commandPrefix,
+                      const std::vector<ControlParameters>& parameters) const;
+
 protected:
   ControlCommand(const std::string& module, const std::string& verb);
 
@@ -21,6 +21,7 @@
 
 #include "ndn-cxx/mgmt/nfd/controller.hpp"
 #include "ndn-cxx/face.hpp"
+#include "ndn-cxx/encoding/tlv-nfd.hpp"
 #include "ndn-cxx/security/v2/key-chain.hpp"
 
 #include <boost/lexical_cast.hpp>
@@ -36,6 +37,10 @@ const uint32_t Controller::ERROR_VALIDATION = 10021; // 10000 + TLS1_ALERT_DECRY
 const uint32_t Controller::ERROR_SERVER = 500;
 const uint32_t Controller::ERROR_LBOUND = 400;
 
+// maximum total size of ControlParameters in one batched command Interest;
+// this leaves room for the response, which is usually larger than the request
+const size_t MAX_BATCH_PARAMETERS_SIZE = MAX_NDN_PACKET_SIZE >> 2;
+
 Controller::Controller(Face& face, KeyChain& keyChain, security::v2::Validator& validator)
   : m_face(face)
   , m_keyChain(keyChain)
@@ -139,6 +144,134 @@ Controller::processValidatedCommandResponse(const Data& data,
     onSuccess(parameters);
 }
 
+void
+Controller::startBatchCommand(const shared_ptr<ControlCommand>& command,
+                              const std::vector<ControlParameters>& parameters,
+                              const BatchCommandCallback& onComplete,
+                              const CommandOptions& options)
+{
+  // split into chunks of consecutive commands, each sent in one Interest
+  std::vector<std::pair<size_t, size_t>> chunks;
+  size_t chunkBegin = 0;
+  size_t chunkSize = 0;
+  for (size_t i = 0; i < parameters.size(); ++i) {
+    command->validateRequest(parameters[i]);
+    size_t size = parameters[i].wireEncode().size();
+    if (i > chunkBegin && chunkSize + size > MAX_BATCH_PARAMETERS_SIZE) {
+      chunks.emplace_back(chunkBegin, i);
+      chunkBegin = i;
+      chunkSize = 0;
+    }
+    chunkSize += size;
+  }
+  if (chunkBegin < parameters.size()) {
+    chunks.emplace_back(chunkBegin, parameters.size());
+  }
+
+  if (chunks.empty()) {
+    if (onComplete)
+      onComplete({});
+    return;
+  }
+
+  struct BatchState
+  {
+    std::vector<ControlResponse> responses;
+    size_t nPendingChunks;
+  };
+  auto state = make_shared<BatchState>();
+  state->responses.resize(parameters.size());
+  state->nPendingChunks = chunks.size();
+
+  for (const auto& chunk : chunks) {
+    size_t offset = chunk.first;
+    size_t nCommands = chunk.second - chunk.first;
+    BatchResponseCallback onResponses = [=] (std::vector<ControlResponse> responses) {
+      BOOST_ASSERT(responses.size() == nCommands);
+      std::move(responses.begin(), responses.end(), state->responses.begin() + offset);
+      if (--state->nPendingChunks == 0 && onComplete) {
+        onComplete(state->responses);
+      }
+    };
+
+    std::vector<ControlParameters> items(parameters.begin() + chunk.first,
+                                         parameters.begin() + chunk.second);
+    Name requestName = command->getBatchRequestName(options.getPrefix(), items);
+    Interest interest = m_signer.makeCommandInterest(requestName, options.getSigningInfo());
+    interest.setInterestLifetime(options.getTimeout());
+
+    m_face.expressInterest(interest,
+      [=] (const Interest&, const Data& data) {
+        processBatchCommandResponse(data, command, nCommands, onResponses);
+      },
+      [=] (const Interest&, const lp::Nack&) {
+        onResponses(std::vector<ControlResponse>(nCommands,
+                      ControlResponse(Controller::ERROR_NACK, "network Nack received")));
+      },
+      [=] (const Interest&) {
+        onResponses(std::vector<ControlResponse>(nCommands,
+                      ControlResponse(Controller::ERROR_TIMEOUT, "request timed out")));
+      });
+  }
+}
+
+void
+Controller::processBatchCommandResponse(const Data& data,
+                                        const shared_ptr<ControlCommand>& command,
+                                        size_t nCommands,
+                                        const BatchResponseCallback& onResponses)
+{
+  auto failAll = [=] (const ControlResponse& response) {
+    onResponses(std::vector<ControlResponse>(nCommands, response));
+  };
+
+  m_validator.validate(data,
+    [=] (const Data& data) {
+      std::vector<ControlResponse> responses;
+      try {
+        ControlResponse response(data.getContent().blockFromValue());
+        if (response.getCode() >= ERROR_LBOUND) {
+          failAll(response);
+          return;
+        }
+
+        Block body = response.getBody();
+        body.parse();
+        if (body.type() != tlv::nfd::ControlResponseBatch || body.elements_size() != nCommands) {
+          failAll(ControlResponse(ERROR_SERVER, "malformed batch response"));
+          return;
+        }
+        for (const auto& element : body.elements()) {
+          responses.emplace_back(element);
+        }
+      }
+      catch (const tlv::Error& e) {
+        failAll(ControlResponse(ERROR_SERVER, e.what()));
+        return;
+      }
+
+      for (auto& response : responses) {
+        if (response.getCode() >= ERROR_LBOUND) {
+          continue;
+        }
+        try {
+          command->validateResponse(ControlParameters(response.getBody()));
+        }
+        catch (const tlv::Error& e) {
+          response = ControlResponse(ERROR_SERVER, e.what());
+        }
+        catch (const ControlCommand::ArgumentError& e) {
+          response = ControlResponse(ERROR_SERVER, e.what());
+        }
+      }
+      onResponses(std::move(responses));
+    },
+    [=] (const Data&, const auto& error) {
+      failAll(ControlResponse(ERROR_VALIDATION, boost::lexical_cast<std::string>(error)));
+    }
+  );
+}
+
 void
 Controller::fetchDataset(const Name& prefix,
                          const std::function<void(ConstBufferPtr)>& processResponse,
@@ -163,6 +296,48 @@ Controller::fetchDataset(const Name& prefix,
   fetcher->onError.connect([this, it] (uint32_t, const std::string&) { m_fetchers.erase(it); });
 }
 
+void
+Controller::fetchDatasetIncremental(const Name& prefix,
+                                    const std::function<void(const Block&)>& processChunk,
+                                    const DatasetFailCallback& onFailure,
+                                    const CommandOptions& options)
+{
+  BOOST_ASSERT(processChunk);
+
+  SegmentFetcher::Options fetcherOptions;
+  fetcherOptions.maxTimeout = options.getTimeout();
+  fetcherOptions.inOrder = true;
+
+  auto fetcher = SegmentFetcher::start(m_face, Interest(prefix), m_validator, fetcherOptions);
+  auto it = m_fetchers.insert(fetcher).first;
+
+  auto process = [=] (const Block& chunk) {
+    try {
+      processChunk(chunk);
+      return true;
+    }
+    catch (const tlv::Error& e) {
+      (*it)->stop();
+      m_fetchers.erase(it);
+      if (onFailure)
+        onFailure(ERROR_SERVER, e.what());
+      return false;
+    }
+  };
+  fetcher->onInOrderData.connect([=] (const Block& chunk) { process(chunk); });
+  fetcher->onInOrderComplete.connect([=] {
+    if (process(Block()))
+      m_fetchers.erase(it);
+  });
+
+  if (onFailure) {
+    fetcher->onError.connect([=] (uint32_t code, const std::string& msg) {
+      processDatasetFetchError(onFailure, code, msg);
+    });
+  }
+  fetcher->onError.connect([this, it] (uint32_t, const std::string&) { m_fetchers.erase(it); });
+}
+
 void
 Controller::processDatasetFetchError(const DatasetFailCallback& onFailure,
                                      uint32_t code, std::string msg)
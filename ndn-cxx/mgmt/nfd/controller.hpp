@@ -59,10 +59,27 @@ public:
    */
   using CommandFailCallback = function<void(const ControlResponse&)>;
 
+  /** \brief a callback on completion of a batched command
+   *
+   *  It receives one ControlResponse per request ControlParameters, in the order of the request.
+   *  A response whose StatusCode is below ERROR_LBOUND carries the response ControlParameters
+   *  as its body.
+   */
+  using BatchCommandCallback = function<void(const std::vector<ControlResponse>&)>;
+
   /** \brief a callback on dataset retrieval failure
    */
   using DatasetFailCallback = function<void(uint32_t code, const std::string& reason)>;
 
+  /** \brief a callback on incremental dataset retrieval, receiving a batch of decoded entries
+   */
+  template<typename Dataset>
+  using DatasetBatchCallback = function<void(std::vector<typename Dataset::ResultType::value_type>)>;
+
+  /** \brief a callback on completion of incremental dataset retrieval
+   */
+  using DatasetCompleteCallback = function<void()>;
+
   /** \brief construct a Controller that uses face for transport,
    *         and uses the passed KeyChain to sign commands
    */
@@ -83,6 +100,26 @@ public:
     startCommand(make_shared<Command>(), parameters, onSuccess, onFailure, options);
   }
 
+  /** \brief start batched command execution
+   *  \param parameters request ControlParameters of each command
+   *  \param onComplete invoked once, after every command has succeeded or failed
+   *  \throw ControlCommand::ArgumentError any of \p parameters is invalid
+   *
+   *  \p parameters are packed into as few signed command Interests as the packet size allows,
+   *  so that signing, validation, and round trips are shared among the commands. The forwarder
+   *  must support batched commands (see mgmt::Dispatcher::addControlCommand). If a command
+   *  Interest times out, is Nacked, or its response cannot be validated, each command it carries
+   *  receives a response with the corresponding error code.
+   */
+  template<typename Command>
+  void
+  startBatch(const std::vector<ControlParameters>& parameters,
+             const BatchCommandCallback& onComplete,
+             const CommandOptions& options = CommandOptions())
+  {
+    startBatchCommand(make_shared<Command>(), parameters, onComplete, options);
+  }
+
   /** \brief start dataset fetching
    */
   template<typename Dataset>
@@ -106,6 +143,43 @@ public:
     fetchDataset(make_shared<Dataset>(param), onSuccess, onFailure, options);
   }
 
+  /** \brief start incremental dataset fetching
+   *
+   *  Segments are requested in a window as with fetch(), but entries are decoded as soon as
+   *  the segments containing them have been received in order, rather than after the whole
+   *  dataset has been reassembled. \p onBatch is invoked with the entries completed by each
+   *  segment; an entry spanning a segment boundary is delivered with the segment in which it
+   *  ends. \p onComplete is invoked after the last batch. If an entry cannot be decoded,
+   *  \p onFailure is invoked with ERROR_SERVER and fetching stops; batches already delivered
+   *  are not retracted.
+   *
+   *  \tparam Dataset a dataset whose ResultType is a vector of entries
+   */
+  template<typename Dataset>
+  std::enable_if_t<std::is_default_constructible<Dataset>::value>
+  fetchIncremental(const DatasetBatchCallback<Dataset>& onBatch,
+                   const DatasetCompleteCallback& onComplete,
+                   const DatasetFailCallback& onFailure,
+                   const CommandOptions& options = CommandOptions())
+  {
+    fetchDatasetIncremental(make_shared<Dataset>(), onBatch, onComplete, onFailure, options);
+  }
+
+  /** \brief start incremental dataset fetching
+   *  \sa fetchIncremental(const DatasetBatchCallback<Dataset>&, const DatasetCompleteCallback&,
+   *                        const DatasetFailCallback&, const CommandOptions&)
+   */
+  template<typename Dataset, typename ParamType = typename Dataset::ParamType>
+  void
+  fetchIncremental(const ParamType& param,
+                   const DatasetBatchCallback<Dataset>& onBatch,
+                   const DatasetCompleteCallback& onComplete,
+                   const DatasetFailCallback& onFailure,
+                   const CommandOptions& options = CommandOptions())
+  {
+    fetchDatasetIncremental(make_shared<Dataset>(param), onBatch, onComplete, onFailure, options);
+  }
+
 private:
   void
   startCommand(const shared_ptr<ControlCommand>& command,
@@ -126,6 +200,20 @@ private:
                                   const CommandSucceedCallback& onSuccess,
                                   const CommandFailCallback& onFailure);
 
+  void
+  startBatchCommand(const shared_ptr<ControlCommand>& command,
+                    const std::vector<ControlParameters>& parameters,
+                    const BatchCommandCallback& onComplete,
+                    const CommandOptions& options);
+
+  using BatchResponseCallback = function<void(std::vector<ControlResponse>)>;
+
+  void
+  processBatchCommandResponse(const Data& data,
+                              const shared_ptr<ControlCommand>& command,
+                              size_t nCommands,
+                              const BatchResponseCallback& onResponses);
+
   template<typename Dataset>
   void
   fetchDataset(shared_ptr<Dataset> dataset,
@@ -139,6 +227,23 @@ private:
                const DatasetFailCallback& onFailure,
                const CommandOptions& options);
 
+  template<typename Dataset>
+  void
+  fetchDatasetIncremental(shared_ptr<Dataset> dataset,
+                          const DatasetBatchCallback<Dataset>& onBatch,
+                          const DatasetCompleteCallback& onComplete,
+                          const DatasetFailCallback& onFailure,
+                          const CommandOptions& options);
+
+  /** \param processChunk invoked with the Content of each segment in order, and with an
+   *                      invalid Block at the end; may throw tlv::Error to abort fetching
+   */
+  void
+  fetchDatasetIncremental(const Name& prefix,
+                          const std::function<void(const Block&)>& processChunk,
+                          const DatasetFailCallback& onFailure,
+                          const CommandOptions& options);
+
   template<typename Dataset>
   void
   processDatasetResponse(shared_ptr<Dataset> dataset,
@@ -195,6 +300,37 @@ Controller::fetchDataset(shared_ptr<Dataset> dataset,
     onFailure, options);
 }
 
+template<typename Dataset>
+void
+Controller::fetchDatasetIncremental(shared_ptr<Dataset> dataset,
+                                    const DatasetBatchCallback<Dataset>& onBatch,
+                                    const DatasetCompleteCallback& onComplete,
+                                    const DatasetFailCallback& onFailure,
+                                    const CommandOptions& options)
+{
+  using Entry = typename Dataset::ResultType::value_type;
+
+  Name prefix = dataset->getDatasetPrefix(options.getPrefix());
+  auto parser = make_shared<StatusDatasetStreamParser>();
+  fetchDatasetIncremental(prefix,
+    [=] (const Block& chunk) {
+      if (!chunk.isValid()) {
+        parser->finish();
+        if (onComplete)
+          onComplete();
+        return;
+      }
+
+      std::vector<Entry> batch;
+      for (const auto& block : parser->parse(chunk)) {
+        batch.emplace_back(block);
+      }
+      if (onBatch && !batch.empty())
+        onBatch(std::move(batch));
+    },
+    onFailure, options);
+}
+
 template<typename Dataset>
 void
 Controller::processDatasetResponse(shared_ptr<Dataset> dataset,
@@ -30,9 +30,13 @@
 namespace ndn {
 namespace nfd {
 
+// face events may be posted in bursts, e.g., when many faces are created or closed at once
+const size_t FACE_MONITOR_WINDOW_SIZE = 8;
+
 FaceMonitor::FaceMonitor(Face& face)
   : NotificationSubscriber<FaceEventNotification>(face, "ndn:/localhost/nfd/faces/events")
 {
+  setWindowSize(FACE_MONITOR_WINDOW_SIZE);
 }
 
 } // namespace nfd
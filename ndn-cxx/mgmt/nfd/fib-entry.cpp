@@ -23,17 +23,31 @@
 #include "ndn-cxx/encoding/block-helpers.hpp"
 #include "ndn-cxx/encoding/encoding-buffer.hpp"
 #include "ndn-cxx/encoding/tlv-nfd.hpp"
+#include "ndn-cxx/encoding/tlv-schema.hpp"
 #include "ndn-cxx/util/concepts.hpp"
 #include "ndn-cxx/util/ostream-joiner.hpp"
 
-#include <boost/range/adaptor/reversed.hpp>
-
 namespace ndn {
 namespace nfd {
 
 BOOST_CONCEPT_ASSERT((StatusDatasetItem<NextHopRecord>));
 BOOST_CONCEPT_ASSERT((StatusDatasetItem<FibEntry>));
 
+struct NextHopRecord::Schema : encoding::schema::Schema<tlv::nfd::NextHopRecord,
+  NDN_CXX_TLV_SCHEMA_FIELD(tlv::nfd::FaceId, NonNegativeIntegerCodec, Required,
+                           &NextHopRecord::m_faceId),
+  NDN_CXX_TLV_SCHEMA_FIELD(tlv::nfd::Cost, NonNegativeIntegerCodec, Required,
+                           &NextHopRecord::m_cost)>
+{
+};
+
+struct FibEntry::Schema : encoding::schema::Schema<tlv::nfd::FibEntry,
+  NDN_CXX_TLV_SCHEMA_FIELD(tlv::Name, NestedCodec, Required, &FibEntry::m_prefix),
+  NDN_CXX_TLV_SCHEMA_FIELD(tlv::nfd::NextHopRecord, NestedCodec, Repeated,
+                           &FibEntry::m_nextHopRecords)>
+{
+};
+
 NextHopRecord::NextHopRecord()
   : m_faceId(INVALID_FACE_ID)
   , m_cost(0)
@@ -65,14 +79,7 @@ template<encoding::Tag TAG>
 size_t
 NextHopRecord::wireEncode(EncodingImpl<TAG>& block) const
 {
-  size_t totalLength = 0;
-
-  totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nfd::Cost, m_cost);
-  totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nfd::FaceId, m_faceId);
-
-  totalLength += block.prependVarNumber(totalLength);
-  totalLength += block.prependVarNumber(ndn::tlv::nfd::NextHopRecord);
-  return totalLength;
+  return Schema::encode(block, *this);
 }
 
 NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(NextHopRecord);
@@ -83,44 +90,15 @@ NextHopRecord::wireEncode() const
   if (m_wire.hasWire())
     return m_wire;
 
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
-
-  m_wire = buffer.block();
+  m_wire = Schema::encode(*this);
   return m_wire;
 }
 
 void
 NextHopRecord::wireDecode(const Block& block)
 {
-  if (block.type() != tlv::nfd::NextHopRecord) {
-    NDN_THROW(Error("NextHopRecord", block.type()));
-  }
-
+  Schema::decode(block, *this);
   m_wire = block;
-  m_wire.parse();
-  auto val = m_wire.elements_begin();
-
-  if (val == m_wire.elements_end()) {
-    NDN_THROW(Error("unexpected end of NextHopRecord"));
-  }
-  else if (val->type() != tlv::nfd::FaceId) {
-    NDN_THROW(Error("FaceId", val->type()));
-  }
-  m_faceId = readNonNegativeInteger(*val);
-  ++val;
-
-  if (val == m_wire.elements_end()) {
-    NDN_THROW(Error("unexpected end of NextHopRecord"));
-  }
-  else if (val->type() != tlv::nfd::Cost) {
-    NDN_THROW(Error("Cost", val->type()));
-  }
-  m_cost = readNonNegativeInteger(*val);
-  ++val;
 }
 
 bool
@@ -176,16 +154,7 @@ template<encoding::Tag TAG>
 size_t
 FibEntry::wireEncode(EncodingImpl<TAG>& block) const
 {
-  size_t totalLength = 0;
-
-  for (const auto& nh : m_nextHopRecords | boost::adaptors::reversed) {
-    totalLength += nh.wireEncode(block);
-  }
-  totalLength += m_prefix.wireEncode(block);
-
-  totalLength += block.prependVarNumber(totalLength);
-  totalLength += block.prependVarNumber(tlv::nfd::FibEntry);
-  return totalLength;
+  return Schema::encode(block, *this);
 }
 
 NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(FibEntry);
@@ -196,43 +165,15 @@ FibEntry::wireEncode() const
   if (m_wire.hasWire())
     return m_wire;
 
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
-
-  m_wire = buffer.block();
+  m_wire = Schema::encode(*this);
   return m_wire;
 }
 
 void
 FibEntry::wireDecode(const Block& block)
 {
-  if (block.type() != tlv::nfd::FibEntry) {
-    NDN_THROW(Error("FibEntry", block.type()));
-  }
-
+  Schema::decode(block, *this);
   m_wire = block;
-  m_wire.parse();
-  auto val = m_wire.elements_begin();
-
-  if (val == m_wire.elements_end()) {
-    NDN_THROW(Error("unexpected end of FibEntry"));
-  }
-  else if (val->type() != tlv::Name) {
-    NDN_THROW(Error("Name", val->type()));
-  }
-  m_prefix.wireDecode(*val);
-  ++val;
-
-  m_nextHopRecords.clear();
-  for (; val != m_wire.elements_end(); ++val) {
-    if (val->type() != tlv::nfd::NextHopRecord) {
-      NDN_THROW(Error("NextHopRecord", val->type()));
-    }
-    m_nextHopRecords.emplace_back(*val);
-  }
 }
 
 bool
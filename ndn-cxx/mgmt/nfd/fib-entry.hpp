@@ -74,6 +74,8 @@ public:
   wireDecode(const Block& block);
 
 private:
+  struct Schema;
+
   uint64_t m_faceId;
   uint64_t m_cost;
 
@@ -153,6 +155,8 @@ public:
   wireDecode(const Block& block);
 
 private:
+  struct Schema;
+
   Name m_prefix;
   std::vector<NextHopRecord> m_nextHopRecords;
 
@@ -23,18 +23,33 @@
 #include "ndn-cxx/encoding/block-helpers.hpp"
 #include "ndn-cxx/encoding/encoding-buffer.hpp"
 #include "ndn-cxx/encoding/tlv-nfd.hpp"
+#include "ndn-cxx/encoding/tlv-schema.hpp"
 #include "ndn-cxx/util/concepts.hpp"
 #include "ndn-cxx/util/ostream-joiner.hpp"
 #include "ndn-cxx/util/string-helper.hpp"
 
-#include <boost/range/adaptor/reversed.hpp>
-
 namespace ndn {
 namespace nfd {
 
 BOOST_CONCEPT_ASSERT((StatusDatasetItem<Route>));
 BOOST_CONCEPT_ASSERT((StatusDatasetItem<RibEntry>));
 
+struct Route::Schema : encoding::schema::Schema<tlv::nfd::Route,
+  NDN_CXX_TLV_SCHEMA_FIELD(tlv::nfd::FaceId, NonNegativeIntegerCodec, Required, &Route::m_faceId),
+  NDN_CXX_TLV_SCHEMA_FIELD(tlv::nfd::Origin, NonNegativeIntegerCodec, Required, &Route::m_origin),
+  NDN_CXX_TLV_SCHEMA_FIELD(tlv::nfd::Cost, NonNegativeIntegerCodec, Required, &Route::m_cost),
+  NDN_CXX_TLV_SCHEMA_FIELD(tlv::nfd::Flags, NonNegativeIntegerCodec, Required, &Route::m_flags),
+  NDN_CXX_TLV_SCHEMA_FIELD(tlv::nfd::ExpirationPeriod, NonNegativeIntegerCodec, Optional,
+                           &Route::m_expirationPeriod)>
+{
+};
+
+struct RibEntry::Schema : encoding::schema::Schema<tlv::nfd::RibEntry,
+  NDN_CXX_TLV_SCHEMA_FIELD(tlv::Name, NestedCodec, Required, &RibEntry::m_prefix),
+  NDN_CXX_TLV_SCHEMA_FIELD(tlv::nfd::Route, NestedCodec, Repeated, &RibEntry::m_routes)>
+{
+};
+
 Route::Route()
   : m_faceId(INVALID_FACE_ID)
   , m_origin(ROUTE_ORIGIN_APP)
@@ -103,20 +118,7 @@ template<encoding::Tag TAG>
 size_t
 Route::wireEncode(EncodingImpl<TAG>& block) const
 {
-  size_t totalLength = 0;
-
-  if (m_expirationPeriod) {
-    totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nfd::ExpirationPeriod,
-                                                  static_cast<uint64_t>(m_expirationPeriod->count()));
-  }
-  totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nfd::Flags, m_flags);
-  totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nfd::Cost, m_cost);
-  totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nfd::Origin, m_origin);
-  totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nfd::FaceId, m_faceId);
-
-  totalLength += block.prependVarNumber(totalLength);
-  totalLength += block.prependVarNumber(ndn::tlv::nfd::Route);
-  return totalLength;
+  return Schema::encode(block, *this);
 }
 
 NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(Route);
@@ -127,66 +129,15 @@ Route::wireEncode() const
   if (m_wire.hasWire())
     return m_wire;
 
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
-
-  m_wire = buffer.block();
+  m_wire = Schema::encode(*this);
   return m_wire;
 }
 
 void
 Route::wireDecode(const Block& block)
 {
-  if (block.type() != tlv::nfd::Route) {
-    NDN_THROW(Error("Route", block.type()));
-  }
-
+  Schema::decode(block, *this);
   m_wire = block;
-  m_wire.parse();
-  auto val = m_wire.elements_begin();
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::FaceId) {
-    m_faceId = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required FaceId field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::Origin) {
-    m_origin = readNonNegativeIntegerAs<RouteOrigin>(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required Origin field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::Cost) {
-    m_cost = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required Cost field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::Flags) {
-    m_flags = readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("missing required Flags field"));
-  }
-
-  if (val != m_wire.elements_end() && val->type() == tlv::nfd::ExpirationPeriod) {
-    m_expirationPeriod.emplace(readNonNegativeInteger(*val));
-    ++val;
-  }
-  else {
-    m_expirationPeriod = nullopt;
-  }
 }
 
 bool
@@ -255,16 +206,7 @@ template<encoding::Tag TAG>
 size_t
 RibEntry::wireEncode(EncodingImpl<TAG>& block) const
 {
-  size_t totalLength = 0;
-
-  for (const auto& route : m_routes | boost::adaptors::reversed) {
-    totalLength += route.wireEncode(block);
-  }
-  totalLength += m_prefix.wireEncode(block);
-
-  totalLength += block.prependVarNumber(totalLength);
-  totalLength += block.prependVarNumber(tlv::nfd::RibEntry);
-  return totalLength;
+  return Schema::encode(block, *this);
 }
 
 NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(RibEntry);
@@ -275,43 +217,15 @@ RibEntry::wireEncode() const
   if (m_wire.hasWire())
     return m_wire;
 
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
-
-  m_wire = buffer.block();
+  m_wire = Schema::encode(*this);
   return m_wire;
 }
 
 void
 RibEntry::wireDecode(const Block& block)
 {
-  if (block.type() != tlv::nfd::RibEntry) {
-    NDN_THROW(Error("RibEntry", block.type()));
-  }
-
+  Schema::decode(block, *this);
   m_wire = block;
-  m_wire.parse();
-  auto val = m_wire.elements_begin();
-
-  if (val == m_wire.elements_end()) {
-    NDN_THROW(Error("unexpected end of RibEntry"));
-  }
-  else if (val->type() != tlv::Name) {
-    NDN_THROW(Error("Name", val->type()));
-  }
-  m_prefix.wireDecode(*val);
-  ++val;
-
-  m_routes.clear();
-  for (; val != m_wire.elements_end(); ++val) {
-    if (val->type() != tlv::nfd::Route) {
-      NDN_THROW(Error("Route", val->type()));
-    }
-    m_routes.emplace_back(*val);
-  }
 }
 
 bool
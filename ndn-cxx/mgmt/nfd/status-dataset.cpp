@@ -171,5 +171,81 @@ RibDataset::parseResult(ConstBufferPtr payload) const
   return parseDatasetVector<RibEntry>(std::move(payload));
 }
 
+std::vector<Block>
+StatusDatasetStreamParser::parse(const Block& chunk)
+{
+  std::vector<Block> elements;
+
+  auto pos = chunk.value_begin();
+  const auto end = chunk.value_end();
+  if (!m_partial.empty()) {
+    if (!completePartialElement(pos, end)) {
+      // the element continues in the next chunk
+      return elements;
+    }
+    auto buffer = make_shared<const Buffer>(std::move(m_partial));
+    m_partial.clear();
+    elements.emplace_back(buffer);
+  }
+
+  while (pos != end) {
+    auto elementBegin = pos;
+    uint32_t type = 0;
+    uint64_t length = 0;
+    if (!tlv::readType(pos, end, type) ||
+        !tlv::readVarNumber(pos, end, length) ||
+        length > static_cast<uint64_t>(end - pos)) {
+      m_partial.assign(elementBegin, end);
+      break;
+    }
+
+    pos += length;
+    elements.emplace_back(chunk, elementBegin, pos);
+  }
+
+  return elements;
+}
+
+void
+StatusDatasetStreamParser::finish() const
+{
+  if (!m_partial.empty()) {
+    NDN_THROW(StatusDataset::ParseResultError("cannot decode Block"));
+  }
+}
+
+bool
+StatusDatasetStreamParser::completePartialElement(Buffer::const_iterator& pos,
+                                                  Buffer::const_iterator end)
+{
+  while (true) {
+    // TLV-TYPE and TLV-LENGTH may themselves be split, so grow one byte at a time until
+    // they can be read, then copy the remainder of TLV-VALUE at once
+    size_t nNeeded = 1;
+    auto partialPos = m_partial.cbegin();
+    uint32_t type = 0;
+    uint64_t length = 0;
+    if (tlv::readType(partialPos, m_partial.cend(), type) &&
+        tlv::readVarNumber(partialPos, m_partial.cend(), length)) {
+      size_t headerSize = static_cast<size_t>(partialPos - m_partial.cbegin());
+      if (length > std::numeric_limits<size_t>::max() - headerSize) {
+        NDN_THROW(StatusDataset::ParseResultError("TLV-LENGTH is too large"));
+      }
+      nNeeded = headerSize + static_cast<size_t>(length) - m_partial.size();
+      if (nNeeded == 0) {
+        return true;
+      }
+    }
+
+    if (pos == end) {
+      return false;
+    }
+
+    size_t nCopied = std::min(nNeeded, static_cast<size_t>(end - pos));
+    m_partial.insert(m_partial.end(), pos, pos + nCopied);
+    pos += nCopied;
+  }
+}
+
 } // namespace nfd
 } // namespace ndn
@@ -253,6 +253,45 @@ public:
   parseResult(ConstBufferPtr payload) const;
 };
 
+/**
+ * \ingroup management
+ * \brief splits a dataset payload that arrives in chunks into its top-level elements
+ *
+ * Each chunk is a Block whose TLV-VALUE is the next part of the payload, such as the Content
+ * element of a segment. It is scanned in place: elements entirely contained in a chunk share
+ * its buffer.
+ * An element that spans chunk boundaries is accumulated until its last byte arrives.
+ */
+class StatusDatasetStreamParser
+{
+public:
+  /**
+   * \brief parses the next chunk of payload
+   * \return elements whose encoding ends within \p chunk, in payload order
+   */
+  std::vector<Block>
+  parse(const Block& chunk);
+
+  /**
+   * \brief indicates the end of payload
+   * \throw StatusDataset::ParseResultError payload ends with an incomplete element
+   */
+  void
+  finish() const;
+
+private:
+  /**
+   * \brief appends bytes in [\p pos, \p end) to the partial element until it is complete
+   * \param[in,out] pos advanced past the consumed bytes
+   * \return whether the partial element is now complete
+   */
+  bool
+  completePartialElement(Buffer::const_iterator& pos, Buffer::const_iterator end);
+
+private:
+  Buffer m_partial;
+};
+
 } // namespace nfd
 } // namespace ndn
 
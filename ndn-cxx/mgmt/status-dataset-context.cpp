@@ -73,6 +73,9 @@ StatusDatasetContext::append(const Block& block)
   }
 
   m_state = State::RESPONDED;
+  if (m_appendedBlocks != nullptr) {
+    m_appendedBlocks->push_back(block);
+  }
 
   size_t nBytesLeft = block.size();
   while (nBytesLeft > 0) {
@@ -108,6 +108,8 @@ private:
   NackSender m_nackSender;
   Name m_prefix;
   time::milliseconds m_expiry;
+  // if not null, appended blocks are also collected here
+  std::vector<Block>* m_appendedBlocks = nullptr;
 
 NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   shared_ptr<EncodingBuffer> m_buffer;
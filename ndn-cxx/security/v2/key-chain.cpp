@@ -456,7 +456,14 @@ KeyChain::sign(Data& data, const SigningInfo& params)
 
   data.setSignature(Signature(sigInfo));
 
-  EncodingBuffer encoder;
+  // two-pass encoding: size the buffer for the unsigned portion, plus room for SignatureValue
+  // at the back and for TLV-TYPE and TLV-LENGTH in front, so that encoding never reallocates
+  EncodingEstimator estimator;
+  size_t unsignedSize = data.wireEncode(estimator, true);
+  const size_t backReserve = 400;
+  const size_t frontReserve = tlv::sizeOfVarNumber(tlv::Data) +
+                              tlv::sizeOfVarNumber(unsignedSize + backReserve);
+  EncodingBuffer encoder(frontReserve + unsignedSize + backReserve, backReserve);
   data.wireEncode(encoder, true);
 
   Block sigValue = sign(encoder.buf(), encoder.size(), keyName, params.getDigestAlgorithm());
@@ -0,0 +1,400 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/transport/datagram-transport.hpp"
+#include "ndn-cxx/encoding/tlv.hpp"
+#include "ndn-cxx/util/logger.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+#include <array>
+#include <deque>
+#include <sys/socket.h>
+
+NDN_LOG_INIT(ndn.DatagramTransport);
+// DEBUG level: connect, close, pause, resume, dropped datagrams.
+
+namespace ndn {
+
+constexpr size_t DatagramTransport::MAX_BATCH_SIZE;
+
+#ifdef __linux__
+using MessageHeader = mmsghdr;
+#else
+struct MessageHeader
+{
+  msghdr msg_hdr;
+  unsigned int msg_len;
+};
+#endif // __linux__
+
+/** \brief send up to \p nMessages datagrams
+ *  \return number of datagrams sent, or -1 with errno set
+ */
+static int
+sendBatch(int fd, MessageHeader* messages, unsigned int nMessages)
+{
+#ifdef __linux__
+  return ::sendmmsg(fd, messages, nMessages, 0);
+#else
+  for (unsigned int i = 0; i < nMessages; ++i) {
+    ssize_t nSent = ::sendmsg(fd, &messages[i].msg_hdr, 0);
+    if (nSent < 0) {
+      return i > 0 ? static_cast<int>(i) : -1;
+    }
+    messages[i].msg_len = static_cast<unsigned int>(nSent);
+  }
+  return static_cast<int>(nMessages);
+#endif // __linux__
+}
+
+/** \brief receive up to \p nMessages datagrams without blocking
+ *  \return number of datagrams received, or -1 with errno set
+ */
+static int
+receiveBatch(int fd, MessageHeader* messages, unsigned int nMessages)
+{
+#ifdef __linux__
+  return ::recvmmsg(fd, messages, nMessages, MSG_DONTWAIT, nullptr);
+#else
+  for (unsigned int i = 0; i < nMessages; ++i) {
+    ssize_t nRead = ::recvmsg(fd, &messages[i].msg_hdr, MSG_DONTWAIT);
+    if (nRead < 0) {
+      return i > 0 ? static_cast<int>(i) : -1;
+    }
+    messages[i].msg_len = static_cast<unsigned int>(nRead);
+    if (nRead == 0) {
+      return static_cast<int>(i + 1);
+    }
+  }
+  return static_cast<int>(nMessages);
+#endif // __linux__
+}
+
+static bool
+isTransientError(int error)
+{
+  // ECONNREFUSED reports an ICMP port unreachable caused by an earlier datagram
+  return error == EAGAIN || error == EWOULDBLOCK || error == EINTR || error == ECONNREFUSED;
+}
+
+class DatagramTransport::Impl : public std::enable_shared_from_this<Impl>
+{
+public:
+  Impl(DatagramTransport& transport, boost::asio::io_service& ioService)
+    : m_transport(transport)
+    , m_ioService(ioService)
+    , m_socket(ioService)
+    , m_receiveBuffer(MAX_BATCH_SIZE * MAX_NDN_PACKET_SIZE)
+  {
+  }
+
+  void
+  open()
+  {
+    m_transport.openSocket(m_socket);
+
+    boost::system::error_code error;
+    m_socket.non_blocking(true, error);
+    if (error) {
+      close();
+      NDN_THROW(Error(error, "cannot set socket to non-blocking mode"));
+    }
+    m_transport.m_isConnected = true;
+  }
+
+  void
+  close()
+  {
+    boost::system::error_code error; // to silently ignore all errors
+    m_socket.cancel(error);
+    m_socket.close(error);
+
+    m_transport.m_isConnected = false;
+    m_transport.m_isReceiving = false;
+    m_sendQueue.clear();
+    m_transport.m_counters.nQueuedPackets.set(0);
+  }
+
+  void
+  pause()
+  {
+    // a pending wait is not cancelled, handleReadable ignores it
+    m_transport.m_isReceiving = false;
+  }
+
+  void
+  resume()
+  {
+    if (!m_transport.m_isReceiving) {
+      m_transport.m_isReceiving = true;
+      asyncWaitReadable();
+    }
+  }
+
+  void
+  send(const Block& header, const Block& payload)
+  {
+    m_sendQueue.emplace_back(header, payload);
+    m_transport.m_counters.nQueuedPackets.set(m_sendQueue.size());
+    if (m_sendQueue.size() == 1 && !m_isWaitingWritable) {
+      // let other packets queue up during the current handler, then send them together
+      m_ioService.post([self = shared_from_this()] {
+        if (!self->m_isWaitingWritable) {
+          self->flushSendQueue();
+        }
+      });
+    }
+  }
+
+private:
+  void
+  asyncWaitReadable()
+  {
+    if (m_isWaitingReadable) {
+      return;
+    }
+    m_isWaitingReadable = true;
+
+    auto handler = [self = shared_from_this()] (const boost::system::error_code& error) {
+      self->m_isWaitingReadable = false;
+      if (error == boost::asio::error::operation_aborted || !self->m_socket.is_open()) {
+        return;
+      }
+      if (error) {
+        self->m_transport.close();
+        NDN_THROW(Error(error, "error while receiving data from socket"));
+      }
+      self->handleReadable();
+    };
+
+#if BOOST_VERSION >= 106600
+    m_socket.async_wait(boost::asio::socket_base::wait_read, std::move(handler));
+#else
+    m_socket.async_receive(boost::asio::null_buffers(),
+                           [h = std::move(handler)] (const boost::system::error_code& ec, size_t) { h(ec); });
+#endif
+  }
+
+  void
+  asyncWaitWritable()
+  {
+    m_isWaitingWritable = true;
+
+    auto handler = [self = shared_from_this()] (const boost::system::error_code& error) {
+      self->m_isWaitingWritable = false;
+      if (error == boost::asio::error::operation_aborted || !self->m_socket.is_open()) {
+        return;
+      }
+      if (error) {
+        self->m_transport.close();
+        NDN_THROW(Error(error, "error while sending data to socket"));
+      }
+      self->flushSendQueue();
+    };
+
+#if BOOST_VERSION >= 106600
+    m_socket.async_wait(boost::asio::socket_base::wait_write, std::move(handler));
+#else
+    m_socket.async_send(boost::asio::null_buffers(),
+                        [h = std::move(handler)] (const boost::system::error_code& ec, size_t) { h(ec); });
+#endif
+  }
+
+  void
+  handleReadable()
+  {
+    std::array<MessageHeader, MAX_BATCH_SIZE> messages;
+    std::array<iovec, MAX_BATCH_SIZE> iovecs;
+
+    // bounded, so that a flood of incoming datagrams cannot starve other handlers
+    for (int nRounds = 0; nRounds < 4 && m_transport.m_isReceiving; ++nRounds) {
+      for (size_t i = 0; i < MAX_BATCH_SIZE; ++i) {
+        iovecs[i].iov_base = &m_receiveBuffer[i * MAX_NDN_PACKET_SIZE];
+        iovecs[i].iov_len = MAX_NDN_PACKET_SIZE;
+        messages[i] = {};
+        messages[i].msg_hdr.msg_iov = &iovecs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+      }
+
+      int nReceived = receiveBatch(m_socket.native_handle(), messages.data(), MAX_BATCH_SIZE);
+      if (nReceived < 0) {
+        if (isTransientError(errno)) {
+          break;
+        }
+        auto error = boost::system::error_code(errno, boost::system::system_category());
+        m_transport.close();
+        NDN_THROW(Error(error, "error while receiving data from socket"));
+      }
+
+      for (int i = 0; i < nReceived && m_transport.m_isReceiving; ++i) {
+        processDatagram(static_cast<const uint8_t*>(iovecs[i].iov_base), messages[i].msg_len,
+                        messages[i].msg_hdr.msg_flags);
+      }
+
+      if (static_cast<size_t>(nReceived) < MAX_BATCH_SIZE) {
+        break;
+      }
+    }
+
+    if (m_transport.m_isReceiving) {
+      asyncWaitReadable();
+    }
+  }
+
+  void
+  processDatagram(const uint8_t* buffer, size_t size, int flags)
+  {
+    if (size == 0 && m_transport.isConnectionOriented()) {
+      m_transport.close();
+      NDN_THROW(Error(boost::system::error_code(), "connection closed by the forwarder"));
+    }
+
+    if ((flags & MSG_TRUNC) != 0) {
+      NDN_LOG_DEBUG("dropped truncated datagram");
+      return;
+    }
+
+    bool isOk = false;
+    Block element;
+    std::tie(isOk, element) = Block::fromBuffer(buffer, size);
+    if (!isOk || element.size() != size) {
+      NDN_LOG_DEBUG("dropped malformed datagram of " << size << " octets");
+      return;
+    }
+
+    m_transport.receive(element);
+  }
+
+  void
+  flushSendQueue()
+  {
+    std::array<MessageHeader, MAX_BATCH_SIZE> messages;
+    std::array<std::array<iovec, 2>, MAX_BATCH_SIZE> iovecs;
+
+    while (!m_sendQueue.empty() && m_socket.is_open()) {
+      size_t nMessages = std::min(m_sendQueue.size(), MAX_BATCH_SIZE);
+      for (size_t i = 0; i < nMessages; ++i) {
+        const Block& header = m_sendQueue[i].first;
+        const Block& payload = m_sendQueue[i].second;
+        size_t nIovecs = 0;
+        if (header.isValid()) {
+          iovecs[i][nIovecs++] = {const_cast<uint8_t*>(header.wire()), header.size()};
+        }
+        iovecs[i][nIovecs++] = {const_cast<uint8_t*>(payload.wire()), payload.size()};
+        messages[i] = {};
+        messages[i].msg_hdr.msg_iov = iovecs[i].data();
+        messages[i].msg_hdr.msg_iovlen = nIovecs;
+      }
+
+      int nSent = sendBatch(m_socket.native_handle(), messages.data(), static_cast<unsigned int>(nMessages));
+      if (nSent < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+          asyncWaitWritable();
+          return;
+        }
+        if (isTransientError(errno)) {
+          continue;
+        }
+        auto error = boost::system::error_code(errno, boost::system::system_category());
+        m_transport.close();
+        NDN_THROW(Error(error, "error while sending data to socket"));
+      }
+
+      for (int i = 0; i < nSent; ++i) {
+        m_transport.m_counters.nOutBytes += messages[i].msg_len;
+      }
+      m_transport.m_counters.nOutPackets += nSent;
+      m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + nSent);
+      m_transport.m_counters.nQueuedPackets.set(m_sendQueue.size());
+    }
+  }
+
+private:
+  DatagramTransport& m_transport;
+  boost::asio::io_service& m_ioService;
+  boost::asio::generic::datagram_protocol::socket m_socket;
+  std::vector<uint8_t> m_receiveBuffer;
+  std::deque<std::pair<Block, Block>> m_sendQueue;
+  bool m_isWaitingReadable = false;
+  bool m_isWaitingWritable = false;
+};
+
+DatagramTransport::DatagramTransport() = default;
+
+DatagramTransport::~DatagramTransport() = default;
+
+void
+DatagramTransport::connect(boost::asio::io_service& ioService,
+                           const ReceiveCallback& receiveCallback)
+{
+  NDN_LOG_DEBUG("connect");
+
+  if (m_impl == nullptr) {
+    Transport::connect(ioService, receiveCallback);
+
+    auto impl = make_shared<Impl>(*this, ioService);
+    impl->open();
+    m_impl = std::move(impl);
+  }
+}
+
+void
+DatagramTransport::close()
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  NDN_LOG_DEBUG("close");
+  m_impl->close();
+  m_impl.reset();
+}
+
+void
+DatagramTransport::pause()
+{
+  if (m_impl != nullptr) {
+    NDN_LOG_DEBUG("pause");
+    m_impl->pause();
+  }
+}
+
+void
+DatagramTransport::resume()
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  NDN_LOG_DEBUG("resume");
+  m_impl->resume();
+}
+
+void
+DatagramTransport::send(const Block& wire)
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  m_impl->send(Block(), wire);
+}
+
+void
+DatagramTransport::send(const Block& header, const Block& payload)
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  m_impl->send(header, payload);
+}
+
+} // namespace ndn
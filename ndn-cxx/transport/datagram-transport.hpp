@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TRANSPORT_DATAGRAM_TRANSPORT_HPP
+#define NDN_TRANSPORT_DATAGRAM_TRANSPORT_HPP
+
+#include "ndn-cxx/transport/transport.hpp"
+
+#include <boost/asio/generic/datagram_protocol.hpp>
+
+namespace ndn {
+
+/** \brief base class of transports that carry one packet per datagram
+ *
+ *  There is no reassembly buffer: each received datagram must contain exactly one TLV element,
+ *  otherwise it is dropped. Outgoing packets are queued and sent in batches at the end of the
+ *  current io_service handler, with one sendmmsg call per batch. Incoming datagrams are read with
+ *  recvmmsg, up to MAX_BATCH_SIZE per call. Other platforms fall back to one system call per packet.
+ *
+ *  A subclass opens and connects the socket in openSocket().
+ */
+class DatagramTransport : public Transport
+{
+public:
+  /** \brief maximum number of datagrams sent or received with one system call
+   */
+  static constexpr size_t MAX_BATCH_SIZE = 32;
+
+  ~DatagramTransport() override;
+
+  /** \throw Transport::Error the socket cannot be opened or connected
+   */
+  void
+  connect(boost::asio::io_service& ioService,
+          const ReceiveCallback& receiveCallback) override;
+
+  void
+  close() override;
+
+  void
+  pause() override;
+
+  void
+  resume() override;
+
+  void
+  send(const Block& wire) override;
+
+  void
+  send(const Block& header, const Block& payload) override;
+
+protected:
+  DatagramTransport();
+
+  /** \brief open \p socket and connect it to the forwarder
+   *  \throw Transport::Error
+   */
+  virtual void
+  openSocket(boost::asio::generic::datagram_protocol::socket& socket) = 0;
+
+  /** \brief whether the socket is connection-oriented, so that an empty read means that the
+   *         forwarder has closed the connection
+   */
+  virtual bool
+  isConnectionOriented() const = 0;
+
+private:
+  class Impl;
+  shared_ptr<Impl> m_impl;
+};
+
+} // namespace ndn
+
+#endif // NDN_TRANSPORT_DATAGRAM_TRANSPORT_HPP
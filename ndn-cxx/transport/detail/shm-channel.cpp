@@ -0,0 +1,449 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifdef __linux__
+
+#include "ndn-cxx/transport/detail/shm-channel.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ndn {
+namespace detail {
+
+const char HANDSHAKE_MAGIC[8] = {'N', 'D', 'N', 'S', 'H', 'M', '\x01', '\x00'};
+
+static boost::system::error_code
+getErrno()
+{
+  return boost::system::error_code(errno, boost::system::system_category());
+}
+
+static size_t
+roundUpToPowerOfTwo(size_t n)
+{
+  size_t capacity = 4096;
+  while (capacity < n) {
+    capacity <<= 1;
+  }
+  return capacity;
+}
+
+shared_ptr<ShmChannel>
+ShmChannel::create(boost::asio::io_service& ioService, size_t ringCapacity)
+{
+  size_t capacity = roundUpToPowerOfTwo(ringCapacity);
+  size_t mappingSize = 2 * ShmRing::computeSize(capacity);
+
+  int memoryFd = ::memfd_create("ndn-cxx-shm-transport", MFD_CLOEXEC);
+  if (memoryFd < 0) {
+    NDN_THROW(Error(getErrno(), "cannot create shared memory"));
+  }
+  if (::ftruncate(memoryFd, static_cast<off_t>(mappingSize)) < 0) {
+    auto error = getErrno();
+    ::close(memoryFd);
+    NDN_THROW(Error(error, "cannot resize shared memory"));
+  }
+
+  int clientEventFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  int serverEventFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (clientEventFd < 0 || serverEventFd < 0) {
+    auto error = getErrno();
+    ::close(memoryFd);
+    if (clientEventFd >= 0)
+      ::close(clientEventFd);
+    if (serverEventFd >= 0)
+      ::close(serverEventFd);
+    NDN_THROW(Error(error, "cannot create eventfd"));
+  }
+
+  // the constructor takes ownership of the file descriptors
+  shared_ptr<ShmChannel> channel(new ShmChannel(ioService, memoryFd, mappingSize,
+                                                clientEventFd, serverEventFd, true));
+  return channel;
+}
+
+shared_ptr<ShmChannel>
+ShmChannel::open(boost::asio::io_service& ioService, int memoryFd, int clientEventFd, int serverEventFd)
+{
+  struct stat st;
+  if (::fstat(memoryFd, &st) < 0 || st.st_size <= 0) {
+    auto error = getErrno();
+    ::close(memoryFd);
+    ::close(clientEventFd);
+    ::close(serverEventFd);
+    NDN_THROW(Error(error, "invalid shared memory"));
+  }
+
+  int flags = ::fcntl(serverEventFd, F_GETFL);
+  if (flags >= 0) {
+    ::fcntl(serverEventFd, F_SETFL, flags | O_NONBLOCK);
+  }
+
+  shared_ptr<ShmChannel> channel(new ShmChannel(ioService, memoryFd, static_cast<size_t>(st.st_size),
+                                                serverEventFd, clientEventFd, false));
+  return channel;
+}
+
+ShmChannel::ShmChannel(boost::asio::io_service& ioService, int memoryFd, size_t mappingSize,
+                       int localEventFd, int remoteEventFd, bool isClient)
+  : m_ioService(ioService)
+  , m_memoryFd(memoryFd)
+  , m_memory(MAP_FAILED)
+  , m_mappingSize(mappingSize)
+  , m_localEventFd(ioService, localEventFd)
+  , m_localEventFdNum(localEventFd)
+  , m_remoteEventFd(remoteEventFd)
+  , m_eventValue(0)
+  , m_isReceiving(false)
+  , m_isWaiting(false)
+  , m_isClosed(false)
+{
+  m_memory = ::mmap(nullptr, m_mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_memoryFd, 0);
+  if (m_memory == MAP_FAILED) {
+    auto error = getErrno();
+    close();
+    NDN_THROW(Error(error, "cannot map shared memory"));
+  }
+
+  try {
+    auto base = static_cast<uint8_t*>(m_memory);
+    if (isClient) {
+      size_t ringSize = m_mappingSize / 2;
+      ShmRing::initialize(base, ringSize - ShmRing::computeSize(0));
+      ShmRing::initialize(base + ringSize, ringSize - ShmRing::computeSize(0));
+    }
+
+    auto first = make_unique<ShmRing>(base, m_mappingSize);
+    size_t firstSize = ShmRing::computeSize(first->getCapacity());
+    auto second = make_unique<ShmRing>(base + firstSize, m_mappingSize - firstSize);
+
+    // the first ring carries packets from the client to the server
+    if (isClient) {
+      m_sendRing = std::move(first);
+      m_receiveRing = std::move(second);
+    }
+    else {
+      m_sendRing = std::move(second);
+      m_receiveRing = std::move(first);
+    }
+  }
+  catch (const std::invalid_argument& e) {
+    close();
+    NDN_THROW_NESTED(Error(e.what()));
+  }
+}
+
+ShmChannel::~ShmChannel()
+{
+  close();
+}
+
+void
+ShmChannel::sendHandshake(int socketFd, const ShmChannel& channel)
+{
+  auto fds = channel.getFileDescriptors();
+
+  iovec iov;
+  iov.iov_base = const_cast<char*>(HANDSHAKE_MAGIC);
+  iov.iov_len = sizeof(HANDSHAKE_MAGIC);
+
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fds))] = {};
+  msghdr msg = {};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+  std::memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(fds));
+
+  if (::sendmsg(socketFd, &msg, MSG_NOSIGNAL) != static_cast<ssize_t>(sizeof(HANDSHAKE_MAGIC))) {
+    NDN_THROW(Error(getErrno(), "cannot send shared-memory handshake"));
+  }
+}
+
+shared_ptr<ShmChannel>
+ShmChannel::acceptHandshake(boost::asio::io_service& ioService, int socketFd)
+{
+  char magic[sizeof(HANDSHAKE_MAGIC)] = {};
+  iovec iov;
+  iov.iov_base = magic;
+  iov.iov_len = sizeof(magic);
+
+  std::array<int, 3> fds;
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fds))] = {};
+  msghdr msg = {};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  ssize_t nRead = ::recvmsg(socketFd, &msg, MSG_CMSG_CLOEXEC);
+  if (nRead < 0) {
+    NDN_THROW(Error(getErrno(), "cannot receive shared-memory handshake"));
+  }
+
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  bool hasFds = cmsg != nullptr && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS;
+  size_t nFds = hasFds ? (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int) : 0;
+  if (nFds > 0) {
+    std::memcpy(fds.data(), CMSG_DATA(cmsg), std::min(nFds, fds.size()) * sizeof(int));
+  }
+
+  if (nRead != static_cast<ssize_t>(sizeof(magic)) ||
+      std::memcmp(magic, HANDSHAKE_MAGIC, sizeof(magic)) != 0 ||
+      nFds != fds.size() || (msg.msg_flags & MSG_CTRUNC) != 0) {
+    for (size_t i = 0; i < std::min(nFds, fds.size()); ++i) {
+      ::close(fds[i]);
+    }
+    NDN_THROW(Error("invalid shared-memory handshake"));
+  }
+
+  return open(ioService, fds[0], fds[1], fds[2]);
+}
+
+void
+ShmChannel::start(const ReceiveCallback& receiveCallback)
+{
+  BOOST_ASSERT(receiveCallback != nullptr);
+  m_receiveCallback = receiveCallback;
+  resume();
+}
+
+void
+ShmChannel::pause()
+{
+  m_isReceiving = false;
+}
+
+void
+ShmChannel::resume()
+{
+  if (m_isClosed || m_isReceiving) {
+    return;
+  }
+
+  m_isReceiving = true;
+  if (m_isWaiting) {
+    // the receive ring was not armed while paused; handleEvent will do it
+    boost::system::error_code error;
+    m_localEventFd.cancel(error);
+  }
+  else {
+    asyncWait();
+  }
+}
+
+void
+ShmChannel::close()
+{
+  if (m_isClosed) {
+    return;
+  }
+  m_isClosed = true;
+  m_isReceiving = false;
+  m_sendQueue.clear();
+
+  boost::system::error_code error; // to silently ignore all errors
+  m_localEventFd.cancel(error);
+  m_localEventFd.close(error);
+  ::close(m_remoteEventFd);
+
+  m_sendRing.reset();
+  m_receiveRing.reset();
+  if (m_memory != MAP_FAILED) {
+    ::munmap(m_memory, m_mappingSize);
+  }
+  ::close(m_memoryFd);
+}
+
+void
+ShmChannel::send(const Block& wire)
+{
+  send(Block(), wire);
+}
+
+void
+ShmChannel::send(const Block& header, const Block& payload)
+{
+  BOOST_ASSERT(!m_isClosed);
+
+  size_t size = (header.isValid() ? header.size() : 0) + payload.size();
+  if (size > m_sendRing->getMaxRecordSize()) {
+    NDN_THROW(Error("Packet size (" + to_string(size) + ") exceeds the shared-memory ring limit (" +
+                    to_string(m_sendRing->getMaxRecordSize()) + ")"));
+  }
+
+  if (m_sendQueue.empty() && tryWrite(header, payload)) {
+    if (m_sendRing->needWakeReader()) {
+      wakePeer();
+    }
+    return;
+  }
+
+  m_sendQueue.emplace_back(header, payload);
+  if (!m_isWaiting) {
+    asyncWait();
+  }
+}
+
+bool
+ShmChannel::tryWrite(const Block& header, const Block& payload)
+{
+  if (header.isValid()) {
+    return m_sendRing->tryWrite(header.wire(), header.size(), payload.wire(), payload.size());
+  }
+  return m_sendRing->tryWrite(payload.wire(), payload.size());
+}
+
+void
+ShmChannel::asyncWait()
+{
+  BOOST_ASSERT(!m_isWaiting);
+  if (m_isClosed) {
+    return;
+  }
+
+  bool hasWork = false;
+  if (m_isReceiving && m_receiveRing->prepareReaderWait()) {
+    hasWork = true;
+  }
+  if (!m_sendQueue.empty()) {
+    const auto& next = m_sendQueue.front();
+    size_t size = (next.first.isValid() ? next.first.size() : 0) + next.second.size();
+    if (m_sendRing->prepareWriterWait(size)) {
+      hasWork = true;
+    }
+  }
+
+  m_isWaiting = true;
+  if (hasWork) {
+    // yield to other handlers instead of looping here
+    m_ioService.post([self = shared_from_this()] { self->handleEvent({}); });
+  }
+  else {
+    m_localEventFd.async_read_some(boost::asio::buffer(&m_eventValue, sizeof(m_eventValue)),
+      [self = shared_from_this()] (const boost::system::error_code& error, size_t) {
+        self->handleEvent(error);
+      });
+  }
+}
+
+void
+ShmChannel::handleEvent(const boost::system::error_code& error)
+{
+  m_isWaiting = false;
+  if (m_isClosed) {
+    return;
+  }
+
+  // operation_aborted means that resume() cancelled the wait
+  if (error && error != boost::asio::error::operation_aborted) {
+    close();
+    NDN_THROW(Error(error, "error while waiting for the shared-memory peer"));
+  }
+
+  processReceived();
+  if (m_isClosed) {
+    return;
+  }
+  flushQueue();
+  asyncWait();
+}
+
+void
+ShmChannel::processReceived()
+{
+  bool hasRead = false;
+  while (m_isReceiving) {
+    std::pair<const uint8_t*, size_t> record;
+    try {
+      record = m_receiveRing->peek();
+    }
+    catch (const ShmRing::Error& e) {
+      close();
+      NDN_THROW_NESTED(Error(e.what()));
+    }
+    if (record.first == nullptr) {
+      break;
+    }
+
+    bool isOk = false;
+    Block element;
+    std::tie(isOk, element) = Block::fromBuffer(record.first, record.second);
+    m_receiveRing->pop();
+    hasRead = true;
+    if (!isOk || element.size() != record.second) {
+      close();
+      NDN_THROW(Error("Received malformed packet from the shared-memory peer"));
+    }
+
+    m_receiveCallback(element);
+    if (m_isClosed) {
+      return;
+    }
+  }
+
+  if (hasRead && m_receiveRing->needWakeWriter()) {
+    wakePeer();
+  }
+}
+
+bool
+ShmChannel::flushQueue()
+{
+  bool hasWritten = false;
+  while (!m_sendQueue.empty() && tryWrite(m_sendQueue.front().first, m_sendQueue.front().second)) {
+    m_sendQueue.pop_front();
+    hasWritten = true;
+  }
+
+  if (hasWritten && m_sendRing->needWakeReader()) {
+    wakePeer();
+  }
+  return m_sendQueue.empty();
+}
+
+void
+ShmChannel::wakePeer()
+{
+  uint64_t value = 1;
+  // the eventfd counter cannot realistically overflow, so the write does not fail
+  ssize_t nWritten = ::write(m_remoteEventFd, &value, sizeof(value));
+  BOOST_ASSERT(nWritten == sizeof(value));
+  (void)nWritten;
+}
+
+} // namespace detail
+} // namespace ndn
+
+#endif // __linux__
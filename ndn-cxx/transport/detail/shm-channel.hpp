@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TRANSPORT_DETAIL_SHM_CHANNEL_HPP
+#define NDN_TRANSPORT_DETAIL_SHM_CHANNEL_HPP
+#ifdef __linux__
+
+#include "ndn-cxx/transport/transport.hpp"
+#include "ndn-cxx/transport/detail/shm-ring.hpp"
+
+#include <boost/asio/posix/stream_descriptor.hpp>
+
+#include <array>
+#include <deque>
+
+namespace ndn {
+namespace detail {
+
+/** \brief one end of a bidirectional packet channel over shared memory
+ *
+ *  A channel consists of a memfd holding two ShmRing, one per direction, and two eventfds used
+ *  to wake up the client and the server end respectively. The client end creates all three file
+ *  descriptors and passes them to the server end, typically over a Unix socket with SCM_RIGHTS.
+ *
+ *  Sending a packet copies it into the ring, and signals the peer's eventfd only if the peer is
+ *  waiting. Received packets are delivered in batches whenever the local eventfd is signaled.
+ */
+class ShmChannel : public std::enable_shared_from_this<ShmChannel>, noncopyable
+{
+public:
+  using Error = Transport::Error;
+  using ReceiveCallback = Transport::ReceiveCallback;
+
+  /** \brief Create the client end of a new channel
+   *  \param ringCapacity capacity of each ring, rounded up to a power of two
+   *  \throw Error the shared memory or the eventfds cannot be created
+   */
+  static shared_ptr<ShmChannel>
+  create(boost::asio::io_service& ioService, size_t ringCapacity);
+
+  /** \brief Open the server end of a channel created by the client
+   *  \param memoryFd the memfd holding the rings
+   *  \param clientEventFd the eventfd that wakes the client end
+   *  \param serverEventFd the eventfd that wakes the server end
+   *  \note The channel takes ownership of the file descriptors, even if an exception is thrown.
+   *  \throw Error the file descriptors do not describe a valid channel
+   */
+  static shared_ptr<ShmChannel>
+  open(boost::asio::io_service& ioService, int memoryFd, int clientEventFd, int serverEventFd);
+
+  /** \brief Pass the file descriptors of a client end to the server over a connected Unix socket
+   *  \throw Error the message cannot be sent
+   */
+  static void
+  sendHandshake(int socketFd, const ShmChannel& channel);
+
+  /** \brief Receive the file descriptors sent by sendHandshake() and open the server end
+   *  \pre \p socketFd is readable
+   *  \throw Error the message cannot be received or is not a valid handshake
+   */
+  static shared_ptr<ShmChannel>
+  acceptHandshake(boost::asio::io_service& ioService, int socketFd);
+
+  ~ShmChannel();
+
+  /** \return file descriptors to pass to the server end: memfd, client eventfd, server eventfd
+   *  \pre this is a client end
+   */
+  std::array<int, 3>
+  getFileDescriptors() const
+  {
+    return {m_memoryFd, m_localEventFdNum, m_remoteEventFd};
+  }
+
+  /** \brief Start delivering received packets to \p receiveCallback
+   */
+  void
+  start(const ReceiveCallback& receiveCallback);
+
+  void
+  pause();
+
+  void
+  resume();
+
+  /** \brief Release the shared memory and the eventfds
+   *  \post no callback will be invoked
+   */
+  void
+  close();
+
+  void
+  send(const Block& wire);
+
+  /** \throw Error the packet is larger than the maximum record size of the ring
+   */
+  void
+  send(const Block& header, const Block& payload);
+
+  bool
+  isReceiving() const
+  {
+    return m_isReceiving;
+  }
+
+private:
+  ShmChannel(boost::asio::io_service& ioService, int memoryFd, size_t mappingSize,
+             int localEventFd, int remoteEventFd, bool isClient);
+
+  /** \brief wait for the local eventfd, unless there is work to do right away
+   */
+  void
+  asyncWait();
+
+  void
+  handleEvent(const boost::system::error_code& error);
+
+  /** \brief deliver all packets in the receive ring
+   */
+  void
+  processReceived();
+
+  /** \brief move as many queued packets as possible into the send ring
+   *  \retval true the queue is empty
+   */
+  bool
+  flushQueue();
+
+  bool
+  tryWrite(const Block& header, const Block& payload);
+
+  void
+  wakePeer();
+
+private:
+  boost::asio::io_service& m_ioService;
+  int m_memoryFd;
+  void* m_memory;
+  size_t m_mappingSize;
+  unique_ptr<ShmRing> m_sendRing;
+  unique_ptr<ShmRing> m_receiveRing;
+  boost::asio::posix::stream_descriptor m_localEventFd;
+  int m_localEventFdNum;
+  int m_remoteEventFd;
+  uint64_t m_eventValue;
+
+  std::deque<std::pair<Block, Block>> m_sendQueue; ///< packets that did not fit into the send ring
+  ReceiveCallback m_receiveCallback;
+  bool m_isReceiving;
+  bool m_isWaiting;
+  bool m_isClosed;
+};
+
+} // namespace detail
+} // namespace ndn
+
+#endif // __linux__
+#endif // NDN_TRANSPORT_DETAIL_SHM_CHANNEL_HPP
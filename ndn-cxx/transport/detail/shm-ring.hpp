@@ -0,0 +1,283 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TRANSPORT_DETAIL_SHM_RING_HPP
+#define NDN_TRANSPORT_DETAIL_SHM_RING_HPP
+
+#include "ndn-cxx/detail/common.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <new>
+
+namespace ndn {
+namespace detail {
+
+/** \brief single-producer single-consumer ring of variable-size records in shared memory
+ *
+ *  The ring occupies a caller-provided memory region of computeSize(capacity) octets, which may
+ *  be mapped by two processes at different addresses. Each record is an 8-octet header carrying
+ *  the record length, followed by the record octets padded to a multiple of 8. A record never
+ *  wraps around the end of the ring, so that the consumer can read it in place.
+ *
+ *  The producer and the consumer can each announce that they are about to sleep; the other side
+ *  checks these flags with needWakeReader() and needWakeWriter() after publishing new records or
+ *  releasing space, and wakes up the sleeper through an out-of-band mechanism such as an eventfd.
+ */
+class ShmRing
+{
+private:
+  struct Header
+  {
+    alignas(64) std::atomic<uint64_t> head; ///< consumer position
+    alignas(64) std::atomic<uint64_t> tail; ///< producer position
+    alignas(64) std::atomic<uint32_t> isReaderWaiting;
+    std::atomic<uint32_t> isWriterWaiting;
+    uint64_t capacity;
+  };
+
+  static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+                "ShmRing requires address-free atomics");
+
+  static constexpr uint32_t WRAP_MARKER = 0xFFFFFFFF;
+  static constexpr size_t RECORD_HEADER_SIZE = 8;
+
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /** \return size of the memory region needed for a ring of \p capacity octets
+   */
+  static constexpr size_t
+  computeSize(size_t capacity)
+  {
+    return sizeof(Header) + capacity;
+  }
+
+  /** \brief Construct an empty ring in \p memory
+   *  \pre capacity is a power of two and at least 64
+   */
+  static void
+  initialize(void* memory, size_t capacity)
+  {
+    BOOST_ASSERT(capacity >= 64 && (capacity & (capacity - 1)) == 0);
+    auto header = new (memory) Header;
+    header->head.store(0, std::memory_order_relaxed);
+    header->tail.store(0, std::memory_order_relaxed);
+    header->isReaderWaiting.store(0, std::memory_order_relaxed);
+    header->isWriterWaiting.store(0, std::memory_order_relaxed);
+    header->capacity = capacity;
+  }
+
+  /** \brief Attach to a ring previously constructed with initialize()
+   *  \param memory the memory region
+   *  \param size size of the memory region, used to validate the ring capacity
+   *  \throw std::invalid_argument the region does not contain a valid ring
+   */
+  ShmRing(void* memory, size_t size)
+    : m_header(static_cast<Header*>(memory))
+    , m_data(static_cast<uint8_t*>(memory) + sizeof(Header))
+    , m_capacity(validateCapacity(memory, size))
+    , m_head(m_header->head.load(std::memory_order_acquire))
+    , m_tail(m_header->tail.load(std::memory_order_acquire))
+  {
+  }
+
+  size_t
+  getCapacity() const
+  {
+    return m_capacity;
+  }
+
+  /** \return maximum size of a record
+   */
+  size_t
+  getMaxRecordSize() const
+  {
+    return m_capacity / 2 - RECORD_HEADER_SIZE;
+  }
+
+public: // producer
+  /** \brief Append a record made of the concatenation of two buffers
+   *  \retval false not enough space in the ring
+   *  \pre len1 + len2 <= getMaxRecordSize()
+   */
+  bool
+  tryWrite(const uint8_t* buf1, size_t len1, const uint8_t* buf2 = nullptr, size_t len2 = 0)
+  {
+    size_t len = len1 + len2;
+    BOOST_ASSERT(len <= getMaxRecordSize());
+    size_t recordSize = RECORD_HEADER_SIZE + align(len);
+
+    if (!hasSpace(m_header->head.load(std::memory_order_acquire), recordSize)) {
+      return false;
+    }
+
+    size_t index = m_tail & (m_capacity - 1);
+    size_t toEnd = m_capacity - index;
+    if (recordSize > toEnd) {
+      writeLength(index, WRAP_MARKER);
+      m_tail += toEnd;
+      index = 0;
+    }
+
+    writeLength(index, static_cast<uint32_t>(len));
+    std::memcpy(m_data + index + RECORD_HEADER_SIZE, buf1, len1);
+    if (len2 > 0) {
+      std::memcpy(m_data + index + RECORD_HEADER_SIZE + len1, buf2, len2);
+    }
+    m_tail += recordSize;
+    m_header->tail.store(m_tail, std::memory_order_seq_cst);
+    return true;
+  }
+
+  /** \brief Announce that the producer waits for free space
+   *  \retval true the consumer has released space meanwhile, the producer should retry instead of waiting
+   */
+  bool
+  prepareWriterWait(size_t len)
+  {
+    m_header->isWriterWaiting.store(1, std::memory_order_seq_cst);
+    return hasSpace(m_header->head.load(std::memory_order_seq_cst), RECORD_HEADER_SIZE + align(len));
+  }
+
+  /** \brief Check, after writing, whether the consumer needs to be woken up
+   */
+  bool
+  needWakeReader()
+  {
+    return m_header->isReaderWaiting.load(std::memory_order_seq_cst) != 0 &&
+           m_header->isReaderWaiting.exchange(0, std::memory_order_seq_cst) != 0;
+  }
+
+public: // consumer
+  /** \brief Get the oldest record without removing it
+   *  \return pointer to and size of the record, or nullptr if the ring is empty
+   *  \throw Error the producer has written a malformed record
+   */
+  std::pair<const uint8_t*, size_t>
+  peek()
+  {
+    uint64_t tail = m_header->tail.load(std::memory_order_acquire);
+    while (m_head != tail) {
+      size_t index = m_head & (m_capacity - 1);
+      uint32_t len = readLength(index);
+      if (len != WRAP_MARKER) {
+        if (len > m_capacity - index - RECORD_HEADER_SIZE) {
+          NDN_THROW(Error("Malformed ShmRing record"));
+        }
+        m_peekedSize = len;
+        return {m_data + index + RECORD_HEADER_SIZE, len};
+      }
+      m_head += m_capacity - index;
+      m_header->head.store(m_head, std::memory_order_seq_cst);
+    }
+    return {nullptr, 0};
+  }
+
+  /** \brief Remove the record returned by peek()
+   */
+  void
+  pop()
+  {
+    m_head += RECORD_HEADER_SIZE + align(m_peekedSize);
+    m_header->head.store(m_head, std::memory_order_seq_cst);
+  }
+
+  /** \brief Announce that the consumer is about to sleep
+   *  \retval true records have arrived meanwhile, the consumer should read them instead of sleeping
+   */
+  bool
+  prepareReaderWait()
+  {
+    m_header->isReaderWaiting.store(1, std::memory_order_seq_cst);
+    return m_header->tail.load(std::memory_order_seq_cst) != m_head;
+  }
+
+  /** \brief Check, after reading, whether the producer needs to be woken up
+   */
+  bool
+  needWakeWriter()
+  {
+    return m_header->isWriterWaiting.load(std::memory_order_seq_cst) != 0 &&
+           m_header->isWriterWaiting.exchange(0, std::memory_order_seq_cst) != 0;
+  }
+
+private:
+  static size_t
+  validateCapacity(void* memory, size_t size)
+  {
+    if (size < sizeof(Header)) {
+      NDN_THROW(std::invalid_argument("ShmRing memory region is too small"));
+    }
+    size_t capacity = static_cast<Header*>(memory)->capacity;
+    if (capacity < 64 || (capacity & (capacity - 1)) != 0 || size - sizeof(Header) < capacity) {
+      NDN_THROW(std::invalid_argument("Invalid ShmRing capacity"));
+    }
+    return capacity;
+  }
+
+  static constexpr size_t
+  align(size_t len)
+  {
+    return (len + RECORD_HEADER_SIZE - 1) & ~(RECORD_HEADER_SIZE - 1);
+  }
+
+  /** \brief whether a record of \p recordSize octets fits, including the skipped tail of the ring
+   */
+  bool
+  hasSpace(uint64_t head, size_t recordSize) const
+  {
+    size_t toEnd = m_capacity - (m_tail & (m_capacity - 1));
+    size_t needed = recordSize <= toEnd ? recordSize : toEnd + recordSize;
+    return m_capacity - (m_tail - head) >= needed;
+  }
+
+  uint32_t
+  readLength(size_t index) const
+  {
+    uint32_t len;
+    std::memcpy(&len, m_data + index, sizeof(len));
+    return len;
+  }
+
+  void
+  writeLength(size_t index, uint32_t len)
+  {
+    std::memcpy(m_data + index, &len, sizeof(len));
+  }
+
+private:
+  Header* m_header;
+  uint8_t* m_data;
+  const size_t m_capacity;
+  uint64_t m_head; ///< consumer-local copy of head
+  uint64_t m_tail; ///< producer-local copy of tail
+  size_t m_peekedSize = 0;
+};
+
+} // namespace detail
+} // namespace ndn
+
+#endif // NDN_TRANSPORT_DETAIL_SHM_RING_HPP
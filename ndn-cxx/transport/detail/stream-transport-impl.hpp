@@ -28,6 +28,7 @@
 #include <boost/asio/write.hpp>
 
 #include <list>
+#include <vector>
 
 namespace ndn {
 namespace detail {
@@ -45,10 +46,24 @@ public:
   typedef std::list<Block> BlockSequence;
   typedef std::list<BlockSequence> TransmissionQueue;
 
+  /** \brief size of the input buffer, enough for several packets per receive
+   */
+  static constexpr size_t INPUT_BUFFER_SIZE = 8 * MAX_NDN_PACKET_SIZE;
+
+  /** \brief maximum number of receive calls per completion handler
+   *
+   *  After an asynchronous receive completes, the socket is drained with up to this many
+   *  non-blocking receive calls before waiting again, so that a burst of packets is handled
+   *  without going through the io_service for every buffer fill.
+   */
+  static constexpr size_t MAX_RECEIVE_BATCH = 16;
+
   StreamTransportImpl(BaseTransport& transport, boost::asio::io_service& ioService)
     : m_transport(transport)
     , m_socket(ioService)
+    , m_inputBuffer(INPUT_BUFFER_SIZE)
     , m_inputBufferSize(0)
+    , m_hasPendingReceive(false)
     , m_isConnecting(false)
     , m_connectTimer(ioService)
   {
@@ -87,6 +102,7 @@ public:
     m_transport.m_isConnected = false;
     m_transport.m_isReceiving = false;
     m_transmissionQueue.clear();
+    m_transport.m_counters.nQueuedPackets.set(0);
   }
 
   void
@@ -140,6 +156,9 @@ protected:
 
     if (!error) {
       m_transport.m_isConnected = true;
+      // for the receive calls that drain the socket after each completion
+      boost::system::error_code ignored;
+      m_socket.non_blocking(true, ignored);
 
       if (!m_transmissionQueue.empty()) {
         resume();
@@ -166,7 +185,8 @@ protected:
   void
   send(BlockSequence&& sequence)
   {
-    m_transmissionQueue.emplace_back(sequence);
+    m_transmissionQueue.push_back(std::move(sequence));
+    m_transport.m_counters.nQueuedPackets.set(m_transmissionQueue.size());
 
     if (m_transport.m_isConnected && m_transmissionQueue.size() == 1) {
       asyncWrite();
@@ -176,16 +196,24 @@ protected:
     // next write will be scheduled either in connectHandler or in asyncWriteHandler
   }
 
+  /** \brief write every queued block sequence with a single gather write
+   */
   void
   asyncWrite()
   {
     BOOST_ASSERT(!m_transmissionQueue.empty());
-    boost::asio::async_write(m_socket, m_transmissionQueue.front(),
-      bind(&Impl::handleAsyncWrite, this->shared_from_this(), _1, m_transmissionQueue.begin()));
+    std::vector<boost::asio::const_buffer> buffers;
+    for (const auto& sequence : m_transmissionQueue) {
+      for (const auto& block : sequence) {
+        buffers.emplace_back(block.wire(), block.size());
+      }
+    }
+    boost::asio::async_write(m_socket, buffers,
+      bind(&Impl::handleAsyncWrite, this->shared_from_this(), _1, m_transmissionQueue.size()));
   }
 
   void
-  handleAsyncWrite(const boost::system::error_code& error, TransmissionQueue::iterator queueItem)
+  handleAsyncWrite(const boost::system::error_code& error, size_t nWritten)
   {
     if (error) {
       if (error == boost::system::errc::operation_canceled) {
@@ -201,7 +229,16 @@ protected:
       return; // queue has been already cleared
     }
 
-    m_transmissionQueue.erase(queueItem);
+    BOOST_ASSERT(nWritten <= m_transmissionQueue.size());
+    auto writtenEnd = std::next(m_transmissionQueue.begin(), nWritten);
+    for (auto it = m_transmissionQueue.begin(); it != writtenEnd; ++it) {
+      for (const auto& block : *it) {
+        m_transport.m_counters.nOutBytes += block.size();
+      }
+    }
+    m_transport.m_counters.nOutPackets += nWritten;
+    m_transmissionQueue.erase(m_transmissionQueue.begin(), writtenEnd);
+    m_transport.m_counters.nQueuedPackets.set(m_transmissionQueue.size());
 
     if (!m_transmissionQueue.empty()) {
       asyncWrite();
@@ -211,17 +248,28 @@ protected:
   void
   asyncReceive()
   {
-    m_socket.async_receive(boost::asio::buffer(m_inputBuffer + m_inputBufferSize,
-                                               MAX_NDN_PACKET_SIZE - m_inputBufferSize), 0,
+    if (m_hasPendingReceive) {
+      return;
+    }
+
+    m_hasPendingReceive = true;
+    m_socket.async_receive(boost::asio::buffer(m_inputBuffer.data() + m_inputBufferSize,
+                                               INPUT_BUFFER_SIZE - m_inputBufferSize), 0,
                            bind(&Impl::handleAsyncReceive, this->shared_from_this(), _1, _2));
   }
 
   void
   handleAsyncReceive(const boost::system::error_code& error, std::size_t nBytesRecvd)
   {
+    m_hasPendingReceive = false;
+
     if (error) {
       if (error == boost::system::errc::operation_canceled) {
-        // async receive has been explicitly cancelled (e.g., socket close)
+        // async receive has been explicitly cancelled (e.g., socket close or pause)
+        if (m_transport.m_isReceiving) {
+          // resumed before the cancellation was delivered
+          asyncReceive();
+        }
         return;
       }
 
@@ -230,11 +278,36 @@ protected:
     }
 
     m_inputBufferSize += nBytesRecvd;
-    // do magic
+    processInputBuffer();
+
+    for (size_t nReceives = 1; nReceives < MAX_RECEIVE_BATCH && m_transport.m_isReceiving; ++nReceives) {
+      boost::system::error_code receiveError;
+      std::size_t nBytes = m_socket.receive(boost::asio::buffer(m_inputBuffer.data() + m_inputBufferSize,
+                                                                INPUT_BUFFER_SIZE - m_inputBufferSize),
+                                            0, receiveError);
+      if (receiveError) {
+        // would_block: the socket has been drained;
+        // any other error will be reported by the next asynchronous receive
+        break;
+      }
 
+      m_inputBufferSize += nBytes;
+      processInputBuffer();
+    }
+
+    if (m_transport.m_isReceiving) {
+      asyncReceive();
+    }
+  }
+
+  /** \brief deliver all complete packets in the input buffer and move the remainder to the front
+   */
+  void
+  processInputBuffer()
+  {
     std::size_t offset = 0;
-    bool hasProcessedSome = processAllReceived(m_inputBuffer, offset, m_inputBufferSize);
-    if (!hasProcessedSome && m_inputBufferSize == MAX_NDN_PACKET_SIZE && offset == 0) {
+    bool hasProcessedSome = processAllReceived(m_inputBuffer.data(), offset, m_inputBufferSize);
+    if (!hasProcessedSome && offset == 0 && m_inputBufferSize >= MAX_NDN_PACKET_SIZE) {
       m_transport.close();
       NDN_THROW(Transport::Error(boost::system::error_code(),
                                  "input buffer full, but a valid TLV cannot be decoded"));
@@ -242,21 +315,37 @@ protected:
 
     if (offset > 0) {
       if (offset != m_inputBufferSize) {
-        std::copy(m_inputBuffer + offset, m_inputBuffer + m_inputBufferSize, m_inputBuffer);
+        std::copy(m_inputBuffer.begin() + offset, m_inputBuffer.begin() + m_inputBufferSize,
+                  m_inputBuffer.begin());
         m_inputBufferSize -= offset;
       }
       else {
         m_inputBufferSize = 0;
       }
     }
-
-    asyncReceive();
   }
 
+  /** \brief deliver the complete elements starting at \p offset, and advance \p offset past them
+   *  \retval false the buffer ends with an incomplete element
+   *  \throw Transport::Error an element is larger than MAX_NDN_PACKET_SIZE
+   */
   bool
   processAllReceived(uint8_t* buffer, size_t& offset, size_t nBytesAvailable)
   {
     while (offset < nBytesAvailable) {
+      // check the declared size before decoding, so that an oversized element is rejected
+      // regardless of whether it arrives in one read or in several
+      const uint8_t* pos = buffer + offset;
+      const uint8_t* end = buffer + nBytesAvailable;
+      uint32_t type = 0;
+      uint64_t length = 0;
+      if (tlv::readType(pos, end, type) && tlv::readVarNumber(pos, end, length) &&
+          length > MAX_NDN_PACKET_SIZE - static_cast<size_t>(pos - (buffer + offset))) {
+        m_transport.close();
+        NDN_THROW(Transport::Error(boost::system::error_code(),
+                                   "received element is larger than MAX_NDN_PACKET_SIZE"));
+      }
+
       bool isOk = false;
       Block element;
       std::tie(isOk, element) = Block::fromBuffer(buffer + offset, nBytesAvailable - offset);
@@ -273,8 +362,9 @@ protected:
   BaseTransport& m_transport;
 
   typename Protocol::socket m_socket;
-  uint8_t m_inputBuffer[MAX_NDN_PACKET_SIZE];
+  std::vector<uint8_t> m_inputBuffer;
   size_t m_inputBufferSize;
+  bool m_hasPendingReceive;
 
   TransmissionQueue m_transmissionQueue;
   bool m_isConnecting;
@@ -0,0 +1,259 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/transport/multi-transport.hpp"
+#include "ndn-cxx/transport/tcp-transport.hpp"
+#include "ndn-cxx/transport/unix-transport.hpp"
+#include "ndn-cxx/encoding/tlv.hpp"
+#include "ndn-cxx/lp/tlv.hpp"
+#include "ndn-cxx/net/face-uri.hpp"
+#include "ndn-cxx/util/logger.hpp"
+
+NDN_LOG_INIT(ndn.MultiTransport);
+
+namespace ndn {
+
+constexpr size_t MultiTransport::MAX_INTEREST_ORIGINS;
+
+/** \brief the network layer packet carried in \p wire, which may be an LpPacket
+ *  \return the packet, or an invalid Block if \p wire carries no packet
+ */
+static Block
+getNetworkPacket(const Block& wire, bool& isNack)
+{
+  isNack = false;
+  if (wire.type() != lp::tlv::LpPacket) {
+    return wire;
+  }
+
+  wire.parse();
+  auto fragment = wire.find(lp::tlv::Fragment);
+  if (fragment == wire.elements_end() || fragment->value_size() == 0) {
+    return {};
+  }
+  isNack = wire.find(lp::tlv::Nack) != wire.elements_end();
+  return Block(wire.getBuffer(), fragment->value_begin(), fragment->value_end());
+}
+
+/** \return the Name of Interest or Data \p packet, or an empty Name if it has none
+ */
+static Name
+getPacketName(const Block& packet)
+{
+  packet.parse();
+  auto name = packet.find(tlv::Name);
+  if (name == packet.elements_end()) {
+    return {};
+  }
+  return Name(*name);
+}
+
+MultiTransport::MultiTransport(std::vector<shared_ptr<Transport>> transports)
+  : m_transports(std::move(transports))
+{
+  if (m_transports.empty()) {
+    NDN_THROW(Error("MultiTransport requires at least one transport"));
+  }
+}
+
+shared_ptr<MultiTransport>
+MultiTransport::create(const std::string& uri, size_t nTransports)
+{
+  std::string scheme = "unix";
+  if (!uri.empty()) {
+    try {
+      scheme = FaceUri(uri).getScheme();
+    }
+    catch (const FaceUri::Error& error) {
+      NDN_THROW_NESTED(Error(error.what()));
+    }
+  }
+
+  std::vector<shared_ptr<Transport>> transports;
+  for (size_t i = 0; i < nTransports; ++i) {
+    if (scheme == "unix") {
+      transports.push_back(UnixTransport::create(uri));
+    }
+    else if (scheme == "tcp" || scheme == "tcp4" || scheme == "tcp6") {
+      transports.push_back(TcpTransport::create(uri));
+    }
+    else {
+      NDN_THROW(Error("Cannot create MultiTransport from \"" + scheme + "\" URI"));
+    }
+  }
+  return make_shared<MultiTransport>(std::move(transports));
+}
+
+void
+MultiTransport::connect(boost::asio::io_service& ioService,
+                        const ReceiveCallback& receiveCallback)
+{
+  NDN_LOG_DEBUG("connect nTransports=" << m_transports.size());
+  Transport::connect(ioService, receiveCallback);
+
+  for (size_t i = 0; i < m_transports.size(); ++i) {
+    ensureConnected(i);
+  }
+  m_isConnected = true;
+}
+
+void
+MultiTransport::close()
+{
+  NDN_LOG_DEBUG("close");
+  for (const auto& transport : m_transports) {
+    if (transport->isConnected()) {
+      transport->close();
+    }
+  }
+  m_interestOrigins.clear();
+  m_interestOriginOrder.clear();
+  m_isConnected = false;
+  m_isReceiving = false;
+}
+
+void
+MultiTransport::pause()
+{
+  for (const auto& transport : m_transports) {
+    if (transport->isConnected()) {
+      transport->pause();
+    }
+  }
+  m_isReceiving = false;
+}
+
+void
+MultiTransport::resume()
+{
+  BOOST_ASSERT(m_isConnected);
+  for (size_t i = 0; i < m_transports.size(); ++i) {
+    ensureConnected(i);
+    m_transports[i]->resume();
+  }
+  m_isReceiving = true;
+}
+
+void
+MultiTransport::send(const Block& wire)
+{
+  size_t index = selectTransport(wire);
+  ensureConnected(index);
+  if (m_isReceiving && !m_transports[index]->isReceiving()) {
+    m_transports[index]->resume();
+  }
+  m_transports[index]->send(wire);
+  ++m_counters.nOutPackets;
+  m_counters.nOutBytes += wire.size();
+}
+
+void
+MultiTransport::send(const Block& header, const Block& payload)
+{
+  size_t index = selectTransport(payload);
+  ensureConnected(index);
+  if (m_isReceiving && !m_transports[index]->isReceiving()) {
+    m_transports[index]->resume();
+  }
+  m_transports[index]->send(header, payload);
+  ++m_counters.nOutPackets;
+  m_counters.nOutBytes += header.size() + payload.size();
+}
+
+size_t
+MultiTransport::selectTransport(const Block& wire)
+{
+  if (m_transports.size() == 1) {
+    return 0;
+  }
+
+  bool isNack = false;
+  Block packet = getNetworkPacket(wire, isNack);
+  if (!packet.isValid()) {
+    // LpPacket without fragment, e.g., an idle packet
+    return 0;
+  }
+
+  Name name = getPacketName(packet);
+  if (packet.type() == tlv::Interest && !isNack) {
+    return std::hash<Name>()(name) % m_transports.size();
+  }
+
+  // Data or Nack: reply on the connection that delivered the Interest
+  // (Data name may be longer than the Interest name)
+  for (ssize_t prefixLen = name.size(); prefixLen >= 0; --prefixLen) {
+    auto it = m_interestOrigins.find(name.getPrefix(prefixLen));
+    if (it != m_interestOrigins.end()) {
+      size_t index = it->second.index;
+      m_interestOriginOrder.erase(it->second.orderIt);
+      m_interestOrigins.erase(it);
+      return index;
+    }
+    if (isNack) {
+      break;
+    }
+  }
+  return std::hash<Name>()(name) % m_transports.size();
+}
+
+void
+MultiTransport::ensureConnected(size_t index)
+{
+  auto& transport = *m_transports[index];
+  if (!transport.isConnected()) {
+    transport.connect(*m_ioService, [this, index] (const Block& wire) { receive(index, wire); });
+  }
+}
+
+void
+MultiTransport::receive(size_t index, const Block& wire)
+{
+  if (m_transports.size() > 1) {
+    bool isNack = false;
+    Block packet = getNetworkPacket(wire, isNack);
+    if (packet.isValid() && packet.type() == tlv::Interest && !isNack) {
+      rememberInterestOrigin(getPacketName(packet), index);
+    }
+  }
+
+  Transport::receive(wire);
+}
+
+void
+MultiTransport::rememberInterestOrigin(const Name& name, size_t index)
+{
+  auto it = m_interestOrigins.find(name);
+  if (it != m_interestOrigins.end()) {
+    it->second.index = index;
+    m_interestOriginOrder.splice(m_interestOriginOrder.end(), m_interestOriginOrder,
+                                 it->second.orderIt);
+    return;
+  }
+
+  auto orderIt = m_interestOriginOrder.insert(m_interestOriginOrder.end(), name);
+  m_interestOrigins.emplace(name, InterestOrigin{index, orderIt});
+  if (m_interestOriginOrder.size() > MAX_INTEREST_ORIGINS) {
+    m_interestOrigins.erase(m_interestOriginOrder.front());
+    m_interestOriginOrder.pop_front();
+  }
+}
+
+} // namespace ndn
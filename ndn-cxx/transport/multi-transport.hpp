@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TRANSPORT_MULTI_TRANSPORT_HPP
+#define NDN_TRANSPORT_MULTI_TRANSPORT_HPP
+
+#include "ndn-cxx/transport/transport.hpp"
+#include "ndn-cxx/name.hpp"
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace ndn {
+
+/** \brief a transport that stripes packets across several connections to the forwarder
+ *
+ *  Each outgoing Interest is sent on the connection selected by a hash of its name, so that
+ *  packets of one application are spread over several sockets and receive loops. The forwarder
+ *  returns Data and Nacks on the connection of the Interest.
+ *
+ *  Data and Nacks sent by the application go out on the connection that delivered the matching
+ *  Interest, because the forwarder only accepts them there. Data that answers no recently received
+ *  Interest is striped by name as well.
+ *
+ *  \note All connections are served by the io_service of the Face.
+ *  \note The forwarder delivers Interests for a registered prefix on the connection that carried
+ *        the registration command.
+ */
+class MultiTransport : public Transport
+{
+public:
+  /** \brief maximum number of received Interests whose connection is remembered
+   */
+  static constexpr size_t MAX_INTEREST_ORIGINS = 65536;
+
+  /** \throw Transport::Error \p transports is empty
+   */
+  explicit
+  MultiTransport(std::vector<shared_ptr<Transport>> transports);
+
+  void
+  connect(boost::asio::io_service& ioService,
+          const ReceiveCallback& receiveCallback) override;
+
+  void
+  close() override;
+
+  void
+  pause() override;
+
+  void
+  resume() override;
+
+  void
+  send(const Block& wire) override;
+
+  void
+  send(const Block& header, const Block& payload) override;
+
+  size_t
+  getNTransports() const
+  {
+    return m_transports.size();
+  }
+
+  /** \brief Create \p nTransports connections to the forwarder at \p uri
+   *  \param uri a unix:// or tcp:// URI, as accepted by UnixTransport::create and TcpTransport::create
+   *  \throw Transport::Error incorrect URI or unsupported protocol is specified
+   */
+  static shared_ptr<MultiTransport>
+  create(const std::string& uri, size_t nTransports);
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** \brief select the connection to send \p wire on
+   */
+  size_t
+  selectTransport(const Block& wire);
+
+private:
+  void
+  ensureConnected(size_t index);
+
+  void
+  receive(size_t index, const Block& wire);
+
+  void
+  rememberInterestOrigin(const Name& name, size_t index);
+
+private:
+  struct InterestOrigin
+  {
+    size_t index;
+    std::list<Name>::iterator orderIt;
+  };
+
+  std::vector<shared_ptr<Transport>> m_transports;
+  std::unordered_map<Name, InterestOrigin> m_interestOrigins;
+  std::list<Name> m_interestOriginOrder; ///< oldest first
+};
+
+} // namespace ndn
+
+#endif // NDN_TRANSPORT_MULTI_TRANSPORT_HPP
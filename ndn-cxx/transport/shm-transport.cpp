@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifdef __linux__
+
+#include "ndn-cxx/transport/shm-transport.hpp"
+#include "ndn-cxx/transport/detail/shm-channel.hpp"
+#include "ndn-cxx/net/face-uri.hpp"
+#include "ndn-cxx/util/logger.hpp"
+#include "ndn-cxx/util/impl/steady-timer.hpp"
+
+NDN_LOG_INIT(ndn.ShmTransport);
+// DEBUG level: connect, close, pause, resume.
+
+namespace ndn {
+
+constexpr size_t ShmTransport::DEFAULT_RING_CAPACITY;
+constexpr time::nanoseconds ShmTransport::CONNECT_TIMEOUT;
+
+ShmTransport::ShmTransport(const std::string& unixSocket, size_t ringCapacity)
+  : m_unixSocket(unixSocket)
+  , m_ringCapacity(ringCapacity)
+  , m_ack(make_shared<uint8_t>(0))
+{
+}
+
+ShmTransport::~ShmTransport()
+{
+  if (m_socket != nullptr) {
+    close();
+  }
+}
+
+shared_ptr<ShmTransport>
+ShmTransport::create(const std::string& uriString)
+{
+  std::string path = "/var/run/nfd.sock";
+  if (!uriString.empty()) {
+    try {
+      const FaceUri uri(uriString);
+      if (uri.getScheme() != "unix") {
+        NDN_THROW(Error("Cannot create ShmTransport from \"" + uri.getScheme() + "\" URI"));
+      }
+      if (!uri.getPath().empty()) {
+        path = uri.getPath();
+      }
+    }
+    catch (const FaceUri::Error& error) {
+      NDN_THROW_NESTED(Error(error.what()));
+    }
+  }
+  return make_shared<ShmTransport>(path);
+}
+
+void
+ShmTransport::connect(boost::asio::io_service& ioService,
+                      const ReceiveCallback& receiveCallback)
+{
+  if (m_socket != nullptr) {
+    // connection or handshake in progress
+    return;
+  }
+
+  NDN_LOG_DEBUG("connect path=" << m_unixSocket);
+  Transport::connect(ioService, receiveCallback);
+
+  // packets sent before the handshake completes are held in the rings
+  m_channel = detail::ShmChannel::create(ioService, m_ringCapacity);
+  m_socket = make_shared<boost::asio::local::stream_protocol::socket>(ioService);
+
+  m_connectTimer = make_unique<util::detail::SteadyTimer>(ioService);
+  m_connectTimer->expires_from_now(CONNECT_TIMEOUT);
+  m_connectTimer->async_wait([this] (const boost::system::error_code& error) {
+    if (error) { // e.g., cancelled timer, the transport may be gone already
+      return;
+    }
+
+    close();
+    NDN_THROW(Error(error, "error while connecting to the forwarder"));
+  });
+
+  m_socket->async_connect(boost::asio::local::stream_protocol::endpoint(m_unixSocket),
+    [this, socket = m_socket] (const boost::system::error_code& error) {
+      if (error == boost::asio::error::operation_aborted) {
+        // closed, the transport may be gone already
+        return;
+      }
+      connectHandler(error);
+    });
+}
+
+void
+ShmTransport::connectHandler(const boost::system::error_code& error)
+{
+  if (error) {
+    close();
+    NDN_THROW(Error(error, "error while connecting to the forwarder"));
+  }
+
+  try {
+    detail::ShmChannel::sendHandshake(m_socket->native_handle(), *m_channel);
+  }
+  catch (const Error&) {
+    close();
+    throw;
+  }
+  asyncReceiveAck();
+}
+
+void
+ShmTransport::asyncReceiveAck()
+{
+  m_socket->async_receive(boost::asio::buffer(m_ack.get(), 1),
+    [this, socket = m_socket, ack = m_ack] (const boost::system::error_code& error, size_t nRead) {
+      if (error == boost::asio::error::operation_aborted) {
+        // closed, the transport may be gone already
+        return;
+      }
+
+      if (error || nRead == 0) {
+        bool wasConnected = m_isConnected;
+        close();
+        NDN_THROW(Error(error, wasConnected ? "connection closed by the forwarder" :
+                                              "forwarder does not support shared-memory transport"));
+      }
+
+      if (!m_isConnected) {
+        m_connectTimer->cancel();
+        m_isConnected = true;
+      }
+      // keep reading to detect that the forwarder goes away
+      asyncReceiveAck();
+    });
+}
+
+void
+ShmTransport::close()
+{
+  NDN_LOG_DEBUG("close");
+
+  if (m_connectTimer != nullptr) {
+    boost::system::error_code error;
+    m_connectTimer->cancel(error);
+  }
+  if (m_socket != nullptr) {
+    boost::system::error_code error; // to silently ignore all errors
+    m_socket->cancel(error);
+    m_socket->close(error);
+    m_socket.reset();
+  }
+  if (m_channel != nullptr) {
+    m_channel->close();
+    m_channel.reset();
+  }
+
+  m_isConnected = false;
+  m_isReceiving = false;
+}
+
+void
+ShmTransport::pause()
+{
+  if (m_channel != nullptr) {
+    NDN_LOG_DEBUG("pause");
+    m_channel->pause();
+  }
+  m_isReceiving = false;
+}
+
+void
+ShmTransport::resume()
+{
+  BOOST_ASSERT(m_channel != nullptr);
+  NDN_LOG_DEBUG("resume");
+  m_channel->start([this] (const Block& wire) { receive(wire); });
+  m_isReceiving = true;
+}
+
+void
+ShmTransport::send(const Block& wire)
+{
+  BOOST_ASSERT(m_channel != nullptr);
+  m_channel->send(wire);
+  ++m_counters.nOutPackets;
+  m_counters.nOutBytes += wire.size();
+}
+
+void
+ShmTransport::send(const Block& header, const Block& payload)
+{
+  BOOST_ASSERT(m_channel != nullptr);
+  m_channel->send(header, payload);
+  ++m_counters.nOutPackets;
+  m_counters.nOutBytes += header.size() + payload.size();
+}
+
+} // namespace ndn
+
+#endif // __linux__
@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TRANSPORT_SHM_TRANSPORT_HPP
+#define NDN_TRANSPORT_SHM_TRANSPORT_HPP
+#ifdef __linux__
+
+#include "ndn-cxx/transport/transport.hpp"
+#include "ndn-cxx/util/time.hpp"
+
+#include <boost/asio/local/stream_protocol.hpp>
+
+namespace ndn {
+
+namespace detail {
+class ShmChannel;
+} // namespace detail
+
+namespace util {
+namespace detail {
+class SteadyTimer;
+} // namespace detail
+} // namespace util
+
+/** \brief a transport that exchanges packets with a local forwarder through shared memory
+ *
+ *  The transport connects to the forwarder's Unix socket and passes it a memfd holding a pair of
+ *  single-producer single-consumer rings, plus two eventfds for wakeups (see detail::ShmChannel).
+ *  Afterwards, packets are copied into and out of the rings without a system call, except to wake
+ *  up a peer that is waiting. The Unix socket stays open only to detect that the forwarder is gone.
+ *
+ *  The forwarder acknowledges the handshake by sending one octet on the Unix socket. A forwarder
+ *  that does not support shared-memory transport closes the connection instead, in which case an
+ *  exception is thrown from the io_service. Like the other stream transports, the transport
+ *  connects asynchronously, and an exception is also thrown from the io_service if the Unix socket
+ *  cannot be connected or the handshake is not acknowledged within CONNECT_TIMEOUT.
+ */
+class ShmTransport : public Transport
+{
+public:
+  /** \brief default capacity of each ring, in octets
+   */
+  static constexpr size_t DEFAULT_RING_CAPACITY = 1 << 20;
+
+  /** \brief how long to wait for the connection and the acknowledgement of the handshake
+   */
+  static constexpr time::nanoseconds CONNECT_TIMEOUT = time::seconds(4);
+
+  explicit
+  ShmTransport(const std::string& unixSocket, size_t ringCapacity = DEFAULT_RING_CAPACITY);
+
+  ~ShmTransport() override;
+
+  void
+  connect(boost::asio::io_service& ioService,
+          const ReceiveCallback& receiveCallback) override;
+
+  void
+  close() override;
+
+  void
+  pause() override;
+
+  void
+  resume() override;
+
+  void
+  send(const Block& wire) override;
+
+  void
+  send(const Block& header, const Block& payload) override;
+
+  /** \brief Create transport with parameters defined in URI
+   *  \param uri a unix:// URI of the forwarder's socket, as accepted by UnixTransport::create
+   *  \throw Transport::Error incorrect URI or unsupported protocol is specified
+   */
+  static shared_ptr<ShmTransport>
+  create(const std::string& uri);
+
+private:
+  void
+  connectHandler(const boost::system::error_code& error);
+
+  void
+  asyncReceiveAck();
+
+private:
+  std::string m_unixSocket;
+  size_t m_ringCapacity;
+  shared_ptr<boost::asio::local::stream_protocol::socket> m_socket;
+  shared_ptr<detail::ShmChannel> m_channel;
+  shared_ptr<uint8_t> m_ack;
+  unique_ptr<util::detail::SteadyTimer> m_connectTimer;
+};
+
+} // namespace ndn
+
+#endif // __linux__
+#endif // NDN_TRANSPORT_SHM_TRANSPORT_HPP
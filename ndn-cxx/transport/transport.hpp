@@ -25,11 +25,27 @@
 #include "ndn-cxx/detail/asio-fwd.hpp"
 #include "ndn-cxx/detail/common.hpp"
 #include "ndn-cxx/encoding/block.hpp"
+#include "ndn-cxx/util/counter.hpp"
 
 #include <boost/system/error_code.hpp>
 
 namespace ndn {
 
+/** \brief counters of a Transport
+ *
+ *  The counters are updated by the thread that runs the transport's io_service,
+ *  and may be read from any thread.
+ */
+class TransportCounters : noncopyable
+{
+public:
+  util::Counter nInPackets;  ///< TLV elements delivered to the receive callback
+  util::Counter nInBytes;    ///< octets of TLV elements delivered to the receive callback
+  util::Counter nOutPackets; ///< TLV elements written to the socket
+  util::Counter nOutBytes;   ///< octets of TLV elements written to the socket
+  util::Counter nQueuedPackets; ///< current number of TLV elements waiting to be written
+};
+
 /** \brief provides TLV-block delivery service
  */
 class Transport : noncopyable
@@ -105,6 +121,12 @@ public:
   bool
   isReceiving() const;
 
+  const TransportCounters&
+  getCounters() const
+  {
+    return m_counters;
+  }
+
 protected:
   /** \brief invoke the receive callback
    */
@@ -116,6 +138,7 @@ protected:
   bool m_isConnected;
   bool m_isReceiving;
   ReceiveCallback m_receiveCallback;
+  TransportCounters m_counters;
 };
 
 inline bool
@@ -133,6 +156,8 @@ Transport::isReceiving() const
 inline void
 Transport::receive(const Block& wire)
 {
+  ++m_counters.nInPackets;
+  m_counters.nInBytes += wire.size();
   m_receiveCallback(wire);
 }
 
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/transport/udp-transport.hpp"
+#include "ndn-cxx/net/face-uri.hpp"
+#include "ndn-cxx/util/logger.hpp"
+
+#include <boost/asio/ip/udp.hpp>
+
+NDN_LOG_INIT(ndn.UdpTransport);
+
+namespace ndn {
+
+UdpTransport::UdpTransport(const std::string& host, const std::string& port/* = "6363"*/)
+  : m_host(host)
+  , m_port(port)
+{
+}
+
+shared_ptr<UdpTransport>
+UdpTransport::create(const std::string& uri)
+{
+  const auto hostAndPort(getSocketHostAndPortFromUri(uri));
+  return make_shared<UdpTransport>(hostAndPort.first, hostAndPort.second);
+}
+
+std::pair<std::string, std::string>
+UdpTransport::getSocketHostAndPortFromUri(const std::string& uriString)
+{
+  std::string host = "localhost";
+  std::string port = "6363";
+
+  if (uriString.empty()) {
+    return {host, port};
+  }
+
+  try {
+    const FaceUri uri(uriString);
+
+    const std::string scheme = uri.getScheme();
+    if (scheme != "udp" && scheme != "udp4" && scheme != "udp6") {
+      NDN_THROW(Error("Cannot create UdpTransport from \"" + scheme + "\" URI"));
+    }
+
+    if (!uri.getHost().empty()) {
+      host = uri.getHost();
+    }
+
+    if (!uri.getPort().empty()) {
+      port = uri.getPort();
+    }
+  }
+  catch (const FaceUri::Error& error) {
+    NDN_THROW_NESTED(Error(error.what()));
+  }
+
+  return {host, port};
+}
+
+void
+UdpTransport::openSocket(boost::asio::generic::datagram_protocol::socket& socket)
+{
+  NDN_LOG_DEBUG("connect host=" << m_host << " port=" << m_port);
+
+  // the forwarder is normally local, so the resolution does not block for long
+  boost::asio::ip::udp::resolver resolver(socket
+#if BOOST_VERSION >= 107000
+                                          .get_executor()
+#else
+                                          .get_io_service()
+#endif
+                                          );
+  boost::system::error_code error;
+  auto endpoint = resolver.resolve(boost::asio::ip::udp::resolver::query(m_host, m_port), error);
+  if (error || endpoint == boost::asio::ip::udp::resolver::iterator()) {
+    NDN_THROW(Error(error, "Unable to resolve host or port"));
+  }
+
+  boost::asio::generic::datagram_protocol::endpoint remote(endpoint->endpoint());
+  socket.open(remote.protocol(), error);
+  if (!error) {
+    socket.connect(remote, error);
+  }
+  if (error) {
+    NDN_THROW(Error(error, "error while connecting to the forwarder"));
+  }
+}
+
+} // namespace ndn
@@ -0,0 +1,64 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TRANSPORT_UDP_TRANSPORT_HPP
+#define NDN_TRANSPORT_UDP_TRANSPORT_HPP
+
+#include "ndn-cxx/transport/datagram-transport.hpp"
+
+namespace ndn {
+
+/** \brief a transport using UDP unicast, one packet per datagram
+ */
+class UdpTransport : public DatagramTransport
+{
+public:
+  explicit
+  UdpTransport(const std::string& host, const std::string& port = "6363");
+
+  /** \brief Create transport with parameters defined in URI
+   *  \throw Transport::Error incorrect URI or unsupported protocol is specified
+   */
+  static shared_ptr<UdpTransport>
+  create(const std::string& uri);
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  static std::pair<std::string, std::string>
+  getSocketHostAndPortFromUri(const std::string& uri);
+
+private:
+  void
+  openSocket(boost::asio::generic::datagram_protocol::socket& socket) override;
+
+  bool
+  isConnectionOriented() const override
+  {
+    return false;
+  }
+
+private:
+  std::string m_host;
+  std::string m_port;
+};
+
+} // namespace ndn
+
+#endif // NDN_TRANSPORT_UDP_TRANSPORT_HPP
@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/transport/unix-seqpacket-transport.hpp"
+#include "ndn-cxx/net/face-uri.hpp"
+#include "ndn-cxx/util/logger.hpp"
+
+#include <boost/asio/local/stream_protocol.hpp>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+NDN_LOG_INIT(ndn.UnixSeqpacketTransport);
+
+namespace ndn {
+
+UnixSeqpacketTransport::UnixSeqpacketTransport(const std::string& unixSocket)
+  : m_unixSocket(unixSocket)
+{
+}
+
+std::string
+UnixSeqpacketTransport::getSocketNameFromUri(const std::string& uriString)
+{
+  std::string path = "/var/run/nfd.seqpacket";
+
+  if (uriString.empty()) {
+    return path;
+  }
+
+  try {
+    const FaceUri uri(uriString);
+
+    if (uri.getScheme() != "unix+seqpacket") {
+      NDN_THROW(Error("Cannot create UnixSeqpacketTransport from \"" + uri.getScheme() + "\" URI"));
+    }
+
+    if (!uri.getPath().empty()) {
+      path = uri.getPath();
+    }
+  }
+  catch (const FaceUri::Error& error) {
+    NDN_THROW_NESTED(Error(error.what()));
+  }
+
+  return path;
+}
+
+shared_ptr<UnixSeqpacketTransport>
+UnixSeqpacketTransport::create(const std::string& uri)
+{
+  return make_shared<UnixSeqpacketTransport>(getSocketNameFromUri(uri));
+}
+
+void
+UnixSeqpacketTransport::openSocket(boost::asio::generic::datagram_protocol::socket& socket)
+{
+  NDN_LOG_DEBUG("connect path=" << m_unixSocket);
+
+  int fd = ::socket(AF_UNIX, SOCK_SEQPACKET, 0);
+  if (fd < 0) {
+    NDN_THROW(Error(boost::system::error_code(errno, boost::system::system_category()),
+                    "cannot create socket"));
+  }
+
+  // a datagram socket object operates a SOCK_SEQPACKET socket just fine,
+  // and generic::seq_packet_protocol::socket has a less convenient receive API
+  boost::system::error_code error;
+  socket.assign(boost::asio::generic::datagram_protocol(AF_UNIX, 0), fd, error);
+  if (error) {
+    ::close(fd);
+    NDN_THROW(Error(error, "cannot create socket"));
+  }
+
+  boost::asio::local::stream_protocol::endpoint local(m_unixSocket);
+  boost::asio::generic::datagram_protocol::endpoint remote(local);
+  socket.connect(remote, error);
+  if (error) {
+    NDN_THROW(Error(error, "error while connecting to the forwarder"));
+  }
+}
+
+} // namespace ndn
@@ -0,0 +1,248 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/util/congestion-control.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ndn {
+namespace util {
+
+std::ostream&
+operator<<(std::ostream& os, CongestionControlAlgorithm algorithm)
+{
+  switch (algorithm) {
+    case CongestionControlAlgorithm::AIMD:
+      return os << "AIMD";
+    case CongestionControlAlgorithm::CUBIC:
+      return os << "CUBIC";
+    case CongestionControlAlgorithm::BBR:
+      return os << "BBR";
+  }
+  return os << static_cast<int>(algorithm);
+}
+
+static double
+toSeconds(time::nanoseconds d)
+{
+  return time::duration_cast<time::duration<double>>(d).count();
+}
+
+constexpr double CongestionControl::MIN_SSTHRESH;
+
+CongestionControl::~CongestionControl() = default;
+
+AimdCongestionControl::AimdCongestionControl(double aiStep, double mdCoef, double initCwnd,
+                                             bool resetCwndToInit)
+  : m_aiStep(aiStep)
+  , m_mdCoef(mdCoef)
+  , m_initCwnd(initCwnd)
+  , m_resetCwndToInit(resetCwndToInit)
+{
+}
+
+void
+AimdCongestionControl::increase(double& cwnd, double& ssthresh, const Ack&)
+{
+  if (cwnd < ssthresh) {
+    cwnd += m_aiStep; // additive increase
+  }
+  else {
+    cwnd += m_aiStep / std::floor(cwnd); // congestion avoidance
+  }
+}
+
+void
+AimdCongestionControl::decrease(double& cwnd, double& ssthresh, time::steady_clock::TimePoint)
+{
+  // Refer to RFC 5681, Section 3.1 for the rationale behind the code below
+  ssthresh = std::max(MIN_SSTHRESH, cwnd * m_mdCoef); // multiplicative decrease
+  cwnd = m_resetCwndToInit ? m_initCwnd : ssthresh;
+}
+
+CubicCongestionControl::CubicCongestionControl(double beta, double c)
+  : m_beta(beta)
+  , m_c(c)
+{
+  BOOST_ASSERT(m_beta > 0.0 && m_beta < 1.0);
+  BOOST_ASSERT(m_c > 0.0);
+}
+
+void
+CubicCongestionControl::increase(double& cwnd, double& ssthresh, const Ack& ack)
+{
+  if (cwnd < ssthresh) {
+    cwnd += 1.0; // slow start
+    return;
+  }
+
+  if (!m_epochStart) {
+    // first increase after a congestion event, or after leaving slow start
+    m_epochStart = ack.time;
+    if (cwnd < m_wMax) {
+      m_k = std::cbrt((m_wMax - cwnd) / m_c);
+      m_origin = m_wMax;
+    }
+    else {
+      m_k = 0.0;
+      m_origin = cwnd;
+    }
+    m_wEst = cwnd;
+  }
+
+  // RFC 8312 Section 4.1: target window one RTT from now
+  double rtt = ack.sRtt >= 0_ns ? toSeconds(ack.sRtt) : 0.0;
+  double t = toSeconds(ack.time - *m_epochStart) + rtt;
+  double target = m_origin + m_c * std::pow(t - m_k, 3.0);
+  target = std::min(target, 1.5 * cwnd);
+
+  // RFC 8312 Section 4.2: window of a Reno flow with the same decrease factor
+  m_wEst += 3.0 * (1.0 - m_beta) / (1.0 + m_beta) / cwnd;
+
+  if (target > cwnd) {
+    cwnd += (target - cwnd) / cwnd;
+  }
+  else {
+    cwnd += 0.01 / cwnd;
+  }
+  cwnd = std::max(cwnd, m_wEst);
+}
+
+void
+CubicCongestionControl::decrease(double& cwnd, double& ssthresh, time::steady_clock::TimePoint)
+{
+  m_epochStart = nullopt;
+
+  // RFC 8312 Section 4.6: fast convergence
+  if (cwnd < m_wMax) {
+    m_wMax = cwnd * (1.0 + m_beta) / 2.0;
+  }
+  else {
+    m_wMax = cwnd;
+  }
+
+  ssthresh = std::max(MIN_SSTHRESH, cwnd * m_beta);
+  cwnd = ssthresh;
+}
+
+constexpr double BbrCongestionControl::MIN_CWND;
+constexpr size_t BbrCongestionControl::BW_FILTER_ROUNDS;
+constexpr size_t BbrCongestionControl::STARTUP_FULL_BW_ROUNDS;
+constexpr double BbrCongestionControl::STARTUP_FULL_BW_GROWTH;
+const std::array<double, 8> BbrCongestionControl::PROBE_GAINS{{1.25, 0.75, 1, 1, 1, 1, 1, 1}};
+const time::nanoseconds BbrCongestionControl::MIN_RTT_WINDOW = 10_s;
+
+BbrCongestionControl::BbrCongestionControl() = default;
+
+void
+BbrCongestionControl::increase(double& cwnd, double&, const Ack& ack)
+{
+  if (ack.rtt >= 0_ns &&
+      (ack.rtt <= m_minRtt || ack.time - m_minRttTime > MIN_RTT_WINDOW)) {
+    m_minRtt = ack.rtt;
+    m_minRttTime = ack.time;
+  }
+
+  if (!m_roundStart) {
+    m_roundStart = ack.time;
+  }
+  ++m_roundDelivered;
+  if (m_minRtt != time::nanoseconds::max() && ack.time - *m_roundStart >= m_minRtt) {
+    onRoundEnd(ack.time);
+  }
+
+  if (m_isStartup) {
+    cwnd += 1.0; // doubles the window every round
+  }
+  else {
+    cwnd = std::max(MIN_CWND, PROBE_GAINS[m_cycleIndex] * getBdp());
+  }
+}
+
+void
+BbrCongestionControl::decrease(double& cwnd, double& ssthresh, time::steady_clock::TimePoint)
+{
+  if (m_isStartup) {
+    // the pipe is full
+    m_isStartup = false;
+    m_cycleIndex = 2;
+  }
+
+  double bdp = getBdp();
+  if (bdp > 0.0) {
+    cwnd = std::min(cwnd, bdp);
+  }
+  else {
+    cwnd /= 2.0;
+  }
+  cwnd = std::max(MIN_CWND, cwnd);
+  ssthresh = cwnd;
+}
+
+double
+BbrCongestionControl::getBandwidth() const
+{
+  size_t nSamples = std::min(m_nRounds, m_bwSamples.size());
+  return nSamples == 0 ? 0.0 : *std::max_element(m_bwSamples.begin(), m_bwSamples.begin() + nSamples);
+}
+
+double
+BbrCongestionControl::getBdp() const
+{
+  if (m_minRtt == time::nanoseconds::max()) {
+    return 0.0;
+  }
+  return getBandwidth() * toSeconds(m_minRtt);
+}
+
+void
+BbrCongestionControl::onRoundEnd(time::steady_clock::TimePoint now)
+{
+  double elapsed = toSeconds(now - *m_roundStart);
+  if (elapsed <= 0.0) {
+    // no time has passed (e.g., zero RTT): keep counting deliveries until a sample can be taken
+    return;
+  }
+  m_bwSamples[m_nRounds % m_bwSamples.size()] = m_roundDelivered / elapsed;
+  ++m_nRounds;
+  m_roundStart = now;
+  m_roundDelivered = 0;
+
+  if (m_isStartup) {
+    double bw = getBandwidth();
+    if (bw >= m_fullBw * STARTUP_FULL_BW_GROWTH) {
+      m_fullBw = bw;
+      m_nFullBwRounds = 0;
+    }
+    else if (++m_nFullBwRounds >= STARTUP_FULL_BW_ROUNDS) {
+      // bandwidth has stopped growing: leave startup, skipping the probing and draining phases
+      m_isStartup = false;
+      m_cycleIndex = 2;
+    }
+  }
+  else {
+    m_cycleIndex = (m_cycleIndex + 1) % PROBE_GAINS.size();
+  }
+}
+
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_CXX_UTIL_CONGESTION_CONTROL_HPP
+#define NDN_CXX_UTIL_CONGESTION_CONTROL_HPP
+
+#include "ndn-cxx/util/time.hpp"
+
+#include <array>
+
+namespace ndn {
+namespace util {
+
+/**
+ * @brief Identifies a built-in congestion control algorithm.
+ */
+enum class CongestionControlAlgorithm {
+  AIMD,  ///< additive increase, multiplicative decrease (RFC 5681)
+  CUBIC, ///< CUBIC window growth function (RFC 8312)
+  BBR,   ///< window sized from estimated bottleneck bandwidth and minimum RTT
+};
+
+std::ostream&
+operator<<(std::ostream& os, CongestionControlAlgorithm algorithm);
+
+/**
+ * @brief Congestion window adjustment algorithm.
+ *
+ * The consumer (e.g., SegmentFetcher) owns the congestion window and the slow start threshold,
+ * and decides when a congestion event has occurred; in particular, it applies Conservative
+ * Window Adaptation so that decrease() is invoked at most once per window of data.
+ * A CongestionControl instance computes how these values change, and may keep per-flow state.
+ */
+class CongestionControl : noncopyable
+{
+public:
+  /**
+   * @brief Information about a received segment.
+   */
+  struct Ack
+  {
+    time::steady_clock::TimePoint time; ///< arrival time
+    time::nanoseconds rtt = -1_ns;  ///< RTT sample, or negative if the segment was retransmitted
+    time::nanoseconds sRtt = -1_ns; ///< smoothed RTT, or negative if there are no RTT samples
+  };
+
+  virtual
+  ~CongestionControl();
+
+  /**
+   * @brief Adjusts the window upon receipt of a segment without a congestion mark.
+   */
+  virtual void
+  increase(double& cwnd, double& ssthresh, const Ack& ack) = 0;
+
+  /**
+   * @brief Adjusts the window in response to a loss or a congestion mark.
+   */
+  virtual void
+  decrease(double& cwnd, double& ssthresh, time::steady_clock::TimePoint now) = 0;
+
+public:
+  static constexpr double MIN_SSTHRESH = 2.0;
+};
+
+/**
+ * @brief Additive increase, multiplicative decrease.
+ *
+ * The window grows by @p aiStep per segment in slow start and by @p aiStep per window in
+ * congestion avoidance, and is multiplied by @p mdCoef upon a congestion event.
+ */
+class AimdCongestionControl : public CongestionControl
+{
+public:
+  AimdCongestionControl(double aiStep, double mdCoef, double initCwnd, bool resetCwndToInit);
+
+  void
+  increase(double& cwnd, double& ssthresh, const Ack& ack) override;
+
+  void
+  decrease(double& cwnd, double& ssthresh, time::steady_clock::TimePoint now) override;
+
+private:
+  const double m_aiStep;
+  const double m_mdCoef;
+  const double m_initCwnd;
+  const bool m_resetCwndToInit;
+};
+
+/**
+ * @brief CUBIC congestion control, as specified in RFC 8312.
+ *
+ * In congestion avoidance, the window follows a cubic function of the time elapsed since the
+ * last congestion event, so that it returns quickly to the size at which that event occurred
+ * regardless of RTT. The TCP-friendly region and fast convergence are implemented.
+ */
+class CubicCongestionControl : public CongestionControl
+{
+public:
+  /**
+   * @param beta multiplicative decrease factor
+   * @param c scaling constant of the cubic function, in segments/second^3
+   */
+  explicit
+  CubicCongestionControl(double beta = 0.7, double c = 0.4);
+
+  void
+  increase(double& cwnd, double& ssthresh, const Ack& ack) override;
+
+  void
+  decrease(double& cwnd, double& ssthresh, time::steady_clock::TimePoint now) override;
+
+private:
+  const double m_beta;
+  const double m_c;
+
+  double m_wMax = 0.0; ///< window size before the last reduction
+  double m_k = 0.0; ///< time to reach m_wMax, in seconds
+  double m_origin = 0.0; ///< origin point of the cubic function
+  double m_wEst = 0.0; ///< estimated window of a Reno flow, for the TCP-friendly region
+  optional<time::steady_clock::TimePoint> m_epochStart;
+};
+
+/**
+ * @brief Rate-based congestion control modeled after BBR.
+ *
+ * The bottleneck bandwidth is estimated as the maximum delivery rate over the last few rounds,
+ * and the propagation delay as the minimum RTT over a ten-second window. During startup the
+ * window doubles every round until the bandwidth estimate stops growing; afterwards the window
+ * is set to the estimated bandwidth-delay product, scaled by a gain that cycles through a
+ * probing phase (1.25), a draining phase (0.75), and six cruising phases (1.0).
+ *
+ * Unlike loss-based algorithms, a loss does not shrink the window below the bandwidth-delay
+ * product; a congestion event only ends the startup phase and caps the window at that product.
+ *
+ * @note This is a window-based approximation: Interests are not paced.
+ */
+class BbrCongestionControl : public CongestionControl
+{
+public:
+  BbrCongestionControl();
+
+  void
+  increase(double& cwnd, double& ssthresh, const Ack& ack) override;
+
+  void
+  decrease(double& cwnd, double& ssthresh, time::steady_clock::TimePoint now) override;
+
+  /**
+   * @brief Returns the estimated bottleneck bandwidth, in segments per second.
+   */
+  double
+  getBandwidth() const;
+
+  /**
+   * @brief Returns the estimated bandwidth-delay product, in segments.
+   */
+  double
+  getBdp() const;
+
+private:
+  void
+  onRoundEnd(time::steady_clock::TimePoint now);
+
+public:
+  static constexpr double MIN_CWND = 4.0;
+  static constexpr size_t BW_FILTER_ROUNDS = 10;
+  static constexpr size_t STARTUP_FULL_BW_ROUNDS = 3;
+  static constexpr double STARTUP_FULL_BW_GROWTH = 1.25;
+  static const std::array<double, 8> PROBE_GAINS;
+  static const time::nanoseconds MIN_RTT_WINDOW;
+
+private:
+  bool m_isStartup = true;
+  time::nanoseconds m_minRtt = time::nanoseconds::max();
+  time::steady_clock::TimePoint m_minRttTime;
+
+  optional<time::steady_clock::TimePoint> m_roundStart;
+  uint64_t m_roundDelivered = 0;
+  std::array<double, BW_FILTER_ROUNDS> m_bwSamples{}; ///< per-round delivery rates, ring buffer
+  size_t m_nRounds = 0;
+
+  double m_fullBw = 0.0;
+  size_t m_nFullBwRounds = 0;
+  size_t m_cycleIndex = 0;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_CXX_UTIL_CONGESTION_CONTROL_HPP
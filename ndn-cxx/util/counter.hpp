@@ -0,0 +1,89 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_COUNTER_HPP
+#define NDN_UTIL_COUNTER_HPP
+
+#include "ndn-cxx/detail/common.hpp"
+
+#include <atomic>
+
+namespace ndn {
+namespace util {
+
+/** \brief A 64-bit counter that is written by one thread and may be read by any thread
+ *
+ *  Updates are relaxed atomic loads and stores rather than read-modify-write operations, so that
+ *  counting on a hot path costs no more than incrementing a plain integer. Consequently, only
+ *  one thread may modify a Counter at a time; readers always observe a value that was stored.
+ */
+class Counter : noncopyable
+{
+public:
+  Counter() noexcept = default;
+
+  operator uint64_t() const noexcept
+  {
+    return m_value.load(std::memory_order_relaxed);
+  }
+
+  Counter&
+  operator++() noexcept
+  {
+    return *this += 1;
+  }
+
+  Counter&
+  operator+=(uint64_t n) noexcept
+  {
+    m_value.store(m_value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    return *this;
+  }
+
+  Counter&
+  operator--() noexcept
+  {
+    return *this -= 1;
+  }
+
+  Counter&
+  operator-=(uint64_t n) noexcept
+  {
+    m_value.store(m_value.load(std::memory_order_relaxed) - n, std::memory_order_relaxed);
+    return *this;
+  }
+
+  /** \brief Set the counter value, e.g. to maintain a gauge such as a queue length
+   */
+  void
+  set(uint64_t value) noexcept
+  {
+    m_value.store(value, std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<uint64_t> m_value{0};
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_COUNTER_HPP
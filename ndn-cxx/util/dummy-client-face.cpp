@@ -20,6 +20,7 @@
  */
 
 #include "ndn-cxx/util/dummy-client-face.hpp"
+#include "ndn-cxx/encoding/tlv-nfd.hpp"
 #include "ndn-cxx/impl/lp-field-tag.hpp"
 #include "ndn-cxx/lp/packet.hpp"
 #include "ndn-cxx/lp/tags.hpp"
@@ -229,16 +230,30 @@ DummyClientFace::enableRegistrationReply()
     if (!localhostRegistration.isPrefixOf(interest.getName()))
       return;
 
-    nfd::ControlParameters params(interest.getName().get(-5).blockFromValue());
-    params.setFaceId(1);
-    params.setOrigin(nfd::ROUTE_ORIGIN_APP);
-    if (interest.getName().get(3) == name::Component("register")) {
-      params.setCost(0);
-    }
+    auto makeResponse = [&interest] (nfd::ControlParameters params) {
+      params.setFaceId(1);
+      params.setOrigin(nfd::ROUTE_ORIGIN_APP);
+      if (interest.getName().get(3) == name::Component("register")) {
+        params.setCost(0);
+      }
+      return nfd::ControlResponse(200, "").setBody(params.wireEncode());
+    };
 
     nfd::ControlResponse resp;
-    resp.setCode(200);
-    resp.setBody(params.wireEncode());
+    Block request = interest.getName().get(-5).blockFromValue();
+    if (request.type() == tlv::nfd::ControlParametersBatch) {
+      request.parse();
+      Block body(tlv::nfd::ControlResponseBatch);
+      for (const auto& element : request.elements()) {
+        body.push_back(makeResponse(nfd::ControlParameters(element)).wireEncode());
+      }
+      body.encode();
+      resp.setCode(200);
+      resp.setBody(body);
+    }
+    else {
+      resp = makeResponse(nfd::ControlParameters(request));
+    }
 
     shared_ptr<Data> data = make_shared<Data>(interest.getName());
     data->setContent(resp.wireEncode());
@@ -0,0 +1,367 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/util/impl/async-log-writer.hpp"
+#include "ndn-cxx/transport/detail/shm-ring.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+
+namespace ndn {
+namespace util {
+namespace detail {
+
+using ndn::detail::ShmRing;
+
+/** \brief minimum capacity of the ring of a thread
+ */
+const size_t MIN_RING_CAPACITY = 1024;
+
+/** \brief how long the writer sleeps if no record arrives
+ */
+const std::chrono::seconds IDLE_TIMEOUT(1);
+
+/** \brief stream buffer that appends to a std::string
+ */
+class StringAppendBuf : public std::streambuf
+{
+public:
+  explicit
+  StringAppendBuf(std::string& str)
+    : m_str(str)
+  {
+  }
+
+protected:
+  int_type
+  overflow(int_type ch) final
+  {
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+      m_str.push_back(traits_type::to_char_type(ch));
+    }
+    return traits_type::not_eof(ch);
+  }
+
+  std::streamsize
+  xsputn(const char_type* s, std::streamsize n) final
+  {
+    m_str.append(s, static_cast<size_t>(n));
+    return n;
+  }
+
+private:
+  std::string& m_str;
+};
+
+/** \brief fixed-size part of a record in the ring, followed by the module name and the message
+ */
+struct AsyncLogRecordHeader
+{
+  time::system_clock::Duration::rep timestamp;
+  LogLevel level;
+  uint32_t moduleSize;
+};
+
+class AsyncLogBuffer : noncopyable
+{
+public:
+  AsyncLogBuffer()
+    : m_streamBuf(text)
+    , os(&m_streamBuf)
+  {
+  }
+
+  void
+  reset(const std::string& module, LogLevel level)
+  {
+    header.timestamp = time::system_clock::now().time_since_epoch().count();
+    header.level = level;
+    header.moduleSize = static_cast<uint32_t>(module.size());
+    text.assign(module);
+
+    // undo formatting changes left by the previous message
+    os.clear();
+    os.flags(std::ios_base::dec | std::ios_base::skipws);
+    os.width(0);
+    os.precision(6);
+    os.fill(' ');
+  }
+
+public:
+  AsyncLogRecordHeader header;
+  std::string text; ///< module name followed by the message
+  bool isBusy = false;
+
+private:
+  StringAppendBuf m_streamBuf;
+
+public:
+  std::ostream os;
+};
+
+class AsyncLogRing : noncopyable
+{
+public:
+  explicit
+  AsyncLogRing(size_t capacity)
+    : m_memory(new uint8_t[ShmRing::computeSize(capacity) + 64])
+    , ring(initialize(m_memory.get(), capacity), ShmRing::computeSize(capacity))
+  {
+  }
+
+private:
+  static void*
+  initialize(uint8_t* memory, size_t capacity)
+  {
+    void* ptr = memory;
+    size_t space = ShmRing::computeSize(capacity) + 64;
+    std::align(64, ShmRing::computeSize(capacity), ptr, space);
+    ShmRing::initialize(ptr, capacity);
+    return ptr;
+  }
+
+private:
+  std::unique_ptr<uint8_t[]> m_memory;
+
+public:
+  ShmRing ring;
+  std::atomic<bool> isOrphaned{false}; ///< the owning thread has exited
+};
+
+/** \brief the ring of the calling thread
+ */
+class ThreadRing : noncopyable
+{
+public:
+  ThreadRing() = default;
+
+  ~ThreadRing()
+  {
+    if (ring != nullptr) {
+      ring->isOrphaned.store(true);
+    }
+  }
+
+public:
+  shared_ptr<AsyncLogRing> ring;
+};
+
+std::atomic<bool> AsyncLogRecord::s_isEnabled{false};
+
+AsyncLogRecord::AsyncLogRecord(const Logger& logger, LogLevel level)
+{
+  thread_local AsyncLogBuffer threadBuffer;
+
+  // a message may be logged while the thread is rendering another one
+  m_isNested = threadBuffer.isBusy;
+  m_buffer = m_isNested ? new AsyncLogBuffer : &threadBuffer;
+  m_buffer->isBusy = true;
+  m_buffer->reset(logger.getModuleName(), level);
+}
+
+AsyncLogRecord::~AsyncLogRecord()
+{
+  AsyncLogWriter::get().commit(*m_buffer);
+  m_buffer->isBusy = false;
+  if (m_isNested) {
+    delete m_buffer;
+  }
+}
+
+std::ostream&
+AsyncLogRecord::stream()
+{
+  return m_buffer->os;
+}
+
+AsyncLogWriter&
+AsyncLogWriter::get()
+{
+  static AsyncLogWriter instance;
+  return instance;
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+  this->stop();
+}
+
+void
+AsyncLogWriter::start(shared_ptr<std::ostream> os, size_t ringCapacity)
+{
+  this->stop();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_os = std::move(os);
+  m_ringCapacity = MIN_RING_CAPACITY;
+  while (m_ringCapacity < ringCapacity) {
+    m_ringCapacity <<= 1;
+  }
+  m_thread = std::thread([this] { this->run(); });
+  AsyncLogRecord::s_isEnabled.store(true);
+}
+
+void
+AsyncLogWriter::stop()
+{
+  AsyncLogRecord::s_isEnabled.store(false);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_thread.joinable()) {
+      return;
+    }
+    m_shouldStop = true;
+  }
+  m_wakeWriter.notify_one();
+  m_thread.join();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_shouldStop = false;
+  m_os.reset();
+}
+
+void
+AsyncLogWriter::flush()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (!m_thread.joinable()) {
+    return;
+  }
+  uint64_t ticket = ++m_nFlushRequested;
+  m_wakeWriter.notify_one();
+  m_flushCompleted.wait(lock, [=] { return m_nFlushCompleted >= ticket; });
+}
+
+void
+AsyncLogWriter::commit(const AsyncLogBuffer& buffer)
+{
+  thread_local ThreadRing threadRing;
+  if (threadRing.ring == nullptr) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    threadRing.ring = make_shared<AsyncLogRing>(std::max(m_ringCapacity, MIN_RING_CAPACITY));
+    // the first record must wake up the writer
+    threadRing.ring->ring.prepareReaderWait();
+    m_rings.push_back(threadRing.ring);
+  }
+
+  ShmRing& ring = threadRing.ring->ring;
+  size_t textSize = std::min(buffer.text.size(), ring.getMaxRecordSize() - sizeof(buffer.header));
+  BOOST_ASSERT(buffer.header.moduleSize <= textSize);
+  if (!ring.tryWrite(reinterpret_cast<const uint8_t*>(&buffer.header), sizeof(buffer.header),
+                     reinterpret_cast<const uint8_t*>(buffer.text.data()), textSize)) {
+    m_nDropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  if (ring.needWakeReader()) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_wakeWriter.notify_one();
+  }
+}
+
+void
+AsyncLogWriter::run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    auto rings = m_rings;
+    uint64_t nFlushRequested = m_nFlushRequested;
+    bool shouldStop = m_shouldStop;
+    lock.unlock();
+
+    bool hasWritten = this->drain(rings);
+    if (hasWritten || shouldStop) {
+      m_os->flush();
+    }
+
+    lock.lock();
+    // every record committed before the flush requests were made has been written
+    if (m_nFlushCompleted < nFlushRequested) {
+      m_nFlushCompleted = nFlushRequested;
+      m_flushCompleted.notify_all();
+    }
+    if (shouldStop) {
+      m_nFlushCompleted = m_nFlushRequested;
+      m_flushCompleted.notify_all();
+      return;
+    }
+    if (hasWritten || m_shouldStop || m_nFlushRequested != nFlushRequested) {
+      continue;
+    }
+
+    // a thread sets isOrphaned after committing its last record
+    m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(), [] (const auto& ring) {
+                    return ring->isOrphaned.load() && ring->ring.peek().first == nullptr;
+                  }),
+                  m_rings.end());
+
+    bool hasRecords = false;
+    for (const auto& ring : m_rings) {
+      hasRecords = ring->ring.prepareReaderWait() || hasRecords;
+    }
+    if (!hasRecords) {
+      m_wakeWriter.wait_for(lock, IDLE_TIMEOUT);
+    }
+  }
+}
+
+bool
+AsyncLogWriter::drain(const std::vector<shared_ptr<AsyncLogRing>>& rings)
+{
+  std::ostream& os = *m_os;
+  bool hasWritten = false;
+
+  for (const auto& ring : rings) {
+    const uint8_t* record = nullptr;
+    size_t recordSize = 0;
+    while (std::tie(record, recordSize) = ring->ring.peek(), record != nullptr) {
+      AsyncLogRecordHeader header;
+      std::memcpy(&header, record, sizeof(header));
+      auto text = reinterpret_cast<const char*>(record + sizeof(header));
+      size_t textSize = recordSize - sizeof(header);
+
+      time::system_clock::TimePoint timestamp(time::system_clock::Duration(header.timestamp));
+      os << log::makeTimestamp(timestamp) << ' ' << std::setw(5) << header.level << ": [";
+      os.write(text, header.moduleSize) << "] ";
+      os.write(text + header.moduleSize, textSize - header.moduleSize) << '\n';
+
+      ring->ring.pop();
+      hasWritten = true;
+    }
+  }
+
+  uint64_t nDropped = m_nDropped.load(std::memory_order_relaxed);
+  if (nDropped != m_nReportedDrops) {
+    os << log::makeTimestamp(time::system_clock::now()) << ' ' << std::setw(5) << LogLevel::WARN
+       << ": [ndn.util.Logging] " << nDropped - m_nReportedDrops << " log messages dropped\n";
+    m_nReportedDrops = nDropped;
+    hasWritten = true;
+  }
+
+  return hasWritten;
+}
+
+} // namespace detail
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_IMPL_ASYNC_LOG_WRITER_HPP
+#define NDN_UTIL_IMPL_ASYNC_LOG_WRITER_HPP
+
+#include "ndn-cxx/util/logger.hpp"
+#include "ndn-cxx/util/time.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ndn {
+namespace util {
+namespace log {
+
+/** \brief Render \p timePoint in the timestamp format of log records.
+ */
+std::string
+makeTimestamp(const time::system_clock::TimePoint& timePoint);
+
+} // namespace log
+
+namespace detail {
+
+class AsyncLogRing;
+
+/** \brief Background thread that writes log records from per-thread rings to a stream.
+ *
+ *  Each thread that logs owns a single-producer single-consumer ring, which it registers on
+ *  first use. Logging threads never block on the writer: a record that does not fit in the
+ *  ring is dropped and counted. The writer sleeps when all rings are empty, and is woken up
+ *  by the first record committed afterwards.
+ */
+class AsyncLogWriter : noncopyable
+{
+public:
+  static AsyncLogWriter&
+  get();
+
+  ~AsyncLogWriter();
+
+  /** \brief Start writing to \p os, replacing the previous stream.
+   *  \param ringCapacity capacity of the ring of each thread that logs for the first time
+   */
+  void
+  start(shared_ptr<std::ostream> os, size_t ringCapacity);
+
+  /** \brief Write the remaining records and stop the background thread.
+   */
+  void
+  stop();
+
+  /** \brief Wait until all records committed before this call have been written.
+   */
+  void
+  flush();
+
+  /** \return number of records dropped because a ring was full
+   */
+  uint64_t
+  getNDropped() const
+  {
+    return m_nDropped.load(std::memory_order_relaxed);
+  }
+
+  /** \brief Append the record rendered in \p buffer to the ring of the calling thread.
+   */
+  void
+  commit(const AsyncLogBuffer& buffer);
+
+private:
+  AsyncLogWriter() = default;
+
+  void
+  run();
+
+  /** \brief Write all records found in \p rings.
+   *  \return whether any record was written
+   */
+  bool
+  drain(const std::vector<shared_ptr<AsyncLogRing>>& rings);
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_wakeWriter;
+  std::condition_variable m_flushCompleted;
+  std::thread m_thread;
+  bool m_shouldStop = false;
+  uint64_t m_nFlushRequested = 0;
+  uint64_t m_nFlushCompleted = 0;
+
+  shared_ptr<std::ostream> m_os;
+  size_t m_ringCapacity = 0;
+  std::vector<shared_ptr<AsyncLogRing>> m_rings;
+
+  std::atomic<uint64_t> m_nDropped{0};
+  uint64_t m_nReportedDrops = 0; ///< accessed by the writer thread only
+};
+
+} // namespace detail
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_IMPL_ASYNC_LOG_WRITER_HPP
@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/util/latency-histogram.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace ndn {
+namespace util {
+
+// Values below 2^SUB_BUCKET_BITS have one bucket each. Values with most significant bit e
+// (e >= SUB_BUCKET_BITS) fall into row (e - SUB_BUCKET_BITS + 1), which is divided into
+// 2^SUB_BUCKET_BITS sub-buckets by the SUB_BUCKET_BITS bits that follow the most significant bit.
+const int SUB_BUCKET_BITS = 4;
+const uint64_t N_SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+const int MAX_MSB = LatencyHistogram::N_BUCKETS / N_SUB_BUCKETS + SUB_BUCKET_BITS - 2;
+
+static_assert(LatencyHistogram::N_BUCKETS % N_SUB_BUCKETS == 0, "");
+
+constexpr size_t LatencyHistogram::N_BUCKETS;
+
+size_t
+LatencyHistogram::getBucketIndex(time::microseconds latency) noexcept
+{
+  if (latency.count() < static_cast<time::microseconds::rep>(N_SUB_BUCKETS)) {
+    return static_cast<size_t>(std::max<time::microseconds::rep>(latency.count(), 0));
+  }
+
+  auto value = static_cast<uint64_t>(latency.count());
+  int msb = 63 - __builtin_clzll(value);
+  if (msb > MAX_MSB) {
+    return N_BUCKETS - 1;
+  }
+  int shift = msb - SUB_BUCKET_BITS;
+  return (shift + 1) * N_SUB_BUCKETS + ((value >> shift) & (N_SUB_BUCKETS - 1));
+}
+
+time::microseconds
+LatencyHistogram::getBucketLowerBound(size_t index) noexcept
+{
+  BOOST_ASSERT(index < N_BUCKETS);
+  if (index < N_SUB_BUCKETS) {
+    return time::microseconds(index);
+  }
+
+  int shift = static_cast<int>(index / N_SUB_BUCKETS) - 1;
+  uint64_t sub = index % N_SUB_BUCKETS;
+  return time::microseconds((N_SUB_BUCKETS + sub) << shift);
+}
+
+time::microseconds
+LatencyHistogram::getBucketUpperBound(size_t index) noexcept
+{
+  BOOST_ASSERT(index < N_BUCKETS);
+  if (index == N_BUCKETS - 1) {
+    return time::microseconds::max();
+  }
+  return getBucketLowerBound(index + 1) - time::microseconds(1);
+}
+
+void
+LatencyHistogram::add(time::microseconds latency, uint64_t count) noexcept
+{
+  auto& bucket = m_buckets[getBucketIndex(latency)];
+  bucket.store(bucket.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+  m_count.store(m_count.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+
+  uint64_t value = static_cast<uint64_t>(std::max<time::microseconds::rep>(latency.count(), 0));
+  m_sum.store(m_sum.load(std::memory_order_relaxed) + value * count, std::memory_order_relaxed);
+}
+
+time::microseconds
+LatencyHistogram::getMean() const noexcept
+{
+  uint64_t count = getCount();
+  if (count == 0) {
+    return time::microseconds::zero();
+  }
+  return time::microseconds(m_sum.load(std::memory_order_relaxed) / count);
+}
+
+time::microseconds
+LatencyHistogram::getQuantile(double q) const noexcept
+{
+  uint64_t count = getCount();
+  if (count == 0) {
+    return time::microseconds::zero();
+  }
+
+  q = std::min(std::max(q, 0.0), 1.0);
+  auto rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(q * count)), 1);
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < N_BUCKETS; ++i) {
+    seen += getBucketCount(i);
+    if (seen >= rank) {
+      return getBucketUpperBound(i);
+    }
+  }
+  // a concurrent record() has incremented m_count but not yet its bucket
+  return getBucketUpperBound(N_BUCKETS - 1);
+}
+
+time::microseconds
+LatencyHistogram::getMin() const noexcept
+{
+  for (size_t i = 0; i < N_BUCKETS; ++i) {
+    if (getBucketCount(i) > 0) {
+      return getBucketLowerBound(i);
+    }
+  }
+  return time::microseconds::zero();
+}
+
+void
+LatencyHistogram::reset() noexcept
+{
+  for (auto& bucket : m_buckets) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  m_count.store(0, std::memory_order_relaxed);
+  m_sum.store(0, std::memory_order_relaxed);
+}
+
+std::ostream&
+operator<<(std::ostream& os, const LatencyHistogram& histogram)
+{
+  return os << "count=" << histogram.getCount()
+            << " min=" << histogram.getMin()
+            << " mean=" << histogram.getMean()
+            << " p50=" << histogram.getQuantile(0.50)
+            << " p90=" << histogram.getQuantile(0.90)
+            << " p99=" << histogram.getQuantile(0.99)
+            << " max=" << histogram.getMax();
+}
+
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_LATENCY_HISTOGRAM_HPP
+#define NDN_UTIL_LATENCY_HISTOGRAM_HPP
+
+#include "ndn-cxx/util/time.hpp"
+
+#include <array>
+#include <atomic>
+
+namespace ndn {
+namespace util {
+
+/** \brief Histogram of latencies with logarithmically sized buckets
+ *
+ *  Similar to an HDR histogram, latencies are counted in microseconds. Values below 16
+ *  microseconds each have their own bucket; every larger power-of-two range is divided into 16
+ *  linear sub-buckets, so that a recorded value is known within 1/16 of its magnitude.
+ *  Values above about 19 hours are counted in the last bucket.
+ *
+ *  Recording is a few arithmetic operations and relaxed atomic stores, with no allocation.
+ *  Only one thread may record into a histogram at a time, while any thread may read it.
+ */
+class LatencyHistogram : noncopyable
+{
+public:
+  static constexpr size_t N_BUCKETS = 528;
+
+  /** \brief Record one latency
+   *
+   *  Negative values are counted as zero.
+   */
+  void
+  record(time::nanoseconds latency) noexcept
+  {
+    add(time::duration_cast<time::microseconds>(latency), 1);
+  }
+
+  /** \brief Record \p count occurrences of \p latency
+   */
+  void
+  add(time::microseconds latency, uint64_t count) noexcept;
+
+  /** \return number of recorded values
+   */
+  uint64_t
+  getCount() const noexcept
+  {
+    return m_count.load(std::memory_order_relaxed);
+  }
+
+  /** \return arithmetic mean of recorded values, or zero if the histogram is empty
+   */
+  time::microseconds
+  getMean() const noexcept;
+
+  /** \return the value below or at which a fraction \p q of recorded values lie
+   *  \param q quantile in [0.0, 1.0], e.g. 0.99 for the 99th percentile
+   *
+   *  The result is the upper bound of the bucket containing the requested rank, or zero if
+   *  the histogram is empty.
+   */
+  time::microseconds
+  getQuantile(double q) const noexcept;
+
+  /** \return lower bound of the bucket containing the smallest recorded value
+   */
+  time::microseconds
+  getMin() const noexcept;
+
+  /** \return upper bound of the bucket containing the largest recorded value
+   */
+  time::microseconds
+  getMax() const noexcept
+  {
+    return getQuantile(1.0);
+  }
+
+  /** \brief Erase all recorded values
+   */
+  void
+  reset() noexcept;
+
+public: // buckets
+  /** \return number of values recorded in bucket \p index
+   */
+  uint64_t
+  getBucketCount(size_t index) const noexcept
+  {
+    return m_buckets[index].load(std::memory_order_relaxed);
+  }
+
+  /** \return index of the bucket that counts \p latency
+   */
+  static size_t
+  getBucketIndex(time::microseconds latency) noexcept;
+
+  /** \return smallest latency counted in bucket \p index
+   */
+  static time::microseconds
+  getBucketLowerBound(size_t index) noexcept;
+
+  /** \return largest latency counted in bucket \p index
+   */
+  static time::microseconds
+  getBucketUpperBound(size_t index) noexcept;
+
+private:
+  std::array<std::atomic<uint64_t>, N_BUCKETS> m_buckets{};
+  std::atomic<uint64_t> m_count{0};
+  std::atomic<uint64_t> m_sum{0}; ///< sum of recorded values in microseconds
+};
+
+std::ostream&
+operator<<(std::ostream& os, const LatencyHistogram& histogram);
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_LATENCY_HISTOGRAM_HPP
@@ -122,6 +122,41 @@ template<class T>
 using ArgumentType = typename ExtractArgument<T>::type;
 /** \endcond */
 
+class AsyncLogBuffer;
+
+/** \brief A log record for the asynchronous log destination.
+ *
+ *  The message is rendered into a buffer owned by the calling thread, and the record is
+ *  committed to the ring of that thread when this object is destroyed.
+ *  \sa Logging::setAsyncDestination
+ */
+class AsyncLogRecord : noncopyable
+{
+public:
+  /** \brief Whether log records go to the asynchronous log destination.
+   */
+  static bool
+  isEnabled()
+  {
+    return s_isEnabled.load(std::memory_order_relaxed);
+  }
+
+  AsyncLogRecord(const Logger& logger, LogLevel level);
+
+  ~AsyncLogRecord();
+
+  std::ostream&
+  stream();
+
+private:
+  AsyncLogBuffer* m_buffer;
+  bool m_isNested;
+
+  static std::atomic<bool> s_isEnabled;
+
+  friend class AsyncLogWriter;
+};
+
 } // namespace detail
 
 /** \cond */
@@ -238,8 +273,14 @@ using ArgumentType = typename ExtractArgument<T>::type;
 #define NDN_LOG_INTERNAL(lvl, expression) \
   do { \
     if (ndn_cxx_getLogger().isLevelEnabled(::ndn::util::LogLevel::lvl)) { \
-      NDN_BOOST_LOG(ndn_cxx_getLogger(), ::ndn::util::LogLevel::lvl)  \
-        << expression; \
+      if (::ndn::util::detail::AsyncLogRecord::isEnabled()) { \
+        ::ndn::util::detail::AsyncLogRecord(ndn_cxx_getLogger(), ::ndn::util::LogLevel::lvl).stream() \
+          << expression; \
+      } \
+      else { \
+        NDN_BOOST_LOG(ndn_cxx_getLogger(), ::ndn::util::LogLevel::lvl)  \
+          << expression; \
+      } \
     } \
   } while (false)
 
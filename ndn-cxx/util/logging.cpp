@@ -20,6 +20,7 @@
  */
 
 #include "ndn-cxx/util/logging.hpp"
+#include "ndn-cxx/util/impl/async-log-writer.hpp"
 #include "ndn-cxx/util/logger.hpp"
 #include "ndn-cxx/util/time.hpp"
 
@@ -47,12 +48,12 @@ namespace ndn {
 namespace util {
 namespace log {
 
-static std::string
-makeTimestamp()
+std::string
+makeTimestamp(const time::system_clock::TimePoint& timePoint)
 {
   using namespace ndn::time;
 
-  const auto sinceEpoch = system_clock::now().time_since_epoch();
+  const auto sinceEpoch = timePoint.time_since_epoch();
   BOOST_ASSERT(sinceEpoch.count() >= 0);
   // use abs() to silence truncation warning in snprintf(), see #4365
   const auto usecs = std::abs(duration_cast<microseconds>(sinceEpoch).count());
@@ -73,12 +74,20 @@ makeTimestamp()
   return buffer;
 }
 
+static std::string
+makeCurrentTimestamp()
+{
+  return makeTimestamp(time::system_clock::now());
+}
+
 BOOST_LOG_ATTRIBUTE_KEYWORD(timestamp, "Timestamp", std::string)
 
 } // namespace log
 
 static const LogLevel INITIAL_DEFAULT_LEVEL = LogLevel::NONE;
 
+constexpr size_t Logging::DEFAULT_ASYNC_BUFFER_SIZE;
+
 Logging&
 Logging::get()
 {
@@ -99,7 +108,7 @@ Logging::Logging()
     this->setLevelImpl(environ);
   }
 
-  boost::log::core::get()->add_global_attribute("Timestamp", boost::log::attributes::make_function(&log::makeTimestamp));
+  boost::log::core::get()->add_global_attribute("Timestamp", boost::log::attributes::make_function(&log::makeCurrentTimestamp));
 }
 
 void
@@ -284,6 +293,8 @@ Logging::setDestinationImpl(boost::shared_ptr<boost::log::sinks::sink> destinati
 {
   std::lock_guard<std::mutex> lock(m_mutex);
 
+  detail::AsyncLogWriter::get().stop();
+
   if (destination == m_destination) {
     return;
   }
@@ -300,6 +311,21 @@ Logging::setDestinationImpl(boost::shared_ptr<boost::log::sinks::sink> destinati
   }
 }
 
+void
+Logging::setAsyncDestinationImpl(shared_ptr<std::ostream> os, size_t bufferSize)
+{
+  this->setDestinationImpl(nullptr);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  detail::AsyncLogWriter::get().start(std::move(os), bufferSize);
+}
+
+uint64_t
+Logging::getNDroppedMessages()
+{
+  return detail::AsyncLogWriter::get().getNDropped();
+}
+
 #ifdef NDN_CXX_HAVE_TESTS
 boost::shared_ptr<boost::log::sinks::sink>
 Logging::getDestination() const
@@ -328,6 +354,7 @@ Logging::flushImpl()
 {
   std::lock_guard<std::mutex> lock(m_mutex);
 
+  detail::AsyncLogWriter::get().flush();
   if (m_destination != nullptr) {
     m_destination->flush();
   }
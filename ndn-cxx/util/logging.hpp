@@ -46,6 +46,10 @@ class Logger;
 class Logging : noncopyable
 {
 public:
+  /** \brief Default buffer size of each thread for setAsyncDestination().
+   */
+  static constexpr size_t DEFAULT_ASYNC_BUFFER_SIZE = 1 << 20;
+
   /** \brief Get list of all registered logger names.
    */
   static std::set<std::string>
@@ -104,6 +108,27 @@ public:
   static void
   setDestination(std::ostream& os);
 
+  /** \brief Set an asynchronous stream log destination.
+   *  \param os a stream for log output
+   *  \param bufferSize capacity, in octets, of the buffer of each thread that logs
+   *
+   *  Log messages bypass Boost.Log: each thread renders its messages into a lock-free buffer of
+   *  its own, and a background thread writes them to \p os using the same format as
+   *  makeDefaultStreamDestination(). A message that does not fit in the buffer is dropped
+   *  rather than blocking the logging thread; the writer reports the number of dropped messages
+   *  in the log, and getNDroppedMessages() returns the total.
+   *
+   *  This replaces the current destination. Calling setDestination() stops the background
+   *  thread and returns to logging through Boost.Log.
+   */
+  static void
+  setAsyncDestination(shared_ptr<std::ostream> os, size_t bufferSize = DEFAULT_ASYNC_BUFFER_SIZE);
+
+  /** \brief Get the number of messages dropped by the asynchronous log destination.
+   */
+  static uint64_t
+  getNDroppedMessages();
+
   /** \brief Flush log backend.
    *
    *  This ensures all log messages are written to the destination stream.
@@ -152,6 +177,9 @@ private:
   void
   setDestinationImpl(boost::shared_ptr<boost::log::sinks::sink> sink);
 
+  void
+  setAsyncDestinationImpl(shared_ptr<std::ostream> os, size_t bufferSize);
+
   void
   flushImpl();
 
@@ -210,6 +238,12 @@ Logging::setDestination(boost::shared_ptr<boost::log::sinks::sink> destination)
   get().setDestinationImpl(std::move(destination));
 }
 
+inline void
+Logging::setAsyncDestination(shared_ptr<std::ostream> os, size_t bufferSize)
+{
+  get().setAsyncDestinationImpl(std::move(os), bufferSize);
+}
+
 inline void
 Logging::flush()
 {
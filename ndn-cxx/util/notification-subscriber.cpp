@@ -33,6 +33,9 @@
 namespace ndn {
 namespace util {
 
+// number of times a missing notification is requested again before it is skipped
+const size_t MAX_GAP_RETRIES = 2;
+
 NotificationSubscriberBase::NotificationSubscriberBase(Face& face, const Name& prefix,
                                                        time::milliseconds interestLifetime)
   : m_face(face)
@@ -43,11 +46,22 @@ NotificationSubscriberBase::NotificationSubscriberBase(Face& face, const Name& p
   , m_attempts(1)
   , m_scheduler(face.getIoService())
   , m_interestLifetime(interestLifetime)
+  , m_windowSize(1)
+  , m_nextSequenceNum(0)
 {
 }
 
 NotificationSubscriberBase::~NotificationSubscriberBase() = default;
 
+void
+NotificationSubscriberBase::setWindowSize(size_t windowSize)
+{
+  if (windowSize == 0) {
+    NDN_THROW(std::invalid_argument("window size must be positive"));
+  }
+  m_windowSize = windowSize;
+}
+
 void
 NotificationSubscriberBase::start()
 {
@@ -65,12 +79,21 @@ NotificationSubscriberBase::stop()
     return;
   m_isRunning = false;
 
-  m_lastInterest.cancel();
+  reset();
+}
+
+void
+NotificationSubscriberBase::reset()
+{
+  m_initialInterest.cancel();
+  m_sequenceRequests.clear();
+  m_reorderBuffer.clear();
 }
 
 void
 NotificationSubscriberBase::sendInitialInterest()
 {
+  reset();
   if (shouldStop())
     return;
 
@@ -78,31 +101,39 @@ NotificationSubscriberBase::sendInitialInterest()
   interest->setCanBePrefix(true);
   interest->setMustBeFresh(true);
   interest->setInterestLifetime(m_interestLifetime);
-  sendInterest(*interest);
+  m_initialInterest = m_face.expressInterest(*interest,
+                                             [this] (const auto&, const auto& d) { this->afterReceiveInitialData(d); },
+                                             [this] (const auto&, const auto& n) { this->afterReceiveNack(n); },
+                                             [this] (const auto&) { this->afterTimeout(); });
 }
 
 void
-NotificationSubscriberBase::sendNextInterest()
+NotificationSubscriberBase::fillWindow()
 {
   if (shouldStop())
     return;
 
+  while (m_nextSequenceNum - m_lastSequenceNum <= m_windowSize) {
+    sendSequenceInterest(m_nextSequenceNum++, 0);
+  }
+}
+
+void
+NotificationSubscriberBase::sendSequenceInterest(uint64_t seqNum, size_t nRetries)
+{
   Name nextName = m_prefix;
-  nextName.appendSequenceNumber(m_lastSequenceNum + 1);
+  nextName.appendSequenceNumber(seqNum);
 
   auto interest = make_shared<Interest>(nextName);
   interest->setCanBePrefix(false);
   interest->setInterestLifetime(m_interestLifetime);
-  sendInterest(*interest);
-}
 
-void
-NotificationSubscriberBase::sendInterest(const Interest& interest)
-{
-  m_lastInterest = m_face.expressInterest(interest,
-                                          [this] (const auto&, const auto& d) { this->afterReceiveData(d); },
-                                          [this] (const auto&, const auto& n) { this->afterReceiveNack(n); },
-                                          [this] (const auto&) { this->afterTimeout(); });
+  auto& request = m_sequenceRequests[seqNum];
+  request.nRetries = nRetries;
+  request.interest = m_face.expressInterest(*interest,
+    [=] (const auto&, const auto& d) { this->afterReceiveSequenceData(seqNum, d); },
+    [this] (const auto&, const auto& n) { this->afterReceiveNack(n); },
+    [=] (const auto&) { this->afterSequenceTimeout(seqNum); });
 }
 
 bool
@@ -119,13 +150,14 @@ NotificationSubscriberBase::shouldStop()
 }
 
 void
-NotificationSubscriberBase::afterReceiveData(const Data& data)
+NotificationSubscriberBase::afterReceiveInitialData(const Data& data)
 {
   if (shouldStop())
     return;
 
+  uint64_t seqNum = 0;
   try {
-    m_lastSequenceNum = data.getName().get(-1).toSequenceNumber();
+    seqNum = data.getName().get(-1).toSequenceNumber();
   }
   catch (const tlv::Error&) {
     onDecodeError(data);
@@ -133,13 +165,83 @@ NotificationSubscriberBase::afterReceiveData(const Data& data)
     return;
   }
 
+  m_lastSequenceNum = seqNum;
+  m_nextSequenceNum = seqNum + 1;
   if (!decodeAndDeliver(data)) {
     onDecodeError(data);
     sendInitialInterest();
     return;
   }
 
-  sendNextInterest();
+  fillWindow();
+}
+
+void
+NotificationSubscriberBase::afterReceiveSequenceData(uint64_t seqNum, const Data& data)
+{
+  m_sequenceRequests.erase(seqNum);
+  if (shouldStop() || seqNum <= m_lastSequenceNum)
+    return;
+
+  m_reorderBuffer[seqNum] = make_shared<Data>(data);
+  if (deliverInOrder()) {
+    fillWindow();
+  }
+}
+
+bool
+NotificationSubscriberBase::deliverInOrder()
+{
+  while (!m_reorderBuffer.empty() && m_reorderBuffer.begin()->first == m_lastSequenceNum + 1) {
+    auto data = std::move(m_reorderBuffer.begin()->second);
+    m_reorderBuffer.erase(m_reorderBuffer.begin());
+    ++m_lastSequenceNum;
+
+    if (data == nullptr) {
+      onGap(m_lastSequenceNum);
+    }
+    else if (!decodeAndDeliver(*data)) {
+      onDecodeError(*data);
+      sendInitialInterest();
+      return false;
+    }
+
+    if (shouldStop())
+      return false;
+  }
+  return true;
+}
+
+void
+NotificationSubscriberBase::afterSequenceTimeout(uint64_t seqNum)
+{
+  size_t nRetries = m_sequenceRequests[seqNum].nRetries;
+  m_sequenceRequests.erase(seqNum);
+  if (shouldStop())
+    return;
+
+  bool isGap = !m_reorderBuffer.empty() && m_reorderBuffer.rbegin()->first > seqNum;
+  if (!isGap) {
+    if (seqNum == m_lastSequenceNum + 1) {
+      // nothing has been published after the last delivered notification
+      afterTimeout();
+    }
+    else {
+      sendSequenceInterest(seqNum, 0);
+    }
+    return;
+  }
+
+  // later notifications have arrived: retrieve the missing one from the publisher's history
+  if (nRetries < MAX_GAP_RETRIES) {
+    sendSequenceInterest(seqNum, nRetries + 1);
+    return;
+  }
+
+  m_reorderBuffer[seqNum] = nullptr;
+  if (deliverInOrder()) {
+    fillWindow();
+  }
 }
 
 void
@@ -149,6 +251,7 @@ NotificationSubscriberBase::afterReceiveNack(const lp::Nack& nack)
     return;
 
   onNack(nack);
+  reset();
 
   time::milliseconds delay = exponentialBackoff(nack);
   m_nackEvent = m_scheduler.schedule(delay, [this] { sendInitialInterest(); });
@@ -34,6 +34,8 @@
 #include "ndn-cxx/util/signal.hpp"
 #include "ndn-cxx/util/time.hpp"
 
+#include <map>
+
 namespace ndn {
 namespace util {
 
@@ -60,6 +62,26 @@ public:
     return m_isRunning;
   }
 
+  /** \return maximum number of notifications that are requested ahead of the last delivered one
+   */
+  size_t
+  getWindowSize() const
+  {
+    return m_windowSize;
+  }
+
+  /** \brief set maximum number of notifications that are requested ahead of the last delivered one
+   *  \throw std::invalid_argument \p windowSize is zero
+   *
+   *  With a window larger than one, Interests for several consecutive sequence numbers are
+   *  outstanding at the same time, so that more than one notification is received per round trip.
+   *  Notifications that arrive out of order are held, and delivered in order of their sequence
+   *  numbers. A notification that is missing while later ones have arrived is requested again
+   *  from the publisher's history; if it still cannot be retrieved, it is skipped and onGap fires.
+   */
+  void
+  setWindowSize(size_t windowSize);
+
   /** \brief start or resume receiving notifications
    *  \note onNotification must have at least one listener,
    *        otherwise this operation has no effect.
@@ -81,14 +103,21 @@ protected:
                              time::milliseconds interestLifetime);
 
 private:
+  /** \brief cancel outstanding Interests and drop notifications held for reordering
+   */
+  void
+  reset();
+
   void
   sendInitialInterest();
 
+  /** \brief request the notifications within the window
+   */
   void
-  sendNextInterest();
+  fillWindow();
 
   void
-  sendInterest(const Interest& interest);
+  sendSequenceInterest(uint64_t seqNum, size_t nRetries);
 
   virtual bool
   hasSubscriber() const = 0;
@@ -100,7 +129,19 @@ private:
   shouldStop();
 
   void
-  afterReceiveData(const Data& data);
+  afterReceiveInitialData(const Data& data);
+
+  void
+  afterReceiveSequenceData(uint64_t seqNum, const Data& data);
+
+  /** \brief deliver held notifications that follow the last delivered one
+   *  \return false if the subscriber has been stopped or restarted
+   */
+  bool
+  deliverInOrder();
+
+  void
+  afterSequenceTimeout(uint64_t seqNum);
 
   /** \brief decode the Data as a notification, and deliver it to subscribers
    *  \return whether decode was successful
@@ -130,6 +171,12 @@ public:
    */
   signal::Signal<NotificationSubscriberBase, Data> onDecodeError;
 
+  /** \brief fires when a notification cannot be retrieved and is skipped
+   *
+   *  The argument is the sequence number of the skipped notification.
+   */
+  signal::Signal<NotificationSubscriberBase, uint64_t> onGap;
+
 private:
   Face& m_face;
   Name m_prefix;
@@ -139,8 +186,20 @@ private:
   uint64_t m_attempts;
   Scheduler m_scheduler;
   scheduler::ScopedEventId m_nackEvent;
-  ScopedPendingInterestHandle m_lastInterest;
+  ScopedPendingInterestHandle m_initialInterest;
   time::milliseconds m_interestLifetime;
+
+  size_t m_windowSize;
+  // next sequence number to request
+  uint64_t m_nextSequenceNum;
+  struct SequenceRequest
+  {
+    ScopedPendingInterestHandle interest;
+    size_t nRetries;
+  };
+  std::map<uint64_t, SequenceRequest> m_sequenceRequests;
+  // notifications received ahead of the last delivered one; nullptr marks a lost notification
+  std::map<uint64_t, shared_ptr<const Data>> m_reorderBuffer;
 };
 
 /** \brief provides a subscriber of Notification Stream
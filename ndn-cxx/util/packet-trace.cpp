@@ -0,0 +1,230 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/util/packet-trace.hpp"
+#include "ndn-cxx/transport/detail/shm-ring.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ndn {
+namespace util {
+
+using ndn::detail::ShmRing;
+
+const char TRACE_MAGIC[8] = {'N', 'D', 'N', 'T', 'R', 'A', 'C', 'E'};
+const uint32_t TRACE_VERSION = 1;
+
+/** \brief size of the file header; the ring follows it
+ */
+const size_t FILE_HEADER_SIZE = 64;
+
+const size_t MIN_CAPACITY = 64 * 1024;
+
+struct FileHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+};
+
+struct RecordHeader
+{
+  time::system_clock::Duration::rep timestamp;
+  PacketDirection direction;
+  uint8_t reserved[7];
+};
+
+static_assert(sizeof(FileHeader) <= FILE_HEADER_SIZE, "");
+static_assert(sizeof(RecordHeader) == 16, "");
+
+static std::string
+getErrorMessage(const std::string& what)
+{
+  return what + ": " + std::strerror(errno);
+}
+
+std::ostream&
+operator<<(std::ostream& os, PacketDirection direction)
+{
+  switch (direction) {
+    case PacketDirection::INCOMING:
+      return os << "in";
+    case PacketDirection::OUTGOING:
+      return os << "out";
+  }
+  return os << to_underlying(direction);
+}
+
+constexpr size_t PacketTraceWriter::DEFAULT_CAPACITY;
+
+PacketTraceWriter::PacketTraceWriter(const std::string& filename, size_t capacity)
+{
+  size_t ringCapacity = MIN_CAPACITY;
+  while (ringCapacity < capacity) {
+    ringCapacity <<= 1;
+  }
+  m_mappingSize = FILE_HEADER_SIZE + ShmRing::computeSize(ringCapacity);
+
+  m_fd = ::open(filename.data(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (m_fd < 0) {
+    NDN_THROW(Error(getErrorMessage("Cannot create " + filename)));
+  }
+  if (::ftruncate(m_fd, static_cast<off_t>(m_mappingSize)) < 0) {
+    auto message = getErrorMessage("Cannot resize " + filename);
+    ::close(m_fd);
+    NDN_THROW(Error(message));
+  }
+  m_memory = ::mmap(nullptr, m_mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (m_memory == MAP_FAILED) {
+    auto message = getErrorMessage("Cannot map " + filename);
+    ::close(m_fd);
+    NDN_THROW(Error(message));
+  }
+
+  auto ringMemory = static_cast<uint8_t*>(m_memory) + FILE_HEADER_SIZE;
+  ShmRing::initialize(ringMemory, ringCapacity);
+  m_ring = make_unique<ShmRing>(ringMemory, m_mappingSize - FILE_HEADER_SIZE);
+
+  // the magic is written last, so that a file is never mistaken for a trace before it is one
+  FileHeader header{};
+  header.version = TRACE_VERSION;
+  std::memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+  std::memcpy(m_memory, &header, sizeof(header));
+}
+
+PacketTraceWriter::~PacketTraceWriter()
+{
+  ::munmap(m_memory, m_mappingSize);
+  ::close(m_fd);
+}
+
+void
+PacketTraceWriter::write(PacketDirection direction, const Block& wire)
+{
+  if (wire.size() > MAX_NDN_PACKET_SIZE) {
+    return;
+  }
+
+  RecordHeader header{};
+  header.timestamp = time::system_clock::now().time_since_epoch().count();
+  header.direction = direction;
+
+  // overwrite the oldest records until the new one fits
+  while (!m_ring->tryWrite(reinterpret_cast<const uint8_t*>(&header), sizeof(header),
+                           wire.wire(), wire.size())) {
+    m_ring->peek();
+    m_ring->pop();
+  }
+  ++m_nRecords;
+}
+
+PacketTraceReader::PacketTraceReader(const std::string& filename)
+{
+  int fd = ::open(filename.data(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    NDN_THROW(Error(getErrorMessage("Cannot open " + filename)));
+  }
+  struct stat st;
+  if (::fstat(fd, &st) < 0) {
+    auto message = getErrorMessage("Cannot stat " + filename);
+    ::close(fd);
+    NDN_THROW(Error(message));
+  }
+  m_mappingSize = static_cast<size_t>(st.st_size);
+  if (m_mappingSize < FILE_HEADER_SIZE) {
+    ::close(fd);
+    NDN_THROW(Error(filename + " is not a packet trace"));
+  }
+
+  // a private mapping, because reading records advances the position stored in the ring
+  m_memory = ::mmap(nullptr, m_mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (m_memory == MAP_FAILED) {
+    NDN_THROW(Error(getErrorMessage("Cannot map " + filename)));
+  }
+
+  FileHeader header;
+  std::memcpy(&header, m_memory, sizeof(header));
+  if (std::memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0) {
+    ::munmap(m_memory, m_mappingSize);
+    NDN_THROW(Error(filename + " is not a packet trace"));
+  }
+  if (header.version != TRACE_VERSION) {
+    ::munmap(m_memory, m_mappingSize);
+    NDN_THROW(Error(filename + " has unsupported version " + to_string(header.version)));
+  }
+
+  try {
+    m_ring = make_unique<ShmRing>(static_cast<uint8_t*>(m_memory) + FILE_HEADER_SIZE,
+                                  m_mappingSize - FILE_HEADER_SIZE);
+  }
+  catch (const std::invalid_argument& e) {
+    ::munmap(m_memory, m_mappingSize);
+    NDN_THROW(Error(filename + " is corrupted: " + e.what()));
+  }
+}
+
+PacketTraceReader::~PacketTraceReader()
+{
+  ::munmap(m_memory, m_mappingSize);
+}
+
+optional<PacketTraceReader::Record>
+PacketTraceReader::read()
+{
+  const uint8_t* buf = nullptr;
+  size_t size = 0;
+  try {
+    std::tie(buf, size) = m_ring->peek();
+  }
+  catch (const ShmRing::Error&) {
+    NDN_THROW_NESTED(Error("Malformed trace record"));
+  }
+  if (buf == nullptr) {
+    return nullopt;
+  }
+  if (size < sizeof(RecordHeader)) {
+    NDN_THROW(Error("Truncated trace record"));
+  }
+
+  RecordHeader header;
+  std::memcpy(&header, buf, sizeof(header));
+
+  Record record;
+  record.timestamp = time::system_clock::TimePoint(time::system_clock::Duration(header.timestamp));
+  record.direction = header.direction;
+  try {
+    record.wire = Block(buf + sizeof(header), size - sizeof(header));
+  }
+  catch (const tlv::Error&) {
+    NDN_THROW_NESTED(Error("Trace record does not contain a TLV element"));
+  }
+  m_ring->pop();
+  return record;
+}
+
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_PACKET_TRACE_HPP
+#define NDN_UTIL_PACKET_TRACE_HPP
+
+#include "ndn-cxx/encoding/block.hpp"
+#include "ndn-cxx/util/time.hpp"
+
+namespace ndn {
+
+namespace detail {
+class ShmRing;
+} // namespace detail
+
+namespace util {
+
+/** \brief Direction of a traced packet.
+ */
+enum class PacketDirection : uint8_t {
+  INCOMING = 0, ///< received from the forwarder
+  OUTGOING = 1, ///< sent to the forwarder
+};
+
+std::ostream&
+operator<<(std::ostream& os, PacketDirection direction);
+
+/** \brief Appends packets to a memory-mapped trace file.
+ *
+ *  The trace file is a ring of records, each containing the time at which the packet was
+ *  traced, its direction, and its wire encoding, including any NDNLPv2 headers. Once the ring
+ *  is full, the oldest records are overwritten. Writing a record copies the wire encoding
+ *  once into the mapping and performs no formatting; the kernel writes the mapped pages back
+ *  to the file, so the trace survives a crash of the process.
+ *
+ *  \sa PacketTraceReader
+ */
+class PacketTraceWriter : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /** \brief Create a trace file, replacing any existing file.
+   *  \param filename path of the trace file
+   *  \param capacity size of the ring in octets, rounded up to a power of two of at least 64 KiB
+   *  \throw Error the file cannot be created or mapped
+   */
+  explicit
+  PacketTraceWriter(const std::string& filename, size_t capacity = DEFAULT_CAPACITY);
+
+  ~PacketTraceWriter();
+
+  /** \brief Append a record.
+   *
+   *  A packet larger than MAX_NDN_PACKET_SIZE is not recorded.
+   */
+  void
+  write(PacketDirection direction, const Block& wire);
+
+  /** \return number of records written, including overwritten ones
+   */
+  uint64_t
+  getNRecords() const
+  {
+    return m_nRecords;
+  }
+
+public:
+  static constexpr size_t DEFAULT_CAPACITY = 64 * 1024 * 1024;
+
+private:
+  int m_fd;
+  void* m_memory;
+  size_t m_mappingSize;
+  unique_ptr<ndn::detail::ShmRing> m_ring;
+  uint64_t m_nRecords = 0;
+};
+
+/** \brief Reads the records of a trace file created by PacketTraceWriter, oldest first.
+ *
+ *  The file should not be written while it is being read.
+ */
+class PacketTraceReader : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  struct Record
+  {
+    time::system_clock::TimePoint timestamp;
+    PacketDirection direction;
+    Block wire;
+  };
+
+  /** \brief Open a trace file.
+   *  \throw Error the file cannot be opened or is not a trace file
+   */
+  explicit
+  PacketTraceReader(const std::string& filename);
+
+  ~PacketTraceReader();
+
+  /** \brief Read the next record.
+   *  \return the record, or nullopt after the last record
+   *  \throw Error the record is malformed
+   */
+  optional<Record>
+  read();
+
+private:
+  void* m_memory;
+  size_t m_mappingSize;
+  unique_ptr<ndn::detail::ShmRing> m_ring;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_PACKET_TRACE_HPP
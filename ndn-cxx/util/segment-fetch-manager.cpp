@@ -0,0 +1,285 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/util/segment-fetch-manager.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ndn {
+namespace util {
+
+void
+SegmentFetchManager::Options::validate() const
+{
+  if (maxInFlight < 1) {
+    NDN_THROW(std::invalid_argument("maxInFlight must be greater than or equal to 1"));
+  }
+
+  SegmentFetcher::Options(fetcherOptions).validate();
+}
+
+SegmentFetchManager::CongestionState::CongestionState(const SegmentFetcher::Options& options)
+  : cwnd(options.initCwnd)
+  , ssthresh(options.initSsthresh)
+  , cc(options.createCongestionControl())
+  , rttEstimator(make_shared<RttEstimator::Options>(options.rttOptions))
+{
+}
+
+SegmentFetchManager::SegmentFetchManager(Face& face, const Options& options)
+  : m_face(face)
+  , m_options(options)
+  , m_scheduler(face.getIoService())
+{
+  m_options.validate();
+}
+
+SegmentFetchManager::~SegmentFetchManager()
+{
+  // prevent stopped fetches from handing their window space to the remaining ones
+  m_isScheduling = true;
+  while (!m_fetches.empty()) {
+    m_fetches.begin()->second.fetcher->stop();
+  }
+}
+
+shared_ptr<SegmentFetcher>
+SegmentFetchManager::fetch(const Interest& baseInterest, security::v2::Validator& validator,
+                           int priority)
+{
+  return fetch(baseInterest, validator, m_options.fetcherOptions, priority);
+}
+
+shared_ptr<SegmentFetcher>
+SegmentFetchManager::fetch(const Interest& baseInterest, security::v2::Validator& validator,
+                           const SegmentFetcher::Options& options, int priority)
+{
+  shared_ptr<SegmentFetcher> fetcher(new SegmentFetcher(m_face, validator, options));
+  fetcher->m_this = fetcher;
+  fetcher->setManager(this, baseInterest);
+
+  // a new fetch has not been served yet, so it goes behind the other waiting fetches, but ahead
+  // of the fetches that have already been served
+  auto& queue = m_queues[priority];
+  auto pos = std::find_if(queue.begin(), queue.end(),
+                          [this] (SegmentFetcher* f) { return getFetch(*f).isStarted; });
+  Fetch fetch{fetcher.get(), &getCongestionState(baseInterest.getName()),
+              queue.insert(pos, fetcher.get()), priority, false};
+  m_fetches.emplace(fetcher.get(), fetch);
+
+  schedule();
+  return fetcher;
+}
+
+double
+SegmentFetchManager::getCwnd(const Name& prefix) const
+{
+  auto state = findCongestionState(prefix);
+  return state == nullptr ? 0.0 : state->cwnd;
+}
+
+const RttEstimatorWithStats*
+SegmentFetchManager::getRttEstimator(const Name& prefix) const
+{
+  auto state = findCongestionState(prefix);
+  return state == nullptr ? nullptr : &state->rttEstimator;
+}
+
+SegmentFetchManager::Fetch&
+SegmentFetchManager::getFetch(const SegmentFetcher& fetcher)
+{
+  auto it = m_fetches.find(&fetcher);
+  BOOST_ASSERT(it != m_fetches.end());
+  return it->second;
+}
+
+SegmentFetchManager::CongestionState&
+SegmentFetchManager::getCongestionState(const Name& name)
+{
+  auto& state = m_states[name.getPrefix(m_options.congestionPrefixLength)];
+  if (state == nullptr) {
+    state = make_unique<CongestionState>(m_options.fetcherOptions);
+  }
+  return *state;
+}
+
+const SegmentFetchManager::CongestionState*
+SegmentFetchManager::findCongestionState(const Name& prefix) const
+{
+  auto it = m_states.find(prefix.getPrefix(m_options.congestionPrefixLength));
+  return it == m_states.end() ? nullptr : it->second.get();
+}
+
+void
+SegmentFetchManager::schedule()
+{
+  if (m_isScheduling) {
+    return;
+  }
+  m_isScheduling = true;
+
+  bool hasSent = true;
+  while (hasSent && m_nInFlight < m_options.maxInFlight) {
+    hasSent = false;
+    for (auto& level : m_queues) {
+      auto& queue = level.second;
+      // offer the window to the fetches of this priority, starting with the one that has waited
+      // the longest; a fetch that sends an Interest moves to the back of the queue
+      for (auto it = queue.begin(); it != queue.end(); ++it) {
+        if (trySend(getFetch(**it))) {
+          queue.splice(queue.end(), queue, it);
+          hasSent = true;
+          break;
+        }
+      }
+      if (hasSent) {
+        break;
+      }
+    }
+  }
+
+  m_isScheduling = false;
+}
+
+void
+SegmentFetchManager::scheduleLater()
+{
+  if (!m_scheduleEvent) {
+    m_scheduleEvent = m_scheduler.schedule(0_ns, [this] { schedule(); });
+  }
+}
+
+bool
+SegmentFetchManager::trySend(Fetch& fetch)
+{
+  if (static_cast<double>(fetch.state->nInFlight) >= std::floor(fetch.state->cwnd)) {
+    return false;
+  }
+
+  if (!fetch.isStarted) {
+    fetch.isStarted = true;
+    fetch.fetcher->fetchFirstSegment(fetch.fetcher->m_templateInterest, false);
+    return true;
+  }
+  return fetch.fetcher->requestNextSegment();
+}
+
+void
+SegmentFetchManager::remove(const SegmentFetcher& fetcher)
+{
+  auto it = m_fetches.find(&fetcher);
+  if (it == m_fetches.end()) {
+    return;
+  }
+
+  // Interests of a stopped fetcher are canceled without being reported
+  Fetch& fetch = it->second;
+  auto nInFlight = static_cast<size_t>(fetcher.m_nSegmentsInFlight);
+  BOOST_ASSERT(fetch.state->nInFlight >= nInFlight && m_nInFlight >= nInFlight);
+  fetch.state->nInFlight -= nInFlight;
+  m_nInFlight -= nInFlight;
+
+  auto queueIt = m_queues.find(fetch.priority);
+  queueIt->second.erase(fetch.queuePos);
+  if (queueIt->second.empty()) {
+    m_queues.erase(queueIt);
+  }
+  m_fetches.erase(it);
+
+  scheduleLater();
+}
+
+void
+SegmentFetchManager::afterInterestSent(const SegmentFetcher& fetcher)
+{
+  ++getFetch(fetcher).state->nInFlight;
+  ++m_nInFlight;
+}
+
+void
+SegmentFetchManager::afterInterestFinished(const SegmentFetcher& fetcher)
+{
+  auto& state = *getFetch(fetcher).state;
+  BOOST_ASSERT(state.nInFlight > 0 && m_nInFlight > 0);
+  --state.nInFlight;
+  --m_nInFlight;
+
+  // the fetcher usually requests more segments right away, but the window space may also be
+  // needed by another fetch
+  scheduleLater();
+}
+
+void
+SegmentFetchManager::addRttMeasurement(const SegmentFetcher& fetcher, time::nanoseconds rtt)
+{
+  auto& state = *getFetch(fetcher).state;
+  state.rttEstimator.addMeasurement(rtt, state.nInFlight + 1);
+}
+
+time::nanoseconds
+SegmentFetchManager::getSmoothedRtt(const SegmentFetcher& fetcher)
+{
+  const auto& rttEstimator = getFetch(fetcher).state->rttEstimator;
+  return rttEstimator.hasSamples() ? rttEstimator.getSmoothedRtt() : -1_ns;
+}
+
+time::nanoseconds
+SegmentFetchManager::getEstimatedRto(const SegmentFetcher& fetcher)
+{
+  return getFetch(fetcher).state->rttEstimator.getEstimatedRto();
+}
+
+void
+SegmentFetchManager::backoffRto(const SegmentFetcher& fetcher)
+{
+  // timeouts of Interests sent around the same time by different fetches are one event;
+  // back off at most once per RTO
+  auto& state = *getFetch(fetcher).state;
+  auto now = time::steady_clock::now();
+  if (now - state.lastBackoff >= state.rttEstimator.getEstimatedRto()) {
+    state.rttEstimator.backoffRto();
+    state.lastBackoff = now;
+  }
+}
+
+void
+SegmentFetchManager::windowIncrease(const SegmentFetcher& fetcher, const CongestionControl::Ack& ack)
+{
+  auto& state = *getFetch(fetcher).state;
+  state.cc->increase(state.cwnd, state.ssthresh, ack);
+}
+
+void
+SegmentFetchManager::windowDecrease(const SegmentFetcher& fetcher)
+{
+  // each fetch detects a loss event separately; reduce the shared window at most once per RTT
+  auto& state = *getFetch(fetcher).state;
+  auto now = time::steady_clock::now();
+  if (state.rttEstimator.hasSamples() && now - state.lastDecrease < state.rttEstimator.getSmoothedRtt()) {
+    return;
+  }
+  state.cc->decrease(state.cwnd, state.ssthresh, now);
+  state.lastDecrease = now;
+}
+
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,240 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_SEGMENT_FETCH_MANAGER_HPP
+#define NDN_UTIL_SEGMENT_FETCH_MANAGER_HPP
+
+#include "ndn-cxx/util/segment-fetcher.hpp"
+
+#include <list>
+#include <unordered_map>
+
+namespace ndn {
+namespace util {
+
+/**
+ * @brief Runs many SegmentFetcher retrievals over shared congestion state.
+ *
+ * Fetches whose base Interest names share the first Options::congestionPrefixLength components
+ * use one congestion window and one RttEstimatorWithStats, instead of each running its own
+ * slow start against the same producer. The congestion state of a prefix outlives individual
+ * fetches, so that later fetches start from what earlier ones have learned.
+ *
+ * Whenever window space is available, the manager hands it out one Interest at a time:
+ * - fetches with a higher priority are served first;
+ * - fetches of equal priority are served round-robin;
+ * - a fetch whose congestion window is full does not block fetches in other windows;
+ * - the total number of in-flight Interests never exceeds Options::maxInFlight.
+ *
+ * Fetches that have not expressed their first Interest yet wait in the same queue.
+ *
+ * Example:
+ *     @code
+ *     SegmentFetchManager manager(face);
+ *     for (const auto& name : names) {
+ *       auto fetcher = manager.fetch(Interest(name), validator);
+ *       fetcher->onComplete.connect(...);
+ *       fetcher->onError.connect(...);
+ *     }
+ *     @endcode
+ */
+class SegmentFetchManager : noncopyable
+{
+public:
+  class Options
+  {
+  public:
+    Options()
+    {
+    }
+
+    void
+    validate() const;
+
+  public:
+    size_t maxInFlight = 1000; ///< maximum number of in-flight Interests across all fetches
+    /// number of leading name components identifying fetches that share congestion state;
+    /// 0 means that all fetches share a single congestion window
+    size_t congestionPrefixLength = 0;
+    /// default options of fetches; the congestion control parameters and RTT estimator options
+    /// also configure the shared congestion windows
+    SegmentFetcher::Options fetcherOptions;
+  };
+
+  explicit
+  SegmentFetchManager(Face& face, const Options& options = Options());
+
+  /**
+   * @brief Stops all fetches that have not completed yet.
+   */
+  ~SegmentFetchManager();
+
+  /**
+   * @brief Starts retrieving a segmented object.
+   *
+   * The arguments have the same meaning as in SegmentFetcher::start(). The retrieval uses
+   * Options::fetcherOptions.
+   *
+   * @param priority fetches with a higher value are served first
+   * @return the SegmentFetcher whose signals report the outcome of the retrieval. Its first
+   *         Interest may be expressed later than with SegmentFetcher::start().
+   */
+  shared_ptr<SegmentFetcher>
+  fetch(const Interest& baseInterest, security::v2::Validator& validator, int priority = 0);
+
+  /**
+   * @brief Starts retrieving a segmented object with per-fetch options.
+   *
+   * The congestion control and RTT estimator settings in @p options are ignored in favor of the
+   * shared state, which is configured by Options::fetcherOptions.
+   */
+  shared_ptr<SegmentFetcher>
+  fetch(const Interest& baseInterest, security::v2::Validator& validator,
+        const SegmentFetcher::Options& options, int priority = 0);
+
+  /**
+   * @brief Returns the number of fetches that have neither completed nor failed.
+   */
+  size_t
+  getNFetches() const
+  {
+    return m_fetches.size();
+  }
+
+  /**
+   * @brief Returns the number of in-flight Interests across all fetches.
+   */
+  size_t
+  getNInFlight() const
+  {
+    return m_nInFlight;
+  }
+
+  /**
+   * @brief Returns the congestion window shared by fetches under @p prefix.
+   * @return the window size, or 0 if no fetch has used this congestion state yet
+   */
+  double
+  getCwnd(const Name& prefix) const;
+
+  /**
+   * @brief Returns the RTT estimator shared by fetches under @p prefix.
+   * @return the estimator, or nullptr if no fetch has used this congestion state yet
+   */
+  const RttEstimatorWithStats*
+  getRttEstimator(const Name& prefix) const;
+
+private:
+  struct CongestionState
+  {
+    CongestionState(const SegmentFetcher::Options& options);
+
+    double cwnd;
+    double ssthresh;
+    unique_ptr<CongestionControl> cc;
+    RttEstimatorWithStats rttEstimator;
+    size_t nInFlight = 0;
+    time::steady_clock::TimePoint lastDecrease;
+    time::steady_clock::TimePoint lastBackoff;
+  };
+
+  struct Fetch
+  {
+    SegmentFetcher* fetcher;
+    CongestionState* state;
+    std::list<SegmentFetcher*>::iterator queuePos;
+    int priority;
+    bool isStarted;
+  };
+
+  Fetch&
+  getFetch(const SegmentFetcher& fetcher);
+
+  CongestionState&
+  getCongestionState(const Name& name);
+
+  const CongestionState*
+  findCongestionState(const Name& prefix) const;
+
+  /**
+   * @brief Sends one Interest on behalf of @p fetch, if its window and the global limit allow.
+   */
+  bool
+  trySend(Fetch& fetch);
+
+  /**
+   * @brief Calls schedule() from the event loop, so that it does not run within the processing
+   *        of a packet by a fetcher.
+   */
+  void
+  scheduleLater();
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE: // called by SegmentFetcher
+  /**
+   * @brief Hands out available window space to fetches.
+   */
+  void
+  schedule();
+
+  void
+  remove(const SegmentFetcher& fetcher);
+
+  void
+  afterInterestSent(const SegmentFetcher& fetcher);
+
+  void
+  afterInterestFinished(const SegmentFetcher& fetcher);
+
+  void
+  addRttMeasurement(const SegmentFetcher& fetcher, time::nanoseconds rtt);
+
+  time::nanoseconds
+  getSmoothedRtt(const SegmentFetcher& fetcher);
+
+  time::nanoseconds
+  getEstimatedRto(const SegmentFetcher& fetcher);
+
+  void
+  backoffRto(const SegmentFetcher& fetcher);
+
+  void
+  windowIncrease(const SegmentFetcher& fetcher, const CongestionControl::Ack& ack);
+
+  void
+  windowDecrease(const SegmentFetcher& fetcher);
+
+private:
+  Face& m_face;
+  Options m_options;
+  std::map<Name, unique_ptr<CongestionState>> m_states;
+  std::unordered_map<const SegmentFetcher*, Fetch> m_fetches;
+  /// round-robin queue of each priority level, highest priority first
+  std::map<int, std::list<SegmentFetcher*>, std::greater<int>> m_queues;
+  Scheduler m_scheduler;
+  scheduler::ScopedEventId m_scheduleEvent;
+  size_t m_nInFlight = 0;
+  bool m_isScheduling = false;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_SEGMENT_FETCH_MANAGER_HPP
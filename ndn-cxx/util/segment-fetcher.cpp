@@ -26,8 +26,8 @@
  */
 
 #include "ndn-cxx/util/segment-fetcher.hpp"
+#include "ndn-cxx/util/segment-fetch-manager.hpp"
 #include "ndn-cxx/name-component.hpp"
-#include "ndn-cxx/encoding/buffer-stream.hpp"
 #include "ndn-cxx/lp/nack.hpp"
 #include "ndn-cxx/lp/nack-header.hpp"
 
@@ -35,13 +35,9 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/range/adaptor/map.hpp>
 
-#include <cmath>
-
 namespace ndn {
 namespace util {
 
-constexpr double SegmentFetcher::MIN_SSTHRESH;
-
 void
 SegmentFetcher::Options::validate()
 {
@@ -60,6 +56,40 @@ SegmentFetcher::Options::validate()
   if (mdCoef < 0.0 || mdCoef > 1.0) {
     NDN_THROW(std::invalid_argument("mdCoef must be in range [0, 1]"));
   }
+
+  if (cubicBeta <= 0.0 || cubicBeta >= 1.0) {
+    NDN_THROW(std::invalid_argument("cubicBeta must be in range (0, 1)"));
+  }
+
+  if (cubicC <= 0.0) {
+    NDN_THROW(std::invalid_argument("cubicC must be greater than 0"));
+  }
+
+  if (!skipSegments.empty() && !inOrder) {
+    NDN_THROW(std::invalid_argument("skipSegments requires inOrder"));
+  }
+}
+
+unique_ptr<CongestionControl>
+SegmentFetcher::Options::createCongestionControl() const
+{
+  if (makeCongestionControl) {
+    auto cc = makeCongestionControl();
+    if (cc == nullptr) {
+      NDN_THROW(std::invalid_argument("makeCongestionControl must return a CongestionControl"));
+    }
+    return cc;
+  }
+
+  switch (ccAlgorithm) {
+    case CongestionControlAlgorithm::AIMD:
+      return make_unique<AimdCongestionControl>(aiStep, mdCoef, initCwnd, resetCwndToInit);
+    case CongestionControlAlgorithm::CUBIC:
+      return make_unique<CubicCongestionControl>(cubicBeta, cubicC);
+    case CongestionControlAlgorithm::BBR:
+      return make_unique<BbrCongestionControl>();
+  }
+  NDN_THROW(std::invalid_argument("Unknown congestion control algorithm"));
 }
 
 SegmentFetcher::SegmentFetcher(Face& face,
@@ -79,10 +109,20 @@ SegmentFetcher::SegmentFetcher(Face& face,
   , m_highInterest(0)
   , m_highData(0)
   , m_recPoint(0)
-  , m_nReceived(0)
+  , m_nReceived(static_cast<int64_t>(options.skipSegments.size()))
   , m_nBytesReceived(0)
+  , m_nextSegmentInOrder(0)
 {
   m_options.validate();
+  m_receivedSegments = m_options.skipSegments;
+  m_cc = m_options.createCongestionControl();
+}
+
+void
+SegmentFetcher::setManager(SegmentFetchManager* manager, const Interest& baseInterest)
+{
+  m_manager = manager;
+  m_templateInterest = baseInterest;
 }
 
 shared_ptr<SegmentFetcher>
@@ -106,6 +146,12 @@ SegmentFetcher::stop()
 
   m_pendingSegments.clear(); // cancels pending Interests and timeout events
   m_face.getIoService().post([self = std::move(m_this)] {});
+
+  if (m_manager != nullptr) {
+    auto manager = m_manager;
+    m_manager = nullptr;
+    manager->remove(*this);
+  }
 }
 
 bool
@@ -137,43 +183,82 @@ SegmentFetcher::fetchSegmentsInWindow(const Interest& origInterest)
     return finalizeFetch();
   }
 
+  if (m_manager != nullptr) {
+    // the manager decides when this fetcher may use the shared window
+    return m_manager->schedule();
+  }
+
   int64_t availableWindowSize = static_cast<int64_t>(m_cwnd) - m_nSegmentsInFlight;
   std::vector<std::pair<uint64_t, bool>> segmentsToRequest; // The boolean indicates whether a retx or not
 
-  while (availableWindowSize > 0) {
-    if (!m_retxQueue.empty()) {
-      auto pendingSegmentIt = m_pendingSegments.find(m_retxQueue.front());
-      m_retxQueue.pop();
-      if (pendingSegmentIt == m_pendingSegments.end()) {
-        // Skip re-requesting this segment, since it was received after RTO timeout
-        continue;
-      }
-      BOOST_ASSERT(pendingSegmentIt->second.state == SegmentState::InRetxQueue);
-      segmentsToRequest.emplace_back(pendingSegmentIt->first, true);
-    }
-    else if (m_nSegments == 0 || m_nextSegmentNum < static_cast<uint64_t>(m_nSegments)) {
-      if (m_receivedSegments.count(m_nextSegmentNum) > 0) {
-        // Don't request a segment a second time if received in response to first "discovery" Interest
-        m_nextSegmentNum++;
-        continue;
-      }
-      segmentsToRequest.emplace_back(m_nextSegmentNum++, false);
-    }
-    else {
-      break;
-    }
+  uint64_t segNum = 0;
+  bool isRetransmission = false;
+  while (availableWindowSize > 0 && nextSegmentToRequest(segNum, isRetransmission)) {
+    segmentsToRequest.emplace_back(segNum, isRetransmission);
     availableWindowSize--;
   }
 
   for (const auto& segment : segmentsToRequest) {
-    Interest interest(origInterest); // to preserve Interest elements
-    interest.setName(Name(m_versionedDataName).appendSegment(segment.first));
-    interest.setCanBePrefix(false);
-    interest.setMustBeFresh(false);
-    interest.setInterestLifetime(m_options.interestLifetime);
-    interest.refreshNonce();
-    sendInterest(segment.first, interest, segment.second);
+    requestSegment(origInterest, segment.first, segment.second);
+  }
+}
+
+bool
+SegmentFetcher::nextSegmentToRequest(uint64_t& segNum, bool& isRetransmission)
+{
+  while (!m_retxQueue.empty()) {
+    auto pendingSegmentIt = m_pendingSegments.find(m_retxQueue.front());
+    m_retxQueue.pop();
+    if (pendingSegmentIt == m_pendingSegments.end()) {
+      // Skip re-requesting this segment, since it was received after RTO timeout
+      continue;
+    }
+    BOOST_ASSERT(pendingSegmentIt->second.state == SegmentState::InRetxQueue);
+    segNum = pendingSegmentIt->first;
+    isRetransmission = true;
+    return true;
+  }
+
+  while (m_nSegments == 0 || m_nextSegmentNum < static_cast<uint64_t>(m_nSegments)) {
+    if (m_receivedSegments.count(m_nextSegmentNum) > 0) {
+      // Don't request a segment a second time if received in response to first "discovery" Interest
+      m_nextSegmentNum++;
+      continue;
+    }
+    segNum = m_nextSegmentNum++;
+    isRetransmission = false;
+    return true;
   }
+  return false;
+}
+
+void
+SegmentFetcher::requestSegment(const Interest& origInterest, uint64_t segNum, bool isRetransmission)
+{
+  Interest interest(origInterest); // to preserve Interest elements
+  interest.setName(Name(m_versionedDataName).appendSegment(segNum));
+  interest.setCanBePrefix(false);
+  interest.setMustBeFresh(false);
+  interest.setInterestLifetime(m_options.interestLifetime);
+  interest.refreshNonce();
+  sendInterest(segNum, interest, isRetransmission);
+}
+
+bool
+SegmentFetcher::requestNextSegment()
+{
+  if (m_this == nullptr || m_versionedDataName.empty()) {
+    // stopped, or the version is still being discovered
+    return false;
+  }
+
+  uint64_t segNum = 0;
+  bool isRetransmission = false;
+  if (!nextSegmentToRequest(segNum, isRetransmission)) {
+    return false;
+  }
+  requestSegment(m_templateInterest, segNum, isRetransmission);
+  return true;
 }
 
 void
@@ -182,6 +267,9 @@ SegmentFetcher::sendInterest(uint64_t segNum, const Interest& interest, bool isR
   weak_ptr<SegmentFetcher> weakSelf = m_this;
 
   ++m_nSegmentsInFlight;
+  if (m_manager != nullptr) {
+    m_manager->afterInterestSent(*this);
+  }
   auto pendingInterest = m_face.expressInterest(interest,
     [this, weakSelf] (const Interest& interest, const Data& data) {
       afterSegmentReceivedCb(interest, data, weakSelf);
@@ -215,8 +303,7 @@ SegmentFetcher::afterSegmentReceivedCb(const Interest& origInterest, const Data&
   if (shouldStop(weakSelf))
     return;
 
-  BOOST_ASSERT(m_nSegmentsInFlight > 0);
-  m_nSegmentsInFlight--;
+  afterInterestFinished();
 
   name::Component currentSegmentComponent = data.getName().get(-1);
   if (!currentSegmentComponent.isSegment()) {
@@ -227,7 +314,7 @@ SegmentFetcher::afterSegmentReceivedCb(const Interest& origInterest, const Data&
 
   // The first received Interest could have any segment ID
   std::map<uint64_t, PendingSegment>::iterator pendingSegmentIt;
-  if (m_receivedSegments.size() > 0) {
+  if (!m_versionedDataName.empty()) {
     pendingSegmentIt = m_pendingSegments.find(currentSegment);
   }
   else {
@@ -264,22 +351,33 @@ SegmentFetcher::afterValidationSuccess(const Data& data, const Interest& origInt
 
   // It was verified in afterSegmentReceivedCb that the last Data name component is a segment number
   uint64_t currentSegment = data.getName().get(-1).toSegment();
+  CongestionControl::Ack ack;
+  ack.time = m_timeLastSegmentReceived;
   // Add measurement to RTO estimator (if not retransmission)
   if (pendingSegmentIt->second.state == SegmentState::FirstInterest) {
     BOOST_ASSERT(m_nSegmentsInFlight >= 0);
-    m_rttEstimator.addMeasurement(m_timeLastSegmentReceived - pendingSegmentIt->second.sendTime,
-                                  static_cast<size_t>(m_nSegmentsInFlight) + 1);
+    ack.rtt = m_timeLastSegmentReceived - pendingSegmentIt->second.sendTime;
+    if (m_manager != nullptr) {
+      m_manager->addRttMeasurement(*this, ack.rtt);
+    }
+    else {
+      m_rttEstimator.addMeasurement(ack.rtt, static_cast<size_t>(m_nSegmentsInFlight) + 1);
+    }
+  }
+  if (m_manager != nullptr) {
+    ack.sRtt = m_manager->getSmoothedRtt(*this);
+  }
+  else if (m_rttEstimator.hasSamples()) {
+    ack.sRtt = m_rttEstimator.getSmoothedRtt();
   }
 
   // Remove from pending segments map
   m_pendingSegments.erase(pendingSegmentIt);
 
-  // Copy data in segment to temporary buffer
-  auto receivedSegmentIt = m_receivedSegments.emplace(std::piecewise_construct,
-                                                      std::forward_as_tuple(currentSegment),
-                                                      std::forward_as_tuple(data.getContent().value_size()));
-  std::copy(data.getContent().value_begin(), data.getContent().value_end(),
-            receivedSegmentIt.first->second.begin());
+  // Keep a reference to the segment's Content; this shares the Data's wire buffer without copying
+  if (m_receivedSegments.insert(currentSegment).second) {
+    m_segmentBuffer.emplace(currentSegment, data.getContent());
+  }
   m_nBytesReceived += data.getContent().value_size();
   afterSegmentValidated(data);
 
@@ -295,7 +393,7 @@ SegmentFetcher::afterValidationSuccess(const Data& data, const Interest& origInt
     }
   }
 
-  if (m_receivedSegments.size() == 1) {
+  if (m_versionedDataName.empty()) {
     m_versionedDataName = data.getName().getPrefix(-1);
     if (currentSegment == 0) {
       // We received the first segment in response, so we can increment the next segment number
@@ -303,6 +401,12 @@ SegmentFetcher::afterValidationSuccess(const Data& data, const Interest& origInt
     }
   }
 
+  if (m_options.inOrder) {
+    deliverInOrderSegments();
+    if (shouldStop(weakSelf))
+      return;
+  }
+
   if (m_highData < currentSegment) {
     m_highData = currentSegment;
   }
@@ -311,7 +415,7 @@ SegmentFetcher::afterValidationSuccess(const Data& data, const Interest& origInt
     windowDecrease();
   }
   else {
-    windowIncrease();
+    windowIncrease(ack);
   }
 
   fetchSegmentsInWindow(origInterest);
@@ -337,8 +441,7 @@ SegmentFetcher::afterNackReceivedCb(const Interest& origInterest, const lp::Nack
 
   afterSegmentNacked();
 
-  BOOST_ASSERT(m_nSegmentsInFlight > 0);
-  m_nSegmentsInFlight--;
+  afterInterestFinished();
 
   switch (nack.getReason()) {
     case lp::NackReason::DUPLICATE:
@@ -360,8 +463,7 @@ SegmentFetcher::afterTimeoutCb(const Interest& origInterest,
 
   afterSegmentTimedOut();
 
-  BOOST_ASSERT(m_nSegmentsInFlight > 0);
-  m_nSegmentsInFlight--;
+  afterInterestFinished();
   afterNackOrTimeout(origInterest);
 }
 
@@ -389,9 +491,14 @@ SegmentFetcher::afterNackOrTimeout(const Interest& origInterest)
   pendingSegmentIt->second.timeoutEvent.cancel();
   pendingSegmentIt->second.state = SegmentState::InRetxQueue;
 
-  m_rttEstimator.backoffRto();
+  if (m_manager != nullptr) {
+    m_manager->backoffRto(*this);
+  }
+  else {
+    m_rttEstimator.backoffRto();
+  }
 
-  if (m_receivedSegments.size() == 0) {
+  if (m_versionedDataName.empty()) {
     // Resend first Interest (until maximum receive timeout exceeded)
     fetchFirstSegment(origInterest, true);
   }
@@ -402,36 +509,87 @@ SegmentFetcher::afterNackOrTimeout(const Interest& origInterest)
   }
 }
 
+void
+SegmentFetcher::deliverInOrderSegments()
+{
+  // segments beyond FinalBlockId are not part of the object
+  while (m_nSegments == 0 || m_nextSegmentInOrder < static_cast<uint64_t>(m_nSegments)) {
+    auto it = m_segmentBuffer.find(m_nextSegmentInOrder);
+    if (it == m_segmentBuffer.end()) {
+      if (m_options.skipSegments.count(m_nextSegmentInOrder) == 0) {
+        // not received yet
+        return;
+      }
+      ++m_nextSegmentInOrder;
+      continue;
+    }
+
+    Block content = std::move(it->second);
+    m_segmentBuffer.erase(it);
+    ++m_nextSegmentInOrder;
+    onInOrderData(content);
+    if (m_this == nullptr) {
+      // stopped by a handler
+      return;
+    }
+  }
+}
+
 void
 SegmentFetcher::finalizeFetch()
 {
-  // Combine segments into final buffer
-  OBufferStream buf;
+  if (m_options.inOrder) {
+    onInOrderComplete();
+    stop();
+    return;
+  }
+
   // We may have received more segments than exist in the object.
   BOOST_ASSERT(m_receivedSegments.size() >= static_cast<uint64_t>(m_nSegments));
 
+  if (!m_options.concatenateSegments) {
+    std::vector<Block> segments;
+    segments.reserve(static_cast<size_t>(m_nSegments));
+    for (int64_t i = 0; i < m_nSegments; i++) {
+      segments.push_back(std::move(m_segmentBuffer.at(i)));
+    }
+    m_segmentBuffer.clear();
+
+    onCompleteSegments(segments);
+    stop();
+    return;
+  }
+
+  // Combine segments into final buffer, releasing each segment once it has been copied
+  size_t totalSize = 0;
   for (int64_t i = 0; i < m_nSegments; i++) {
-    buf.write(m_receivedSegments[i].get<const char>(), m_receivedSegments[i].size());
+    totalSize += m_segmentBuffer.at(i).value_size();
   }
 
-  onComplete(buf.buf());
+  auto buf = make_shared<Buffer>();
+  buf->reserve(totalSize);
+  for (int64_t i = 0; i < m_nSegments; i++) {
+    auto it = m_segmentBuffer.find(i);
+    buf->insert(buf->end(), it->second.value_begin(), it->second.value_end());
+    m_segmentBuffer.erase(it);
+  }
+
+  onComplete(buf);
   stop();
 }
 
 void
-SegmentFetcher::windowIncrease()
+SegmentFetcher::windowIncrease(const CongestionControl::Ack& ack)
 {
   if (m_options.useConstantCwnd) {
     BOOST_ASSERT(m_cwnd == m_options.initCwnd);
     return;
   }
 
-  if (m_cwnd < m_ssthresh) {
-    m_cwnd += m_options.aiStep; // additive increase
-  }
-  else {
-    m_cwnd += m_options.aiStep / std::floor(m_cwnd); // congestion avoidance
+  if (m_manager != nullptr) {
+    return m_manager->windowIncrease(*this, ack);
   }
+  m_cc->increase(m_cwnd, m_ssthresh, ack);
 }
 
 void
@@ -445,9 +603,10 @@ SegmentFetcher::windowDecrease()
       return;
     }
 
-    // Refer to RFC 5681, Section 3.1 for the rationale behind the code below
-    m_ssthresh = std::max(MIN_SSTHRESH, m_cwnd * m_options.mdCoef); // multiplicative decrease
-    m_cwnd = m_options.resetCwndToInit ? m_options.initCwnd : m_ssthresh;
+    if (m_manager != nullptr) {
+      return m_manager->windowDecrease(*this);
+    }
+    m_cc->decrease(m_cwnd, m_ssthresh, time::steady_clock::now());
   }
 }
 
@@ -471,14 +630,23 @@ SegmentFetcher::updateRetransmittedSegment(uint64_t segmentNum,
   pendingSegmentIt->second.timeoutEvent = timeoutEvent;
 }
 
+void
+SegmentFetcher::afterInterestFinished()
+{
+  BOOST_ASSERT(m_nSegmentsInFlight > 0);
+  m_nSegmentsInFlight--;
+  if (m_manager != nullptr) {
+    m_manager->afterInterestFinished(*this);
+  }
+}
+
 void
 SegmentFetcher::cancelExcessInFlightSegments()
 {
   for (auto it = m_pendingSegments.begin(); it != m_pendingSegments.end();) {
     if (it->first >= static_cast<uint64_t>(m_nSegments)) {
       it = m_pendingSegments.erase(it); // cancels pending Interest and timeout event
-      BOOST_ASSERT(m_nSegmentsInFlight > 0);
-      m_nSegmentsInFlight--;
+      afterInterestFinished();
     }
     else {
       ++it;
@@ -510,8 +678,8 @@ SegmentFetcher::getEstimatedRto()
 {
   // We don't want an Interest timeout greater than the maximum allowed timeout between the
   // succesful receipt of segments
-  return std::min(m_options.maxTimeout,
-                  time::duration_cast<time::milliseconds>(m_rttEstimator.getEstimatedRto()));
+  auto rto = m_manager != nullptr ? m_manager->getEstimatedRto(*this) : m_rttEstimator.getEstimatedRto();
+  return std::min(m_options.maxTimeout, time::duration_cast<time::milliseconds>(rto));
 }
 
 } // namespace util
@@ -30,15 +30,19 @@
 
 #include "ndn-cxx/face.hpp"
 #include "ndn-cxx/security/v2/validator.hpp"
+#include "ndn-cxx/util/congestion-control.hpp"
 #include "ndn-cxx/util/rtt-estimator.hpp"
 #include "ndn-cxx/util/scheduler.hpp"
 #include "ndn-cxx/util/signal.hpp"
 
 #include <queue>
+#include <set>
 
 namespace ndn {
 namespace util {
 
+class SegmentFetchManager;
+
 /**
  * @brief Utility class to fetch the latest version of a segmented object.
  *
@@ -61,12 +65,19 @@ namespace util {
  *    indicated by the FinalBlockId in a received Data packet is reached. This retrieval will start
  *    at segment 1 if segment 0 was received in response to the Interest expressed in step 2;
  *    otherwise, retrieval will start at segment 0. By default, congestion control will be used to
- *    manage the Interest window size. Interests expressed in this step will follow this Name
- *    format:
+ *    manage the Interest window size; the algorithm is selected with Options::ccAlgorithm.
+ *    Interests expressed in this step will follow this Name format:
  *
  *    Interest: `/<prefix>/<version>/<segment=(N)>`
  *
  * 4. Signal #onComplete passing a memory buffer that combines the content of all segments in the object.
+ *    If Options::inOrder is set, the content of each segment is instead passed to #onInOrderData as
+ *    soon as all preceding segments have been received, and #onInOrderComplete is signaled at the end.
+ *    If Options::concatenateSegments is unset, #onCompleteSegments is signaled with the content of
+ *    each segment, without combining them into one buffer.
+ *
+ * Received segments are retained by reference to the Content element of each Data packet, so that
+ * their payload is not copied unless a contiguous buffer is requested.
  *
  * If an error occurs during the fetching process, #onError is signaled with one of the error codes
  * from SegmentFetcher::ErrorCode.
@@ -123,6 +134,14 @@ public:
     void
     validate();
 
+    /**
+     * @brief Creates the congestion control instance selected by these options.
+     *
+     * This is `makeCongestionControl()` if set, otherwise an instance of `ccAlgorithm`.
+     */
+    unique_ptr<CongestionControl>
+    createCongestionControl() const;
+
   public:
     bool useConstantCwnd = false; ///< if true, window size is kept at `initCwnd`
     bool useConstantInterestTimeout = false; ///< if true, Interest timeout is kept at `maxTimeout`
@@ -130,11 +149,21 @@ public:
     time::milliseconds interestLifetime = 4_s; ///< lifetime of sent Interests - independent of Interest timeout
     double initCwnd = 1.0; ///< initial congestion window size
     double initSsthresh = std::numeric_limits<double>::max(); ///< initial slow start threshold
-    double aiStep = 1.0; ///< additive increase step (in segments)
-    double mdCoef = 0.5; ///< multiplicative decrease coefficient
+    CongestionControlAlgorithm ccAlgorithm = CongestionControlAlgorithm::AIMD; ///< congestion control algorithm
+    /// if set, creates the congestion control instance, overriding `ccAlgorithm`
+    std::function<unique_ptr<CongestionControl>()> makeCongestionControl;
+    double aiStep = 1.0; ///< additive increase step (in segments), AIMD only
+    double mdCoef = 0.5; ///< multiplicative decrease coefficient, AIMD only
+    double cubicBeta = 0.7; ///< multiplicative decrease factor, CUBIC only
+    double cubicC = 0.4; ///< scaling constant of the window growth function, CUBIC only
     bool disableCwa = false; ///< disable Conservative Window Adaptation
-    bool resetCwndToInit = false; ///< reduce cwnd to initCwnd when loss event occurs
+    bool resetCwndToInit = false; ///< reduce cwnd to initCwnd when loss event occurs, AIMD only
     bool ignoreCongMarks = false; ///< disable window decrease after congestion mark received
+    bool inOrder = false; ///< deliver segments via onInOrderData instead of reassembling the object
+    bool concatenateSegments = true; ///< if false, signal onCompleteSegments instead of onComplete
+    /// segments that the application already has, e.g., from an interrupted retrieval; they are
+    /// neither requested nor delivered via #onInOrderData. Requires `inOrder`.
+    std::set<uint64_t> skipSegments;
     RttEstimator::Options rttOptions; ///< options for RTT estimator
   };
 
@@ -179,6 +208,9 @@ private:
 
   SegmentFetcher(Face& face, security::v2::Validator& validator, const Options& options);
 
+  void
+  setManager(SegmentFetchManager* manager, const Interest& baseInterest);
+
   static bool
   shouldStop(const weak_ptr<SegmentFetcher>& weakSelf);
 
@@ -188,9 +220,28 @@ private:
   void
   fetchSegmentsInWindow(const Interest& origInterest);
 
+  /**
+   * @brief Selects the next segment to request, either from the retransmission queue or a new one.
+   * @retval false there is currently no segment to request
+   */
+  bool
+  nextSegmentToRequest(uint64_t& segNum, bool& isRetransmission);
+
+  void
+  requestSegment(const Interest& origInterest, uint64_t segNum, bool isRetransmission);
+
+  /**
+   * @brief Sends an Interest for the next segment, if any; used by SegmentFetchManager.
+   */
+  bool
+  requestNextSegment();
+
   void
   sendInterest(uint64_t segNum, const Interest& interest, bool isRetransmission);
 
+  void
+  afterInterestFinished();
+
   void
   afterSegmentReceivedCb(const Interest& origInterest, const Data& data,
                          const weak_ptr<SegmentFetcher>& weakSelf);
@@ -216,11 +267,14 @@ private:
   void
   afterNackOrTimeout(const Interest& origInterest);
 
+  void
+  deliverInOrderSegments();
+
   void
   finalizeFetch();
 
   void
-  windowIncrease();
+  windowIncrease(const CongestionControl::Ack& ack);
 
   void
   windowDecrease();
@@ -242,12 +296,37 @@ private:
   time::milliseconds
   getEstimatedRto();
 
+  friend SegmentFetchManager;
+
 public:
   /**
    * @brief Emits upon successful retrieval of the complete data.
    */
   Signal<SegmentFetcher, ConstBufferPtr> onComplete;
 
+  /**
+   * @brief Emits upon successful retrieval of the complete data when Options::concatenateSegments
+   *        is unset.
+   *
+   * Handlers are provided with the Content element of every segment, in segment order.
+   * These Blocks share the wire encoding of the received Data packets.
+   */
+  Signal<SegmentFetcher, std::vector<Block>> onCompleteSegments;
+
+  /**
+   * @brief Emits with the Content element of each segment, in segment order, when
+   *        Options::inOrder is set.
+   *
+   * The Block shares the wire encoding of the received Data packet. The fetcher releases its
+   * reference as soon as the segment has been delivered.
+   */
+  Signal<SegmentFetcher, Block> onInOrderData;
+
+  /**
+   * @brief Emits after the last segment has been delivered via #onInOrderData.
+   */
+  Signal<SegmentFetcher> onInOrderComplete;
+
   /**
    * @brief Emits when the retrieval could not be completed due to an error.
    *
@@ -292,8 +371,6 @@ private:
   };
 
 NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
-  static constexpr double MIN_SSTHRESH = 2.0;
-
   shared_ptr<SegmentFetcher> m_this;
 
   Options m_options;
@@ -301,6 +378,7 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   Scheduler m_scheduler;
   security::v2::Validator& m_validator;
   RttEstimator m_rttEstimator;
+  unique_ptr<CongestionControl> m_cc;
   time::milliseconds m_timeout;
 
   time::steady_clock::TimePoint m_timeLastSegmentReceived;
@@ -316,9 +394,15 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   uint64_t m_recPoint;
   int64_t m_nReceived;
   int64_t m_nBytesReceived;
+  uint64_t m_nextSegmentInOrder;
 
-  std::map<uint64_t, Buffer> m_receivedSegments;
+  std::set<uint64_t> m_receivedSegments;
+  std::map<uint64_t, Block> m_segmentBuffer;
   std::map<uint64_t, PendingSegment> m_pendingSegments;
+
+  /// if not null, the congestion window and RTT estimator of the manager are used
+  SegmentFetchManager* m_manager = nullptr;
+  Interest m_templateInterest;
 };
 
 } // namespace util
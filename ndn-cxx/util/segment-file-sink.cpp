@@ -0,0 +1,296 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/util/segment-file-sink.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ndn {
+namespace util {
+
+const std::string SegmentFileSink::PROGRESS_FILE_MAGIC = "ndn-cxx segment file sink v1";
+
+SegmentFileSink::SegmentFileSink(const std::string& filename)
+  : m_filename(filename)
+  , m_progressFilename(getProgressFilename(filename))
+{
+}
+
+SegmentFileSink::~SegmentFileSink()
+{
+  closeFiles();
+}
+
+std::string
+SegmentFileSink::getProgressFilename(const std::string& filename)
+{
+  return filename + ".progress";
+}
+
+shared_ptr<SegmentFileSink>
+SegmentFileSink::start(Face& face,
+                       const Interest& baseInterest,
+                       security::v2::Validator& validator,
+                       const std::string& filename,
+                       SegmentFetcher::Options options)
+{
+  shared_ptr<SegmentFileSink> sink(new SegmentFileSink(filename));
+
+  Interest interest(baseInterest);
+  bool isResumed = sink->loadProgress(baseInterest.getName());
+  sink->openOutput(isResumed);
+  if (isResumed) {
+    interest.setName(sink->m_versionedName);
+  }
+
+  // segments are released by the fetcher once all preceding segments have been received,
+  // so that at most a window of them is held in memory
+  options.inOrder = true;
+  options.skipSegments = std::move(sink->m_resumedSegments);
+  sink->m_resumedSegments.clear();
+
+  auto fetcher = SegmentFetcher::start(face, interest, validator, options);
+  sink->m_fetcher = fetcher;
+  fetcher->afterSegmentValidated.connect([sink] (const Data& data) {
+    sink->afterSegmentValidated(data);
+  });
+  fetcher->onInOrderComplete.connect([sink] { sink->finish(); });
+  fetcher->onError.connect([sink] (uint32_t code, const std::string& msg) {
+    sink->closeFiles();
+    sink->onError(code, msg);
+  });
+  return sink;
+}
+
+void
+SegmentFileSink::stop()
+{
+  auto fetcher = m_fetcher.lock();
+  if (fetcher != nullptr) {
+    fetcher->stop();
+  }
+  closeFiles();
+}
+
+bool
+SegmentFileSink::loadProgress(const Name& prefix)
+{
+  std::ifstream is(m_progressFilename, std::ios::binary);
+  if (!is) {
+    return false;
+  }
+
+  std::string magic, uri, segmentSize;
+  if (!std::getline(is, magic) || magic != PROGRESS_FILE_MAGIC ||
+      !std::getline(is, uri) || !std::getline(is, segmentSize)) {
+    return false;
+  }
+
+  try {
+    m_versionedName = Name(uri);
+    m_segmentSize = std::stoull(segmentSize);
+  }
+  catch (const std::exception&) {
+    return false;
+  }
+  if (!prefix.isPrefixOf(m_versionedName) || m_versionedName.size() == prefix.size()) {
+    // progress of a different object
+    return false;
+  }
+  m_progressHeaderSize = magic.size() + uri.size() + segmentSize.size() + 3;
+
+  m_bitmap.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+  for (size_t i = 0; i < m_bitmap.size(); ++i) {
+    for (size_t bit = 0; bit < 8; ++bit) {
+      if (m_bitmap[i] & (1 << bit)) {
+        m_resumedSegments.insert(i * 8 + bit);
+      }
+    }
+  }
+  m_nResumedSegments = m_resumedSegments.size();
+  return true;
+}
+
+void
+SegmentFileSink::openOutput(bool isResumed)
+{
+  if (isResumed) {
+    m_fd = ::open(m_filename.data(), O_WRONLY);
+    m_progressFd = ::open(m_progressFilename.data(), O_WRONLY);
+    if (m_fd >= 0 && m_progressFd >= 0) {
+      return;
+    }
+
+    // the output file is gone: start over
+    closeFiles();
+    m_versionedName.clear();
+    m_segmentSize = nullopt;
+    m_bitmap.clear();
+    m_resumedSegments.clear();
+    m_nResumedSegments = 0;
+  }
+
+  m_fd = ::open(m_filename.data(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (m_fd < 0) {
+    NDN_THROW(Error("Cannot open " + m_filename + ": " + std::strerror(errno)));
+  }
+  ::unlink(m_progressFilename.data());
+}
+
+void
+SegmentFileSink::afterSegmentValidated(const Data& data)
+{
+  if (m_fd < 0) {
+    return;
+  }
+
+  // SegmentFetcher has verified that the last name component is a segment number
+  uint64_t segment = data.getName().at(-1).toSegment();
+  bool isLastSegment = data.getFinalBlock() && *data.getFinalBlock() == data.getName().at(-1);
+
+  if (!m_segmentSize) {
+    if (isLastSegment && segment > 0) {
+      // the size of the other segments is unknown until one of them arrives
+      m_pendingLastSegment = make_shared<Data>(data);
+      return;
+    }
+    m_segmentSize = data.getContent().value_size();
+    createProgressFile(data.getName().getPrefix(-1));
+    if (m_fd < 0) {
+      return;
+    }
+  }
+
+  size_t size = data.getContent().value_size();
+  if (size > *m_segmentSize || (size < *m_segmentSize && !isLastSegment)) {
+    return fail(SEGMENT_SIZE_MISMATCH, "Segment " + to_string(segment) + " has " + to_string(size) +
+                " octets, but other segments have " + to_string(*m_segmentSize) + " octets");
+  }
+  writeSegment(segment, data.getContent());
+
+  if (m_pendingLastSegment != nullptr && m_fd >= 0) {
+    auto last = std::move(m_pendingLastSegment);
+    m_pendingLastSegment = nullptr;
+    afterSegmentValidated(*last);
+  }
+}
+
+void
+SegmentFileSink::writeSegment(uint64_t segment, const Block& content)
+{
+  if (!writeAt(m_fd, content.value(), content.value_size(), segment * *m_segmentSize)) {
+    return fail(IO_ERROR, "Cannot write " + m_filename + ": " + std::strerror(errno));
+  }
+
+  size_t byteIndex = static_cast<size_t>(segment / 8);
+  if (byteIndex >= m_bitmap.size()) {
+    m_bitmap.resize(byteIndex + 1);
+  }
+  m_bitmap[byteIndex] |= static_cast<uint8_t>(1 << (segment % 8));
+  if (!writeAt(m_progressFd, &m_bitmap[byteIndex], 1, m_progressHeaderSize + byteIndex)) {
+    return fail(IO_ERROR, "Cannot write " + m_progressFilename + ": " + std::strerror(errno));
+  }
+}
+
+void
+SegmentFileSink::createProgressFile(const Name& versionedName)
+{
+  m_versionedName = versionedName;
+  m_progressFd = ::open(m_progressFilename.data(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (m_progressFd < 0) {
+    return fail(IO_ERROR, "Cannot open " + m_progressFilename + ": " + std::strerror(errno));
+  }
+
+  std::string header = PROGRESS_FILE_MAGIC + "\n" + m_versionedName.toUri() + "\n" +
+                       to_string(*m_segmentSize) + "\n";
+  m_progressHeaderSize = header.size();
+  if (!writeAt(m_progressFd, reinterpret_cast<const uint8_t*>(header.data()), header.size(), 0)) {
+    return fail(IO_ERROR, "Cannot write " + m_progressFilename + ": " + std::strerror(errno));
+  }
+}
+
+bool
+SegmentFileSink::writeAt(int fd, const uint8_t* buf, size_t size, uint64_t offset)
+{
+  while (size > 0) {
+    ssize_t n = ::pwrite(fd, buf, size, static_cast<off_t>(offset));
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    buf += n;
+    size -= static_cast<size_t>(n);
+    offset += static_cast<uint64_t>(n);
+  }
+  return true;
+}
+
+void
+SegmentFileSink::finish()
+{
+  if (m_fd < 0) {
+    return;
+  }
+
+  struct stat st;
+  if (::fstat(m_fd, &st) != 0) {
+    return fail(IO_ERROR, "Cannot stat " + m_filename + ": " + std::strerror(errno));
+  }
+
+  closeFiles();
+  ::unlink(m_progressFilename.data());
+  onComplete(static_cast<uint64_t>(st.st_size));
+}
+
+void
+SegmentFileSink::fail(uint32_t code, const std::string& msg)
+{
+  auto fetcher = m_fetcher.lock();
+  if (fetcher != nullptr) {
+    fetcher->stop();
+  }
+  closeFiles();
+  onError(code, msg);
+}
+
+void
+SegmentFileSink::closeFiles()
+{
+  if (m_fd >= 0) {
+    ::close(m_fd);
+    m_fd = -1;
+  }
+  if (m_progressFd >= 0) {
+    ::close(m_progressFd);
+    m_progressFd = -1;
+  }
+}
+
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_CXX_UTIL_SEGMENT_FILE_SINK_HPP
+#define NDN_CXX_UTIL_SEGMENT_FILE_SINK_HPP
+
+#include "ndn-cxx/util/segment-fetcher.hpp"
+
+namespace ndn {
+namespace util {
+
+/**
+ * @brief Retrieves a segmented object with SegmentFetcher and writes it into a file.
+ *
+ * Every segment is written at its offset in the file as soon as it has been validated,
+ * regardless of arrival order, so that memory usage does not depend on the object size.
+ * This requires all segments except the last to have the same size.
+ *
+ * While retrieval is in progress, a progress file (see getProgressFilename()) records the
+ * versioned name, the segment size, and a bitmap of the segments that have been written.
+ * If retrieval is interrupted, starting again with the same filename and a base Interest
+ * whose name is a prefix of the recorded versioned name resumes it: the same version is
+ * fetched, and segments that have already been written are not requested again.
+ * The progress file is deleted upon successful completion.
+ *
+ * @note A segment's bit is set only after the segment has been handed to the operating system,
+ *       which is sufficient to resume after the process is interrupted. Neither file is synced
+ *       to stable storage.
+ */
+class SegmentFileSink : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /**
+   * @brief Error codes passed to #onError, in addition to SegmentFetcher::ErrorCode.
+   */
+  enum ErrorCode {
+    /// Writing the output file or the progress file failed
+    IO_ERROR = 100,
+    /// A segment other than the last one differs in size from the other segments
+    SEGMENT_SIZE_MISMATCH = 101,
+  };
+
+  /**
+   * @brief Starts or resumes retrieval of an object into @p filename.
+   *
+   * @param face, baseInterest, validator see SegmentFetcher::start
+   * @param filename output file; it is truncated unless retrieval is being resumed
+   * @param options options for the SegmentFetcher; `inOrder` and `skipSegments` are overridden
+   * @throw Error the output file cannot be opened
+   */
+  static shared_ptr<SegmentFileSink>
+  start(Face& face,
+        const Interest& baseInterest,
+        security::v2::Validator& validator,
+        const std::string& filename,
+        SegmentFetcher::Options options = SegmentFetcher::Options());
+
+  ~SegmentFileSink();
+
+  /**
+   * @brief Stops retrieval, keeping the progress file so that it can be resumed later.
+   */
+  void
+  stop();
+
+  /**
+   * @brief Returns the number of segments already present when retrieval started.
+   */
+  size_t
+  getNResumedSegments() const
+  {
+    return m_nResumedSegments;
+  }
+
+  /**
+   * @brief Returns the name of the progress file associated with @p filename.
+   */
+  static std::string
+  getProgressFilename(const std::string& filename);
+
+public:
+  /**
+   * @brief Emits with the size of the object after all segments have been written.
+   */
+  Signal<SegmentFileSink, uint64_t> onComplete;
+
+  /**
+   * @brief Emits when retrieval fails, with a SegmentFetcher::ErrorCode or a
+   *        SegmentFileSink::ErrorCode.
+   */
+  Signal<SegmentFileSink, uint32_t, std::string> onError;
+
+private:
+  explicit
+  SegmentFileSink(const std::string& filename);
+
+  /**
+   * @brief Loads the progress file of a retrieval of an object under @p prefix.
+   * @return whether the retrieval can be resumed
+   */
+  bool
+  loadProgress(const Name& prefix);
+
+  void
+  openOutput(bool isResumed);
+
+  void
+  afterSegmentValidated(const Data& data);
+
+  void
+  writeSegment(uint64_t segment, const Block& content);
+
+  void
+  createProgressFile(const Name& versionedName);
+
+  bool
+  writeAt(int fd, const uint8_t* buf, size_t size, uint64_t offset);
+
+  void
+  finish();
+
+  void
+  fail(uint32_t code, const std::string& msg);
+
+  void
+  closeFiles();
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  static const std::string PROGRESS_FILE_MAGIC;
+
+  const std::string m_filename;
+  const std::string m_progressFilename;
+  int m_fd = -1;
+  int m_progressFd = -1;
+
+  weak_ptr<SegmentFetcher> m_fetcher;
+  Name m_versionedName;
+  optional<size_t> m_segmentSize;
+  size_t m_progressHeaderSize = 0;
+  std::vector<uint8_t> m_bitmap;
+  std::set<uint64_t> m_resumedSegments;
+  size_t m_nResumedSegments = 0;
+  shared_ptr<const Data> m_pendingLastSegment; ///< final segment received before the segment size was known
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_CXX_UTIL_SEGMENT_FILE_SINK_HPP
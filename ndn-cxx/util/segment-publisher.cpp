@@ -0,0 +1,320 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/util/segment-publisher.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <fstream>
+
+namespace ndn {
+namespace util {
+
+void
+SegmentPublisher::Options::validate() const
+{
+  if (segmentSize < 1 || segmentSize > MAX_NDN_PACKET_SIZE) {
+    NDN_THROW(std::invalid_argument("segmentSize must be in range [1, MAX_NDN_PACKET_SIZE]"));
+  }
+
+  if (windowSize < 1) {
+    NDN_THROW(std::invalid_argument("windowSize must be greater than or equal to 1"));
+  }
+
+  if (batchSize < 1) {
+    NDN_THROW(std::invalid_argument("batchSize must be greater than or equal to 1"));
+  }
+
+  if (signingIo != nullptr) {
+    if (signingKeyChain == nullptr) {
+      NDN_THROW(std::invalid_argument("signingKeyChain must be set if signingIo is set"));
+    }
+    if (signingInfo.getPibIdentity() || signingInfo.getPibKey()) {
+      NDN_THROW(std::invalid_argument("signingInfo must not refer to a PIB entry "
+                                      "if signingIo is set"));
+    }
+  }
+}
+
+SegmentPublisher::SegmentPublisher(Face& face, KeyChain& keyChain, const Name& prefix,
+                                   const Options& options)
+  : m_face(face)
+  , m_keyChain(keyChain)
+  , m_options(options)
+  , m_versionedName(Name(prefix).appendVersion(options.version))
+  , m_isAlive(make_shared<bool>(true))
+{
+  m_options.validate();
+  if (m_options.signingIo != nullptr && m_options.signingKeyChain == &m_keyChain) {
+    NDN_THROW(std::invalid_argument("signingKeyChain must be separate from "
+                                    "the publisher's KeyChain"));
+  }
+}
+
+SegmentPublisher::SegmentPublisher(Face& face, KeyChain& keyChain, const Name& prefix,
+                                   ConstBufferPtr buffer, const Options& options)
+  : SegmentPublisher(face, keyChain, prefix, options)
+{
+  BOOST_ASSERT(buffer != nullptr);
+  m_buffer = std::move(buffer);
+  m_isRandomAccess = true;
+  m_nSegments = std::max<uint64_t>(1, (m_buffer->size() + m_options.segmentSize - 1) / m_options.segmentSize);
+  start();
+}
+
+SegmentPublisher::SegmentPublisher(Face& face, KeyChain& keyChain, const Name& prefix,
+                                   const std::string& filename, const Options& options)
+  : SegmentPublisher(face, keyChain, prefix, options)
+{
+  m_file = make_unique<std::ifstream>(filename, std::ios::binary | std::ios::ate);
+  if (!*m_file) {
+    NDN_THROW(Error("Cannot open " + filename));
+  }
+  auto size = static_cast<uint64_t>(m_file->tellg());
+  m_stream = m_file.get();
+  m_isRandomAccess = true;
+  m_nSegments = std::max<uint64_t>(1, (size + m_options.segmentSize - 1) / m_options.segmentSize);
+  start();
+}
+
+SegmentPublisher::SegmentPublisher(Face& face, KeyChain& keyChain, const Name& prefix,
+                                   std::istream& is, const Options& options)
+  : SegmentPublisher(face, keyChain, prefix, options)
+{
+  m_stream = &is;
+  start();
+}
+
+SegmentPublisher::~SegmentPublisher() = default;
+
+void
+SegmentPublisher::start()
+{
+  InterestFilter filter(m_versionedName.getPrefix(-1));
+  auto onInterestCb = [this] (const InterestFilter&, const Interest& interest) { onInterest(interest); };
+
+  if (m_options.wantRegister) {
+    weak_ptr<bool> isAlive = m_isAlive;
+    m_registeredPrefix = m_face.setInterestFilter(filter, onInterestCb,
+      [this, isAlive] (const Name&, const std::string& reason) {
+        if (!isAlive.expired()) {
+          fail("Cannot register prefix: " + reason);
+        }
+      });
+  }
+  else {
+    m_interestFilter = m_face.setInterestFilter(filter, onInterestCb);
+  }
+
+  produce();
+}
+
+void
+SegmentPublisher::onInterest(const Interest& interest)
+{
+  const Name& name = interest.getName();
+  uint64_t segment = 0;
+  if (name.size() > m_versionedName.size()) {
+    if (name.size() != m_versionedName.size() + 1 || !m_versionedName.isPrefixOf(name) ||
+        !name[-1].isSegment()) {
+      return;
+    }
+    segment = name[-1].toSegment();
+  }
+  else if (!interest.getCanBePrefix() || !name.isPrefixOf(m_versionedName)) {
+    // Interest for another version, or for the versioned name itself without CanBePrefix
+    return;
+  }
+
+  if (m_nSegments && segment >= *m_nSegments) {
+    return;
+  }
+  m_highestRequested = std::max(m_highestRequested, segment);
+
+  auto it = m_segments.find(segment);
+  if (it != m_segments.end()) {
+    m_face.put(*it->second);
+  }
+  else if (segment >= m_nextSegment || (m_isSigning && segment >= m_batchBegin)) {
+    // answered as soon as the segment is signed
+    m_pendingSegments.insert(segment);
+    if (m_isRandomAccess && !m_isSigning && segment >= m_nextSegment + m_options.windowSize) {
+      // the consumer skipped ahead: resume signing from the requested segment
+      m_nextSegment = segment;
+    }
+  }
+  else if (m_isRandomAccess) {
+    // the segment fell behind the window: sign it again
+    Buffer content;
+    if (readSegment(segment, content)) {
+      auto data = makeSegment(segment, content);
+      m_keyChain.sign(*data, m_options.signingInfo);
+      m_face.put(*data);
+    }
+  }
+
+  evict();
+  produce();
+}
+
+bool
+SegmentPublisher::readSegment(uint64_t segment, Buffer& content)
+{
+  if (m_hasFailed || (m_nSegments && segment >= *m_nSegments)) {
+    return false;
+  }
+
+  const size_t segmentSize = m_options.segmentSize;
+  if (m_buffer != nullptr) {
+    auto begin = std::min<uint64_t>(segment * segmentSize, m_buffer->size());
+    auto end = std::min<uint64_t>(begin + segmentSize, m_buffer->size());
+    content.assign(m_buffer->begin() + begin, m_buffer->begin() + end);
+    return true;
+  }
+
+  if (m_isRandomAccess) {
+    m_stream->clear();
+    m_stream->seekg(static_cast<std::streamoff>(segment * segmentSize));
+  }
+  content.resize(segmentSize);
+  m_stream->read(reinterpret_cast<char*>(content.data()), static_cast<std::streamsize>(segmentSize));
+  if (m_stream->bad()) {
+    fail("Cannot read segment " + to_string(segment));
+    return false;
+  }
+  content.resize(static_cast<size_t>(m_stream->gcount()));
+
+  if (!m_nSegments && (content.size() < segmentSize ||
+                       m_stream->peek() == std::istream::traits_type::eof())) {
+    m_nSegments = segment + 1;
+  }
+  return true;
+}
+
+shared_ptr<Data>
+SegmentPublisher::makeSegment(uint64_t segment, const Buffer& content) const
+{
+  auto data = make_shared<Data>(Name(m_versionedName).appendSegment(segment));
+  data->setFreshnessPeriod(m_options.freshnessPeriod);
+  data->setContent(content.data(), content.size());
+  if (m_nSegments) {
+    data->setFinalBlock(name::Component::fromSegment(*m_nSegments - 1));
+  }
+  return data;
+}
+
+void
+SegmentPublisher::produce()
+{
+  if (m_isSigning || m_hasFailed) {
+    return;
+  }
+
+  uint64_t end = m_highestRequested + m_options.windowSize;
+  std::vector<shared_ptr<Data>> batch;
+  m_batchBegin = m_nextSegment;
+  while (batch.size() < m_options.batchSize && m_nextSegment < end) {
+    Buffer content;
+    if (!readSegment(m_nextSegment, content)) {
+      break;
+    }
+    batch.push_back(makeSegment(m_nextSegment, content));
+    ++m_nextSegment;
+  }
+  if (batch.empty()) {
+    return;
+  }
+
+  // sign in a separate event, so that Interests are processed between batches
+  m_isSigning = true;
+  weak_ptr<bool> isAlive = m_isAlive;
+  auto afterSigned = [this, isAlive, batch] {
+    if (!isAlive.expired()) {
+      afterBatchSigned(batch);
+    }
+  };
+
+  if (m_options.signingIo == nullptr) {
+    m_face.getIoService().post([this, isAlive, batch, afterSigned] {
+      if (isAlive.expired()) {
+        return;
+      }
+      for (const auto& data : batch) {
+        m_keyChain.sign(*data, m_options.signingInfo);
+      }
+      afterSigned();
+    });
+    return;
+  }
+
+  // the worker only touches the batch and its own KeyChain; the result is handed back to the
+  // Face's thread, where the publisher's liveness is checked
+  m_options.signingIo->post([batch, afterSigned,
+                             &keyChain = *m_options.signingKeyChain,
+                             signingInfo = m_options.signingInfo,
+                             &faceIo = m_face.getIoService()] () mutable {
+    for (const auto& data : batch) {
+      keyChain.sign(*data, signingInfo);
+    }
+    faceIo.post(std::move(afterSigned));
+  });
+}
+
+void
+SegmentPublisher::afterBatchSigned(std::vector<shared_ptr<Data>> batch)
+{
+  m_isSigning = false;
+  for (const auto& data : batch) {
+    uint64_t segment = data->getName()[-1].toSegment();
+    m_segments[segment] = data;
+    if (m_pendingSegments.erase(segment) > 0) {
+      m_face.put(*data);
+    }
+  }
+
+  evict();
+  produce();
+}
+
+void
+SegmentPublisher::evict()
+{
+  if (m_highestRequested <= m_options.windowSize) {
+    return;
+  }
+
+  // segment 0 is kept to answer Interests that discover the version
+  uint64_t lowest = m_highestRequested - m_options.windowSize;
+  auto it = m_segments.upper_bound(0);
+  while (it != m_segments.end() && it->first < lowest) {
+    it = m_segments.erase(it);
+  }
+  m_pendingSegments.erase(m_pendingSegments.begin(), m_pendingSegments.lower_bound(lowest));
+}
+
+void
+SegmentPublisher::fail(const std::string& msg)
+{
+  m_hasFailed = true;
+  onError(msg);
+}
+
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,220 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_SEGMENT_PUBLISHER_HPP
+#define NDN_UTIL_SEGMENT_PUBLISHER_HPP
+
+#include "ndn-cxx/face.hpp"
+#include "ndn-cxx/security/v2/key-chain.hpp"
+#include "ndn-cxx/util/signal.hpp"
+
+#include <istream>
+#include <set>
+
+namespace ndn {
+namespace util {
+
+/**
+ * @brief Utility class to publish a segmented object; the counterpart of SegmentFetcher.
+ *
+ * SegmentPublisher splits a buffer, a file, or a stream into segments named
+ * `/<prefix>/<version>/<segment>` and answers Interests for them:
+ * - an Interest for `/<prefix>` or `/<prefix>/<version>` is answered with segment 0;
+ * - an Interest for `/<prefix>/<version>/<segment>` is answered with that segment.
+ *
+ * Segments are signed ahead of demand, in batches of Options::batchSize: the publisher keeps up
+ * to Options::windowSize signed segments beyond the highest segment requested so far, so that
+ * Interests are answered from already encoded packets. Signing happens either on the Face's
+ * io_service, one batch per event loop iteration, or on Options::signingIo.
+ *
+ * Segments that fell behind the window are signed again on demand if the source supports random
+ * access (a buffer or a file). Interests for such segments of a plain stream are not answered.
+ * All segments but the last carry Options::segmentSize octets of content; every segment carries
+ * the FinalBlockId once the number of segments is known.
+ *
+ * Example:
+ *     @code
+ *     SegmentPublisher publisher(face, keyChain, "/data/prefix", buffer);
+ *     @endcode
+ */
+class SegmentPublisher : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  class Options
+  {
+  public:
+    Options()
+    {
+    }
+
+    void
+    validate() const;
+
+  public:
+    size_t segmentSize = 8000; ///< content size of each segment, except the last one
+    size_t windowSize = 64; ///< number of segments signed ahead of the highest requested segment
+    size_t batchSize = 8; ///< number of segments signed at once
+    time::milliseconds freshnessPeriod = 10_s; ///< FreshnessPeriod of each segment
+    security::SigningInfo signingInfo; ///< how to sign the segments
+    optional<uint64_t> version; ///< version component; the current time if not set
+    bool wantRegister = true; ///< whether to register the prefix with the forwarder
+    /** @brief if set, batches are signed on threads running this io_service
+     *
+     *  At most one batch is being signed at a time, with #signingKeyChain. Segments that fell
+     *  behind the window are still signed again with the publisher's KeyChain on the Face's
+     *  thread. The io_service must outlive the publisher's pending batch.
+     */
+    boost::asio::io_service* signingIo = nullptr;
+    /** @brief KeyChain used on the threads of #signingIo
+     *
+     *  KeyChain is not thread-safe, so this must be a separate instance from the publisher's
+     *  KeyChain that can sign with #signingInfo, and it must not be used by anything else while
+     *  segments are being signed. Required if #signingIo is set.
+     */
+    KeyChain* signingKeyChain = nullptr;
+  };
+
+  /**
+   * @brief Publishes the content of @p buffer under @p prefix.
+   */
+  SegmentPublisher(Face& face, KeyChain& keyChain, const Name& prefix, ConstBufferPtr buffer,
+                   const Options& options = Options());
+
+  /**
+   * @brief Publishes the content of the file named @p filename under @p prefix.
+   * @throw Error the file cannot be opened
+   */
+  SegmentPublisher(Face& face, KeyChain& keyChain, const Name& prefix, const std::string& filename,
+                   const Options& options = Options());
+
+  /**
+   * @brief Publishes the content read from @p is under @p prefix.
+   *
+   * The stream is read sequentially, as segments are signed; it must remain valid as long as the
+   * publisher exists.
+   */
+  SegmentPublisher(Face& face, KeyChain& keyChain, const Name& prefix, std::istream& is,
+                   const Options& options = Options());
+
+  ~SegmentPublisher();
+
+  /**
+   * @brief Returns the name of the published object, including the version component.
+   */
+  const Name&
+  getVersionedName() const
+  {
+    return m_versionedName;
+  }
+
+  /**
+   * @brief Returns the number of segments, if it is already known.
+   */
+  optional<uint64_t>
+  getNSegments() const
+  {
+    return m_nSegments;
+  }
+
+  /**
+   * @brief Returns the number of signed segments being kept.
+   */
+  size_t
+  getNCachedSegments() const
+  {
+    return m_segments.size();
+  }
+
+public:
+  /**
+   * @brief Emits when the prefix cannot be registered or the source cannot be read.
+   */
+  Signal<SegmentPublisher, std::string> onError;
+
+private:
+  SegmentPublisher(Face& face, KeyChain& keyChain, const Name& prefix, const Options& options);
+
+  void
+  start();
+
+  void
+  onInterest(const Interest& interest);
+
+  /**
+   * @brief Reads the content of @p segment from the source.
+   * @return whether the segment exists
+   */
+  bool
+  readSegment(uint64_t segment, Buffer& content);
+
+  shared_ptr<Data>
+  makeSegment(uint64_t segment, const Buffer& content) const;
+
+  /**
+   * @brief Starts signing the next batch, if the window is not full.
+   */
+  void
+  produce();
+
+  void
+  afterBatchSigned(std::vector<shared_ptr<Data>> batch);
+
+  void
+  evict();
+
+  void
+  fail(const std::string& msg);
+
+private:
+  Face& m_face;
+  KeyChain& m_keyChain;
+  Options m_options;
+  Name m_versionedName;
+
+  ConstBufferPtr m_buffer;
+  unique_ptr<std::istream> m_file;
+  std::istream* m_stream = nullptr;
+  bool m_isRandomAccess = false;
+  bool m_hasFailed = false;
+
+  optional<uint64_t> m_nSegments;
+  uint64_t m_nextSegment = 0; ///< next segment to sign ahead of demand
+  uint64_t m_highestRequested = 0;
+  uint64_t m_batchBegin = 0; ///< first segment of the batch being signed
+  bool m_isSigning = false;
+  std::map<uint64_t, shared_ptr<const Data>> m_segments;
+  std::set<uint64_t> m_pendingSegments; ///< requested segments that are not signed yet
+
+  ScopedRegisteredPrefixHandle m_registeredPrefix;
+  ScopedInterestFilterHandle m_interestFilter;
+  shared_ptr<bool> m_isAlive;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_SEGMENT_PUBLISHER_HPP
@@ -27,17 +27,19 @@ namespace signal {
 
 BOOST_CONCEPT_ASSERT((boost::EqualityComparable<Connection>));
 
-Connection::Connection(weak_ptr<DisconnectFunction> disconnect) noexcept
-  : m_disconnect(std::move(disconnect))
+Connection::Connection(weak_ptr<SignalBase> signal, size_t index, uint64_t id) noexcept
+  : m_signal(std::move(signal))
+  , m_index(index)
+  , m_id(id)
 {
 }
 
 void
 Connection::disconnect()
 {
-  auto f = m_disconnect.lock();
-  if (f != nullptr) {
-    (*f)();
+  auto signal = m_signal.lock();
+  if (signal != nullptr) {
+    signal->disconnectSlot(m_index, m_id);
   }
 }
 
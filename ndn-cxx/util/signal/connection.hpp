@@ -28,7 +28,26 @@ namespace ndn {
 namespace util {
 namespace signal {
 
-using DisconnectFunction = std::function<void()>;
+/** \brief (implementation detail) interface through which a Connection reaches its Signal
+ *
+ *  A Signal shares ownership of itself, through a shared_ptr with a no-op deleter, with the
+ *  weak_ptrs held by its Connections. When the Signal is destructed, these weak_ptrs expire.
+ *  A slot is identified by its index in the Signal and by a connection identifier that is
+ *  never reused by the same Signal, so that a Connection does not match a later handler
+ *  placed in the same slot.
+ */
+class SignalBase
+{
+public:
+  virtual void
+  disconnectSlot(size_t index, uint64_t id) = 0;
+
+  virtual bool
+  isSlotConnected(size_t index, uint64_t id) const noexcept = 0;
+
+protected:
+  ~SignalBase() = default;
+};
 
 /** \brief represents a connection to a signal
  *  \note This type is copyable. Any copy can be used to disconnect.
@@ -42,8 +61,8 @@ public:
   /** \brief disconnects from the signal
    *  \note If the connection is already disconnected, or if the Signal has been destructed,
    *        this operation has no effect.
-   *  \warning During signal emission, attempting to disconnect a connection other than
-   *           the executing handler's own connection results in undefined behavior.
+   *  \note During signal emission, a disconnected handler that has not executed yet
+   *        will not be executed.
    */
   void
   disconnect();
@@ -53,14 +72,12 @@ public:
   bool
   isConnected() const noexcept
   {
-    return !m_disconnect.expired();
+    auto signal = m_signal.lock();
+    return signal != nullptr && signal->isSlotConnected(m_index, m_id);
   }
 
 private:
-  /** \param disconnect weak_ptr to a function that disconnects the handler
-   */
-  explicit
-  Connection(weak_ptr<DisconnectFunction> disconnect) noexcept;
+  Connection(weak_ptr<SignalBase> signal, size_t index, uint64_t id) noexcept;
 
   template<typename Owner, typename ...TArgs>
   friend class Signal;
@@ -78,8 +95,9 @@ private:
   operator==(const Connection& lhs, const Connection& rhs) noexcept
   {
     return (!lhs.isConnected() && !rhs.isConnected()) ||
-        (!lhs.m_disconnect.owner_before(rhs.m_disconnect) &&
-         !rhs.m_disconnect.owner_before(lhs.m_disconnect));
+        (lhs.m_id == rhs.m_id &&
+         !lhs.m_signal.owner_before(rhs.m_signal) &&
+         !rhs.m_signal.owner_before(lhs.m_signal));
   }
 
   friend bool
@@ -89,14 +107,11 @@ private:
   }
 
 private:
-  /** \note The only shared_ptr to the disconnect function is stored in Signal<..>::Slot,
-   *        and will be destructed if the handler is disconnected (through another Connection
-   *        instance) or the Signal is destructed.
-   *        Connection needs a weak_ptr instead of a shared_ptr to the disconnect function,
-   *        because the disconnect function is bound with an iterator to the Slot,
-   *        which is invalidated when the Slot is erased.
+  /** \note This weak_ptr expires when the Signal is destructed.
    */
-  weak_ptr<DisconnectFunction> m_disconnect;
+  weak_ptr<SignalBase> m_signal;
+  size_t m_index = 0;
+  uint64_t m_id = 0;
 };
 
 } // namespace signal
@@ -24,7 +24,7 @@
 
 #include "ndn-cxx/util/signal/connection.hpp"
 
-#include <list>
+#include <boost/container/small_vector.hpp>
 
 namespace ndn {
 namespace util {
@@ -48,7 +48,7 @@ class DummyExtraArg;
  *  \sa signal-emit.hpp allows owner's derived classes to emit signals
  */
 template<typename Owner, typename ...TArgs>
-class Signal : noncopyable
+class Signal final : private SignalBase, noncopyable
 {
 public: // API for anyone
   /** \brief represents a function that can connect to the signal
@@ -61,7 +61,7 @@ public: // API for anyone
 
   /** \brief connects a handler to the signal
    *  \note If invoked from a handler, the new handler won't receive the current emitted signal.
-   *  \warning The handler is permitted to disconnect itself, but it must ensure its validity.
+   *  \note The handler is permitted to disconnect itself or any other handler.
    */
   Connection
   connect(Handler handler);
@@ -99,56 +99,82 @@ private: // API for owner
   friend Owner;
 
 private: // internal implementation
-  typedef Signal<Owner, TArgs...> Self;
-
-  /** \brief stores a handler function, and a function to disconnect this handler
+  /** \brief stores a handler function
    */
   struct Slot
   {
     /** \brief the handler function who will receive emitted signals
+     *  \note This is empty if the slot is free.
      */
     Handler handler;
 
-    /** \brief the disconnect function which will disconnect this handler
-     *
-     *  In practice this is the Signal::disconnect method bound to an iterator
-     *  pointing at this slot.
-     *
-     *  This is the only shared_ptr to this function object.
-     *  Connection class has a weak_ptr which references the same function object.
-     *  When the slot is erased or the signal is destructed, this function object is
-     *  destructed, and the related Connections cannot disconnect this slot again.
+    /** \brief identifies the connection, never reused within a Signal
+     *  \note This is zero if the slot is free.
+     */
+    uint64_t id;
+
+    /** \brief whether the slot is disconnected after the handler executes once
      */
-    shared_ptr<DisconnectFunction> disconnect;
+    bool isSingleShot;
   };
 
+  Connection
+  connectImpl(Handler handler, bool isSingleShot);
+
+  Slot*
+  findSlot(size_t index, uint64_t id) noexcept;
+
+  void
+  disconnectSlot(size_t index, uint64_t id) final;
+
+  bool
+  isSlotConnected(size_t index, uint64_t id) const noexcept final;
+
+  /** \brief cleans up after signal emission
+   */
+  void
+  finishEmit();
+
+private:
   /** \brief stores slots
-   *  \note std::list is used because iterators must not be invalidated
-   *        when other slots are added or removed
+   *
+   *  Slots are addressed by index, so that disconnecting a handler does not move other slots.
+   *  Free slots are reused by later connections. Small handlers are stored inline by
+   *  std::function, so that connecting typically does not allocate.
    */
-  typedef std::list<Slot> SlotList;
-  SlotList m_slots;
+  boost::container::small_vector<Slot, 2> m_slots;
+
+  /** \brief slots connected during signal emission
+   *
+   *  They cannot be added to m_slots while a handler stored in m_slots is executing,
+   *  because growing m_slots may move that handler. A slot at index i of this vector
+   *  has index m_slots.size() + i, and is appended to m_slots after the emission.
+   */
+  std::vector<Slot> m_pendingSlots;
+
+  size_t m_nConnected = 0;
+  uint64_t m_lastId = 0;
 
   /** \brief is a signal handler executing?
    */
-  bool m_isExecuting;
+  bool m_isExecuting = false;
 
-  /** \brief iterator to current executing slot
+  /** \brief were slots connected or disconnected during signal emission?
+   */
+  bool m_hasChangedDuringEmit = false;
+
+  /** \brief index of current executing slot
    *  \note This field is meaningful when isExecuting==true
    */
-  typename SlotList::iterator m_currentSlot;
+  size_t m_currentSlot = 0;
 
-  /** \brief disconnects the handler in a slot
+  /** \brief a non-owning shared_ptr to this Signal, whose weak_ptrs are held by Connections
    */
-  void
-  disconnect(typename SlotList::iterator it);
+  shared_ptr<SignalBase> m_self;
 };
 
 template<typename Owner, typename ...TArgs>
-Signal<Owner, TArgs...>::Signal()
-  : m_isExecuting(false)
-{
-}
+Signal<Owner, TArgs...>::Signal() = default;
 
 template<typename Owner, typename ...TArgs>
 Signal<Owner, TArgs...>::~Signal()
@@ -160,53 +186,100 @@ template<typename Owner, typename ...TArgs>
 Connection
 Signal<Owner, TArgs...>::connect(Handler handler)
 {
-  auto it = m_slots.insert(m_slots.end(), {std::move(handler), nullptr});
-  it->disconnect = make_shared<DisconnectFunction>([=] { disconnect(it); });
-
-  return signal::Connection(it->disconnect);
+  return connectImpl(std::move(handler), false);
 }
 
 template<typename Owner, typename ...TArgs>
 Connection
 Signal<Owner, TArgs...>::connectSingleShot(Handler handler)
 {
-  auto it = m_slots.insert(m_slots.end(), {nullptr, nullptr});
-  it->disconnect = make_shared<DisconnectFunction>([=] { disconnect(it); });
-  signal::Connection conn(it->disconnect);
+  return connectImpl(std::move(handler), true);
+}
 
-  it->handler = [conn, handler = std::move(handler)] (const TArgs&... args) mutable {
-    handler(args...);
-    conn.disconnect();
-  };
+template<typename Owner, typename ...TArgs>
+Connection
+Signal<Owner, TArgs...>::connectImpl(Handler handler, bool isSingleShot)
+{
+  if (m_self == nullptr) {
+    m_self = shared_ptr<SignalBase>(static_cast<SignalBase*>(this), [] (SignalBase*) {});
+  }
 
-  return conn;
+  Slot slot{std::move(handler), ++m_lastId, isSingleShot};
+  size_t index = 0;
+  if (m_isExecuting) {
+    m_hasChangedDuringEmit = true;
+    index = m_slots.size() + m_pendingSlots.size();
+    m_pendingSlots.push_back(std::move(slot));
+  }
+  else {
+    while (index < m_slots.size() && m_slots[index].id != 0) {
+      ++index;
+    }
+    if (index < m_slots.size()) {
+      m_slots[index] = std::move(slot);
+    }
+    else {
+      m_slots.push_back(std::move(slot));
+    }
+  }
+  ++m_nConnected;
+
+  return Connection(m_self, index, m_lastId);
 }
 
 template<typename Owner, typename ...TArgs>
-void
-Signal<Owner, TArgs...>::disconnect(typename SlotList::iterator it)
+typename Signal<Owner, TArgs...>::Slot*
+Signal<Owner, TArgs...>::findSlot(size_t index, uint64_t id) noexcept
 {
-  if (m_isExecuting) {
-    // during signal emission, only the currently executing handler can be disconnected
-    BOOST_ASSERT_MSG(it == m_currentSlot, "cannot disconnect another handler from a handler");
+  Slot* slot = nullptr;
+  if (index < m_slots.size()) {
+    slot = &m_slots[index];
+  }
+  else if (index - m_slots.size() < m_pendingSlots.size()) {
+    slot = &m_pendingSlots[index - m_slots.size()];
+  }
+  // id 0 marks a disconnected slot, which must not match a stale connection
+  return slot != nullptr && id != 0 && slot->id == id ? slot : nullptr;
+}
 
-    // this serves to indicate that the current slot needs to be erased from the list
-    // after it finishes executing; we cannot do it here because of bug #2333
-    m_currentSlot = m_slots.end();
+template<typename Owner, typename ...TArgs>
+void
+Signal<Owner, TArgs...>::disconnectSlot(size_t index, uint64_t id)
+{
+  Slot* slot = findSlot(index, id);
+  if (slot == nullptr) {
+    return;
+  }
 
-    // expire all weak_ptrs, to prevent double disconnections
-    it->disconnect.reset();
+  slot->id = 0;
+  --m_nConnected;
+  if (m_isExecuting) {
+    m_hasChangedDuringEmit = true;
+    if (index != m_currentSlot) {
+      slot->handler = nullptr;
+    }
+    // else, the executing handler is released after it returns
+    return;
   }
-  else {
-    m_slots.erase(it);
+
+  slot->handler = nullptr;
+  while (!m_slots.empty() && m_slots.back().id == 0) {
+    m_slots.pop_back();
   }
 }
 
+template<typename Owner, typename ...TArgs>
+bool
+Signal<Owner, TArgs...>::isSlotConnected(size_t index, uint64_t id) const noexcept
+{
+  return const_cast<Signal*>(this)->findSlot(index, id) != nullptr;
+}
+
 template<typename Owner, typename ...TArgs>
 bool
 Signal<Owner, TArgs...>::isEmpty() const
 {
-  return !m_isExecuting && m_slots.empty();
+  return !m_isExecuting && m_nConnected == 0;
 }
 
 template<typename Owner, typename ...TArgs>
@@ -215,34 +288,60 @@ Signal<Owner, TArgs...>::operator()(const TArgs&... args)
 {
   BOOST_ASSERT_MSG(!m_isExecuting, "cannot emit signal from a handler");
 
-  if (m_slots.empty()) {
+  if (m_nConnected == 0) {
     return;
   }
 
-  auto it = m_slots.begin();
-  auto last = std::prev(m_slots.end());
   m_isExecuting = true;
-
   try {
-    bool isLast = false;
-    while (!isLast) {
-      m_currentSlot = it;
-      isLast = it == last;
-
-      m_currentSlot->handler(args...);
-
-      if (m_currentSlot == m_slots.end())
-        it = m_slots.erase(it);
-      else
-        ++it;
+    // m_slots does not grow during emission, so these pointers remain valid
+    Slot* begin = m_slots.data();
+    Slot* end = begin + m_slots.size();
+    for (Slot* slot = begin; slot != end; ++slot) {
+      if (slot->id == 0) {
+        continue;
+      }
+      m_currentSlot = static_cast<size_t>(slot - begin);
+      slot->handler(args...);
+
+      if (slot->isSingleShot && slot->id != 0) {
+        disconnectSlot(m_currentSlot, slot->id);
+      }
+      if (slot->id == 0) {
+        slot->handler = nullptr;
+      }
     }
   }
   catch (...) {
-    m_isExecuting = false;
+    finishEmit();
     throw;
   }
+  finishEmit();
+}
 
+template<typename Owner, typename ...TArgs>
+void
+Signal<Owner, TArgs...>::finishEmit()
+{
   m_isExecuting = false;
+  if (!m_hasChangedDuringEmit) {
+    return;
+  }
+  m_hasChangedDuringEmit = false;
+
+  if (m_slots[m_currentSlot].id == 0) {
+    m_slots[m_currentSlot].handler = nullptr;
+  }
+
+  for (auto& slot : m_pendingSlots) {
+    m_slots.push_back(std::move(slot));
+  }
+  m_pendingSlots.clear();
+
+  // trailing free slots are released; indices of the remaining slots are unchanged
+  while (!m_slots.empty() && m_slots.back().id == 0) {
+    m_slots.pop_back();
+  }
 }
 
 template<typename Owner, typename ...TArgs>
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2013-2018 Regents of the University of California.
+ * Copyright (c) 2013-2019 Regents of the University of California.
  *
  * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
  *
@@ -22,8 +22,11 @@
 #define BOOST_TEST_MODULE ndn-cxx Encoding Benchmark
 #include "tests/boost-test.hpp"
 
+#include "ndn-cxx/data.hpp"
+#include "ndn-cxx/encoding/buffer-pool.hpp"
 #include "ndn-cxx/encoding/tlv.hpp"
 #include "tests/integrated/timed-execute.hpp"
+#include "tests/make-interest-data.hpp"
 
 #include <boost/mpl/vector.hpp>
 #include <boost/mpl/vector_c.hpp>
@@ -130,6 +133,80 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(ReadVarNumber, Test, ReadVarNumberTests)
             << " " << d << std::endl;
 }
 
+// Benchmark of Data decoding and of sub-element copies, which are dominated by the reference
+// counting of the shared wire buffer.
+// Run this benchmark with:
+//    ./encoding-benchmark -t 'DecodeData'
+//    ./encoding-benchmark -t 'CopySubElements'
+// For accurate results, it is required to compile ndn-cxx in release mode.
+BOOST_AUTO_TEST_CASE(DecodeData)
+{
+  const int N_ITERATIONS = 1000000;
+
+  auto data = makeData("/benchmark/decode/data/with/a/reasonably/long/name/v=1/seg=0");
+  data->setContent(make_shared<Buffer>(1024));
+  Block wire = signData(data)->wireEncode();
+
+  size_t nComponents = 0;
+  auto d = timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      ndn::Data decoded(wire);
+      nComponents += decoded.getName().size();
+    }
+  });
+  BOOST_CHECK_EQUAL(nComponents, N_ITERATIONS * data->getName().size());
+  std::cout << "decode Data " << d << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(CopySubElements)
+{
+  const int N_ITERATIONS = 1000000;
+
+  Block wire = makeData("/benchmark/copy/sub/elements/of/a/name/with/many/components")
+               ->getName().wireEncode();
+  wire.parse();
+
+  size_t nElements = 0;
+  auto d = timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      Block copy(wire);
+      Block rebuilt(tlv::Name);
+      for (auto&& element : copy.elements()) {
+        rebuilt.push_back(element);
+      }
+      nElements += rebuilt.elements_size();
+    }
+  });
+  BOOST_CHECK_EQUAL(nElements, N_ITERATIONS * wire.elements_size());
+  std::cout << "copy " << wire.elements_size() << " sub-elements " << d << std::endl;
+}
+
+// Benchmark of Data encoding with and without the per-thread encoding buffer pool.
+// Run this benchmark with:
+//    ./encoding-benchmark -t 'EncodeData'
+BOOST_AUTO_TEST_CASE(EncodeData)
+{
+  const int N_ITERATIONS = 1000000;
+
+  auto data = makeData("/benchmark/encode/data/v=1/seg=0");
+  data->setContent(make_shared<Buffer>(1024));
+  signData(data);
+
+  auto& pool = encoding::BufferPool::getThreadLocal();
+  for (size_t capacity : {size_t(0), encoding::BufferPool::DEFAULT_CAPACITY}) {
+    pool.setCapacity(capacity);
+    size_t totalSize = 0;
+    auto d = timedExecute([&] {
+      for (int i = 0; i < N_ITERATIONS; ++i) {
+        EncodingBuffer encoder;
+        totalSize += data->wireEncode(encoder);
+      }
+    });
+    BOOST_CHECK_EQUAL(totalSize, N_ITERATIONS * data->wireEncode().size());
+    std::cout << "encode Data pool-capacity=" << capacity << " " << d << std::endl;
+  }
+}
+
 } // namespace tests
 } // namespace tlv
 } // namespace ndn
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MODULE ndn-cxx InMemoryStorage Hit Ratio Benchmark
+#include "tests/boost-test.hpp"
+
+#include "ndn-cxx/ims/in-memory-storage-arc.hpp"
+#include "ndn-cxx/ims/in-memory-storage-fifo.hpp"
+#include "ndn-cxx/ims/in-memory-storage-lfu.hpp"
+#include "ndn-cxx/ims/in-memory-storage-lru.hpp"
+#include "ndn-cxx/ims/in-memory-storage-tinylfu.hpp"
+#include "tests/make-interest-data.hpp"
+#include "tests/integrated/timed-execute.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+namespace ndn {
+namespace tests {
+
+/** @brief Loads the request trace to replay.
+ *
+ *  The trace is read from the file given after "--" on the command line, one name URI per line.
+ *  Without a file, a synthetic trace is generated: Zipf-distributed requests over a catalog,
+ *  interrupted periodically by scans of names that are requested only once.
+ */
+static std::vector<Name>
+loadTrace()
+{
+  std::vector<Name> trace;
+
+  auto& suite = boost::unit_test::framework::master_test_suite();
+  if (suite.argc > 1) {
+    std::ifstream is(suite.argv[1]);
+    BOOST_REQUIRE_MESSAGE(is, "cannot open trace file " << suite.argv[1]);
+    std::string line;
+    while (std::getline(is, line)) {
+      if (!line.empty()) {
+        trace.emplace_back(line);
+      }
+    }
+    std::cout << "replaying " << trace.size() << " requests from " << suite.argv[1] << std::endl;
+    return trace;
+  }
+
+  const size_t nRequests = 200000;
+  const size_t catalogSize = 20000;
+  const size_t scanInterval = 20000;
+  const size_t scanLength = 4000;
+
+  std::vector<double> weights(catalogSize);
+  for (size_t i = 0; i < catalogSize; ++i) {
+    weights[i] = 1.0 / std::pow(i + 1, 0.9);
+  }
+  std::discrete_distribution<size_t> zipf(weights.begin(), weights.end());
+  std::mt19937 rng(1);
+
+  size_t nScanned = 0;
+  while (trace.size() < nRequests) {
+    if (trace.size() % scanInterval == scanInterval - 1) {
+      for (size_t i = 0; i < scanLength; ++i) {
+        trace.push_back(Name("/scan").appendNumber(nScanned++));
+      }
+    }
+    trace.push_back(Name("/catalog").appendNumber(zipf(rng)));
+  }
+  std::cout << "replaying " << trace.size() << " synthetic requests" << std::endl;
+  return trace;
+}
+
+template<typename Ims>
+static void
+replay(const std::string& policy, const std::vector<Name>& trace, size_t limit)
+{
+  Ims ims(limit);
+  size_t nHits = 0;
+
+  auto d = timedExecute([&] {
+    for (const auto& name : trace) {
+      if (ims.find(name) != nullptr) {
+        ++nHits;
+      }
+      else {
+        ims.insert(*makeData(name));
+      }
+    }
+  });
+
+  BOOST_CHECK_LE(ims.size(), limit);
+  std::cout << policy << " limit=" << limit << ": hit ratio "
+            << (100.0 * nHits / trace.size()) << "%, " << d << ", "
+            << (d.count() / trace.size()) << " ns per request" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(HitRatio)
+{
+  const auto trace = loadTrace();
+
+  for (size_t limit : {100, 1000, 5000}) {
+    replay<InMemoryStorageFifo>("Fifo", trace, limit);
+    replay<InMemoryStorageLru>("Lru", trace, limit);
+    replay<InMemoryStorageLfu>("Lfu", trace, limit);
+    replay<InMemoryStorageArc>("Arc", trace, limit);
+    replay<InMemoryStorageTinyLfu>("TinyLfu", trace, limit);
+  }
+}
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MODULE ndn-cxx SegmentFetcher Benchmark
+#include "tests/boost-test.hpp"
+
+#include "ndn-cxx/security/validator-null.hpp"
+#include "ndn-cxx/util/dummy-client-face.hpp"
+#include "ndn-cxx/util/segment-fetcher.hpp"
+#include "tests/make-interest-data.hpp"
+#include "tests/unit/unit-test-time-fixture.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using namespace ndn::tests;
+
+/** \brief emulates a bottleneck link between a DummyClientFace and a producer
+ *
+ *  Each Data enters a drop-tail queue served at a fixed rate, and arrives at the consumer one
+ *  round-trip time after leaving the queue. Random loss is applied to every Interest.
+ */
+class EmulatedLink : noncopyable
+{
+public:
+  struct Params
+  {
+    std::string description;
+    time::milliseconds rtt;
+    double rate; ///< segments per second
+    double lossRate;
+  };
+
+  EmulatedLink(DummyClientFace& face, const Params& params, const std::vector<shared_ptr<Data>>& segments)
+    : m_face(face)
+    , m_scheduler(face.getIoService())
+    , m_params(params)
+    , m_serviceTime(time::duration_cast<time::nanoseconds>(time::duration<double>(1.0 / params.rate)))
+    , m_queueLimit(static_cast<size_t>(params.rate * params.rtt.count() / 1000.0)) // one BDP
+    , m_segments(segments)
+  {
+    m_face.onSendInterest.connect([this] (const Interest& interest) { onInterest(interest); });
+  }
+
+private:
+  void
+  onInterest(const Interest& interest)
+  {
+    auto now = time::steady_clock::now();
+
+    if (m_loss(m_rng) < m_params.lossRate) {
+      ++nLost;
+      return;
+    }
+
+    if (m_linkFree > now && static_cast<size_t>((m_linkFree - now) / m_serviceTime) >= m_queueLimit) {
+      ++nDropped;
+      return;
+    }
+
+    const auto& lastComponent = interest.getName().at(-1);
+    uint64_t segment = lastComponent.isSegment() ? lastComponent.toSegment() : 0;
+    BOOST_ASSERT(segment < m_segments.size());
+
+    m_linkFree = std::max(now, m_linkFree) + m_serviceTime;
+    m_scheduler.schedule(m_linkFree - now + m_params.rtt,
+                         [this, data = m_segments[segment]] { m_face.receive(*data); });
+  }
+
+public:
+  size_t nLost = 0;
+  size_t nDropped = 0;
+
+private:
+  DummyClientFace& m_face;
+  Scheduler m_scheduler;
+  const Params m_params;
+  const time::nanoseconds m_serviceTime;
+  const size_t m_queueLimit;
+  const std::vector<shared_ptr<Data>>& m_segments;
+  time::steady_clock::TimePoint m_linkFree;
+  std::mt19937 m_rng{42};
+  std::uniform_real_distribution<double> m_loss{0.0, 1.0};
+};
+
+static std::vector<shared_ptr<Data>>
+makeSegments(const Name& versionedName, size_t nSegments, size_t segmentSize)
+{
+  std::vector<uint8_t> payload(segmentSize, 0xbb);
+  std::vector<shared_ptr<Data>> segments;
+  segments.reserve(nSegments);
+  for (size_t i = 0; i < nSegments; ++i) {
+    auto data = make_shared<Data>(Name(versionedName).appendSegment(i));
+    data->setFreshnessPeriod(1_s);
+    data->setContent(payload.data(), payload.size());
+    data->setFinalBlock(name::Component::fromSegment(nSegments - 1));
+    segments.push_back(signData(data));
+    segments.back()->wireEncode();
+  }
+  return segments;
+}
+
+BOOST_FIXTURE_TEST_CASE(Goodput, UnitTestTimeFixture)
+{
+  const size_t nSegments = 20000;
+  const size_t segmentSize = 1000;
+  const Name prefix("/benchmark/object");
+  auto segments = makeSegments(Name(prefix).appendVersion(1), nSegments, segmentSize);
+
+  const EmulatedLink::Params scenarios[] = {
+    {"20ms RTT", 20_ms, 2000.0, 0.0},
+    {"300ms RTT", 300_ms, 2000.0, 0.0},
+    {"300ms RTT, 0.1% loss", 300_ms, 2000.0, 0.001},
+  };
+
+  std::cout << std::left << std::setw(24) << "scenario" << std::setw(8) << "cc"
+            << std::right << std::setw(12) << "time (s)" << std::setw(16) << "goodput (Mb/s)"
+            << std::setw(10) << "dropped" << std::setw(8) << "lost" << std::endl;
+
+  for (const auto& scenario : scenarios) {
+    for (auto algorithm : {CongestionControlAlgorithm::AIMD,
+                           CongestionControlAlgorithm::CUBIC,
+                           CongestionControlAlgorithm::BBR}) {
+      DummyClientFace face(io);
+      EmulatedLink link(face, scenario, segments);
+
+      SegmentFetcher::Options options;
+      options.ccAlgorithm = algorithm;
+      auto fetcher = SegmentFetcher::start(face, Interest(prefix), security::getAcceptAllValidator(),
+                                           options);
+      bool isDone = false;
+      size_t nBytes = 0;
+      fetcher->onComplete.connect([&] (ConstBufferPtr content) {
+        isDone = true;
+        nBytes = content->size();
+      });
+      fetcher->onError.connect([&] (uint32_t, const std::string& msg) {
+        isDone = true;
+        BOOST_ERROR(msg);
+      });
+
+      auto start = time::steady_clock::now();
+      while (!isDone && time::steady_clock::now() - start < 10_min) {
+        advanceClocks(1_ms);
+      }
+      double elapsed = time::duration_cast<time::duration<double>>(time::steady_clock::now() - start).count();
+      advanceClocks(1_ms, 10); // let the fetcher release itself before the face goes away
+
+      BOOST_CHECK_EQUAL(nBytes, nSegments * segmentSize);
+      std::cout << std::left << std::setw(24) << scenario.description << std::setw(8) << algorithm
+                << std::right << std::fixed << std::setprecision(1) << std::setw(12) << elapsed
+                << std::setw(16) << nBytes * 8 / elapsed / 1e6
+                << std::setw(10) << link.nDropped << std::setw(8) << link.nLost << std::endl;
+    }
+  }
+}
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
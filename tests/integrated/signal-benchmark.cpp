@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MODULE ndn-cxx Signal Benchmark
+#include "tests/boost-test.hpp"
+
+#include "ndn-cxx/util/signal.hpp"
+#include "tests/integrated/timed-execute.hpp"
+
+#include <boost/mpl/vector_c.hpp>
+#include <iostream>
+
+namespace ndn {
+namespace util {
+namespace signal {
+namespace tests {
+
+using namespace ndn::tests;
+
+class Emitter
+{
+public:
+  void
+  emit(int value)
+  {
+    sig(value);
+  }
+
+public:
+  Signal<Emitter, int> sig;
+};
+
+using SlotCounts = boost::mpl::vector_c<size_t, 1, 4, 64>;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(Emit, NSlots, SlotCounts)
+{
+  const size_t nSlots = NSlots::value;
+  const size_t nEmits = 10000000 / nSlots;
+
+  Emitter emitter;
+  uint64_t sum = 0;
+  for (size_t i = 0; i < nSlots; ++i) {
+    emitter.sig.connect([&sum] (int value) { sum += value; });
+  }
+
+  auto d = timedExecute([&] {
+    for (size_t i = 0; i < nEmits; ++i) {
+      emitter.emit(1);
+    }
+  });
+
+  BOOST_CHECK_EQUAL(sum, nEmits * nSlots);
+  std::cout << "emit to " << nSlots << " slots, " << nEmits << " times: " << d
+            << ", " << (d.count() / (nEmits * nSlots)) << " ns per handler" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(ConnectDisconnect, NSlots, SlotCounts)
+{
+  const size_t nSlots = NSlots::value;
+  const size_t nRounds = 2000000 / nSlots;
+
+  Emitter emitter;
+  std::vector<Connection> connections(nSlots);
+
+  auto d = timedExecute([&] {
+    for (size_t i = 0; i < nRounds; ++i) {
+      for (auto& conn : connections) {
+        conn = emitter.sig.connect([] (int) {});
+      }
+      for (auto& conn : connections) {
+        conn.disconnect();
+      }
+    }
+  });
+
+  std::cout << "connect and disconnect " << nSlots << " slots, " << nRounds << " times: " << d
+            << ", " << (d.count() / (nRounds * nSlots)) << " ns per slot" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(SingleShot, NSlots, SlotCounts)
+{
+  const size_t nSlots = NSlots::value;
+  const size_t nRounds = 2000000 / nSlots;
+
+  Emitter emitter;
+  size_t nCalls = 0;
+
+  auto d = timedExecute([&] {
+    for (size_t i = 0; i < nRounds; ++i) {
+      for (size_t j = 0; j < nSlots; ++j) {
+        emitter.sig.connectSingleShot([&nCalls] (int) { ++nCalls; });
+      }
+      emitter.emit(0);
+    }
+  });
+
+  BOOST_CHECK_EQUAL(nCalls, nRounds * nSlots);
+  std::cout << "connect, emit and auto-disconnect " << nSlots << " single-shot slots, "
+            << nRounds << " times: " << d << ", "
+            << (d.count() / (nRounds * nSlots)) << " ns per slot" << std::endl;
+}
+
+} // namespace tests
+} // namespace signal
+} // namespace util
+} // namespace ndn
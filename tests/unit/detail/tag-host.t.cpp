@@ -81,6 +81,63 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Basic, T, Fixtures, T)
   BOOST_CHECK(this->template getTag<TestTag2>() == nullptr);
 }
 
+using InlineTag = SimpleTag<uint64_t, 3>;
+using NameTag = SimpleTag<Name, 4>;
+
+static_assert(detail::IsInlineTag<InlineTag>::value, "");
+static_assert(!detail::IsInlineTag<NameTag>::value, "");
+static_assert(!detail::IsInlineTag<TestTag>::value, "");
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(Value, T, Fixtures, T)
+{
+  BOOST_CHECK(!this->template getTagValue<InlineTag>());
+
+  this->template setTagValue<InlineTag>(42);
+  BOOST_CHECK_EQUAL(this->template getTagValue<InlineTag>().value(), 42);
+
+  auto tag = this->template getTag<InlineTag>();
+  BOOST_REQUIRE(tag != nullptr);
+  BOOST_CHECK_EQUAL(tag->get(), 42);
+  // getTag() on an inline value wraps a copy and does not cache it in the tag host
+  BOOST_CHECK_NE(this->template getTag<InlineTag>(), tag);
+  BOOST_CHECK_EQUAL(this->template getTag<InlineTag>()->get(), 42);
+  BOOST_CHECK_EQUAL(this->template getTagValue<InlineTag>().value(), 42);
+
+  this->setTag(make_shared<InlineTag>(7));
+  BOOST_CHECK_EQUAL(this->template getTagValue<InlineTag>().value(), 7);
+  this->template setTagValue<InlineTag>(8);
+  BOOST_CHECK_EQUAL(this->template getTag<InlineTag>()->get(), 8);
+
+  this->template setTagValue<NameTag>("/A");
+  BOOST_CHECK_EQUAL(this->template getTagValue<NameTag>().value(), "/A");
+  BOOST_CHECK_EQUAL(this->template getTag<NameTag>()->get(), "/A");
+
+  // more tags than the inline capacity
+  this->setTag(make_shared<TestTag>());
+  this->setTag(make_shared<TestTag2>());
+  BOOST_CHECK_EQUAL(this->template getTagValue<InlineTag>().value(), 8);
+  BOOST_CHECK_EQUAL(this->template getTagValue<NameTag>().value(), "/A");
+  BOOST_CHECK(this->template getTag<TestTag>() != nullptr);
+  BOOST_CHECK(this->template getTag<TestTag2>() != nullptr);
+
+  this->template removeTag<InlineTag>();
+  BOOST_CHECK(!this->template getTagValue<InlineTag>());
+  BOOST_CHECK(this->template getTag<InlineTag>() == nullptr);
+  BOOST_CHECK(this->template getTag<TestTag2>() != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Copy)
+{
+  TagHost host;
+  host.setTagValue<InlineTag>(1);
+  host.setTag(make_shared<TestTag>());
+
+  TagHost copy(host);
+  host.setTagValue<InlineTag>(2);
+  BOOST_CHECK_EQUAL(copy.getTagValue<InlineTag>().value(), 1);
+  BOOST_CHECK_EQUAL(copy.getTag<TestTag>(), host.getTag<TestTag>());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestTagHost
 BOOST_AUTO_TEST_SUITE_END() // Detail
 
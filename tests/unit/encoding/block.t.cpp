@@ -517,6 +517,29 @@ BOOST_AUTO_TEST_CASE(InsertMiddle)
   BOOST_CHECK_EQUAL(*(it - 1) == firstBlock, true);
 }
 
+BOOST_AUTO_TEST_CASE(PushBackInsertMove)
+{
+  Block masterBlock(tlv::Name);
+  Block firstBlock = makeStringBlock(tlv::GenericNameComponent, "firstName");
+  Block secondBlock = makeStringBlock(tlv::GenericNameComponent, "secondName");
+  auto firstBuffer = firstBlock.getBuffer();
+  auto secondBuffer = secondBlock.getBuffer();
+  BOOST_CHECK_EQUAL(firstBuffer.use_count(), 2);
+  BOOST_CHECK_EQUAL(secondBuffer.use_count(), 2);
+
+  masterBlock.push_back(std::move(secondBlock));
+  BOOST_CHECK_EQUAL(secondBuffer.use_count(), 2);
+  BOOST_CHECK(!secondBlock.hasValue());
+
+  auto it = masterBlock.insert(masterBlock.elements_begin(), std::move(firstBlock));
+  BOOST_CHECK_EQUAL(firstBuffer.use_count(), 2);
+  BOOST_CHECK(!firstBlock.hasValue());
+
+  BOOST_CHECK_EQUAL(masterBlock.elements_size(), 2);
+  BOOST_CHECK_EQUAL(it->getBuffer(), firstBuffer);
+  BOOST_CHECK_EQUAL((it + 1)->getBuffer(), secondBuffer);
+}
+
 BOOST_AUTO_TEST_CASE(EraseSingleElement)
 {
   Block masterBlock(tlv::Name);
@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/encoding/buffer-pool.hpp"
+#include "ndn-cxx/encoding/encoder.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace ndn {
+namespace encoding {
+namespace tests {
+
+class BufferPoolFixture
+{
+protected:
+  BufferPoolFixture()
+    : pool(BufferPool::getThreadLocal())
+  {
+    pool.clear();
+  }
+
+  ~BufferPoolFixture()
+  {
+    pool.setCapacity(BufferPool::DEFAULT_CAPACITY);
+    pool.clear();
+  }
+
+protected:
+  BufferPool& pool;
+};
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+BOOST_FIXTURE_TEST_SUITE(TestBufferPool, BufferPoolFixture)
+
+BOOST_AUTO_TEST_CASE(ThreadLocal)
+{
+  BOOST_CHECK_EQUAL(&BufferPool::getThreadLocal(), &pool);
+  BOOST_CHECK_EQUAL(pool.getCapacity(), BufferPool::DEFAULT_CAPACITY);
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Reuse)
+{
+  auto buf1 = pool.allocate(100);
+  BOOST_CHECK_EQUAL(buf1->size(), 100);
+  BOOST_CHECK_GE(buf1->capacity(), BufferPool::SIZE_CLASSES.front());
+  const Buffer* raw1 = buf1.get();
+
+  buf1.reset();
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+
+  // same size class
+  auto buf2 = pool.allocate(300);
+  BOOST_CHECK_EQUAL(buf2.get(), raw1);
+  BOOST_CHECK_EQUAL(buf2->size(), 300);
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+
+  // different size class
+  auto buf3 = pool.allocate(BufferPool::SIZE_CLASSES.back());
+  BOOST_CHECK_NE(buf3.get(), raw1);
+  BOOST_CHECK_EQUAL(buf3->size(), BufferPool::SIZE_CLASSES.back());
+
+  buf2.reset();
+  buf3.reset();
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+
+  // a buffer of a larger class is not used for a smaller request, and vice versa
+  auto buf4 = pool.allocate(1000);
+  BOOST_CHECK_EQUAL(buf4->size(), 1000);
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Oversized)
+{
+  auto buf = pool.allocate(BufferPool::SIZE_CLASSES.back() + 1);
+  BOOST_CHECK_EQUAL(buf->size(), BufferPool::SIZE_CLASSES.back() + 1);
+  buf.reset();
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Capacity)
+{
+  pool.setCapacity(2);
+  std::vector<shared_ptr<Buffer>> bufs;
+  for (int i = 0; i < 4; ++i) {
+    bufs.push_back(pool.allocate(100));
+  }
+  bufs.clear();
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+
+  pool.setCapacity(1);
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+
+  pool.setCapacity(0);
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+  pool.allocate(100).reset();
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(EncoderAndBlock)
+{
+  Block block;
+  {
+    Encoder encoder(100, 0);
+    encoder.prependByte(0x00);
+    encoder.prependVarNumber(1);
+    encoder.prependVarNumber(0x42);
+    block = encoder.block();
+    encoder.reserve(3000, true);
+    BOOST_CHECK_EQUAL(encoder.capacity(), 3000);
+  }
+  // the reallocated encoder buffer is released, while the original is still in use by block
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+  BOOST_CHECK_EQUAL(block.type(), 0x42);
+  BOOST_CHECK_EQUAL(block.value_size(), 1);
+
+  block = {};
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestBufferPool
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace encoding
+} // namespace ndn
@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/encoding/tlv-schema.hpp"
+#include "ndn-cxx/name.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace ndn {
+namespace encoding {
+namespace schema {
+namespace tests {
+
+struct Item
+{
+  class Error : public tlv::Error
+  {
+  public:
+    using tlv::Error::Error;
+  };
+
+  void
+  wireDecode(const Block& wire);
+
+  uint64_t number = 0;
+  time::milliseconds period = 0_ms;
+  Name name;
+  optional<uint64_t> opt;
+  std::vector<Name> list;
+};
+
+struct ItemSchema : Schema<200,
+  NDN_CXX_TLV_SCHEMA_FIELD(201, NonNegativeIntegerCodec, Required, &Item::number),
+  NDN_CXX_TLV_SCHEMA_FIELD(202, NonNegativeIntegerCodec, Required, &Item::period),
+  NDN_CXX_TLV_SCHEMA_FIELD(tlv::Name, NestedCodec, Required, &Item::name),
+  NDN_CXX_TLV_SCHEMA_FIELD(203, NonNegativeIntegerCodec, Optional, &Item::opt),
+  NDN_CXX_TLV_SCHEMA_FIELD(tlv::Name, NestedCodec, Repeated, &Item::list)>
+{
+};
+
+void
+Item::wireDecode(const Block& wire)
+{
+  ItemSchema::decode(wire, *this);
+}
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+BOOST_AUTO_TEST_SUITE(TestTlvSchema)
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+  Item item;
+  item.number = 1;
+  item.period = 300_ms;
+  item.name = "/A";
+  item.list = {"/B", "/C"};
+
+  const uint8_t expected1[] = {
+    0xc8, 0x16,
+          0xc9, 0x01, 0x01,
+          0xca, 0x02, 0x01, 0x2c,
+          0x07, 0x03, 0x08, 0x01, 0x41,
+          0x07, 0x03, 0x08, 0x01, 0x42,
+          0x07, 0x03, 0x08, 0x01, 0x43,
+  };
+  Block wire = ItemSchema::encode(item);
+  BOOST_CHECK_EQUAL_COLLECTIONS(wire.begin(), wire.end(), expected1, expected1 + sizeof(expected1));
+
+  EncodingEstimator estimator;
+  BOOST_CHECK_EQUAL(ItemSchema::encode(estimator, item), sizeof(expected1));
+
+  Item decoded;
+  decoded.opt = 7;
+  decoded.list = {"/Z"};
+  decoded.wireDecode(wire);
+  BOOST_CHECK_EQUAL(decoded.number, 1);
+  BOOST_CHECK_EQUAL(decoded.period, 300_ms);
+  BOOST_CHECK_EQUAL(decoded.name, "/A");
+  BOOST_CHECK(!decoded.opt);
+  BOOST_REQUIRE_EQUAL(decoded.list.size(), 2);
+  BOOST_CHECK_EQUAL(decoded.list[0], "/B");
+  BOOST_CHECK_EQUAL(decoded.list[1], "/C");
+
+  item.opt = 5;
+  item.list.clear();
+  const uint8_t expected2[] = {
+    0xc8, 0x0f,
+          0xc9, 0x01, 0x01,
+          0xca, 0x02, 0x01, 0x2c,
+          0x07, 0x03, 0x08, 0x01, 0x41,
+          0xcb, 0x01, 0x05,
+  };
+  wire = ItemSchema::encode(item);
+  BOOST_CHECK_EQUAL_COLLECTIONS(wire.begin(), wire.end(), expected2, expected2 + sizeof(expected2));
+
+  decoded.wireDecode(wire);
+  BOOST_CHECK_EQUAL(decoded.opt.value_or(0), 5);
+  BOOST_CHECK(decoded.list.empty());
+}
+
+BOOST_AUTO_TEST_CASE(DecodeErrors)
+{
+  Item item;
+
+  const uint8_t wrongType[] = {0xc9, 0x00};
+  BOOST_CHECK_THROW(item.wireDecode(Block(wrongType, sizeof(wrongType))), Item::Error);
+
+  const uint8_t missingName[] = {
+    0xc8, 0x06,
+          0xc9, 0x01, 0x01,
+          0xca, 0x01, 0x2c,
+  };
+  BOOST_CHECK_THROW(item.wireDecode(Block(missingName, sizeof(missingName))), Item::Error);
+
+  const uint8_t outOfOrder[] = {
+    0xc8, 0x0b,
+          0xca, 0x01, 0x2c,
+          0xc9, 0x01, 0x01,
+          0x07, 0x03, 0x08, 0x01, 0x41,
+  };
+  BOOST_CHECK_THROW(item.wireDecode(Block(outOfOrder, sizeof(outOfOrder))), Item::Error);
+
+  const uint8_t badInteger[] = {
+    0xc8, 0x0d,
+          0xc9, 0x03, 0x01, 0x02, 0x03,
+          0xca, 0x01, 0x2c,
+          0x07, 0x03, 0x08, 0x01, 0x41,
+  };
+  BOOST_CHECK_THROW(item.wireDecode(Block(badInteger, sizeof(badInteger))), tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(UnrecognizedElements)
+{
+  Item item;
+
+  const uint8_t nonCritical[] = {
+    0xc8, 0x0f,
+          0xc9, 0x01, 0x01,
+          0xfd, 0x01, 0x00, 0x00, // non-critical type 256
+          0xca, 0x01, 0x2c,
+          0x07, 0x03, 0x08, 0x01, 0x41,
+  };
+  BOOST_CHECK_NO_THROW(item.wireDecode(Block(nonCritical, sizeof(nonCritical))));
+  BOOST_CHECK_EQUAL(item.number, 1);
+  BOOST_CHECK_EQUAL(item.period, 44_ms);
+
+  const uint8_t critical[] = {
+    0xc8, 0x0f,
+          0xc9, 0x01, 0x01,
+          0xfd, 0x01, 0x01, 0x00, // critical type 257
+          0xca, 0x01, 0x2c,
+          0x07, 0x03, 0x08, 0x01, 0x41,
+  };
+  BOOST_CHECK_THROW(item.wireDecode(Block(critical, sizeof(critical))), Item::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestTlvSchema
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace schema
+} // namespace encoding
+} // namespace ndn
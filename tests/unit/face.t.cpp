@@ -20,17 +20,24 @@
  */
 
 #include "ndn-cxx/face.hpp"
+#include "ndn-cxx/face-counters.hpp"
 #include "ndn-cxx/lp/tags.hpp"
 #include "ndn-cxx/transport/tcp-transport.hpp"
+#include "ndn-cxx/transport/udp-transport.hpp"
+#include "ndn-cxx/transport/unix-seqpacket-transport.hpp"
 #include "ndn-cxx/transport/unix-transport.hpp"
 #include "ndn-cxx/util/dummy-client-face.hpp"
+#include "ndn-cxx/util/packet-trace.hpp"
 #include "ndn-cxx/util/scheduler.hpp"
 
 #include "tests/boost-test.hpp"
 #include "tests/make-interest-data.hpp"
 #include "tests/unit/identity-management-time-fixture.hpp"
 
+#include <boost/filesystem.hpp>
 #include <boost/logic/tribool.hpp>
+#include <atomic>
+#include <thread>
 
 namespace ndn {
 namespace tests {
@@ -341,6 +348,45 @@ BOOST_AUTO_TEST_CASE(DataCallbackPutData) // Bug 4596
   BOOST_CHECK_EQUAL(face.sentData.back().getName(), "/chronosync/sampleDigest/1");
 }
 
+BOOST_AUTO_TEST_CASE(Counters)
+{
+  face.expressInterest(*makeInterest("/A", true, 50_ms), nullptr, nullptr, nullptr);
+  face.expressInterest(*makeInterest("/B", false, 50_ms), nullptr, nullptr, nullptr);
+  face.expressInterest(*makeInterest("/C", false, 50_ms), nullptr, nullptr, nullptr);
+  advanceClocks(10_ms);
+  const FaceCounters& counters = face.getCounters();
+  BOOST_CHECK_EQUAL(counters.nOutInterests, 3);
+  BOOST_CHECK_EQUAL(counters.nPendingInterests, 3);
+  BOOST_CHECK_GT(counters.nOutBytes, 0);
+
+  advanceClocks(10_ms);
+  face.receive(*makeData("/A/1"));
+  face.receive(makeNack(face.sentInterests.at(1), lp::NackReason::NO_ROUTE));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(counters.nInData, 1);
+  BOOST_CHECK_EQUAL(counters.nInNacks, 1);
+  BOOST_CHECK_EQUAL(counters.nSatisfiedInterests, 1);
+  BOOST_CHECK_EQUAL(counters.nNackedInterests, 1);
+  BOOST_CHECK_EQUAL(counters.nPendingInterests, 1);
+  BOOST_CHECK_GT(counters.nInBytes, 0);
+  BOOST_CHECK_EQUAL(counters.rtt.getCount(), 1);
+  BOOST_CHECK_EQUAL(counters.rtt.getMean(), 10_ms);
+
+  advanceClocks(10_ms, 10);
+  BOOST_CHECK_EQUAL(counters.nTimedOutInterests, 1);
+  BOOST_CHECK_EQUAL(counters.nPendingInterests, 0);
+
+  FaceCounters decoded(counters.wireEncode());
+  BOOST_CHECK_EQUAL(decoded.nOutInterests, 3);
+  BOOST_CHECK_EQUAL(decoded.nInBytes, counters.nInBytes);
+  BOOST_CHECK_EQUAL(decoded.nTimedOutInterests, 1);
+  BOOST_CHECK_EQUAL(decoded.rtt.getCount(), 1);
+  BOOST_CHECK_EQUAL(decoded.rtt.getMax(), counters.rtt.getMax());
+
+  BOOST_CHECK_THROW(FaceCounters(makeStringBlock(tlv::facecounters::FaceCounters, "")),
+                    FaceCounters::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Consumer
 
 BOOST_AUTO_TEST_SUITE(Producer)
@@ -654,6 +700,61 @@ BOOST_AUTO_TEST_CASE(RegisterUnregisterPrefixHandle)
   }));
 }
 
+BOOST_AUTO_TEST_CASE(RegisterPrefixBatched)
+{
+  face.setPrefixRegistrationBatching(true);
+
+  std::vector<Name> registered;
+  std::vector<RegisteredPrefixHandle> handles;
+  for (int i = 0; i < 10; ++i) {
+    handles.push_back(face.registerPrefix(Name("/Hello").appendNumber(i),
+      [&registered] (const Name& prefix) { registered.push_back(prefix); },
+      [] (const Name&, const std::string&) { BOOST_FAIL("Unexpected registerPrefix failure"); }));
+  }
+  size_t nInInterests = 0;
+  face.setInterestFilter("/World", [&] (const InterestFilter&, const Interest&) { ++nInInterests; },
+                         [&registered] (const Name& prefix) { registered.push_back(prefix); },
+                         [] (const Name&, const std::string&) {
+                           BOOST_FAIL("Unexpected setInterestFilter failure");
+                         });
+  advanceClocks(1_ms, 10);
+
+  // all registrations are carried by one command Interest
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 1);
+  BOOST_REQUIRE_EQUAL(registered.size(), 11);
+  BOOST_CHECK_EQUAL(registered.front(), Name("/Hello").appendNumber(0));
+  BOOST_CHECK_EQUAL(registered.back(), "/World");
+
+  face.receive(*makeInterest("/World/A"));
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(nInInterests, 1);
+
+  BOOST_CHECK(runPrefixUnreg([&] (const auto& success, const auto& failure) {
+    handles.front().unregister(success, failure);
+  }));
+}
+
+BOOST_AUTO_TEST_CASE(RegisterPrefixBatchedFailure)
+{
+  face.setPrefixRegistrationBatching(true);
+
+  std::vector<Name> registered;
+  std::vector<Name> failed;
+  auto onSuccess = [&registered] (const Name& prefix) { registered.push_back(prefix); };
+  auto onFailure = [&failed] (const Name& prefix, const std::string&) { failed.push_back(prefix); };
+  face.registerPrefix("/Hello/1", onSuccess, onFailure);
+  // the command of this registration cannot be signed
+  face.registerPrefix("/Hello/2", onSuccess, onFailure, security::signingByIdentity(Name("/nonexistent")));
+  face.registerPrefix("/Hello/3", onSuccess, onFailure);
+
+  BOOST_CHECK_NO_THROW(advanceClocks(1_ms, 10));
+  BOOST_REQUIRE_EQUAL(failed.size(), 1);
+  BOOST_CHECK_EQUAL(failed.front(), "/Hello/2");
+  BOOST_REQUIRE_EQUAL(registered.size(), 2);
+  BOOST_CHECK_EQUAL(registered[0], "/Hello/1");
+  BOOST_CHECK_EQUAL(registered[1], "/Hello/3");
+}
+
 BOOST_AUTO_TEST_CASE(SimilarFilters)
 {
   size_t nInInterests1 = 0;
@@ -813,8 +914,138 @@ BOOST_AUTO_TEST_CASE(DestroyWithoutProcessEvents) // Bug 3248
   BOOST_CHECK(true);
 }
 
+BOOST_AUTO_TEST_CASE(PacketTrace)
+{
+  boost::filesystem::create_directories(UNIT_TEST_CONFIG_PATH);
+  auto path = (boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "face.trace").string();
+  auto trace = make_shared<util::PacketTraceWriter>(path);
+  face.setPacketTrace(trace);
+
+  auto interest = makeInterest("/A", true);
+  face.expressInterest(*interest, nullptr, nullptr, nullptr);
+  advanceClocks(10_ms);
+  auto data = makeData("/A/1");
+  face.receive(*data);
+  advanceClocks(10_ms);
+
+  face.setPacketTrace(nullptr);
+  face.put(*makeData("/B"));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(trace->getNRecords(), 2);
+  trace.reset();
+
+  util::PacketTraceReader reader(path);
+  auto record = reader.read();
+  BOOST_REQUIRE(record);
+  BOOST_CHECK_EQUAL(record->direction, util::PacketDirection::OUTGOING);
+  BOOST_CHECK_EQUAL(record->wire, face.sentInterests.at(0).wireEncode());
+  record = reader.read();
+  BOOST_REQUIRE(record);
+  BOOST_CHECK_EQUAL(record->direction, util::PacketDirection::INCOMING);
+  BOOST_CHECK_EQUAL(Data(record->wire).getName(), "/A/1");
+  BOOST_CHECK(!reader.read());
+
+  boost::filesystem::remove(path);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // IoRoutines
 
+BOOST_AUTO_TEST_SUITE(Submission)
+
+BOOST_AUTO_TEST_CASE(SubmitInterest)
+{
+  size_t nData = 0;
+  auto hdl = face.trySubmit(*makeInterest("/Hello/World", true, 50_ms),
+                            [&] (const Interest&, const Data&) { ++nData; },
+                            bind([] { BOOST_FAIL("Unexpected Nack"); }),
+                            bind([] { BOOST_FAIL("Unexpected timeout"); }));
+  BOOST_CHECK(hdl);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 0);
+
+  advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 1);
+  BOOST_CHECK(face.sentInterests.front().hasNonce());
+
+  face.receive(*makeData("/Hello/World/a"));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nData, 1);
+
+  hdl = face.trySubmit(*makeInterest("/Hello/World", true, 50_ms),
+                       bind([] { BOOST_FAIL("Unexpected Data"); }),
+                       bind([] { BOOST_FAIL("Unexpected Nack"); }),
+                       bind([] { BOOST_FAIL("Unexpected timeout"); }));
+  BOOST_REQUIRE(hdl);
+  advanceClocks(10_ms);
+  hdl->cancel();
+  advanceClocks(10_ms);
+  face.receive(*makeData("/Hello/World/a"));
+  advanceClocks(100_ms);
+}
+
+BOOST_AUTO_TEST_CASE(SubmitDataAndNack)
+{
+  // a Nack is sent only in response to a pending Interest
+  face.setInterestFilter("/", bind([]{}));
+  advanceClocks(10_ms);
+  face.receive(*makeInterest("/B", false, 4_s, 1));
+  advanceClocks(10_ms);
+
+  BOOST_CHECK(face.trySubmit(*makeData("/A")));
+  BOOST_CHECK(face.trySubmit(makeNack(*makeInterest("/B", false, 4_s, 1), lp::NackReason::NO_ROUTE)));
+  BOOST_CHECK(face.trySubmit(*makeData("/C")));
+  BOOST_CHECK_EQUAL(face.sentData.size(), 0);
+
+  advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  BOOST_CHECK_EQUAL(face.sentData[0].getName(), "/A");
+  BOOST_CHECK_EQUAL(face.sentData[1].getName(), "/C");
+  BOOST_REQUIRE_EQUAL(face.sentNacks.size(), 1);
+  BOOST_CHECK_EQUAL(face.sentNacks[0].getInterest().getName(), "/B");
+}
+
+BOOST_AUTO_TEST_CASE(QueueFull)
+{
+  size_t nSubmitted = 0;
+  while (face.trySubmit(*makeData(Name("/A").appendNumber(nSubmitted)))) {
+    ++nSubmitted;
+  }
+  BOOST_CHECK_EQUAL(nSubmitted, Face::SUBMISSION_QUEUE_CAPACITY);
+
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(face.sentData.size(), Face::SUBMISSION_QUEUE_CAPACITY);
+  BOOST_CHECK(face.trySubmit(*makeData("/B")));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(face.sentData.size(), Face::SUBMISSION_QUEUE_CAPACITY + 1);
+}
+
+BOOST_AUTO_TEST_CASE(SubmitFromThreads)
+{
+  const size_t N_THREADS = 4;
+  const size_t N_PACKETS = 200;
+  static_assert(N_THREADS * N_PACKETS <= Face::SUBMISSION_QUEUE_CAPACITY, "");
+
+  std::atomic<size_t> nSubmitted{0};
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < N_THREADS; ++t) {
+    threads.emplace_back([this, t, &nSubmitted] {
+      for (size_t i = 0; i < N_PACKETS; ++i) {
+        if (face.trySubmit(*makeData(Name("/A").appendNumber(t).appendNumber(i)))) {
+          ++nSubmitted;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  BOOST_CHECK_EQUAL(nSubmitted, N_THREADS * N_PACKETS);
+
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(face.sentData.size(), N_THREADS * N_PACKETS);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Submission
+
 BOOST_AUTO_TEST_SUITE(Transport)
 
 using ndn::Transport;
@@ -910,6 +1141,24 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Tcp, T, ConfigOptions, T)
   BOOST_CHECK(dynamic_pointer_cast<TcpTransport>(face->getTransport()) != nullptr);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(Udp, T, ConfigOptions, T)
+{
+  this->configure("udp4://127.0.0.1:6000");
+
+  shared_ptr<Face> face;
+  BOOST_REQUIRE_NO_THROW(face = make_shared<Face>());
+  BOOST_CHECK(dynamic_pointer_cast<UdpTransport>(face->getTransport()) != nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(UnixSeqpacket, T, ConfigOptions, T)
+{
+  this->configure("unix+seqpacket:///some/path");
+
+  shared_ptr<Face> face;
+  BOOST_REQUIRE_NO_THROW(face = make_shared<Face>());
+  BOOST_CHECK(dynamic_pointer_cast<UnixSeqpacketTransport>(face->getTransport()) != nullptr);
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(WrongTransport, T, ConfigOptions, T)
 {
   this->configure("wrong-transport:");
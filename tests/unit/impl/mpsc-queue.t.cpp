@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/impl/mpsc-queue.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <thread>
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Impl)
+BOOST_AUTO_TEST_SUITE(TestMpscQueue)
+
+BOOST_AUTO_TEST_CASE(Capacity)
+{
+  MpscQueue<int> queue(5);
+  BOOST_CHECK_EQUAL(queue.capacity(), 8);
+
+  int value = 0;
+  BOOST_CHECK_EQUAL(queue.tryPop(value), false);
+  for (int i = 0; i < 8; ++i) {
+    BOOST_CHECK_EQUAL(queue.tryPush(int(i)), true);
+  }
+  BOOST_CHECK_EQUAL(queue.tryPush(8), false);
+
+  // elements come out in order, and popped slots can be reused
+  for (int round = 0; round < 3; ++round) {
+    BOOST_CHECK_EQUAL(queue.tryPop(value), true);
+    BOOST_CHECK_EQUAL(value, round);
+    BOOST_CHECK_EQUAL(queue.tryPush(8 + round), true);
+    BOOST_CHECK_EQUAL(queue.tryPush(100), false);
+  }
+  for (int i = 3; i < 11; ++i) {
+    BOOST_CHECK_EQUAL(queue.tryPop(value), true);
+    BOOST_CHECK_EQUAL(value, i);
+  }
+  BOOST_CHECK_EQUAL(queue.tryPop(value), false);
+}
+
+BOOST_AUTO_TEST_CASE(ReleaseElement)
+{
+  MpscQueue<shared_ptr<int>> queue(2);
+  auto element = make_shared<int>(1);
+  BOOST_CHECK(queue.tryPush(shared_ptr<int>(element)));
+  BOOST_CHECK_EQUAL(element.use_count(), 2);
+
+  shared_ptr<int> popped;
+  BOOST_CHECK(queue.tryPop(popped));
+  popped.reset();
+  BOOST_CHECK_EQUAL(element.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(MultipleProducers)
+{
+  const int N_THREADS = 4;
+  const int N_ELEMENTS = 10000;
+  MpscQueue<int> queue(64);
+
+  std::vector<std::thread> producers;
+  for (int t = 0; t < N_THREADS; ++t) {
+    producers.emplace_back([&queue, t] {
+      for (int i = 0; i < N_ELEMENTS; ++i) {
+        while (!queue.tryPush(t * N_ELEMENTS + i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // elements of each producer are received exactly once and in order
+  std::vector<int> next(N_THREADS, 0);
+  int nReceived = 0;
+  int value = 0;
+  while (nReceived < N_THREADS * N_ELEMENTS) {
+    if (!queue.tryPop(value)) {
+      std::this_thread::yield();
+      continue;
+    }
+    int t = value / N_ELEMENTS;
+    BOOST_REQUIRE_EQUAL(value % N_ELEMENTS, next[t]);
+    ++next[t];
+    ++nReceived;
+  }
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  BOOST_CHECK_EQUAL(queue.tryPop(value), false);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestMpscQueue
+BOOST_AUTO_TEST_SUITE_END() // Impl
+
+} // namespace tests
+} // namespace ndn
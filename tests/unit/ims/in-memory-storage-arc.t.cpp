@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/ims/in-memory-storage-arc.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/make-interest-data.hpp"
+
+namespace ndn {
+namespace tests {
+
+using namespace ndn::tests;
+
+BOOST_AUTO_TEST_SUITE(Ims)
+BOOST_AUTO_TEST_SUITE(TestInMemoryStorageArc)
+
+BOOST_AUTO_TEST_CASE(Promotion)
+{
+  InMemoryStorageArc ims(4);
+
+  for (int i = 1; i <= 4; ++i) {
+    ims.insert(*makeData(Name("/insert").appendNumber(i)));
+  }
+  BOOST_CHECK_EQUAL(ims.m_t1.size(), 4);
+  BOOST_CHECK_EQUAL(ims.m_t2.size(), 0);
+
+  // an accessed entry moves from T1 to T2
+  BOOST_CHECK(ims.find(*makeInterest(Name("/insert").appendNumber(1))) != nullptr);
+  BOOST_CHECK_EQUAL(ims.m_t1.size(), 3);
+  BOOST_CHECK_EQUAL(ims.m_t2.size(), 1);
+
+  // T1 exceeds its target, so the least recently used entry of T1 is evicted into B1
+  ims.insert(*makeData("/insert/5"));
+  BOOST_CHECK_EQUAL(ims.size(), 4);
+  BOOST_CHECK(ims.find(*makeInterest(Name("/insert").appendNumber(2))) == nullptr);
+  BOOST_CHECK(ims.find(*makeInterest(Name("/insert").appendNumber(1))) != nullptr);
+  BOOST_CHECK_EQUAL(ims.m_b1.size(), 1);
+  BOOST_CHECK_EQUAL(ims.m_b2.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(GhostHit)
+{
+  InMemoryStorageArc ims(4);
+
+  for (int i = 1; i <= 4; ++i) {
+    ims.insert(*makeData(Name("/insert").appendNumber(i)));
+  }
+  ims.find(*makeInterest(Name("/insert").appendNumber(1)));
+  ims.insert(*makeData("/insert/5"));
+  BOOST_CHECK_EQUAL(ims.getRecencyTarget(), 0);
+
+  // reinserting the name evicted from T1 grows the recency target and goes straight to T2
+  ims.insert(*makeData(Name("/insert").appendNumber(2)));
+  BOOST_CHECK_EQUAL(ims.getRecencyTarget(), 1);
+  BOOST_CHECK_EQUAL(ims.m_b1.size(), 1);
+  BOOST_CHECK_EQUAL(ims.m_t2.size(), 2);
+  BOOST_CHECK(ims.find(*makeInterest(Name("/insert").appendNumber(2))) != nullptr);
+
+  // evict everything in T2 into B2, then a hit in B2 shrinks the recency target again
+  ims.find(*makeInterest(Name("/insert").appendNumber(4)));
+  ims.find(*makeInterest("/insert/5"));
+  BOOST_CHECK_EQUAL(ims.m_t1.size(), 0);
+  ims.evictItem();
+  BOOST_CHECK_EQUAL(ims.m_b2.size(), 1);
+  ims.insert(*makeData(Name("/insert").appendNumber(1)));
+  BOOST_CHECK_EQUAL(ims.getRecencyTarget(), 0);
+  BOOST_CHECK_EQUAL(ims.m_b2.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ScanResistance)
+{
+  InMemoryStorageArc ims(8);
+
+  for (int i = 0; i < 4; ++i) {
+    ims.insert(*makeData(Name("/hot").appendNumber(i)));
+    ims.find(*makeInterest(Name("/hot").appendNumber(i)));
+  }
+
+  // a long scan of names used only once cycles through T1 without displacing T2
+  for (int i = 0; i < 100; ++i) {
+    ims.insert(*makeData(Name("/scan").appendNumber(i)));
+  }
+  BOOST_CHECK_EQUAL(ims.size(), 8);
+  for (int i = 0; i < 4; ++i) {
+    BOOST_CHECK(ims.find(*makeInterest(Name("/hot").appendNumber(i))) != nullptr);
+  }
+  BOOST_CHECK_LE(ims.m_b1.size() + ims.m_b2.size(), 8);
+}
+
+BOOST_AUTO_TEST_CASE(Erase)
+{
+  InMemoryStorageArc ims(4);
+
+  for (int i = 1; i <= 4; ++i) {
+    ims.insert(*makeData(Name("/insert").appendNumber(i)));
+  }
+  ims.find(*makeInterest(Name("/insert").appendNumber(1)));
+
+  ims.erase("/insert");
+  BOOST_CHECK_EQUAL(ims.size(), 0);
+  BOOST_CHECK_EQUAL(ims.m_t1.size(), 0);
+  BOOST_CHECK_EQUAL(ims.m_t2.size(), 0);
+  BOOST_CHECK_EQUAL(ims.evictItem(), false);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestInMemoryStorageArc
+BOOST_AUTO_TEST_SUITE_END() // Ims
+
+} // namespace tests
+} // namespace ndn
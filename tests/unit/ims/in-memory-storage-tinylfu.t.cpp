@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/ims/in-memory-storage-tinylfu.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/make-interest-data.hpp"
+
+namespace ndn {
+namespace tests {
+
+using namespace ndn::tests;
+
+BOOST_AUTO_TEST_SUITE(Ims)
+BOOST_AUTO_TEST_SUITE(TestInMemoryStorageTinyLfu)
+
+BOOST_AUTO_TEST_CASE(Sketch)
+{
+  using FrequencySketch = InMemoryStorageTinyLfu::FrequencySketch;
+  FrequencySketch sketch(16);
+
+  Name name("/frequent");
+  BOOST_CHECK_EQUAL(sketch.estimate(name), 0);
+  for (int i = 0; i < 20; ++i) {
+    sketch.increment(name);
+  }
+  BOOST_CHECK_EQUAL(sketch.estimate(name), FrequencySketch::MAX_COUNT);
+
+  // enough distinct additions trigger aging, which halves all counters
+  for (int i = 0; i < 640; ++i) {
+    sketch.increment(Name("/rare").appendNumber(i));
+  }
+  BOOST_CHECK_LT(sketch.estimate(name), FrequencySketch::MAX_COUNT);
+  BOOST_CHECK_GE(sketch.estimate(name), FrequencySketch::MAX_COUNT / 2);
+}
+
+BOOST_AUTO_TEST_CASE(Segments)
+{
+  InMemoryStorageTinyLfu ims(10);
+  BOOST_CHECK_EQUAL(ims.getWindowCapacity(), 1);
+  BOOST_CHECK_EQUAL(ims.getMainCapacity(), 9);
+  BOOST_CHECK_EQUAL(ims.getProtectedCapacity(), 8);
+
+  for (int i = 0; i < 10; ++i) {
+    ims.insert(*makeData(Name("/insert").appendNumber(i)));
+  }
+  BOOST_CHECK_EQUAL(ims.m_window.size(), 1);
+  BOOST_CHECK_EQUAL(ims.m_probation.size(), 9);
+  BOOST_CHECK_EQUAL(ims.m_protected.size(), 0);
+
+  // accessing an entry on probation promotes it, overflowing protected entries are demoted
+  for (int i = 0; i < 9; ++i) {
+    BOOST_CHECK(ims.find(*makeInterest(Name("/insert").appendNumber(i))) != nullptr);
+  }
+  BOOST_CHECK_EQUAL(ims.m_window.size(), 1);
+  BOOST_CHECK_EQUAL(ims.m_probation.size(), 1);
+  BOOST_CHECK_EQUAL(ims.m_protected.size(), 8);
+}
+
+BOOST_AUTO_TEST_CASE(ScanResistance)
+{
+  InMemoryStorageTinyLfu ims(10);
+
+  for (int i = 0; i < 10; ++i) {
+    ims.insert(*makeData(Name("/hot").appendNumber(i)));
+  }
+  for (int n = 0; n < 3; ++n) {
+    for (int i = 0; i < 9; ++i) {
+      ims.find(*makeInterest(Name("/hot").appendNumber(i)));
+    }
+  }
+
+  // names used only once lose the admission contest against frequently used ones
+  for (int i = 0; i < 50; ++i) {
+    ims.insert(*makeData(Name("/scan").appendNumber(i)));
+  }
+  BOOST_CHECK_EQUAL(ims.size(), 10);
+  for (int i = 0; i < 9; ++i) {
+    BOOST_CHECK(ims.find(*makeInterest(Name("/hot").appendNumber(i))) != nullptr);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Admission)
+{
+  InMemoryStorageTinyLfu ims(10);
+
+  for (int i = 0; i < 10; ++i) {
+    ims.insert(*makeData(Name("/insert").appendNumber(i)));
+  }
+
+  ims.insert(*makeData("/frequent"));
+  for (int i = 0; i < 3; ++i) {
+    BOOST_CHECK(ims.find(*makeInterest("/frequent")) != nullptr);
+  }
+
+  // the window candidate is more popular than the probation victim and replaces it
+  ims.insert(*makeData("/new"));
+  BOOST_CHECK_EQUAL(ims.size(), 10);
+  BOOST_CHECK(ims.find(*makeInterest(Name("/insert").appendNumber(0))) == nullptr);
+  BOOST_CHECK(ims.find(*makeInterest("/frequent")) != nullptr);
+  BOOST_CHECK(ims.find(*makeInterest("/new")) != nullptr);
+  BOOST_CHECK_EQUAL(ims.m_window.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Erase)
+{
+  InMemoryStorageTinyLfu ims(10);
+
+  for (int i = 0; i < 10; ++i) {
+    ims.insert(*makeData(Name("/insert").appendNumber(i)));
+  }
+  ims.find(*makeInterest(Name("/insert").appendNumber(0)));
+
+  ims.erase("/insert");
+  BOOST_CHECK_EQUAL(ims.size(), 0);
+  BOOST_CHECK_EQUAL(ims.m_window.size() + ims.m_probation.size() + ims.m_protected.size(), 0);
+  BOOST_CHECK_EQUAL(ims.evictItem(), false);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestInMemoryStorageTinyLfu
+BOOST_AUTO_TEST_SUITE_END() // Ims
+
+} // namespace tests
+} // namespace ndn
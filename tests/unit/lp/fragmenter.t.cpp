@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/lp/fragmenter.hpp"
+#include "ndn-cxx/lp/fields.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace ndn {
+namespace lp {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Lp)
+BOOST_AUTO_TEST_SUITE(TestFragmenter)
+
+static Packet
+makePacket(size_t payloadSize)
+{
+  auto payload = make_shared<Buffer>(payloadSize);
+  for (size_t i = 0; i < payloadSize; ++i) {
+    (*payload)[i] = static_cast<uint8_t>(i);
+  }
+
+  Packet packet;
+  packet.add<FragmentField>(std::make_pair(payload->cbegin(), payload->cend()));
+  packet.add<CongestionMarkField>(1);
+  return packet;
+}
+
+BOOST_AUTO_TEST_CASE(Fits)
+{
+  Fragmenter fragmenter(100);
+  Packet packet = makePacket(500);
+  auto fragments = fragmenter.fragment(packet, 1500);
+  BOOST_REQUIRE_EQUAL(fragments.size(), 1);
+  BOOST_CHECK_EQUAL(fragments.front(), packet.wireEncode());
+}
+
+BOOST_AUTO_TEST_CASE(Split)
+{
+  Fragmenter fragmenter(100);
+  Packet packet = makePacket(5000);
+  auto fragments = fragmenter.fragment(packet, 1500);
+  BOOST_REQUIRE_EQUAL(fragments.size(), 4);
+
+  Buffer payload;
+  for (size_t i = 0; i < fragments.size(); ++i) {
+    BOOST_CHECK_LE(fragments[i].size(), 1500);
+    Packet frag(fragments[i]);
+    BOOST_CHECK_EQUAL(frag.get<SequenceField>(), 100 + i);
+    BOOST_CHECK_EQUAL(frag.get<FragIndexField>(), i);
+    BOOST_CHECK_EQUAL(frag.get<FragCountField>(), fragments.size());
+    BOOST_CHECK_EQUAL(frag.has<CongestionMarkField>(), i == 0);
+
+    auto range = frag.get<FragmentField>();
+    payload.insert(payload.end(), range.first, range.second);
+  }
+
+  auto range = packet.get<FragmentField>();
+  BOOST_CHECK_EQUAL_COLLECTIONS(payload.begin(), payload.end(), range.first, range.second);
+
+  // Sequence numbers continue across packets
+  fragments = fragmenter.fragment(packet, 1500);
+  BOOST_CHECK_EQUAL(Packet(fragments.front()).get<SequenceField>(), 104);
+}
+
+BOOST_AUTO_TEST_CASE(Errors)
+{
+  Fragmenter fragmenter;
+  BOOST_CHECK_THROW(fragmenter.fragment(Packet(), 1500), Fragmenter::Error);
+  BOOST_CHECK_THROW(fragmenter.fragment(makePacket(5000), 50), Fragmenter::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestFragmenter
+BOOST_AUTO_TEST_SUITE_END() // Lp
+
+} // namespace tests
+} // namespace lp
+} // namespace ndn
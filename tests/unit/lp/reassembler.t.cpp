@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/lp/reassembler.hpp"
+#include "ndn-cxx/lp/fields.hpp"
+#include "ndn-cxx/lp/fragmenter.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/make-interest-data.hpp"
+#include "tests/unit/unit-test-time-fixture.hpp"
+
+namespace ndn {
+namespace lp {
+namespace tests {
+
+using namespace ndn::tests;
+
+class ReassemblerFixture : public UnitTestTimeFixture
+{
+protected:
+  std::vector<Packet>
+  makeFragments(const Block& netPacket, size_t mtu)
+  {
+    Packet packet;
+    packet.add<FragmentField>(std::make_pair(netPacket.begin(), netPacket.end()));
+    packet.add<CongestionMarkField>(1);
+
+    std::vector<Packet> fragments;
+    for (const auto& wire : fragmenter.fragment(packet, mtu)) {
+      fragments.emplace_back(wire);
+    }
+    return fragments;
+  }
+
+protected:
+  Scheduler scheduler{io};
+  Fragmenter fragmenter{1000};
+  Reassembler reassembler{scheduler};
+  Block netPacket = makeNetPacket();
+
+private:
+  static Block
+  makeNetPacket()
+  {
+    auto data = makeData("/A");
+    std::vector<uint8_t> content(3000, 0xBB);
+    data->setContent(content.data(), content.size());
+    return signData(data)->wireEncode();
+  }
+};
+
+BOOST_AUTO_TEST_SUITE(Lp)
+BOOST_FIXTURE_TEST_SUITE(TestReassembler, ReassemblerFixture)
+
+BOOST_AUTO_TEST_CASE(Unfragmented)
+{
+  Packet packet;
+  packet.add<FragmentField>(std::make_pair(netPacket.begin(), netPacket.end()));
+  auto result = reassembler.receiveFragment(packet);
+  BOOST_REQUIRE(result);
+  BOOST_CHECK_EQUAL(result->first, netPacket);
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(OutOfOrder)
+{
+  auto fragments = makeFragments(netPacket, 1000);
+  BOOST_REQUIRE_EQUAL(fragments.size(), 4);
+
+  BOOST_CHECK(!reassembler.receiveFragment(fragments[2]));
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+  BOOST_CHECK(!reassembler.receiveFragment(fragments[0]));
+  BOOST_CHECK(!reassembler.receiveFragment(fragments[0])); // duplicate
+  BOOST_CHECK(!reassembler.receiveFragment(fragments[3]));
+
+  auto result = reassembler.receiveFragment(fragments[1]);
+  BOOST_REQUIRE(result);
+  BOOST_CHECK_EQUAL(result->first, netPacket);
+  BOOST_CHECK(result->second.has<CongestionMarkField>());
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Timeout)
+{
+  auto fragments = makeFragments(netPacket, 1000);
+  BOOST_CHECK(!reassembler.receiveFragment(fragments[0]));
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+
+  advanceClocks(100_ms, 6);
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+
+  // the remaining fragments start a new partial packet that never completes
+  BOOST_CHECK(!reassembler.receiveFragment(fragments[1]));
+  BOOST_CHECK(!reassembler.receiveFragment(fragments[2]));
+  BOOST_CHECK(!reassembler.receiveFragment(fragments[3]));
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(TableFull)
+{
+  Reassembler::Options options;
+  options.maxPartialPackets = 2;
+  Reassembler small(scheduler, options);
+
+  auto fragments1 = makeFragments(netPacket, 1000);
+  auto fragments2 = makeFragments(netPacket, 1000);
+  auto fragments3 = makeFragments(netPacket, 1000);
+  BOOST_CHECK(!small.receiveFragment(fragments1[0]));
+  BOOST_CHECK(!small.receiveFragment(fragments2[0]));
+  BOOST_CHECK(!small.receiveFragment(fragments3[0]));
+  BOOST_CHECK_EQUAL(small.size(), 2);
+
+  // existing partial packets can still complete
+  for (size_t i = 1; i < fragments1.size(); ++i) {
+    auto result = small.receiveFragment(fragments1[i]);
+    BOOST_CHECK_EQUAL(static_cast<bool>(result), i + 1 == fragments1.size());
+  }
+  BOOST_CHECK_EQUAL(small.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Oversized)
+{
+  Reassembler::Options options;
+  options.maxPacketSize = 1500;
+  Reassembler small(scheduler, options);
+
+  auto fragments = makeFragments(netPacket, 1000);
+  BOOST_CHECK(!small.receiveFragment(fragments[0]));
+  BOOST_CHECK_EQUAL(small.size(), 1);
+
+  // the partial packet is dropped as soon as its fragments exceed the limit
+  BOOST_CHECK(!small.receiveFragment(fragments[1]));
+  BOOST_CHECK_EQUAL(small.size(), 0);
+
+  // the remaining fragments start a new partial packet that never completes
+  BOOST_CHECK(!small.receiveFragment(fragments[2]));
+  BOOST_CHECK(!small.receiveFragment(fragments[3]));
+  BOOST_CHECK_EQUAL(small.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  BOOST_CHECK_THROW(reassembler.receiveFragment(Packet()), Reassembler::Error);
+
+  auto fragments = makeFragments(netPacket, 1000);
+  Packet badIndex = fragments[1];
+  badIndex.set<FragIndexField>(4);
+  BOOST_CHECK_THROW(reassembler.receiveFragment(badIndex), Reassembler::Error);
+
+  Packet noSequence = fragments[1];
+  noSequence.remove<SequenceField>();
+  BOOST_CHECK_THROW(reassembler.receiveFragment(noSequence), Reassembler::Error);
+
+  Packet tooMany = fragments[1];
+  tooMany.set<FragCountField>(401);
+  BOOST_CHECK_THROW(reassembler.receiveFragment(tooMany), Reassembler::Error);
+
+  const uint8_t bytes[] = {0x06, 0xFD, 0x10};
+  const Buffer notTlv(bytes, sizeof(bytes));
+  Packet truncated;
+  truncated.add<FragmentField>(std::make_pair(notTlv.begin(), notTlv.end()));
+  BOOST_CHECK_THROW(reassembler.receiveFragment(truncated), Reassembler::Error);
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestReassembler
+BOOST_AUTO_TEST_SUITE_END() // Lp
+
+} // namespace tests
+} // namespace lp
+} // namespace ndn
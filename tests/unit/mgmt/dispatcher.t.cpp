@@ -20,6 +20,8 @@
  */
 
 #include "ndn-cxx/mgmt/dispatcher.hpp"
+#include "ndn-cxx/encoding/tlv-dataset.hpp"
+#include "ndn-cxx/encoding/tlv-nfd.hpp"
 #include "ndn-cxx/mgmt/nfd/control-parameters.hpp"
 #include "ndn-cxx/util/dummy-client-face.hpp"
 
@@ -236,6 +238,115 @@ BOOST_AUTO_TEST_CASE(ControlCommand)
   BOOST_CHECK_EQUAL(nCallbackCalled, 1);
 }
 
+BOOST_AUTO_TEST_CASE(ControlCommandBatch)
+{
+  size_t nValidateCalled = 0;
+  size_t nHandlerCalled = 0;
+  dispatcher
+    .addControlCommand<VoidParameters>("test",
+                                       makeTestAuthorization(),
+                                       [&] (const ControlParameters&) {
+                                         return ++nValidateCalled != 2;
+                                       },
+                                       [&] (const Name&, const Interest&, const ControlParameters&,
+                                            const CommandContinuation& done) {
+                                         ++nHandlerCalled;
+                                         done(ControlResponse(200, "OK"));
+                                       });
+  dispatcher.addTopPrefix("/root");
+  advanceClocks(1_ms);
+  face.sentData.clear();
+
+  Block batch(tlv::nfd::ControlParametersBatch);
+  for (int i = 0; i < 3; ++i) {
+    batch.push_back(Block(128));
+  }
+  batch.encode();
+
+  face.receive(*makeInterest(Name("/root/test").append(batch).append("valid")));
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(nValidateCalled, 3);
+  BOOST_CHECK_EQUAL(nHandlerCalled, 2);
+
+  // a single response carries the response to each command
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  ControlResponse resp(face.sentData[0].getContent().blockFromValue());
+  BOOST_CHECK_EQUAL(resp.getCode(), 200);
+  Block body = resp.getBody();
+  BOOST_CHECK_EQUAL(body.type(), tlv::nfd::ControlResponseBatch);
+  body.parse();
+  BOOST_REQUIRE_EQUAL(body.elements_size(), 3);
+  BOOST_CHECK_EQUAL(ControlResponse(body.elements()[0]).getCode(), 200);
+  BOOST_CHECK_EQUAL(ControlResponse(body.elements()[1]).getCode(), 400);
+  BOOST_CHECK_EQUAL(ControlResponse(body.elements()[2]).getCode(), 200);
+
+  // a batch in which every command is rejected is rejected as a whole
+  face.receive(*makeInterest(Name("/root/test").append(batch).append("invalid")));
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(nHandlerCalled, 2);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  BOOST_CHECK_EQUAL(ControlResponse(face.sentData[1].getContent().blockFromValue()).getCode(), 403);
+
+  // a batch with a malformed item is silently ignored
+  batch.push_back(Block(129));
+  batch.encode();
+  face.receive(*makeInterest(Name("/root/test").append(batch).append("valid")));
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(face.sentData.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(ControlCommandBatchPartiallyAuthorized)
+{
+  auto authorize = [] (const Name&, const Interest&, const ControlParameters* params,
+                       const AcceptContinuation& accept, const RejectContinuation& reject) {
+    if (static_cast<const nfd::ControlParameters*>(params)->getName() == "/forbidden") {
+      reject(RejectReply::STATUS403);
+    }
+    else {
+      accept("");
+    }
+  };
+
+  std::vector<Name> handledNames;
+  auto handle = [&] (const Name&, const Interest&, const ControlParameters& params,
+                     const CommandContinuation& done) {
+    handledNames.push_back(static_cast<const nfd::ControlParameters&>(params).getName());
+    done(ControlResponse(200, "OK"));
+  };
+
+  dispatcher.addControlCommand<nfd::ControlParameters>("test", authorize,
+                                                       [] (const ControlParameters&) {
+                                                         return true;
+                                                       },
+                                                       handle);
+  dispatcher.addTopPrefix("/root");
+  advanceClocks(1_ms);
+  face.sentData.clear();
+
+  // the second command must not be let through by the authorization of the first one
+  Block batch(tlv::nfd::ControlParametersBatch);
+  batch.push_back(nfd::ControlParameters().setName("/allowed").wireEncode());
+  batch.push_back(nfd::ControlParameters().setName("/forbidden").wireEncode());
+  batch.push_back(nfd::ControlParameters().setName("/allowed/2").wireEncode());
+  batch.encode();
+
+  face.receive(*makeInterest(Name("/root/test").append(batch)));
+  advanceClocks(1_ms, 10);
+  BOOST_REQUIRE_EQUAL(handledNames.size(), 2);
+  BOOST_CHECK_EQUAL(handledNames[0], "/allowed");
+  BOOST_CHECK_EQUAL(handledNames[1], "/allowed/2");
+
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  ControlResponse resp(face.sentData[0].getContent().blockFromValue());
+  BOOST_CHECK_EQUAL(resp.getCode(), 200);
+  Block body = resp.getBody();
+  body.parse();
+  BOOST_REQUIRE_EQUAL(body.elements_size(), 3);
+  BOOST_CHECK_EQUAL(ControlResponse(body.elements()[0]).getCode(), 200);
+  BOOST_CHECK_EQUAL(ControlResponse(body.elements()[1]).getCode(), 403);
+  BOOST_CHECK_EQUAL(ControlResponse(body.elements()[2]).getCode(), 200);
+}
+
 class StatefulParameters : public mgmt::ControlParameters
 {
 public:
@@ -436,6 +547,182 @@ BOOST_AUTO_TEST_CASE(StatusDataset)
   BOOST_CHECK_EQUAL(storage.size(), 0); // the nack packet will not be inserted into the in-memory storage
 }
 
+BOOST_AUTO_TEST_CASE(StatusDatasetSigningIo)
+{
+  Block largeBlock;
+  {
+    EncodingBuffer encoder;
+    for (size_t i = 0; i < 2500; ++i) {
+      encoder.prependByte(1);
+    }
+    encoder.prependVarNumber(2500);
+    encoder.prependVarNumber(129);
+    largeBlock = encoder.block();
+  }
+
+  boost::asio::io_service signingIo;
+  BOOST_CHECK_THROW(dispatcher.setDatasetSigningIo(&signingIo), std::invalid_argument);
+  BOOST_CHECK_THROW(dispatcher.setDatasetSigningIo(&signingIo, &m_keyChain), std::invalid_argument);
+  KeyChain signingKeyChain("pib-memory:", "tpm-memory:");
+  dispatcher.setDatasetSigningIo(&signingIo, &signingKeyChain);
+  dispatcher.addStatusDataset("test/large",
+                              makeAcceptAllAuthorization(),
+                              [&largeBlock] (const Name& prefix, const Interest& interest,
+                                             StatusDatasetContext& context) {
+                                for (int i = 0; i < 10; ++i) {
+                                  context.append(largeBlock);
+                                }
+                                context.end();
+                              });
+  dispatcher.addTopPrefix("/root");
+  advanceClocks(1_ms);
+  face.sentData.clear();
+
+  face.receive(*makeInterest("/root/test/large/valid"));
+  advanceClocks(1_ms, 10);
+
+  // the first segment is signed and sent right away
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  BOOST_CHECK_EQUAL(face.sentData[0].getName().at(-1).toSegment(), 0);
+  BOOST_CHECK_EQUAL(storage.size(), 1);
+
+  // an Interest for a segment that is being signed is answered once it is signed
+  Name segment1 = face.sentData[0].getName().getPrefix(-1).appendSegment(1);
+  face.receive(*makeInterest(segment1));
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(face.sentData.size(), 1);
+
+  while (signingIo.poll() > 0) {
+    signingIo.reset();
+    advanceClocks(1_ms);
+  }
+  advanceClocks(1_ms, 10);
+
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  BOOST_CHECK_EQUAL(face.sentData[1].getName(), segment1);
+  BOOST_CHECK_GT(storage.size(), 2);
+
+  // every segment is in the storage, the last one has FinalBlockId
+  uint64_t nSegments = storage.size();
+  for (uint64_t i = 0; i < nSegments; ++i) {
+    auto data = storage.find(face.sentData[0].getName().getPrefix(-1).appendSegment(i));
+    BOOST_REQUIRE(data != nullptr);
+    BOOST_CHECK_EQUAL(data->getFinalBlock().has_value(), i == nSegments - 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(StatusDatasetSnapshot)
+{
+  uint64_t generation = 1;
+  size_t nHandlerCalls = 0;
+  std::vector<Block> items{makeNonNegativeIntegerBlock(129, 1), makeNonNegativeIntegerBlock(129, 2)};
+  dispatcher.addStatusDataset("test/snapshot",
+                              makeAcceptAllAuthorization(),
+                              [&] (const Name& prefix, const Interest& interest,
+                                   StatusDatasetContext& context) {
+                                ++nHandlerCalls;
+                                for (const auto& item : items) {
+                                  context.append(item);
+                                }
+                                context.end();
+                              },
+                              [&generation] { return generation; },
+                              true);
+  dispatcher.addTopPrefix("/root");
+  advanceClocks(1_ms);
+  face.sentData.clear();
+
+  auto request = makeInterest("/root/test/snapshot", true);
+  request->setMustBeFresh(true);
+  face.receive(*request);
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(nHandlerCalls, 1);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  Name version1Name = face.sentData[0].getName();
+
+  // the generation is unchanged: the stale segment is sent again without invoking the handler
+  advanceClocks(500_ms, 3);
+  face.receive(*request);
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(nHandlerCalls, 1);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  BOOST_CHECK_EQUAL(face.sentData[1].getName(), version1Name);
+  BOOST_CHECK(face.sentData[1].wireEncode() == face.sentData[0].wireEncode());
+
+  // the generation has changed: a new version is generated, with a delta from the old version
+  generation = 2;
+  items = {makeNonNegativeIntegerBlock(129, 2), makeNonNegativeIntegerBlock(129, 3)};
+  advanceClocks(500_ms, 3);
+  face.receive(*request);
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(nHandlerCalls, 2);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 3);
+  Name version2Name = face.sentData[2].getName();
+  BOOST_CHECK_NE(version2Name, version1Name);
+
+  Name deltaPrefix("/root/test/snapshot");
+  deltaPrefix.append(getStatusDatasetDeltaKeyword()).append(version1Name.at(-2));
+  face.receive(*makeInterest(deltaPrefix, true));
+  advanceClocks(1_ms, 10);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 4);
+  const Data& delta = face.sentData[3];
+  BOOST_CHECK_EQUAL(delta.getName(),
+                    Name(deltaPrefix).append(version2Name.at(-2)).appendSegment(0));
+  BOOST_CHECK(delta.getFinalBlock() == delta.getName().at(-1));
+
+  Block content = delta.getContent();
+  content.parse();
+  BOOST_REQUIRE_EQUAL(content.elements_size(), 2);
+  BOOST_CHECK_EQUAL(content.elements()[0].type(), tlv::dataset::DatasetDeltaRemoved);
+  content.elements()[0].parse();
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(content.elements()[0].elements().at(0)), 1);
+  BOOST_CHECK_EQUAL(content.elements()[1].type(), tlv::dataset::DatasetDeltaAdded);
+  content.elements()[1].parse();
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(content.elements()[1].elements().at(0)), 3);
+}
+
+BOOST_AUTO_TEST_CASE(StatusDatasetSnapshotEviction)
+{
+  std::map<Name, size_t> nHandlerCalls;
+  dispatcher.addStatusDataset("test/snapshot",
+                              makeAcceptAllAuthorization(),
+                              [&] (const Name& prefix, const Interest& interest,
+                                   StatusDatasetContext& context) {
+                                ++nHandlerCalls[interest.getName()];
+                                context.append(makeNonNegativeIntegerBlock(129, 1));
+                                context.end();
+                              },
+                              [] { return 1; });
+  dispatcher.addTopPrefix("/root");
+  advanceClocks(1_ms);
+
+  auto request = [this] (const Name& name) {
+    auto interest = makeInterest(name, true);
+    interest->setMustBeFresh(true);
+    face.receive(*interest);
+    advanceClocks(1_ms, 10);
+    // let the segment become stale, so that the next request reaches the dispatcher
+    advanceClocks(500_ms, 3);
+  };
+
+  // fill the snapshot cache (64 request Names)
+  request("/root/test/snapshot/A");
+  for (int i = 1; i < 64; ++i) {
+    request(Name("/root/test/snapshot/B").appendNumber(i));
+  }
+  BOOST_CHECK_EQUAL(nHandlerCalls["/root/test/snapshot/A"], 1);
+
+  // /A is used again, so /B/1 becomes the least recently used snapshot
+  request("/root/test/snapshot/A");
+  BOOST_CHECK_EQUAL(nHandlerCalls["/root/test/snapshot/A"], 1);
+
+  request(Name("/root/test/snapshot/B").appendNumber(64));
+  request("/root/test/snapshot/A");
+  BOOST_CHECK_EQUAL(nHandlerCalls["/root/test/snapshot/A"], 1);
+  request(Name("/root/test/snapshot/B").appendNumber(1));
+  BOOST_CHECK_EQUAL(nHandlerCalls[Name("/root/test/snapshot/B").appendNumber(1)], 2);
+}
+
 BOOST_AUTO_TEST_CASE(NotificationStream)
 {
   const uint8_t buf[] = {0x82, 0x01, 0x02};
@@ -21,6 +21,7 @@
 
 #include "ndn-cxx/mgmt/nfd/controller.hpp"
 #include "ndn-cxx/mgmt/nfd/control-response.hpp"
+#include "ndn-cxx/encoding/tlv-nfd.hpp"
 
 #include "tests/boost-test.hpp"
 #include "tests/make-interest-data.hpp"
@@ -265,6 +266,89 @@ BOOST_AUTO_TEST_CASE(FailureNoCallback)
   BOOST_CHECK_EQUAL(succeeds.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(Batch)
+{
+  std::vector<ControlParameters> parameters(3);
+  for (size_t i = 0; i < parameters.size(); ++i) {
+    parameters[i].setName(Name("/batch").appendNumber(i));
+  }
+
+  std::vector<ControlResponse> responses;
+  size_t nCompleted = 0;
+  controller.startBatch<RibRegisterCommand>(parameters,
+    [&] (const std::vector<ControlResponse>& r) {
+      responses = r;
+      ++nCompleted;
+    });
+  this->advanceClocks(1_ms);
+
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 1);
+  // 9 components: ndn:/localhost/nfd/rib/register/<batch>/<signed Interest x4>
+  const Name& requestName = face.sentInterests[0].getName();
+  BOOST_REQUIRE_EQUAL(requestName.size(), 9);
+  Block batch = requestName.at(4).blockFromValue();
+  BOOST_CHECK_EQUAL(batch.type(), tlv::nfd::ControlParametersBatch);
+  batch.parse();
+  BOOST_REQUIRE_EQUAL(batch.elements_size(), 3);
+  BOOST_CHECK_EQUAL(ControlParameters(batch.elements()[2]).getName(), "/batch/%02");
+
+  Block body(tlv::nfd::ControlResponseBatch);
+  for (size_t i = 0; i < parameters.size(); ++i) {
+    if (i == 1) {
+      body.push_back(ControlResponse(409, "conflict").wireEncode());
+      continue;
+    }
+    ControlParameters responseParameters(parameters[i]);
+    responseParameters.setFaceId(1).setOrigin(ROUTE_ORIGIN_APP).setCost(0)
+                      .setFlags(ROUTE_FLAG_CHILD_INHERIT);
+    ControlResponse response(200, "OK");
+    response.setBody(responseParameters.wireEncode());
+    body.push_back(response.wireEncode());
+  }
+  body.encode();
+  this->respond(ControlResponse(200, "OK").setBody(body));
+
+  BOOST_CHECK_EQUAL(nCompleted, 1);
+  BOOST_REQUIRE_EQUAL(responses.size(), 3);
+  BOOST_CHECK_EQUAL(responses[0].getCode(), 200);
+  BOOST_CHECK_EQUAL(ControlParameters(responses[0].getBody()).getName(), "/batch/%00");
+  BOOST_CHECK_EQUAL(responses[1].getCode(), 409);
+  BOOST_CHECK_EQUAL(responses[2].getCode(), 200);
+}
+
+BOOST_AUTO_TEST_CASE(BatchSplitTimeout)
+{
+  std::vector<ControlParameters> parameters(500);
+  for (size_t i = 0; i < parameters.size(); ++i) {
+    parameters[i].setName(Name("/batch").appendNumber(i));
+  }
+
+  CommandOptions options;
+  options.setTimeout(50_ms);
+
+  std::vector<ControlResponse> responses;
+  controller.startBatch<RibRegisterCommand>(parameters,
+    [&] (const std::vector<ControlResponse>& r) { responses = r; },
+    options);
+  this->advanceClocks(1_ms);
+
+  BOOST_CHECK_GT(face.sentInterests.size(), 1);
+  size_t nParameters = 0;
+  for (const auto& interest : face.sentInterests) {
+    BOOST_CHECK_LE(interest.wireEncode().size(), MAX_NDN_PACKET_SIZE);
+    Block batch = interest.getName().at(4).blockFromValue();
+    batch.parse();
+    nParameters += batch.elements_size();
+  }
+  BOOST_CHECK_EQUAL(nParameters, parameters.size());
+
+  this->advanceClocks(51_ms);
+  BOOST_REQUIRE_EQUAL(responses.size(), parameters.size());
+  for (const auto& response : responses) {
+    BOOST_CHECK_EQUAL(response.getCode(), Controller::ERROR_TIMEOUT);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestController
 BOOST_AUTO_TEST_SUITE_END() // Nfd
 BOOST_AUTO_TEST_SUITE_END() // Mgmt
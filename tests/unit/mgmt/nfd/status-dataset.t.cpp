@@ -481,6 +481,112 @@ BOOST_AUTO_TEST_CASE(RibListWithOptions)
 
 BOOST_AUTO_TEST_SUITE_END() // Datasets
 
+BOOST_AUTO_TEST_SUITE(Incremental)
+
+BOOST_AUTO_TEST_CASE(StreamParser)
+{
+  RibEntry payload1;
+  payload1.setName("/zXxBth97ee");
+  RibEntry payload2;
+  payload2.setName("/rJ8CvUpr4G");
+  ndn::encoding::EncodingBuffer buffer;
+  payload2.wireEncode(buffer);
+  payload1.wireEncode(buffer);
+
+  // split the payload into three chunks at every pair of positions
+  for (size_t i = 0; i <= buffer.size(); ++i) {
+    for (size_t j = i; j <= buffer.size(); ++j) {
+      BOOST_TEST_CONTEXT("split at " << i << " and " << j) {
+        StatusDatasetStreamParser parser;
+        std::vector<Block> elements;
+        for (const auto& chunk : {makeBinaryBlock(tlv::Content, buffer.buf(), i),
+                                  makeBinaryBlock(tlv::Content, buffer.buf() + i, j - i),
+                                  makeBinaryBlock(tlv::Content, buffer.buf() + j, buffer.size() - j)}) {
+          auto parsed = parser.parse(chunk);
+          elements.insert(elements.end(), parsed.begin(), parsed.end());
+        }
+        BOOST_CHECK_NO_THROW(parser.finish());
+        BOOST_REQUIRE_EQUAL(elements.size(), 2);
+        BOOST_CHECK_EQUAL(RibEntry(elements[0]), payload1);
+        BOOST_CHECK_EQUAL(RibEntry(elements[1]), payload2);
+      }
+    }
+  }
+
+  StatusDatasetStreamParser parser;
+  BOOST_CHECK_EQUAL(parser.parse(makeBinaryBlock(tlv::Content, buffer.buf(), buffer.size() - 1)).size(), 1);
+  BOOST_CHECK_THROW(parser.finish(), StatusDataset::ParseResultError);
+}
+
+BOOST_AUTO_TEST_CASE(SpanningSegments)
+{
+  std::vector<RibEntry> result;
+  size_t nBatches = 0;
+  bool isComplete = false;
+  controller.fetchIncremental<RibDataset>(
+    [&] (std::vector<RibEntry> batch) {
+      ++nBatches;
+      result.insert(result.end(), batch.begin(), batch.end());
+    },
+    [&] { isComplete = true; },
+    datasetFailCallback);
+  this->advanceClocks(500_ms);
+
+  RibEntry payload1;
+  payload1.setName("/zXxBth97ee");
+  RibEntry payload2;
+  payload2.setName("/rJ8CvUpr4G");
+  ndn::encoding::EncodingBuffer buffer;
+  payload2.wireEncode(buffer);
+  payload1.wireEncode(buffer);
+  size_t splitPos = payload1.wireEncode().size() + 3; // within TLV-VALUE of payload2
+
+  Name versionedName = Name("/localhost/nfd/rib/list").appendVersion();
+  auto data0 = make_shared<Data>(Name(versionedName).appendSegment(0));
+  data0->setFreshnessPeriod(1_s);
+  data0->setContent(buffer.buf(), splitPos);
+  face.receive(*signData(data0));
+  this->advanceClocks(500_ms);
+
+  BOOST_CHECK_EQUAL(nBatches, 1);
+  BOOST_REQUIRE_EQUAL(result.size(), 1);
+  BOOST_CHECK_EQUAL(result.front().getName(), "/zXxBth97ee");
+  BOOST_CHECK(!isComplete);
+
+  auto data1 = make_shared<Data>(Name(versionedName).appendSegment(1));
+  data1->setFreshnessPeriod(1_s);
+  data1->setFinalBlock(name::Component::fromSegment(1));
+  data1->setContent(buffer.buf() + splitPos, buffer.size() - splitPos);
+  face.receive(*signData(data1));
+  this->advanceClocks(500_ms);
+
+  BOOST_CHECK_EQUAL(nBatches, 2);
+  BOOST_REQUIRE_EQUAL(result.size(), 2);
+  BOOST_CHECK_EQUAL(result.back().getName(), "/rJ8CvUpr4G");
+  BOOST_CHECK(isComplete);
+  BOOST_CHECK_EQUAL(failCodes.size(), 0);
+  BOOST_CHECK_EQUAL(controller.m_fetchers.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ParseError)
+{
+  controller.fetchIncremental<FaceDataset>(
+    [] (std::vector<FaceStatus>) { BOOST_FAIL("no entry should be decoded"); },
+    [] { BOOST_FAIL("fetchIncremental should not complete"); },
+    datasetFailCallback);
+  this->advanceClocks(500_ms);
+
+  Name payload; // Name is not valid FaceStatus
+  this->sendDataset("/localhost/nfd/faces/list", payload);
+  this->advanceClocks(500_ms);
+
+  BOOST_REQUIRE_EQUAL(failCodes.size(), 1);
+  BOOST_CHECK_EQUAL(failCodes.back(), Controller::ERROR_SERVER);
+  BOOST_CHECK_EQUAL(controller.m_fetchers.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Incremental
+
 BOOST_AUTO_TEST_SUITE_END() // TestStatusDataset
 BOOST_AUTO_TEST_SUITE_END() // Nfd
 BOOST_AUTO_TEST_SUITE_END() // Mgmt
@@ -0,0 +1,289 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/transport/udp-transport.hpp"
+#include "ndn-cxx/transport/unix-seqpacket-transport.hpp"
+#include "ndn-cxx/face.hpp"
+#include "ndn-cxx/lp/fields.hpp"
+#include "ndn-cxx/lp/fragmenter.hpp"
+#include "ndn-cxx/lp/reassembler.hpp"
+#include "ndn-cxx/security/v2/key-chain.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/make-interest-data.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/filesystem.hpp>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Transport)
+
+using ndn::Transport;
+
+class DatagramTransportFixture
+{
+public:
+  ~DatagramTransportFixture()
+  {
+    if (serverFd >= 0) {
+      ::close(serverFd);
+    }
+  }
+
+  void
+  poll()
+  {
+    io.poll();
+    io.reset();
+  }
+
+  /** \brief send every datagram received by the server back to its sender
+   */
+  void
+  echo()
+  {
+    uint8_t buffer[MAX_NDN_PACKET_SIZE];
+    sockaddr_storage peer;
+    socklen_t peerLen = sizeof(peer);
+    ssize_t nRead;
+    while ((nRead = ::recvfrom(serverFd, buffer, sizeof(buffer), MSG_DONTWAIT,
+                               reinterpret_cast<sockaddr*>(&peer), &peerLen)) > 0) {
+      ++nEchoed;
+      ::sendto(serverFd, buffer, static_cast<size_t>(nRead), 0, reinterpret_cast<sockaddr*>(&peer), peerLen);
+      lastPeer = peer;
+      lastPeerLen = peerLen;
+      peerLen = sizeof(peer);
+    }
+  }
+
+  /** \brief receive every datagram sent to the server
+   */
+  std::vector<Block>
+  receiveAll()
+  {
+    std::vector<Block> datagrams;
+    uint8_t buffer[MAX_NDN_PACKET_SIZE];
+    lastPeerLen = sizeof(lastPeer);
+    ssize_t nRead;
+    while ((nRead = ::recvfrom(serverFd, buffer, sizeof(buffer), MSG_DONTWAIT,
+                               reinterpret_cast<sockaddr*>(&lastPeer), &lastPeerLen)) > 0) {
+      datagrams.emplace_back(buffer, static_cast<size_t>(nRead));
+      lastPeerLen = sizeof(lastPeer);
+    }
+    return datagrams;
+  }
+
+  /** \brief send \p nPackets Interests and wait until they are echoed back
+   */
+  void
+  sendAndEcho(ndn::Transport& transport, size_t nPackets)
+  {
+    for (size_t i = 0; i < nPackets; ++i) {
+      transport.send(makeInterest(Name("/A").appendNumber(i))->wireEncode());
+    }
+    for (int i = 0; i < 100 && received.size() < nPackets; ++i) {
+      poll();
+      echo();
+    }
+  }
+
+public:
+  boost::asio::io_service io;
+  int serverFd = -1;
+  size_t nEchoed = 0;
+  sockaddr_storage lastPeer;
+  socklen_t lastPeerLen = 0;
+  std::vector<Block> received;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestDatagramTransport, DatagramTransportFixture)
+
+BOOST_AUTO_TEST_CASE(UdpUri)
+{
+  using Pair = std::pair<std::string, std::string>;
+  BOOST_CHECK(UdpTransport::getSocketHostAndPortFromUri("") == Pair("localhost", "6363"));
+  BOOST_CHECK(UdpTransport::getSocketHostAndPortFromUri("udp://192.0.2.1") == Pair("192.0.2.1", "6363"));
+  BOOST_CHECK(UdpTransport::getSocketHostAndPortFromUri("udp4://example.com:7000") ==
+              Pair("example.com", "7000"));
+  BOOST_CHECK_THROW(UdpTransport::getSocketHostAndPortFromUri("tcp://localhost"), Transport::Error);
+  BOOST_CHECK_THROW(UdpTransport::getSocketHostAndPortFromUri("udp"), Transport::Error);
+}
+
+BOOST_AUTO_TEST_CASE(UnixSeqpacketUri)
+{
+  BOOST_CHECK_EQUAL(UnixSeqpacketTransport::getSocketNameFromUri(""), "/var/run/nfd.seqpacket");
+  BOOST_CHECK_EQUAL(UnixSeqpacketTransport::getSocketNameFromUri("unix+seqpacket:///tmp/nfd"), "/tmp/nfd");
+  BOOST_CHECK_THROW(UnixSeqpacketTransport::getSocketNameFromUri("unix:///tmp/nfd"), Transport::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Udp)
+{
+  boost::asio::ip::udp::socket server(io, boost::asio::ip::udp::endpoint(
+                                            boost::asio::ip::address_v4::loopback(), 0));
+  serverFd = ::dup(server.native_handle());
+  server.close();
+
+  sockaddr_in addr{};
+  socklen_t addrLen = sizeof(addr);
+  ::getsockname(serverFd, reinterpret_cast<sockaddr*>(&addr), &addrLen);
+
+  UdpTransport transport("127.0.0.1", to_string(ntohs(addr.sin_port)));
+  transport.connect(io, [this] (const Block& wire) { received.push_back(wire); });
+  BOOST_CHECK(transport.isConnected());
+  transport.resume();
+
+  // more packets than one batch
+  sendAndEcho(transport, 100);
+  BOOST_CHECK_EQUAL(nEchoed, 100);
+  BOOST_REQUIRE_EQUAL(received.size(), 100);
+  for (size_t i = 0; i < received.size(); ++i) {
+    BOOST_CHECK_EQUAL(Interest(received[i]).getName(), Name("/A").appendNumber(i));
+  }
+
+  // malformed datagrams are dropped
+  ::sendto(serverFd, "\x05\x10", 2, 0, reinterpret_cast<sockaddr*>(&lastPeer), lastPeerLen);
+  received.clear();
+  poll();
+  BOOST_CHECK_EQUAL(received.size(), 0);
+
+  transport.close();
+  BOOST_CHECK(!transport.isConnected());
+}
+
+BOOST_AUTO_TEST_CASE(FaceFragmentation)
+{
+  boost::asio::ip::udp::socket server(io, boost::asio::ip::udp::endpoint(
+                                            boost::asio::ip::address_v4::loopback(), 0));
+  serverFd = ::dup(server.native_handle());
+  server.close();
+
+  sockaddr_in addr{};
+  socklen_t addrLen = sizeof(addr);
+  ::getsockname(serverFd, reinterpret_cast<sockaddr*>(&addr), &addrLen);
+
+  KeyChain keyChain("pib-memory:", "tpm-memory:");
+  Face face(make_shared<UdpTransport>("127.0.0.1", to_string(ntohs(addr.sin_port))), io, keyChain);
+
+  auto makeLargeData = [] (const Name& name, size_t contentSize) {
+    auto data = makeData(name);
+    std::vector<uint8_t> content(contentSize, 0xBB);
+    data->setContent(content.data(), content.size());
+    return signData(data);
+  };
+
+  // a large Data from the forwarder is reassembled before it satisfies the Interest
+  optional<Data> receivedData;
+  face.expressInterest(*makeInterest("/B", true),
+                       [&] (const Interest&, const Data& data) { receivedData = data; },
+                       nullptr, nullptr);
+  poll();
+  BOOST_REQUIRE_EQUAL(receiveAll().size(), 1);
+
+  auto data = makeLargeData("/B/1", 20000);
+  lp::Packet lpPacket;
+  lpPacket.add<lp::FragmentField>(std::make_pair(data->wireEncode().begin(), data->wireEncode().end()));
+  lp::Fragmenter fragmenter;
+  auto fragments = fragmenter.fragment(lpPacket, 1500);
+  BOOST_CHECK_GT(fragments.size(), 1);
+  for (const auto& fragment : fragments) {
+    ::sendto(serverFd, fragment.wire(), fragment.size(), 0,
+             reinterpret_cast<sockaddr*>(&lastPeer), lastPeerLen);
+  }
+  poll();
+  BOOST_REQUIRE(receivedData);
+  BOOST_CHECK_EQUAL(receivedData->wireEncode(), data->wireEncode());
+
+  // a large Data from the application is fragmented
+  auto data2 = makeLargeData("/C", 20000);
+  face.put(*data2);
+  poll();
+  auto datagrams = receiveAll();
+  BOOST_CHECK_EQUAL(datagrams.size(), 3);
+
+  Scheduler scheduler(io);
+  lp::Reassembler reassembler(scheduler);
+  optional<std::pair<Block, lp::Packet>> reassembled;
+  for (const auto& datagram : datagrams) {
+    BOOST_CHECK_LE(datagram.size(), MAX_NDN_PACKET_SIZE);
+    reassembled = reassembler.receiveFragment(lp::Packet(datagram));
+  }
+  BOOST_REQUIRE(reassembled);
+  BOOST_CHECK_EQUAL(reassembled->first, data2->wireEncode());
+
+  // even fragmented, a packet cannot exceed MAX_FRAGMENTED_PACKET_SIZE
+  face.put(*makeLargeData("/D", Face::MAX_FRAGMENTED_PACKET_SIZE));
+  BOOST_CHECK_THROW(poll(), Face::OversizedPacketError);
+}
+
+BOOST_AUTO_TEST_CASE(UnixSeqpacket)
+{
+  boost::filesystem::create_directories(UNIT_TEST_CONFIG_PATH);
+  auto path = (boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "seqpacket.sock").string();
+  boost::filesystem::remove(path);
+
+  int listenFd = ::socket(AF_UNIX, SOCK_SEQPACKET, 0);
+  BOOST_REQUIRE_GE(listenFd, 0);
+  boost::asio::local::stream_protocol::endpoint endpoint(path);
+  BOOST_REQUIRE_EQUAL(::bind(listenFd, endpoint.data(), endpoint.size()), 0);
+  BOOST_REQUIRE_EQUAL(::listen(listenFd, 1), 0);
+
+  UnixSeqpacketTransport transport(path);
+  transport.connect(io, [this] (const Block& wire) { received.push_back(wire); });
+  BOOST_CHECK(transport.isConnected());
+  transport.resume();
+
+  serverFd = ::accept(listenFd, nullptr, nullptr);
+  ::close(listenFd);
+  BOOST_REQUIRE_GE(serverFd, 0);
+
+  sendAndEcho(transport, 100);
+  BOOST_REQUIRE_EQUAL(received.size(), 100);
+  for (size_t i = 0; i < received.size(); ++i) {
+    BOOST_CHECK_EQUAL(Interest(received[i]).getName(), Name("/A").appendNumber(i));
+  }
+
+  // the forwarder goes away
+  ::close(serverFd);
+  serverFd = -1;
+  BOOST_CHECK_THROW(poll(), Transport::Error);
+  BOOST_CHECK(!transport.isConnected());
+  boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(ConnectFailure)
+{
+  UnixSeqpacketTransport transport("/nonexistent/seqpacket.sock");
+  BOOST_CHECK_THROW(transport.connect(io, [] (const Block&) {}), Transport::Error);
+  BOOST_CHECK(!transport.isConnected());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestDatagramTransport
+BOOST_AUTO_TEST_SUITE_END() // Transport
+
+} // namespace tests
+} // namespace ndn
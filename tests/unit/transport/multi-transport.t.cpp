@@ -0,0 +1,299 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/transport/multi-transport.hpp"
+#include "ndn-cxx/face.hpp"
+#include "ndn-cxx/lp/packet.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/make-interest-data.hpp"
+#include "tests/unit/identity-management-time-fixture.hpp"
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Transport)
+
+using ndn::Transport;
+
+class MockTransport : public Transport
+{
+public:
+  void
+  connect(boost::asio::io_service& ioService, const ReceiveCallback& receiveCallback) override
+  {
+    Transport::connect(ioService, receiveCallback);
+    m_isConnected = true;
+    ++nConnects;
+  }
+
+  void
+  close() override
+  {
+    m_isConnected = false;
+    m_isReceiving = false;
+  }
+
+  void
+  pause() override
+  {
+    m_isReceiving = false;
+  }
+
+  void
+  resume() override
+  {
+    m_isReceiving = true;
+  }
+
+  void
+  send(const Block& wire) override
+  {
+    sentPackets.push_back(wire);
+  }
+
+  void
+  send(const Block& header, const Block& payload) override
+  {
+    send(payload);
+  }
+
+  void
+  inject(const Block& wire)
+  {
+    receive(wire);
+  }
+
+public:
+  std::vector<Block> sentPackets;
+  int nConnects = 0;
+};
+
+class MultiTransportFixture : public IdentityManagementTimeFixture
+{
+public:
+  MultiTransportFixture()
+  {
+    std::vector<shared_ptr<Transport>> transports;
+    for (int i = 0; i < 4; ++i) {
+      mocks.push_back(make_shared<MockTransport>());
+      transports.push_back(mocks.back());
+    }
+    transport = make_shared<MultiTransport>(std::move(transports));
+  }
+
+  /** \return index of the mock that sent \p wire, or -1
+   */
+  int
+  findSender(const Block& wire) const
+  {
+    for (size_t i = 0; i < mocks.size(); ++i) {
+      for (const auto& sent : mocks[i]->sentPackets) {
+        if (sent == wire) {
+          return static_cast<int>(i);
+        }
+      }
+    }
+    return -1;
+  }
+
+  size_t
+  countSent() const
+  {
+    size_t n = 0;
+    for (const auto& mock : mocks) {
+      n += mock->sentPackets.size();
+    }
+    return n;
+  }
+
+public:
+  std::vector<shared_ptr<MockTransport>> mocks;
+  shared_ptr<MultiTransport> transport;
+  std::vector<Block> received;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestMultiTransport, MultiTransportFixture)
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  BOOST_CHECK_THROW(MultiTransport({}), Transport::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Create)
+{
+  auto unix = MultiTransport::create("unix:///tmp/nfd.sock", 3);
+  BOOST_CHECK_EQUAL(unix->getNTransports(), 3);
+  auto tcp = MultiTransport::create("tcp://localhost:6363", 2);
+  BOOST_CHECK_EQUAL(tcp->getNTransports(), 2);
+  BOOST_CHECK_THROW(MultiTransport::create("udp://localhost:6363", 2), Transport::Error);
+}
+
+BOOST_AUTO_TEST_CASE(ConnectClose)
+{
+  transport->connect(io, [this] (const Block& wire) { received.push_back(wire); });
+  BOOST_CHECK(transport->isConnected());
+  for (const auto& mock : mocks) {
+    BOOST_CHECK(mock->isConnected());
+  }
+
+  transport->resume();
+  BOOST_CHECK(transport->isReceiving());
+  for (const auto& mock : mocks) {
+    BOOST_CHECK(mock->isReceiving());
+  }
+
+  // a connection that was lost is reestablished on the next send
+  mocks[1]->close();
+  for (int i = 0; i < 64; ++i) {
+    transport->send(makeInterest(Name("/A").appendNumber(i))->wireEncode());
+  }
+  BOOST_CHECK_EQUAL(mocks[1]->nConnects, 2);
+  BOOST_CHECK(mocks[1]->isReceiving());
+
+  transport->close();
+  BOOST_CHECK(!transport->isConnected());
+  for (const auto& mock : mocks) {
+    BOOST_CHECK(!mock->isConnected());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(StripeInterests)
+{
+  transport->connect(io, [this] (const Block& wire) { received.push_back(wire); });
+
+  std::set<int> senders;
+  for (int i = 0; i < 64; ++i) {
+    Block wire = makeInterest(Name("/A").appendNumber(i))->wireEncode();
+    transport->send(wire);
+    senders.insert(findSender(wire));
+  }
+  BOOST_CHECK_EQUAL(countSent(), 64);
+  BOOST_CHECK_EQUAL(senders.size(), 4);
+
+  // the same name is always sent on the same connection
+  auto interest = makeInterest("/A/B");
+  size_t index = transport->selectTransport(interest->wireEncode());
+  interest->refreshNonce();
+  BOOST_CHECK_EQUAL(transport->selectTransport(interest->wireEncode()), index);
+
+  lp::Packet lpPacket(interest->wireEncode());
+  BOOST_CHECK_EQUAL(transport->selectTransport(lpPacket.wireEncode()), index);
+}
+
+BOOST_AUTO_TEST_CASE(ReplyOnIncomingConnection)
+{
+  transport->connect(io, [this] (const Block& wire) { received.push_back(wire); });
+
+  for (size_t i = 0; i < mocks.size(); ++i) {
+    mocks[i]->inject(makeInterest(Name("/P").appendNumber(i))->wireEncode());
+  }
+  BOOST_CHECK_EQUAL(received.size(), 4);
+
+  for (size_t i = 0; i < mocks.size(); ++i) {
+    // Data name is longer than the Interest name
+    Block data = makeData(Name("/P").appendNumber(i).append("v1"))->wireEncode();
+    transport->send(data);
+    BOOST_CHECK_EQUAL(findSender(data), static_cast<int>(i));
+  }
+
+  auto interest = makeInterest("/N");
+  lp::Packet incoming(interest->wireEncode());
+  mocks[2]->inject(incoming.wireEncode());
+  Block nack = lp::Packet(interest->wireEncode()).add<lp::NackField>(lp::NackHeader()).wireEncode();
+  transport->send(nack);
+  BOOST_CHECK_EQUAL(findSender(nack), 2);
+}
+
+BOOST_AUTO_TEST_CASE(ReplyAfterOriginsEvicted)
+{
+  transport->connect(io, [this] (const Block& wire) { received.push_back(wire); });
+
+  // an answered Interest must not leave a stale entry that later evicts a newer origin
+  mocks[1]->inject(makeInterest("/A")->wireEncode());
+  transport->send(makeData("/A/v1")->wireEncode());
+  mocks[3]->inject(makeInterest("/A")->wireEncode());
+  for (size_t i = 1; i < MultiTransport::MAX_INTEREST_ORIGINS; ++i) {
+    mocks[0]->inject(makeInterest(Name("/B").appendNumber(i))->wireEncode());
+  }
+
+  Block data = makeData("/A")->wireEncode();
+  transport->send(data);
+  BOOST_CHECK_EQUAL(findSender(data), 3);
+
+  // the oldest origin is evicted once the limit is exceeded
+  mocks[2]->inject(makeInterest("/C")->wireEncode());
+  mocks[2]->inject(makeInterest("/D")->wireEncode());
+  data = makeData(Name("/B").appendNumber(1))->wireEncode();
+  transport->send(data);
+  BOOST_CHECK_EQUAL(findSender(data),
+                    static_cast<int>(std::hash<Name>()(Name("/B").appendNumber(1)) % mocks.size()));
+}
+
+BOOST_AUTO_TEST_CASE(WithFace)
+{
+  Face face(transport, io, m_keyChain);
+  face.setInterestFilter("/P", [&face] (const auto&, const Interest& interest) {
+    face.put(*makeData(interest.getName()));
+  });
+  advanceClocks(10_ms);
+
+  int nData = 0;
+  for (int i = 0; i < 16; ++i) {
+    face.expressInterest(*makeInterest(Name("/A").appendNumber(i)),
+                         [&] (const auto&, const auto&) { ++nData; }, nullptr, nullptr);
+  }
+  advanceClocks(10_ms);
+
+  // answer each Interest on the connection it was sent on
+  for (const auto& mock : mocks) {
+    auto sent = mock->sentPackets;
+    for (const auto& wire : sent) {
+      lp::Packet packet(wire);
+      if (!packet.has<lp::FragmentField>()) {
+        continue;
+      }
+      auto fragment = packet.get<lp::FragmentField>();
+      Block inner(&*fragment.first, std::distance(fragment.first, fragment.second));
+      if (inner.type() == tlv::Interest) {
+        Interest interest(inner);
+        if (interest.getName().getPrefix(1) == "/A") {
+          mock->inject(makeData(interest.getName())->wireEncode());
+        }
+      }
+    }
+  }
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nData, 16);
+
+  // producer Data goes back on the connection that delivered the Interest
+  Block incoming = makeInterest("/P/1")->wireEncode();
+  mocks[3]->inject(incoming);
+  size_t nSent = mocks[3]->sentPackets.size();
+  advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(mocks[3]->sentPackets.size(), nSent + 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestMultiTransport
+BOOST_AUTO_TEST_SUITE_END() // Transport
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,274 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/transport/shm-transport.hpp"
+#include "ndn-cxx/transport/detail/shm-channel.hpp"
+#include "ndn-cxx/face.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/make-interest-data.hpp"
+#include "tests/unit/identity-management-time-fixture.hpp"
+
+#include <boost/asio/write.hpp>
+#include <boost/filesystem.hpp>
+
+#ifdef __linux__
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Transport)
+
+using ndn::Transport;
+using detail::ShmChannel;
+using detail::ShmRing;
+
+/** \brief a stand-in for a forwarder that answers every Interest with a Data of the same name
+ */
+class ShmLoopbackForwarder
+{
+public:
+  enum Mode {
+    ACCEPT_SHM,
+    REJECT_SHM,
+    IGNORE_HANDSHAKE,
+  };
+
+  ShmLoopbackForwarder(boost::asio::io_service& io, const std::string& path, Mode mode = ACCEPT_SHM)
+    : m_io(io)
+    , m_acceptor(io)
+    , m_mode(mode)
+  {
+    boost::filesystem::remove(path);
+    m_acceptor.open();
+    m_acceptor.bind(boost::asio::local::stream_protocol::endpoint(path));
+    m_acceptor.listen();
+    accept();
+  }
+
+public:
+  std::vector<Block> received;
+
+private:
+  void
+  accept()
+  {
+    auto socket = make_shared<boost::asio::local::stream_protocol::socket>(m_io);
+    m_acceptor.async_accept(*socket, [this, socket] (const boost::system::error_code& error) {
+      if (error) {
+        return;
+      }
+      m_socket = socket;
+      m_socket->async_receive(boost::asio::null_buffers(),
+                              [this] (const boost::system::error_code& error, size_t) {
+                                if (!error && m_mode != IGNORE_HANDSHAKE) {
+                                  handshake();
+                                }
+                              });
+    });
+  }
+
+  void
+  handshake()
+  {
+    m_channel = ShmChannel::acceptHandshake(m_io, m_socket->native_handle());
+    if (m_mode == REJECT_SHM) {
+      m_channel->close();
+      m_socket->close();
+      return;
+    }
+
+    m_channel->start([this] (const Block& wire) {
+      received.push_back(wire);
+      if (wire.type() == tlv::Interest) {
+        m_channel->send(makeData(Interest(wire).getName())->wireEncode());
+      }
+    });
+    uint8_t ack = 1;
+    boost::asio::write(*m_socket, boost::asio::buffer(&ack, 1));
+  }
+
+private:
+  boost::asio::io_service& m_io;
+  boost::asio::local::stream_protocol::acceptor m_acceptor;
+  shared_ptr<boost::asio::local::stream_protocol::socket> m_socket;
+  shared_ptr<ShmChannel> m_channel;
+  Mode m_mode;
+};
+
+class ShmTransportFixture : public IdentityManagementTimeFixture
+{
+public:
+  ShmTransportFixture()
+    : path((boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "shm-transport.sock").string())
+  {
+    boost::filesystem::create_directories(UNIT_TEST_CONFIG_PATH);
+  }
+
+  ~ShmTransportFixture()
+  {
+    boost::filesystem::remove(path);
+  }
+
+public:
+  const std::string path;
+};
+
+BOOST_AUTO_TEST_SUITE(TestShmRing)
+
+BOOST_AUTO_TEST_CASE(WriteRead)
+{
+  std::vector<uint64_t> memory(ShmRing::computeSize(64) / sizeof(uint64_t));
+  ShmRing::initialize(memory.data(), 64);
+  ShmRing producer(memory.data(), memory.size() * sizeof(uint64_t));
+  ShmRing consumer(memory.data(), memory.size() * sizeof(uint64_t));
+  BOOST_CHECK_EQUAL(producer.getCapacity(), 64);
+  BOOST_CHECK_EQUAL(producer.getMaxRecordSize(), 24);
+
+  BOOST_CHECK(consumer.peek().first == nullptr);
+  BOOST_CHECK_EQUAL(consumer.prepareReaderWait(), false);
+
+  const uint8_t a[] = {1, 2, 3};
+  const uint8_t b[] = {4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
+  BOOST_CHECK(producer.tryWrite(a, sizeof(a), b, sizeof(b))); // 8 + 24
+  BOOST_CHECK_EQUAL(producer.needWakeReader(), true);
+  BOOST_CHECK_EQUAL(producer.needWakeReader(), false);
+  BOOST_CHECK(producer.tryWrite(a, sizeof(a))); // 8 + 8
+  BOOST_CHECK(!producer.tryWrite(b, sizeof(b))); // 8 + 24 does not fit
+  BOOST_CHECK_EQUAL(producer.prepareWriterWait(sizeof(b)), false);
+
+  auto record = consumer.peek();
+  BOOST_REQUIRE_EQUAL(record.second, sizeof(a) + sizeof(b));
+  BOOST_CHECK_EQUAL(record.first[0], 1);
+  BOOST_CHECK_EQUAL(record.first[19], 20);
+  consumer.pop();
+  BOOST_CHECK_EQUAL(consumer.needWakeWriter(), true);
+
+  // the record does not fit before the end of the ring, so it is written at the beginning
+  BOOST_CHECK(producer.tryWrite(b, sizeof(b)));
+
+  record = consumer.peek();
+  BOOST_REQUIRE_EQUAL(record.second, sizeof(a));
+  consumer.pop();
+  record = consumer.peek();
+  BOOST_REQUIRE_EQUAL(record.second, sizeof(b));
+  BOOST_CHECK(record.first == reinterpret_cast<const uint8_t*>(memory.data()) + ShmRing::computeSize(0) + 8);
+  consumer.pop();
+  BOOST_CHECK(consumer.peek().first == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Invalid)
+{
+  std::vector<uint64_t> memory(ShmRing::computeSize(64) / sizeof(uint64_t));
+  ShmRing::initialize(memory.data(), 64);
+  BOOST_CHECK_THROW(ShmRing(memory.data(), ShmRing::computeSize(32)), std::invalid_argument);
+  BOOST_CHECK_THROW(ShmRing(memory.data(), 8), std::invalid_argument);
+
+  ShmRing producer(memory.data(), memory.size() * sizeof(uint64_t));
+  ShmRing consumer(memory.data(), memory.size() * sizeof(uint64_t));
+  const uint8_t a[] = {1, 2, 3};
+  BOOST_CHECK(producer.tryWrite(a, sizeof(a)));
+
+  // corrupt the record length
+  uint32_t len = 1000;
+  std::memcpy(reinterpret_cast<uint8_t*>(memory.data()) + ShmRing::computeSize(0), &len, sizeof(len));
+  BOOST_CHECK_THROW(consumer.peek(), ShmRing::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestShmRing
+
+BOOST_FIXTURE_TEST_SUITE(TestShmTransport, ShmTransportFixture)
+
+BOOST_AUTO_TEST_CASE(Create)
+{
+  BOOST_CHECK_NO_THROW(ShmTransport::create("unix:///tmp/nfd.sock"));
+  BOOST_CHECK_THROW(ShmTransport::create("tcp://localhost"), Transport::Error);
+}
+
+BOOST_AUTO_TEST_CASE(ConnectionRefused)
+{
+  ShmTransport transport(path);
+  transport.connect(io, [] (const Block&) {});
+  BOOST_CHECK_THROW(advanceClocks(1_ms, 10), Transport::Error);
+  BOOST_CHECK(!transport.isConnected());
+}
+
+BOOST_AUTO_TEST_CASE(ConnectTimeout)
+{
+  ShmLoopbackForwarder forwarder(io, path, ShmLoopbackForwarder::IGNORE_HANDSHAKE);
+  ShmTransport transport(path);
+  transport.connect(io, [] (const Block&) {});
+  BOOST_CHECK_NO_THROW(advanceClocks(1_ms, 10));
+  BOOST_CHECK(!transport.isConnected());
+
+  BOOST_CHECK_THROW(advanceClocks(1_s, 5), Transport::Error);
+  BOOST_CHECK(!transport.isConnected());
+}
+
+BOOST_AUTO_TEST_CASE(ExpressInterest)
+{
+  ShmLoopbackForwarder forwarder(io, path);
+  Face face(make_shared<ShmTransport>(path), io, m_keyChain);
+
+  int nData = 0;
+  face.expressInterest(*makeInterest("/A/1"),
+                       [&] (const Interest&, const Data& data) {
+                         BOOST_CHECK_EQUAL(data.getName(), "/A/1");
+                         ++nData;
+                       }, nullptr, nullptr);
+  advanceClocks(1_ms, 20);
+  BOOST_CHECK_EQUAL(forwarder.received.size(), 1);
+  BOOST_CHECK_EQUAL(nData, 1);
+}
+
+BOOST_AUTO_TEST_CASE(RingFull)
+{
+  ShmLoopbackForwarder forwarder(io, path);
+  // both rings overflow, so that packets are queued in both directions
+  Face face(make_shared<ShmTransport>(path, 4096), io, m_keyChain);
+
+  int nData = 0;
+  for (int i = 0; i < 500; ++i) {
+    face.expressInterest(*makeInterest(Name("/A").appendNumber(i)),
+                         [&] (const Interest&, const Data&) { ++nData; }, nullptr, nullptr);
+  }
+  advanceClocks(1_ms, 100);
+  BOOST_CHECK_EQUAL(forwarder.received.size(), 500);
+  BOOST_CHECK_EQUAL(nData, 500);
+}
+
+BOOST_AUTO_TEST_CASE(ForwarderWithoutShm)
+{
+  ShmLoopbackForwarder forwarder(io, path, ShmLoopbackForwarder::REJECT_SHM);
+  ShmTransport transport(path);
+  transport.connect(io, [] (const Block&) {});
+  BOOST_CHECK(!transport.isConnected());
+  BOOST_CHECK_THROW(advanceClocks(1_ms, 10), Transport::Error);
+  BOOST_CHECK(!transport.isConnected());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestShmTransport
+BOOST_AUTO_TEST_SUITE_END() // Transport
+
+} // namespace tests
+} // namespace ndn
+
+#endif // __linux__
@@ -20,10 +20,16 @@
  */
 
 #include "ndn-cxx/transport/unix-transport.hpp"
+#include "ndn-cxx/encoding/block-helpers.hpp"
 
 #include "tests/boost-test.hpp"
+#include "tests/make-interest-data.hpp"
 #include "tests/unit/transport/transport-fixture.hpp"
 
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/filesystem.hpp>
+
 namespace ndn {
 namespace tests {
 
@@ -60,6 +66,101 @@ BOOST_AUTO_TEST_CASE(GetDefaultSocketNameBadMalformedUri)
                         });
 }
 
+BOOST_AUTO_TEST_CASE(ReceiveBurst)
+{
+  boost::asio::io_service io;
+  auto poll = [&io] {
+    io.poll();
+    io.reset();
+  };
+
+  boost::filesystem::create_directories(UNIT_TEST_CONFIG_PATH);
+  auto path = (boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "unix-transport.sock").string();
+  boost::filesystem::remove(path);
+  boost::asio::local::stream_protocol::acceptor acceptor(io, boost::asio::local::stream_protocol::endpoint(path));
+  boost::asio::local::stream_protocol::socket server(io);
+  acceptor.async_accept(server, [] (const boost::system::error_code&) {});
+
+  UnixTransport transport(path);
+  std::vector<Block> received;
+  transport.connect(io, [&received] (const Block& wire) { received.push_back(wire); });
+  for (int i = 0; i < 100 && !transport.isConnected(); ++i) {
+    poll();
+  }
+  BOOST_REQUIRE(transport.isConnected());
+  transport.resume();
+
+  // more packets than fit into the input buffer, written at once
+  const size_t nPackets = 2000;
+  std::vector<uint8_t> stream;
+  for (size_t i = 0; i < nPackets; ++i) {
+    Block wire = makeData(Name("/A").appendNumber(i))->wireEncode();
+    stream.insert(stream.end(), wire.begin(), wire.end());
+  }
+
+  // the last packet arrives in two parts
+  boost::asio::async_write(server, boost::asio::buffer(stream.data(), stream.size() - 10),
+                           [] (const boost::system::error_code&, size_t) {});
+  for (int i = 0; i < 1000 && received.size() < nPackets - 1; ++i) {
+    poll();
+  }
+  BOOST_CHECK_EQUAL(received.size(), nPackets - 1);
+
+  boost::asio::write(server, boost::asio::buffer(stream.data() + stream.size() - 10, 10));
+  for (int i = 0; i < 100 && received.size() < nPackets; ++i) {
+    poll();
+  }
+  BOOST_REQUIRE_EQUAL(received.size(), nPackets);
+  for (size_t i = 0; i < nPackets; ++i) {
+    BOOST_CHECK_EQUAL(Data(received[i]).getName(), Name("/A").appendNumber(i));
+  }
+
+  transport.close();
+  boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(ReceiveOversized)
+{
+  boost::asio::io_service io;
+  auto poll = [&io] {
+    io.poll();
+    io.reset();
+  };
+
+  boost::filesystem::create_directories(UNIT_TEST_CONFIG_PATH);
+  auto path = (boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "unix-transport.sock").string();
+  boost::filesystem::remove(path);
+  boost::asio::local::stream_protocol::acceptor acceptor(io, boost::asio::local::stream_protocol::endpoint(path));
+  boost::asio::local::stream_protocol::socket server(io);
+  acceptor.async_accept(server, [] (const boost::system::error_code&) {});
+
+  UnixTransport transport(path);
+  std::vector<Block> received;
+  transport.connect(io, [&received] (const Block& wire) { received.push_back(wire); });
+  for (int i = 0; i < 100 && !transport.isConnected(); ++i) {
+    poll();
+  }
+  BOOST_REQUIRE(transport.isConnected());
+  transport.resume();
+
+  // an element just over the size limit, which fits into the input buffer, written at once
+  std::vector<uint8_t> value(MAX_NDN_PACKET_SIZE);
+  Block oversized = makeBinaryBlock(tlv::Data, value.data(), value.size());
+  BOOST_REQUIRE_GT(oversized.size(), MAX_NDN_PACKET_SIZE);
+  boost::asio::write(server, boost::asio::buffer(oversized.wire(), oversized.size()));
+
+  BOOST_CHECK_THROW(([&] {
+                      for (int i = 0; i < 100; ++i) {
+                        poll();
+                      }
+                    }()),
+                    Transport::Error);
+  BOOST_CHECK_EQUAL(received.size(), 0);
+  BOOST_CHECK(!transport.isConnected());
+
+  boost::filesystem::remove(path);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestUnixTransport
 BOOST_AUTO_TEST_SUITE_END() // Transport
 
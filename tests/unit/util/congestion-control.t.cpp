@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/util/congestion-control.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <boost/lexical_cast.hpp>
+#include <cmath>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Util)
+BOOST_AUTO_TEST_SUITE(TestCongestionControl)
+
+const time::steady_clock::TimePoint T0 = time::steady_clock::TimePoint() + 1_s;
+
+static CongestionControl::Ack
+makeAck(time::nanoseconds t, time::nanoseconds rtt = -1_ns)
+{
+  CongestionControl::Ack ack;
+  ack.time = T0 + t;
+  ack.rtt = rtt;
+  ack.sRtt = rtt;
+  return ack;
+}
+
+BOOST_AUTO_TEST_CASE(Aimd)
+{
+  AimdCongestionControl cc(1.0, 0.5, 1.0, false);
+  double cwnd = 1.0;
+  double ssthresh = 8.0;
+
+  for (int i = 0; i < 7; ++i) {
+    cc.increase(cwnd, ssthresh, makeAck(0_ms));
+  }
+  BOOST_CHECK_EQUAL(cwnd, 8.0); // slow start
+  cc.increase(cwnd, ssthresh, makeAck(0_ms));
+  BOOST_CHECK_EQUAL(cwnd, 8.125); // congestion avoidance
+
+  cc.decrease(cwnd, ssthresh, T0);
+  BOOST_CHECK_EQUAL(ssthresh, 8.125 / 2);
+  BOOST_CHECK_EQUAL(cwnd, 8.125 / 2);
+
+  cwnd = 3.0;
+  cc.decrease(cwnd, ssthresh, T0);
+  BOOST_CHECK_EQUAL(ssthresh, CongestionControl::MIN_SSTHRESH);
+  BOOST_CHECK_EQUAL(cwnd, CongestionControl::MIN_SSTHRESH);
+
+  AimdCongestionControl ccReset(1.0, 0.5, 1.0, true);
+  cwnd = 20.0;
+  ccReset.decrease(cwnd, ssthresh, T0);
+  BOOST_CHECK_EQUAL(ssthresh, 10.0);
+  BOOST_CHECK_EQUAL(cwnd, 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(Cubic)
+{
+  CubicCongestionControl cc(0.7, 0.4);
+  double cwnd = 100.0;
+  double ssthresh = std::numeric_limits<double>::max();
+
+  cc.increase(cwnd, ssthresh, makeAck(0_ms));
+  BOOST_CHECK_EQUAL(cwnd, 101.0); // slow start
+
+  cwnd = 100.0;
+  cc.decrease(cwnd, ssthresh, T0);
+  BOOST_CHECK_EQUAL(ssthresh, 70.0);
+  BOOST_CHECK_EQUAL(cwnd, 70.0);
+
+  // one segment every 10ms; the window should approach its previous maximum after
+  // K = cbrt(100 * (1 - 0.7) / 0.4) = 4.2s, stay near it, then grow beyond it
+  std::map<int, double> cwndAt;
+  for (int i = 0; i <= 1000; ++i) {
+    cc.increase(cwnd, ssthresh, makeAck(time::milliseconds(10 * i)));
+    cwndAt[i] = cwnd;
+  }
+  BOOST_CHECK_GT(cwndAt[100], 75.0);
+  BOOST_CHECK_LT(cwndAt[100], 85.0);
+  BOOST_CHECK_GT(cwndAt[420], 95.0);
+  BOOST_CHECK_LT(cwndAt[500], 100.0);
+  BOOST_CHECK_GT(cwndAt[1000], 130.0);
+
+  // fast convergence: loss below the previous maximum lowers it further
+  cwnd = 90.0;
+  cc.decrease(cwnd, ssthresh, T0);
+  BOOST_CHECK_CLOSE(cwnd, 63.0, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(Bbr)
+{
+  BbrCongestionControl cc;
+  double cwnd = 1.0;
+  double ssthresh = std::numeric_limits<double>::max();
+  BOOST_CHECK_EQUAL(cc.getBandwidth(), 0.0);
+  BOOST_CHECK_EQUAL(cc.getBdp(), 0.0);
+
+  // segments delivered at 1000/s with 100ms RTT
+  int i = 0;
+  for (; i < 100; ++i) {
+    cc.increase(cwnd, ssthresh, makeAck(time::milliseconds(i), 100_ms));
+  }
+  BOOST_CHECK_EQUAL(cwnd, 101.0); // startup: one segment per ack
+
+  for (; i < 600; ++i) {
+    cc.increase(cwnd, ssthresh, makeAck(time::milliseconds(i), 100_ms));
+  }
+  // bandwidth stopped growing, so startup has ended and the window tracks the BDP
+  BOOST_CHECK_CLOSE(cc.getBandwidth(), 1000.0, 2.0);
+  BOOST_CHECK_CLOSE(cc.getBdp(), 100.0, 2.0);
+  BOOST_CHECK_CLOSE(cwnd, cc.getBdp(), 0.001);
+
+  // a congestion event does not shrink the window below the BDP
+  cwnd = 150.0;
+  cc.decrease(cwnd, ssthresh, T0);
+  BOOST_CHECK_CLOSE(cwnd, cc.getBdp(), 0.001);
+
+  cwnd = 2.0;
+  cc.decrease(cwnd, ssthresh, T0);
+  BOOST_CHECK_EQUAL(cwnd, BbrCongestionControl::MIN_CWND);
+}
+
+BOOST_AUTO_TEST_CASE(BbrZeroRtt)
+{
+  BbrCongestionControl cc;
+  double cwnd = 1.0;
+  double ssthresh = std::numeric_limits<double>::max();
+
+  // every ack ends a round, often without any time elapsed
+  for (int i = 0; i < 100; ++i) {
+    cc.increase(cwnd, ssthresh, makeAck(time::milliseconds(i / 10), 0_ns));
+  }
+  BOOST_CHECK(std::isfinite(cc.getBandwidth()));
+  BOOST_CHECK_GT(cc.getBandwidth(), 0.0);
+  BOOST_CHECK_EQUAL(cc.getBdp(), 0.0);
+  BOOST_CHECK(std::isfinite(cwnd));
+
+  cc.decrease(cwnd, ssthresh, T0);
+  BOOST_CHECK(std::isfinite(cwnd));
+  BOOST_CHECK_GE(cwnd, BbrCongestionControl::MIN_CWND);
+}
+
+BOOST_AUTO_TEST_CASE(PrintAlgorithm)
+{
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(CongestionControlAlgorithm::AIMD), "AIMD");
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(CongestionControlAlgorithm::CUBIC), "CUBIC");
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(CongestionControlAlgorithm::BBR), "BBR");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCongestionControl
+BOOST_AUTO_TEST_SUITE_END() // Util
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/util/latency-histogram.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Util)
+BOOST_AUTO_TEST_SUITE(TestLatencyHistogram)
+
+BOOST_AUTO_TEST_CASE(Buckets)
+{
+  for (int i = 0; i < 16; ++i) {
+    BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(time::microseconds(i)), i);
+  }
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(time::microseconds(-5)), 0);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(time::microseconds(31)), 31);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(time::microseconds(32)), 32);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(time::microseconds(33)), 32);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(time::microseconds(34)), 33);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(time::hours(1000)),
+                    LatencyHistogram::N_BUCKETS - 1);
+
+  for (size_t i = 0; i < LatencyHistogram::N_BUCKETS - 1; ++i) {
+    auto lower = LatencyHistogram::getBucketLowerBound(i);
+    auto upper = LatencyHistogram::getBucketUpperBound(i);
+    BOOST_REQUIRE_LE(lower, upper);
+    BOOST_REQUIRE_EQUAL(LatencyHistogram::getBucketIndex(lower), i);
+    BOOST_REQUIRE_EQUAL(LatencyHistogram::getBucketIndex(upper), i);
+    // the width of a bucket is at most 1/16 of its lower bound
+    BOOST_REQUIRE_LE((upper - lower) * 16, std::max(lower, time::microseconds(1)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Statistics)
+{
+  LatencyHistogram h;
+  BOOST_CHECK_EQUAL(h.getCount(), 0);
+  BOOST_CHECK_EQUAL(h.getMean(), time::microseconds::zero());
+  BOOST_CHECK_EQUAL(h.getQuantile(0.5), time::microseconds::zero());
+
+  for (int i = 1; i <= 100; ++i) {
+    h.record(time::milliseconds(i));
+  }
+  BOOST_CHECK_EQUAL(h.getCount(), 100);
+  BOOST_CHECK_EQUAL(h.getMean(), 50500_us);
+  BOOST_CHECK_LE(h.getMin(), 1_ms);
+  BOOST_CHECK_GE(h.getMax(), 100_ms);
+  BOOST_CHECK_LE(h.getMax(), 100_ms * 17 / 16);
+
+  auto p50 = h.getQuantile(0.5);
+  BOOST_CHECK_GE(p50, 50_ms);
+  BOOST_CHECK_LE(p50, 50_ms * 17 / 16);
+  auto p99 = h.getQuantile(0.99);
+  BOOST_CHECK_GE(p99, 99_ms);
+  BOOST_CHECK_LE(p99, 99_ms * 17 / 16);
+
+  h.reset();
+  BOOST_CHECK_EQUAL(h.getCount(), 0);
+  BOOST_CHECK_EQUAL(h.getQuantile(1.0), time::microseconds::zero());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestLatencyHistogram
+BOOST_AUTO_TEST_SUITE_END() // Util
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
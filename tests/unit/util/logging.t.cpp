@@ -27,6 +27,8 @@
 
 #include <boost/test/output_test_stream.hpp>
 
+#include <thread>
+
 namespace ndn {
 namespace util {
 namespace tests {
@@ -656,6 +658,78 @@ BOOST_AUTO_TEST_CASE(SetNullptrDestination)
   // The default Boost.Log output is still expected
 }
 
+BOOST_AUTO_TEST_CASE(AsyncDestination)
+{
+  using boost::test_tools::output_test_stream;
+
+  auto os2 = make_shared<output_test_stream>();
+  Logging::setAsyncDestination(os2);
+  BOOST_CHECK(Logging::get().getDestination() == nullptr);
+
+  Logging::setLevel("Module1", LogLevel::INFO);
+  logFromModule1();
+  std::thread([] { logFromModule2(); }).join();
+
+  Logging::flush();
+  BOOST_CHECK(os.is_equal(""));
+  BOOST_CHECK(os2->is_equal(
+    LOG_SYSTIME_STR + "  INFO: [Module1] info1\n" +
+    LOG_SYSTIME_STR + "  WARN: [Module1] warn1\n" +
+    LOG_SYSTIME_STR + " ERROR: [Module1] error1\n" +
+    LOG_SYSTIME_STR + " FATAL: [Module1] fatal1\n" +
+    LOG_SYSTIME_STR + " FATAL: [Module2] fatal2\n"
+    ));
+
+  // formatting state does not leak into the next message
+  NDN_LOG_FATAL(std::hex << 255);
+  NDN_LOG_FATAL(255);
+  Logging::flush();
+  BOOST_CHECK(os2->is_equal(
+    LOG_SYSTIME_STR + " FATAL: [ndn.util.tests.Logging] ff\n" +
+    LOG_SYSTIME_STR + " FATAL: [ndn.util.tests.Logging] 255\n"
+    ));
+
+  // switch back to Boost.Log
+  Logging::setDestination(os);
+  logFromModule1();
+  Logging::flush();
+  BOOST_CHECK(os2->is_equal(""));
+  BOOST_CHECK(os.is_equal(
+    LOG_SYSTIME_STR + "  INFO: [Module1] info1\n" +
+    LOG_SYSTIME_STR + "  WARN: [Module1] warn1\n" +
+    LOG_SYSTIME_STR + " ERROR: [Module1] error1\n" +
+    LOG_SYSTIME_STR + " FATAL: [Module1] fatal1\n"
+    ));
+}
+
+BOOST_AUTO_TEST_CASE(AsyncDestinationOverflow)
+{
+  auto os2 = make_shared<std::ostringstream>();
+  Logging::setAsyncDestination(os2, 1024);
+  uint64_t nDroppedBefore = Logging::getNDroppedMessages();
+
+  // a new thread gets a buffer of the new size
+  const int nMessages = 1000;
+  std::thread([] {
+    for (int i = 0; i < nMessages; ++i) {
+      NDN_LOG_FATAL("message " << i << ' ' << std::string(100, 'x'));
+    }
+  }).join();
+
+  Logging::flush();
+  uint64_t nDropped = Logging::getNDroppedMessages() - nDroppedBefore;
+  std::string output = os2->str();
+  auto nLines = static_cast<uint64_t>(std::count(output.begin(), output.end(), '\n'));
+  if (nDropped == 0) {
+    BOOST_CHECK_EQUAL(nLines, nMessages);
+  }
+  else {
+    // the writer reports drops in one or more lines of their own
+    BOOST_CHECK_GT(nLines, nMessages - nDropped);
+    BOOST_CHECK_NE(output.find("log messages dropped"), std::string::npos);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestLogging
 BOOST_AUTO_TEST_SUITE_END() // Util
 
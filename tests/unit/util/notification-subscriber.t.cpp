@@ -33,6 +33,8 @@
 #include "tests/unit/identity-management-time-fixture.hpp"
 #include "tests/unit/util/simple-notification.hpp"
 
+#include <boost/algorithm/string/join.hpp>
+
 namespace ndn {
 namespace util {
 namespace tests {
@@ -70,6 +72,20 @@ public:
     subscriberFace.receive(data);
   }
 
+  /** \brief deliver the notification with a specific sequence number to subscriber
+   */
+  void
+  deliverNotification(uint64_t seqNum, const std::string& msg)
+  {
+    Name dataName = streamPrefix;
+    dataName.appendSequenceNumber(seqNum);
+    Data data(dataName);
+    data.setContent(SimpleNotification(msg).wireEncode());
+    data.setFreshnessPeriod(1_s);
+    m_keyChain.sign(data);
+    subscriberFace.receive(data);
+  }
+
   /** \brief deliver a Nack to subscriber
    */
   void
@@ -312,6 +328,79 @@ BOOST_AUTO_TEST_CASE(PayloadError)
   BOOST_CHECK(this->hasInitialRequest());
 }
 
+BOOST_AUTO_TEST_CASE(Pipeline)
+{
+  BOOST_CHECK_THROW(subscriber.setWindowSize(0), std::invalid_argument);
+  subscriber.setWindowSize(4);
+  std::vector<std::string> messages;
+  subscriber.onNotification.connect([&] (const SimpleNotification& n) {
+    messages.push_back(n.getMessage());
+  });
+  subscriber.start();
+  advanceClocks(1_ms);
+
+  subscriberFace.sentInterests.clear();
+  this->deliverNotification(10, "n10");
+  advanceClocks(1_ms);
+
+  // Interests for the next four notifications are outstanding
+  BOOST_REQUIRE_EQUAL(subscriberFace.sentInterests.size(), 4);
+  for (uint64_t i = 0; i < 4; ++i) {
+    BOOST_CHECK_EQUAL(subscriberFace.sentInterests[i].getName(),
+                      Name(streamPrefix).appendSequenceNumber(11 + i));
+  }
+  subscriberFace.sentInterests.clear();
+
+  // notifications received out of order are delivered in order
+  this->deliverNotification(12, "n12");
+  this->deliverNotification(13, "n13");
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(messages.size(), 1);
+  BOOST_CHECK_EQUAL(subscriberFace.sentInterests.size(), 0);
+
+  this->deliverNotification(11, "n11");
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(boost::algorithm::join(messages, ","), "n10,n11,n12,n13");
+  BOOST_REQUIRE_EQUAL(subscriberFace.sentInterests.size(), 3);
+  BOOST_CHECK_EQUAL(subscriberFace.sentInterests.back().getName(),
+                    Name(streamPrefix).appendSequenceNumber(17));
+}
+
+BOOST_AUTO_TEST_CASE(Gap)
+{
+  subscriber.setWindowSize(4);
+  std::vector<std::string> messages;
+  subscriber.onNotification.connect([&] (const SimpleNotification& n) {
+    messages.push_back(n.getMessage());
+  });
+  std::vector<uint64_t> gaps;
+  subscriber.onGap.connect([&] (uint64_t seqNum) { gaps.push_back(seqNum); });
+  subscriber.start();
+  advanceClocks(1_ms);
+
+  this->deliverNotification(0, "n0");
+  advanceClocks(1_ms);
+  this->deliverNotification(2, "n2");
+  advanceClocks(1_ms);
+  subscriberFace.sentInterests.clear();
+
+  // the missing notification is requested again
+  advanceClocks(100_ms, 11);
+  BOOST_CHECK_EQUAL(std::count_if(subscriberFace.sentInterests.begin(),
+                                  subscriberFace.sentInterests.end(),
+                                  [this] (const Interest& interest) {
+                                    return interest.getName() ==
+                                           Name(streamPrefix).appendSequenceNumber(1);
+                                  }), 1);
+  BOOST_CHECK_EQUAL(boost::algorithm::join(messages, ","), "n0");
+
+  // after it cannot be retrieved, it is skipped
+  advanceClocks(100_ms, 20);
+  BOOST_CHECK_EQUAL(boost::algorithm::join(messages, ","), "n0,n2");
+  BOOST_REQUIRE_EQUAL(gaps.size(), 1);
+  BOOST_CHECK_EQUAL(gaps[0], 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestNotificationSubscriber
 BOOST_AUTO_TEST_SUITE_END() // Util
 
@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/util/packet-trace.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/make-interest-data.hpp"
+#include "tests/unit/unit-test-time-fixture.hpp"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using namespace ndn::tests;
+
+class PacketTraceFixture : public UnitTestTimeFixture
+{
+public:
+  PacketTraceFixture()
+  {
+    boost::filesystem::create_directories(UNIT_TEST_CONFIG_PATH);
+  }
+
+  ~PacketTraceFixture()
+  {
+    boost::filesystem::remove(path);
+  }
+
+public:
+  const std::string path = (boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "test.trace").string();
+};
+
+BOOST_AUTO_TEST_SUITE(Util)
+BOOST_FIXTURE_TEST_SUITE(TestPacketTrace, PacketTraceFixture)
+
+BOOST_AUTO_TEST_CASE(WriteRead)
+{
+  auto t0 = time::system_clock::now();
+  {
+    PacketTraceWriter writer(path);
+    writer.write(PacketDirection::OUTGOING, makeInterest("/A")->wireEncode());
+    advanceClocks(1_s);
+    writer.write(PacketDirection::INCOMING, makeData("/A/B")->wireEncode());
+    BOOST_CHECK_EQUAL(writer.getNRecords(), 2);
+  }
+
+  PacketTraceReader reader(path);
+  auto record = reader.read();
+  BOOST_REQUIRE(record);
+  BOOST_CHECK(record->timestamp == t0);
+  BOOST_CHECK_EQUAL(record->direction, PacketDirection::OUTGOING);
+  BOOST_CHECK_EQUAL(Interest(record->wire).getName(), "/A");
+
+  record = reader.read();
+  BOOST_REQUIRE(record);
+  BOOST_CHECK(record->timestamp == t0 + 1_s);
+  BOOST_CHECK_EQUAL(record->direction, PacketDirection::INCOMING);
+  BOOST_CHECK_EQUAL(Data(record->wire).getName(), "/A/B");
+
+  BOOST_CHECK(!reader.read());
+}
+
+BOOST_AUTO_TEST_CASE(Overwrite)
+{
+  const int nPackets = 5000;
+  {
+    PacketTraceWriter writer(path, 1);
+    for (int i = 0; i < nPackets; ++i) {
+      writer.write(PacketDirection::OUTGOING, makeInterest(Name("/A").appendNumber(i))->wireEncode());
+    }
+    BOOST_CHECK_EQUAL(writer.getNRecords(), nPackets);
+  }
+
+  // the newest records are kept, in order
+  PacketTraceReader reader(path);
+  std::vector<uint64_t> numbers;
+  while (auto record = reader.read()) {
+    numbers.push_back(Interest(record->wire).getName().at(-1).toNumber());
+  }
+  BOOST_REQUIRE_GT(numbers.size(), 100);
+  BOOST_CHECK_LT(numbers.size(), nPackets);
+  BOOST_CHECK_EQUAL(numbers.back(), nPackets - 1);
+  for (size_t i = 1; i < numbers.size(); ++i) {
+    BOOST_CHECK_EQUAL(numbers[i], numbers[i - 1] + 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(NotATrace)
+{
+  BOOST_CHECK_THROW(PacketTraceReader("/nonexistent/test.trace"), PacketTraceReader::Error);
+  BOOST_CHECK_THROW(PacketTraceWriter("/nonexistent/test.trace"), PacketTraceWriter::Error);
+
+  {
+    std::ofstream os(path);
+    os << std::string(200, 'x');
+  }
+  BOOST_CHECK_THROW(PacketTraceReader{path}, PacketTraceReader::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestPacketTrace
+BOOST_AUTO_TEST_SUITE_END() // Util
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,233 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/util/segment-fetch-manager.hpp"
+#include "ndn-cxx/util/dummy-client-face.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/make-interest-data.hpp"
+#include "tests/unit/dummy-validator.hpp"
+#include "tests/unit/identity-management-time-fixture.hpp"
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using namespace ndn::tests;
+
+class SegmentFetchManagerFixture : public IdentityManagementTimeFixture
+{
+protected:
+  SegmentFetchManagerFixture()
+    : face(io, m_keyChain)
+  {
+    face.onSendInterest.connect([this] (const Interest& interest) {
+      if (isAutoResponding) {
+        respond(interest);
+      }
+    });
+  }
+
+  /** \brief Answers \p interest with a segment of the object it names.
+   */
+  void
+  respond(const Interest& interest)
+  {
+    Name prefix = interest.getName();
+    uint64_t segment = 0;
+    if (prefix.at(-1).isSegment()) {
+      segment = prefix.at(-1).toSegment();
+      prefix = prefix.getPrefix(-2);
+    }
+
+    const uint8_t buffer[] = "Hello, world!";
+    auto data = make_shared<Data>(Name(prefix).appendVersion(1).appendSegment(segment));
+    data->setContent(buffer, sizeof(buffer));
+    data->setFreshnessPeriod(1_s);
+    data->setFinalBlock(name::Component::fromSegment(nSegments - 1));
+    face.receive(*signData(data));
+  }
+
+  shared_ptr<SegmentFetcher>
+  fetch(SegmentFetchManager& manager, const Name& name, int priority = 0)
+  {
+    auto fetcher = manager.fetch(Interest(name), validator, priority);
+    fetcher->onComplete.connect([this] (ConstBufferPtr) { ++nCompletions; });
+    fetcher->onError.connect([this] (uint32_t, const std::string&) { ++nErrors; });
+    return fetcher;
+  }
+
+  std::vector<Name>
+  getSentNames() const
+  {
+    std::vector<Name> names;
+    for (const auto& interest : face.sentInterests) {
+      names.push_back(interest.getName());
+    }
+    return names;
+  }
+
+protected:
+  DummyClientFace face;
+  DummyValidator validator;
+  bool isAutoResponding = true;
+  uint64_t nSegments = 3;
+  int nCompletions = 0;
+  int nErrors = 0;
+};
+
+BOOST_AUTO_TEST_SUITE(Util)
+BOOST_FIXTURE_TEST_SUITE(TestSegmentFetchManager, SegmentFetchManagerFixture)
+
+BOOST_AUTO_TEST_CASE(SharedCongestionState)
+{
+  nSegments = 10;
+  SegmentFetchManager::Options options;
+  options.congestionPrefixLength = 1;
+  SegmentFetchManager manager(face, options);
+
+  fetch(manager, "/a/x");
+  fetch(manager, "/a/y");
+  fetch(manager, "/b/z");
+  BOOST_CHECK_EQUAL(manager.getNFetches(), 3);
+  advanceClocks(10_ms, 100);
+
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK_EQUAL(nCompletions, 3);
+  BOOST_CHECK_EQUAL(manager.getNFetches(), 0);
+  BOOST_CHECK_EQUAL(manager.getNInFlight(), 0);
+
+  // both fetches under /a grew the same window
+  BOOST_CHECK_GT(manager.getCwnd("/a"), manager.getCwnd("/b"));
+  BOOST_CHECK_GT(manager.getCwnd("/b"), 1.0);
+  BOOST_CHECK_EQUAL(manager.getCwnd("/a/other"), manager.getCwnd("/a"));
+  BOOST_CHECK(manager.getRttEstimator("/a") != nullptr);
+  BOOST_CHECK(manager.getRttEstimator("/a") != manager.getRttEstimator("/b"));
+  BOOST_CHECK_EQUAL(manager.getCwnd("/c"), 0.0);
+  BOOST_CHECK(manager.getRttEstimator("/c") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(MaxInFlight)
+{
+  nSegments = 1;
+  isAutoResponding = false;
+  SegmentFetchManager::Options options;
+  options.maxInFlight = 2;
+  options.fetcherOptions.useConstantCwnd = true;
+  options.fetcherOptions.initCwnd = 10.0;
+  SegmentFetchManager manager(face, options);
+
+  for (int i = 0; i < 5; ++i) {
+    fetch(manager, Name("/object").appendNumber(i));
+  }
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(manager.getNInFlight(), 2);
+  BOOST_CHECK_EQUAL(manager.getNFetches(), 5);
+
+  isAutoResponding = true;
+  respond(face.sentInterests.at(0));
+  respond(face.sentInterests.at(1));
+  advanceClocks(1_ms, 10);
+
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 5);
+  BOOST_CHECK_EQUAL(nCompletions, 5);
+  BOOST_CHECK_EQUAL(manager.getNFetches(), 0);
+  BOOST_CHECK_EQUAL(manager.getNInFlight(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Priority)
+{
+  nSegments = 1;
+  isAutoResponding = false;
+  SegmentFetchManager::Options options;
+  options.maxInFlight = 1;
+  SegmentFetchManager manager(face, options);
+
+  fetch(manager, "/A", 0);
+  fetch(manager, "/B", 1);
+  fetch(manager, "/C", 0);
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 1);
+
+  isAutoResponding = true;
+  respond(face.sentInterests.at(0));
+  advanceClocks(1_ms, 10);
+
+  // /B was queued after /C, but has a higher priority
+  std::vector<Name> expected{"/A", "/B", "/C"};
+  auto actual = getSentNames();
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(nCompletions, 3);
+}
+
+BOOST_AUTO_TEST_CASE(RoundRobin)
+{
+  SegmentFetchManager::Options options;
+  options.fetcherOptions.useConstantCwnd = true;
+  SegmentFetchManager manager(face, options);
+
+  fetch(manager, "/A");
+  fetch(manager, "/B");
+  advanceClocks(1_ms, 10);
+
+  // the shared window holds a single Interest, which the two fetches take in turns
+  std::vector<Name> expected{
+    "/A",
+    "/B",
+    Name("/A").appendVersion(1).appendSegment(1),
+    Name("/B").appendVersion(1).appendSegment(1),
+    Name("/A").appendVersion(1).appendSegment(2),
+    Name("/B").appendVersion(1).appendSegment(2),
+  };
+  auto actual = getSentNames();
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(nCompletions, 2);
+}
+
+BOOST_AUTO_TEST_CASE(Destruct)
+{
+  isAutoResponding = false;
+  shared_ptr<SegmentFetcher> fetcher1, fetcher2;
+  {
+    SegmentFetchManager::Options options;
+    options.maxInFlight = 1;
+    SegmentFetchManager manager(face, options);
+    fetcher1 = fetch(manager, "/A");
+    fetcher2 = fetch(manager, "/B");
+    advanceClocks(1_ms);
+    BOOST_CHECK_EQUAL(face.sentInterests.size(), 1);
+  }
+  BOOST_CHECK(fetcher1->m_this == nullptr);
+  BOOST_CHECK(fetcher2->m_this == nullptr);
+
+  advanceClocks(1_s, 10);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(nCompletions, 0);
+  BOOST_CHECK_EQUAL(nErrors, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSegmentFetchManager
+BOOST_AUTO_TEST_SUITE_END() // Util
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
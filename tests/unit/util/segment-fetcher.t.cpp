@@ -362,6 +362,141 @@ BOOST_AUTO_TEST_CASE(FirstSegmentNotZero)
   BOOST_CHECK_EQUAL(nAfterSegmentTimedOut, 0);
 }
 
+BOOST_AUTO_TEST_CASE(InOrder)
+{
+  DummyValidator acceptValidator;
+  nSegments = 401;
+  defaultSegmentToSend = 47;
+  face.onSendInterest.connect(bind(&Fixture::onInterest, this, _1));
+
+  SegmentFetcher::Options options;
+  options.inOrder = true;
+  shared_ptr<SegmentFetcher> fetcher = SegmentFetcher::start(face, Interest("/hello/world"),
+                                                             acceptValidator, options);
+  connectSignals(fetcher);
+  size_t nInOrderData = 0;
+  size_t nInOrderBytes = 0;
+  size_t nInOrderCompletions = 0;
+  fetcher->onInOrderData.connect([&] (const Block& content) {
+    BOOST_CHECK_EQUAL(content.type(), tlv::Content);
+    ++nInOrderData;
+    nInOrderBytes += content.value_size();
+  });
+  fetcher->onInOrderComplete.connect([&] {
+    BOOST_CHECK_EQUAL(nInOrderData, 401);
+    ++nInOrderCompletions;
+  });
+  fetcher->afterSegmentValidated.connect([&] (const Data& data) {
+    // segments are released once delivered, so at most the out-of-order ones are retained
+    BOOST_CHECK_LE(fetcher->m_segmentBuffer.size(), fetcher->m_receivedSegments.size() - nInOrderData);
+  });
+
+  face.processEvents(1_s);
+
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK_EQUAL(nCompletions, 0);
+  BOOST_CHECK_EQUAL(nInOrderCompletions, 1);
+  BOOST_CHECK_EQUAL(nInOrderData, 401);
+  BOOST_CHECK_EQUAL(nInOrderBytes, 14 * 401);
+}
+
+BOOST_AUTO_TEST_CASE(SegmentsWithoutConcatenation)
+{
+  DummyValidator acceptValidator;
+  nSegments = 401;
+  face.onSendInterest.connect(bind(&Fixture::onInterest, this, _1));
+
+  SegmentFetcher::Options options;
+  options.concatenateSegments = false;
+  shared_ptr<SegmentFetcher> fetcher = SegmentFetcher::start(face, Interest("/hello/world"),
+                                                             acceptValidator, options);
+  connectSignals(fetcher);
+  std::vector<Block> segments;
+  fetcher->onCompleteSegments.connect([&] (const std::vector<Block>& s) { segments = s; });
+
+  face.processEvents(1_s);
+
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK_EQUAL(nCompletions, 0);
+  BOOST_REQUIRE_EQUAL(segments.size(), 401);
+  for (const auto& segment : segments) {
+    BOOST_CHECK_EQUAL(segment.type(), tlv::Content);
+    BOOST_CHECK_EQUAL(segment.value_size(), 14);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CongestionControlAlgorithms)
+{
+  for (auto algorithm : {CongestionControlAlgorithm::AIMD,
+                         CongestionControlAlgorithm::CUBIC,
+                         CongestionControlAlgorithm::BBR}) {
+    BOOST_TEST_CONTEXT(algorithm) {
+      DummyValidator acceptValidator;
+      nSegments = 401;
+      nCompletions = 0;
+      uniqSegmentsSent.clear();
+      auto conn = face.onSendInterest.connect(bind(&Fixture::onInterest, this, _1));
+
+      SegmentFetcher::Options options;
+      options.ccAlgorithm = algorithm;
+      shared_ptr<SegmentFetcher> fetcher = SegmentFetcher::start(face, Interest("/hello/world"),
+                                                                 acceptValidator, options);
+      connectSignals(fetcher);
+      face.processEvents(1_s);
+      conn.disconnect();
+
+      BOOST_CHECK_EQUAL(nErrors, 0);
+      BOOST_CHECK_EQUAL(nCompletions, 1);
+      BOOST_CHECK_EQUAL(dataSize, 14 * 401);
+      BOOST_CHECK_GT(fetcher->m_cwnd, options.initCwnd);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CustomCongestionControl)
+{
+  class FixedWindow : public CongestionControl
+  {
+  public:
+    void
+    increase(double& cwnd, double&, const Ack&) final
+    {
+      ++nIncreases;
+      cwnd = 3.0;
+    }
+
+    void
+    decrease(double&, double&, time::steady_clock::TimePoint) final
+    {
+    }
+
+  public:
+    int nIncreases = 0;
+  };
+
+  DummyValidator acceptValidator;
+  nSegments = 10;
+  face.onSendInterest.connect(bind(&Fixture::onInterest, this, _1));
+
+  FixedWindow* cc = nullptr;
+  SegmentFetcher::Options options;
+  options.makeCongestionControl = [&cc] {
+    auto fixedWindow = make_unique<FixedWindow>();
+    cc = fixedWindow.get();
+    return fixedWindow;
+  };
+  shared_ptr<SegmentFetcher> fetcher = SegmentFetcher::start(face, Interest("/hello/world"),
+                                                             acceptValidator, options);
+  connectSignals(fetcher);
+  BOOST_REQUIRE(cc != nullptr);
+  face.processEvents(1_s);
+
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK_EQUAL(nCompletions, 1);
+  BOOST_CHECK_EQUAL(cc->nIncreases, 10);
+  BOOST_CHECK_EQUAL(fetcher->m_cwnd, 3.0);
+}
+
 BOOST_AUTO_TEST_CASE(WindowSize)
 {
   DummyValidator acceptValidator;
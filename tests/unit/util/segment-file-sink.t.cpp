@@ -0,0 +1,226 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/util/segment-file-sink.hpp"
+#include "ndn-cxx/util/dummy-client-face.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/make-interest-data.hpp"
+#include "tests/unit/dummy-validator.hpp"
+#include "tests/unit/identity-management-time-fixture.hpp"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using namespace ndn::tests;
+
+class SegmentFileSinkFixture : public IdentityManagementTimeFixture
+{
+protected:
+  SegmentFileSinkFixture()
+    : face(io, m_keyChain)
+    , filepath(boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "TestSegmentFileSink")
+    , filename(filepath.string())
+  {
+    boost::filesystem::create_directories(filepath.parent_path());
+    face.onSendInterest.connect([this] (const Interest& interest) { onInterest(interest); });
+  }
+
+  ~SegmentFileSinkFixture()
+  {
+    boost::system::error_code ec;
+    boost::filesystem::remove(filepath, ec); // ignore error
+    boost::filesystem::remove(SegmentFileSink::getProgressFilename(filename), ec);
+  }
+
+  std::vector<uint8_t>
+  makeSegmentContent(uint64_t segment) const
+  {
+    size_t size = segment == nSegments - 1 ? LAST_SEGMENT_SIZE : SEGMENT_SIZE;
+    if (segment == wrongSizeSegment) {
+      size /= 2;
+    }
+    return std::vector<uint8_t>(size, static_cast<uint8_t>(segment));
+  }
+
+  std::vector<uint8_t>
+  makeObject() const
+  {
+    std::vector<uint8_t> object;
+    for (uint64_t i = 0; i < nSegments; ++i) {
+      auto content = makeSegmentContent(i);
+      object.insert(object.end(), content.begin(), content.end());
+    }
+    return object;
+  }
+
+  std::vector<uint8_t>
+  readFile() const
+  {
+    std::ifstream is(filename, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+  }
+
+  shared_ptr<SegmentFileSink>
+  startSink()
+  {
+    auto sink = SegmentFileSink::start(face, Interest("/object"), validator, filename);
+    sink->onComplete.connect([this] (uint64_t size) {
+      ++nCompletions;
+      completedSize = size;
+    });
+    sink->onError.connect([this] (uint32_t code, const std::string&) {
+      ++nErrors;
+      lastError = code;
+    });
+    return sink;
+  }
+
+private:
+  void
+  onInterest(const Interest& interest)
+  {
+    uint64_t segment = 0;
+    if (interest.getName().at(-1).isSegment()) {
+      segment = interest.getName().at(-1).toSegment();
+      requestedSegments.push_back(segment);
+    }
+    if (segment >= maxSegmentToServe) {
+      return;
+    }
+
+    auto data = make_shared<Data>(Name("/object").appendVersion(1).appendSegment(segment));
+    data->setFreshnessPeriod(1_s);
+    auto content = makeSegmentContent(segment);
+    data->setContent(content.data(), content.size());
+    data->setFinalBlock(name::Component::fromSegment(nSegments - 1));
+    face.receive(*signData(data));
+  }
+
+protected:
+  static constexpr size_t SEGMENT_SIZE = 100;
+  static constexpr size_t LAST_SEGMENT_SIZE = 37;
+
+  DummyClientFace face;
+  DummyValidator validator;
+  boost::filesystem::path filepath;
+  std::string filename;
+
+  uint64_t nSegments = 20;
+  uint64_t maxSegmentToServe = std::numeric_limits<uint64_t>::max();
+  uint64_t wrongSizeSegment = std::numeric_limits<uint64_t>::max();
+  std::vector<uint64_t> requestedSegments;
+
+  int nCompletions = 0;
+  uint64_t completedSize = 0;
+  int nErrors = 0;
+  uint32_t lastError = 0;
+};
+
+BOOST_AUTO_TEST_SUITE(Util)
+BOOST_FIXTURE_TEST_SUITE(TestSegmentFileSink, SegmentFileSinkFixture)
+
+BOOST_AUTO_TEST_CASE(Complete)
+{
+  auto sink = startSink();
+  advanceClocks(10_ms, 100);
+
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK_EQUAL(nCompletions, 1);
+  BOOST_CHECK_EQUAL(completedSize, 19 * SEGMENT_SIZE + LAST_SEGMENT_SIZE);
+  BOOST_CHECK_EQUAL(sink->getNResumedSegments(), 0);
+  auto actual = readFile();
+  auto expected = makeObject();
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+  BOOST_CHECK(!boost::filesystem::exists(SegmentFileSink::getProgressFilename(filename)));
+}
+
+BOOST_AUTO_TEST_CASE(Resume)
+{
+  maxSegmentToServe = 5;
+  auto sink = startSink();
+  advanceClocks(10_ms, 100);
+  sink->stop();
+  advanceClocks(10_ms);
+
+  BOOST_CHECK_EQUAL(nCompletions, 0);
+  BOOST_CHECK(boost::filesystem::exists(SegmentFileSink::getProgressFilename(filename)));
+
+  maxSegmentToServe = std::numeric_limits<uint64_t>::max();
+  requestedSegments.clear();
+  sink = startSink();
+  BOOST_CHECK_EQUAL(sink->getNResumedSegments(), 5);
+  advanceClocks(10_ms, 100);
+
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK_EQUAL(nCompletions, 1);
+  for (uint64_t segment : requestedSegments) {
+    BOOST_CHECK_GE(segment, 5);
+  }
+  auto actual = readFile();
+  auto expected = makeObject();
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+  BOOST_CHECK(!boost::filesystem::exists(SegmentFileSink::getProgressFilename(filename)));
+}
+
+BOOST_AUTO_TEST_CASE(ResumeDifferentObject)
+{
+  maxSegmentToServe = 5;
+  auto sink = startSink();
+  advanceClocks(10_ms, 100);
+  sink->stop();
+  advanceClocks(10_ms);
+
+  // the progress file belongs to /object, so it must not be used for /other
+  sink = SegmentFileSink::start(face, Interest("/other"), validator, filename);
+  BOOST_CHECK_EQUAL(sink->getNResumedSegments(), 0);
+  BOOST_CHECK_EQUAL(boost::filesystem::file_size(filepath), 0);
+  sink->stop();
+}
+
+BOOST_AUTO_TEST_CASE(SegmentSizeMismatch)
+{
+  wrongSizeSegment = 3;
+  auto sink = startSink();
+  advanceClocks(10_ms, 100);
+
+  BOOST_CHECK_EQUAL(nCompletions, 0);
+  BOOST_CHECK_EQUAL(nErrors, 1);
+  BOOST_CHECK_EQUAL(lastError, SegmentFileSink::SEGMENT_SIZE_MISMATCH);
+}
+
+BOOST_AUTO_TEST_CASE(CannotOpen)
+{
+  boost::filesystem::create_directory(filepath);
+  BOOST_CHECK_THROW(startSink(), SegmentFileSink::Error);
+  boost::filesystem::remove(filepath);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSegmentFileSink
+BOOST_AUTO_TEST_SUITE_END() // Util
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,220 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/util/segment-publisher.hpp"
+#include "ndn-cxx/util/dummy-client-face.hpp"
+#include "ndn-cxx/util/random.hpp"
+#include "ndn-cxx/util/segment-fetcher.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/unit/dummy-validator.hpp"
+#include "tests/unit/identity-management-time-fixture.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using namespace ndn::tests;
+
+class SegmentPublisherFixture : public IdentityManagementTimeFixture
+{
+protected:
+  SegmentPublisherFixture()
+    : producerFace(io, m_keyChain)
+    , consumerFace(io, m_keyChain)
+  {
+    producerFace.linkTo(consumerFace);
+    options.segmentSize = 1000;
+    options.wantRegister = false;
+  }
+
+  static ConstBufferPtr
+  makeObject(size_t size)
+  {
+    auto buffer = make_shared<Buffer>(size);
+    random::generateSecureBytes(buffer->data(), buffer->size());
+    return buffer;
+  }
+
+  /** \brief Retrieves /object with SegmentFetcher.
+   *  \return the object, or nullptr if the retrieval failed
+   */
+  ConstBufferPtr
+  fetch()
+  {
+    ConstBufferPtr result;
+    auto fetcher = SegmentFetcher::start(consumerFace, Interest("/object"), validator);
+    fetcher->onComplete.connect([&result] (ConstBufferPtr buffer) { result = buffer; });
+    advanceClocks(10_ms, 100);
+    return result;
+  }
+
+protected:
+  DummyClientFace producerFace;
+  DummyClientFace consumerFace;
+  DummyValidator validator;
+  SegmentPublisher::Options options;
+};
+
+BOOST_AUTO_TEST_SUITE(Util)
+BOOST_FIXTURE_TEST_SUITE(TestSegmentPublisher, SegmentPublisherFixture)
+
+BOOST_AUTO_TEST_CASE(PublishBuffer)
+{
+  auto object = makeObject(10500);
+  SegmentPublisher publisher(producerFace, m_keyChain, "/object", object, options);
+  BOOST_CHECK_EQUAL(publisher.getVersionedName().size(), 2);
+  BOOST_CHECK(publisher.getVersionedName()[-1].isVersion());
+  BOOST_CHECK_EQUAL(publisher.getNSegments().value_or(0), 11);
+
+  auto result = fetch();
+  BOOST_REQUIRE(result != nullptr);
+  BOOST_CHECK_EQUAL_COLLECTIONS(result->begin(), result->end(), object->begin(), object->end());
+}
+
+BOOST_AUTO_TEST_CASE(PublishEmptyBuffer)
+{
+  SegmentPublisher publisher(producerFace, m_keyChain, "/object", make_shared<Buffer>(), options);
+  BOOST_CHECK_EQUAL(publisher.getNSegments().value_or(0), 1);
+
+  auto result = fetch();
+  BOOST_REQUIRE(result != nullptr);
+  BOOST_CHECK_EQUAL(result->size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(PublishStream)
+{
+  auto object = makeObject(2500);
+  std::istringstream is(std::string(object->begin(), object->end()));
+  SegmentPublisher publisher(producerFace, m_keyChain, "/object", is, options);
+  // the first batch is read at construction, which reaches the end of this short stream
+  BOOST_CHECK_EQUAL(publisher.getNSegments().value_or(0), 3);
+  BOOST_CHECK_EQUAL(publisher.getNCachedSegments(), 0);
+
+  auto result = fetch();
+  BOOST_REQUIRE(result != nullptr);
+  BOOST_CHECK_EQUAL_COLLECTIONS(result->begin(), result->end(), object->begin(), object->end());
+  BOOST_CHECK_EQUAL(publisher.getNSegments().value_or(0), 3);
+}
+
+BOOST_AUTO_TEST_CASE(PublishFile)
+{
+  auto object = makeObject(4000);
+  auto filepath = boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "TestSegmentPublisher";
+  boost::filesystem::create_directories(filepath.parent_path());
+  {
+    std::ofstream os(filepath.string(), std::ios::binary);
+    os.write(reinterpret_cast<const char*>(object->data()), object->size());
+  }
+
+  SegmentPublisher publisher(producerFace, m_keyChain, "/object", filepath.string(), options);
+  BOOST_CHECK_EQUAL(publisher.getNSegments().value_or(0), 4);
+  auto result = fetch();
+  boost::filesystem::remove(filepath);
+
+  BOOST_REQUIRE(result != nullptr);
+  BOOST_CHECK_EQUAL_COLLECTIONS(result->begin(), result->end(), object->begin(), object->end());
+
+  BOOST_CHECK_THROW(SegmentPublisher(producerFace, m_keyChain, "/object", filepath.string(), options),
+                    SegmentPublisher::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Window)
+{
+  options.windowSize = 4;
+  options.batchSize = 3;
+  SegmentPublisher publisher(producerFace, m_keyChain, "/object", makeObject(20000), options);
+  BOOST_CHECK_EQUAL(publisher.getNCachedSegments(), 0);
+
+  // segments are signed ahead of demand in batches; the batch that follows a signed batch is
+  // signed in the same run of the io_service, until the window is full
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(publisher.getNCachedSegments(), 4);
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(publisher.getNCachedSegments(), 4);
+  BOOST_CHECK_EQUAL(producerFace.sentData.size(), 0);
+
+  // the window follows the highest requested segment
+  Interest interest(Name(publisher.getVersionedName()).appendSegment(9));
+  interest.setCanBePrefix(false);
+  consumerFace.expressInterest(interest, nullptr, nullptr, nullptr);
+  advanceClocks(1_ms, 10);
+  BOOST_REQUIRE_EQUAL(producerFace.sentData.size(), 1);
+  BOOST_CHECK_EQUAL(producerFace.sentData.back().getName(), interest.getName());
+  BOOST_CHECK_EQUAL(producerFace.sentData.back().getFinalBlock().value(),
+                    name::Component::fromSegment(19));
+  BOOST_CHECK_LE(publisher.getNCachedSegments(), 2 * options.windowSize + 1);
+
+  // a segment that fell behind the window is signed again
+  interest.setName(Name(publisher.getVersionedName()).appendSegment(1));
+  consumerFace.expressInterest(interest, nullptr, nullptr, nullptr);
+  advanceClocks(1_ms, 10);
+  BOOST_REQUIRE_EQUAL(producerFace.sentData.size(), 2);
+  BOOST_CHECK_EQUAL(producerFace.sentData.back().getName(), interest.getName());
+
+  // segments beyond the end are not answered
+  interest.setName(Name(publisher.getVersionedName()).appendSegment(20));
+  consumerFace.expressInterest(interest, nullptr, nullptr, nullptr);
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(producerFace.sentData.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(SigningIo)
+{
+  boost::asio::io_service signingIo;
+  options.signingIo = &signingIo;
+  options.windowSize = 4;
+  options.batchSize = 2;
+  BOOST_CHECK_THROW(SegmentPublisher(producerFace, m_keyChain, "/object", makeObject(1), options),
+                    std::invalid_argument);
+  options.signingKeyChain = &m_keyChain;
+  BOOST_CHECK_THROW(SegmentPublisher(producerFace, m_keyChain, "/object", makeObject(1), options),
+                    std::invalid_argument);
+
+  KeyChain signingKeyChain("pib-memory:", "tpm-memory:");
+  options.signingKeyChain = &signingKeyChain;
+  SegmentPublisher publisher(producerFace, m_keyChain, "/object", makeObject(10000), options);
+
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(publisher.getNCachedSegments(), 0);
+
+  signingIo.poll();
+  signingIo.reset();
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(publisher.getNCachedSegments(), 2);
+
+  signingIo.poll();
+  signingIo.reset();
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(publisher.getNCachedSegments(), 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSegmentPublisher
+BOOST_AUTO_TEST_SUITE_END() // Util
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
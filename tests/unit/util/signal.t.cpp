@@ -358,6 +358,30 @@ BOOST_AUTO_TEST_CASE(ConnectSingleShotDisconnected)
   BOOST_CHECK_EQUAL(hit, 0); // handler not called
 }
 
+BOOST_AUTO_TEST_CASE(ConnectSingleShotDisconnectSelf)
+{
+  SignalOwner0 so;
+
+  int hit = 0;
+  Connection connection;
+  connection = so.sig.connectSingleShot([&connection, &hit] {
+    ++hit;
+    connection.disconnect();
+  });
+  int hit2 = 0;
+  so.sig.connect([&hit2] { ++hit2; });
+
+  so.emitSignal(sig);
+  BOOST_CHECK_EQUAL(hit, 1); // handler called
+  BOOST_CHECK_EQUAL(hit2, 1);
+  BOOST_CHECK_EQUAL(connection.isConnected(), false);
+  BOOST_CHECK_EQUAL(so.isSigEmpty(), false); // the other handler is still connected
+
+  so.emitSignal(sig);
+  BOOST_CHECK_EQUAL(hit, 1); // handler not called
+  BOOST_CHECK_EQUAL(hit2, 2);
+}
+
 BOOST_AUTO_TEST_CASE(ConnectSingleShot1)
 {
   SignalEmitter1 se;
@@ -420,6 +444,61 @@ BOOST_AUTO_TEST_CASE(DisconnectSelfInHandler)
   BOOST_CHECK_EQUAL(hit, 1); // handler not called
 }
 
+BOOST_AUTO_TEST_CASE(DisconnectOtherInHandler)
+{
+  SignalOwner0 so;
+
+  int hit1 = 0, hit2 = 0, hit3 = 0;
+  Connection conn2, conn3;
+  so.sig.connect([&] {
+    ++hit1;
+    conn2.disconnect();
+    // a handler connected during emission can be disconnected before the emission ends
+    conn3 = so.sig.connect([&] { ++hit3; });
+    conn3.disconnect();
+  });
+  conn2 = so.sig.connect([&] { ++hit2; });
+
+  so.emitSignal(sig);
+  BOOST_CHECK_EQUAL(hit1, 1);
+  BOOST_CHECK_EQUAL(hit2, 0); // disconnected before it would execute
+  BOOST_CHECK_EQUAL(conn2.isConnected(), false);
+  BOOST_CHECK_EQUAL(conn3.isConnected(), false);
+
+  so.emitSignal(sig);
+  BOOST_CHECK_EQUAL(hit1, 2);
+  BOOST_CHECK_EQUAL(hit2, 0);
+  BOOST_CHECK_EQUAL(hit3, 0);
+}
+
+BOOST_AUTO_TEST_CASE(ReuseSlot)
+{
+  SignalOwner0 so;
+
+  int hit1 = 0, hit2 = 0, hit3 = 0;
+  Connection conn1 = so.sig.connect([&] { ++hit1; });
+  Connection conn2 = so.sig.connect([&] { ++hit2; });
+  conn1.disconnect();
+
+  // the new handler takes the slot of the disconnected one
+  Connection conn3 = so.sig.connect([&] { ++hit3; });
+  BOOST_CHECK_EQUAL(conn1.isConnected(), false);
+  BOOST_CHECK(conn1 != conn3);
+
+  // a stale connection cannot disconnect the new handler
+  conn1.disconnect();
+  BOOST_CHECK_EQUAL(conn3.isConnected(), true);
+
+  so.emitSignal(sig);
+  BOOST_CHECK_EQUAL(hit1, 0);
+  BOOST_CHECK_EQUAL(hit2, 1);
+  BOOST_CHECK_EQUAL(hit3, 1);
+
+  conn2.disconnect();
+  conn3.disconnect();
+  BOOST_CHECK_EQUAL(so.isSigEmpty(), true);
+}
+
 BOOST_AUTO_TEST_CASE(ThrowInHandler)
 {
   SignalOwner0 so;
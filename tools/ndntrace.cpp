@@ -0,0 +1,317 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2019 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/face.hpp"
+#include "ndn-cxx/lp/nack.hpp"
+#include "ndn-cxx/lp/packet.hpp"
+#include "ndn-cxx/transport/transport.hpp"
+#include "ndn-cxx/util/packet-trace.hpp"
+#include "ndn-cxx/util/scheduler.hpp"
+#include "ndn-cxx/version.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/parsers.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+#include <iostream>
+
+namespace ndn {
+namespace ndntrace {
+
+using util::PacketDirection;
+using util::PacketTraceReader;
+
+const char NDNTRACE_HELP_TEXT[] = R"STR(Usage: ndntrace COMMAND [OPTION]... FILE
+
+Available commands:
+  help      Print this help text
+  version   Print program version
+  dump      Print the packets recorded in a trace file
+  replay    Send the outgoing packets of a trace file to the local forwarder
+
+Try 'ndntrace COMMAND --help' for more information on each command.)STR";
+
+static void
+printPacket(std::ostream& os, const Block& wire)
+{
+  lp::Packet lpPacket(wire);
+  if (lpPacket.has<lp::FragCountField>() && lpPacket.get<lp::FragCountField>() > 1) {
+    // a partial or malformed fragment may lack some fields, which are then printed as '?'
+    os << "fragment ";
+    if (lpPacket.has<lp::FragIndexField>()) {
+      os << lpPacket.get<lp::FragIndexField>();
+    }
+    else {
+      os << '?';
+    }
+    os << '/' << lpPacket.get<lp::FragCountField>() << " seq=";
+    if (lpPacket.has<lp::SequenceField>()) {
+      os << lpPacket.get<lp::SequenceField>();
+    }
+    else {
+      os << '?';
+    }
+    return;
+  }
+  if (!lpPacket.has<lp::FragmentField>()) {
+    os << "idle";
+    return;
+  }
+
+  Block netPacket = wire;
+  if (wire.type() == lp::tlv::LpPacket) {
+    // a bare Interest/Data is wrapped by a copy in lpPacket, so only an LpPacket is sliced
+    Buffer::const_iterator begin, end;
+    std::tie(begin, end) = lpPacket.get<lp::FragmentField>();
+    netPacket = Block(wire, begin, end);
+  }
+  switch (netPacket.type()) {
+    case tlv::Interest:
+      if (lpPacket.has<lp::NackField>()) {
+        os << "N " << Interest(netPacket) << '~' << lpPacket.get<lp::NackField>().getReason();
+      }
+      else {
+        os << "I " << Interest(netPacket);
+      }
+      break;
+    case tlv::Data:
+      os << "D " << Data(netPacket).getName();
+      break;
+    default:
+      os << "type=" << netPacket.type();
+      break;
+  }
+}
+
+static int
+ndntrace_dump(int argc, char** argv)
+{
+  namespace po = boost::program_options;
+
+  std::string filename;
+
+  po::options_description description(
+    "Usage: ndntrace dump [-h] FILE\n"
+    "\n"
+    "Prints one line per packet: timestamp, direction, size, and a summary of the packet.\n"
+    "\n"
+    "Options");
+  description.add_options()
+    ("help,h", "produce help message")
+    ("file",   po::value<std::string>(&filename), "trace file")
+    ;
+
+  po::positional_options_description p;
+  p.add("file", 1);
+
+  po::variables_map vm;
+  try {
+    po::store(po::command_line_parser(argc, argv).options(description).positional(p).run(), vm);
+    po::notify(vm);
+  }
+  catch (const std::exception& e) {
+    std::cerr << "ERROR: " << e.what() << "\n\n"
+              << description << std::endl;
+    return 2;
+  }
+
+  if (vm.count("help") > 0) {
+    std::cout << description << std::endl;
+    return 0;
+  }
+
+  if (vm.count("file") == 0) {
+    std::cerr << "ERROR: you must specify a trace file" << std::endl;
+    return 2;
+  }
+
+  PacketTraceReader reader(filename);
+  while (auto record = reader.read()) {
+    std::cout << time::toIsoString(record->timestamp) << ' '
+              << (record->direction == PacketDirection::INCOMING ? '>' : '<') << ' '
+              << record->wire.size() << ' ';
+    // a malformed packet is reported, and the dump continues with the next record
+    try {
+      printPacket(std::cout, record->wire);
+    }
+    catch (const tlv::Error& e) {
+      std::cout << "malformed: " << e.what();
+    }
+    std::cout << '\n';
+  }
+  return 0;
+}
+
+/** \brief Face that exposes its transport, so that recorded packets can be sent as they are
+ */
+class ReplayFace : public Face
+{
+public:
+  using Face::getTransport;
+};
+
+class Replayer : noncopyable
+{
+public:
+  Replayer(PacketTraceReader& reader, bool wantTiming)
+    : m_reader(reader)
+    , m_wantTiming(wantTiming)
+    , m_scheduler(m_face.getIoService())
+    , m_transport(m_face.getTransport())
+  {
+  }
+
+  size_t
+  run()
+  {
+    m_transport->connect(m_face.getIoService(), [] (const Block&) {});
+    m_start = time::steady_clock::now();
+    sendNext();
+    m_face.getIoService().run();
+    return m_nSent;
+  }
+
+private:
+  void
+  sendNext()
+  {
+    optional<PacketTraceReader::Record> record;
+    do {
+      record = m_reader.read();
+    } while (record && record->direction != PacketDirection::OUTGOING);
+
+    if (!record) {
+      // let the transport finish sending before closing it
+      m_scheduler.schedule(1_s, [this] { m_transport->close(); });
+      return;
+    }
+
+    if (!m_firstTimestamp) {
+      m_firstTimestamp = record->timestamp;
+    }
+    auto delay = m_wantTiming ? (record->timestamp - *m_firstTimestamp) -
+                                (time::steady_clock::now() - m_start)
+                              : time::nanoseconds::zero();
+    m_scheduler.schedule(std::max(delay, time::nanoseconds::zero()), [this, wire = record->wire] {
+      m_transport->send(wire);
+      ++m_nSent;
+      sendNext();
+    });
+  }
+
+private:
+  PacketTraceReader& m_reader;
+  bool m_wantTiming;
+  ReplayFace m_face;
+  Scheduler m_scheduler;
+  shared_ptr<Transport> m_transport;
+  time::steady_clock::TimePoint m_start;
+  optional<time::system_clock::TimePoint> m_firstTimestamp;
+  size_t m_nSent = 0;
+};
+
+static int
+ndntrace_replay(int argc, char** argv)
+{
+  namespace po = boost::program_options;
+
+  std::string filename;
+  bool isFast = false;
+
+  po::options_description description(
+    "Usage: ndntrace replay [-h] [-f] FILE\n"
+    "\n"
+    "Sends the packets that were recorded as outgoing to the local forwarder, using the\n"
+    "transport configured in client.conf.\n"
+    "\n"
+    "Options");
+  description.add_options()
+    ("help,h", "produce help message")
+    ("fast,f", po::bool_switch(&isFast), "send packets as fast as possible, "
+                                          "instead of reproducing the recorded timing")
+    ("file",   po::value<std::string>(&filename), "trace file")
+    ;
+
+  po::positional_options_description p;
+  p.add("file", 1);
+
+  po::variables_map vm;
+  try {
+    po::store(po::command_line_parser(argc, argv).options(description).positional(p).run(), vm);
+    po::notify(vm);
+  }
+  catch (const std::exception& e) {
+    std::cerr << "ERROR: " << e.what() << "\n\n"
+              << description << std::endl;
+    return 2;
+  }
+
+  if (vm.count("help") > 0) {
+    std::cout << description << std::endl;
+    return 0;
+  }
+
+  if (vm.count("file") == 0) {
+    std::cerr << "ERROR: you must specify a trace file" << std::endl;
+    return 2;
+  }
+
+  PacketTraceReader reader(filename);
+  Replayer replayer(reader, !isFast);
+  size_t nSent = replayer.run();
+  std::cerr << "Sent " << nSent << " packets" << std::endl;
+  return 0;
+}
+
+} // namespace ndntrace
+} // namespace ndn
+
+int
+main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    std::cerr << ndn::ndntrace::NDNTRACE_HELP_TEXT << std::endl;
+    return 2;
+  }
+
+  using namespace ndn::ndntrace;
+
+  std::string command(argv[1]);
+  try {
+    if (command == "help")         { std::cout << NDNTRACE_HELP_TEXT << std::endl; }
+    else if (command == "version") { std::cout << NDN_CXX_VERSION_BUILD_STRING << std::endl; }
+    else if (command == "dump")    { return ndntrace_dump(argc - 1, argv + 1); }
+    else if (command == "replay")  { return ndntrace_replay(argc - 1, argv + 1); }
+    else {
+      std::cerr << "ERROR: Unknown command '" << command << "'\n"
+                << "\n"
+                << NDNTRACE_HELP_TEXT << std::endl;
+      return 2;
+    }
+  }
+  catch (const std::exception& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}